@@ -4,6 +4,7 @@
 #pragma once
 
 #include <cstddef>
+#include <vector>
 #include "openvino/openvino.hpp"
 
 namespace ov::genai {
@@ -17,6 +18,20 @@ namespace ov::genai {
                     * of a given token in cache */
     };
 
+    /**
+    * @brief Represents the policy which determines the tokens that may be evicted from cache and the moment of eviction
+    */
+    enum class CacheEvictionPolicy {
+        DEFAULT, /**< The "start" and "recent" areas of KV cache are retained and the blocks with the lowest aggregated
+                    * importance scores are evicted from the area between them during generation */
+        H2O,     /**< Heavy-hitter oracle: same as DEFAULT, but the "start" area is not retained, so the blocks in the
+                    * beginning of KV cache are kept only if their scores are high enough */
+        SNAPKV   /**< The prompt is compressed to max_cache_size once after it is processed, based on attention scores of
+                    * the last "recent_size" prompt tokens (the observation window), and no tokens are evicted during
+                    * generation. With dynamic split-fuse the observation window is processed in a separate chunk,
+                    * otherwise scores of the whole prompt are used. `aggregation_mode` is not used by this policy */
+    };
+
     /**
     * @brief Configuration struct for the cache eviction algorithm.
     */
@@ -66,6 +81,21 @@ namespace ov::genai {
          *  original llama model and you experience accuracy issues with cache eviction enabled
          *  and apply_rotation=true.**/
         bool apply_rotation = false;
+
+        /** Attention scores are aggregated and blocks are evicted once per this number of generation steps.
+         *  Values larger than 1 reduce the cost of score aggregation at large batch sizes, but the KV cache of
+         *  a sequence may exceed max_cache_size by the tokens generated between evictions, and the importance
+         *  of tokens is estimated from the scores of a subset of generation steps. Must be non-zero.**/
+        std::size_t score_aggregation_interval = 1;
+
+        /** Indices of decoder layers whose attention scores are aggregated. If empty, scores of each layer are
+         *  aggregated separately and blocks are evicted from each layer independently. Otherwise, scores of the
+         *  listed layers are summed into a single importance score and the same blocks are evicted from all layers,
+         *  which makes aggregation cost independent of the number of layers in the model.**/
+        std::vector<std::size_t> score_layers;
+
+        /** The policy of cache eviction. */
+        CacheEvictionPolicy policy = CacheEvictionPolicy::DEFAULT;
     private:
         /** Number of tokens in the *beginning* of KV cache that should be retained
  * in the KV cache for this sequence during generation. Must be non-zero and a multiple of the KV cache block size for
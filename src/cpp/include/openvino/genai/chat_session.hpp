@@ -0,0 +1,142 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <filesystem>
+#include <list>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "openvino/runtime/tensor.hpp"
+#include "openvino/genai/tokenizer.hpp"
+#include "openvino/genai/visibility.hpp"
+
+namespace ov::genai {
+
+/**
+ * @brief Snapshot of a chat conversation of LLMPipeline: the chat history and the KV cache computed for it.
+ * A session exported by LLMPipeline::export_chat_session() can be imported later with LLMPipeline::import_chat_session()
+ * to continue the conversation without recomputing its history, so that many conversations can be served by a single
+ * pipeline. The KV cache is valid only for the model and the device the session was exported from.
+ */
+struct OPENVINO_GENAI_EXPORTS ChatSession {
+    /**
+     * Messages of the conversation. Empty if the chat is run with encoded inputs.
+     */
+    ChatHistory history;
+
+    /**
+     * The chat history with the chat template applied, as it was encoded at the last turn.
+     */
+    std::string templated_history;
+
+    /**
+     * Token ids of the conversation: the encoded templated history, or inputs and outputs of a chat run with encoded inputs.
+     */
+    std::vector<int64_t> history_tokens;
+
+    /**
+     * Whether the chat is run with encoded inputs.
+     */
+    bool encoded_inputs = false;
+
+    /**
+     * Token ids whose keys and values are stored in the KV cache.
+     */
+    std::vector<int64_t> kv_cache_tokens;
+
+    /**
+     * Number of tokens at the end of the KV cache which are dropped before the next generation.
+     */
+    size_t num_kv_cache_tokens_to_trim = 0;
+
+    /**
+     * Attention mask of the tokens stored in the KV cache.
+     */
+    ov::Tensor attention_mask;
+
+    /**
+     * Model states holding the KV cache, by names of the model variables.
+     */
+    std::map<std::string, ov::Tensor> states;
+
+    /**
+     * @return Size of the KV cache and token ids held by the session in bytes.
+     */
+    size_t get_byte_size() const;
+
+    /**
+     * Writes the session to a binary file.
+     */
+    void save(const std::filesystem::path& path) const;
+
+    /**
+     * Reads a session written by save().
+     */
+    static ChatSession load(const std::filesystem::path& path);
+};
+
+/**
+ * @brief Keeps chat sessions of many conversations within a memory budget.
+ * When the total size of sessions exceeds the budget, the least recently used ones are saved to the spill directory
+ * and loaded back on access, or dropped if the spill directory is not set. A session larger than the whole budget is
+ * saved to the spill directory right away. Methods can be called from any thread.
+ */
+class OPENVINO_GENAI_EXPORTS ChatSessionCache {
+public:
+    /**
+     * @param max_memory_size Maximum total size of sessions kept in memory in bytes.
+     * @param spill_dir Directory for sessions which don't fit into the memory budget. If empty, such sessions are dropped.
+     */
+    explicit ChatSessionCache(size_t max_memory_size, const std::filesystem::path& spill_dir = {});
+
+    ~ChatSessionCache();
+
+    /**
+     * Stores the session, replacing the previous session with the same id.
+     * Throws if the session is larger than the memory budget and the spill directory is not set.
+     */
+    void put(const std::string& session_id, ChatSession session);
+
+    /**
+     * Removes the session from the cache and returns it.
+     * @return The session, or std::nullopt if there is no session with the id or it was dropped.
+     */
+    std::optional<ChatSession> take(const std::string& session_id);
+
+    /**
+     * @return Whether the cache holds a session with the id, in memory or in the spill directory.
+     */
+    bool contains(const std::string& session_id) const;
+
+    void remove(const std::string& session_id);
+
+    /**
+     * @return Total size of sessions kept in memory in bytes.
+     */
+    size_t get_memory_size() const;
+
+private:
+    void remove_locked(const std::string& session_id);
+    std::filesystem::path get_spill_path(const std::string& session_id);
+    void spill_least_recently_used();
+
+    size_t m_max_memory_size;
+    std::filesystem::path m_spill_dir;
+    size_t m_memory_size = 0;
+
+    // the most recently used sessions are at the front
+    std::list<std::pair<std::string, ChatSession>> m_sessions;
+    std::unordered_map<std::string, std::list<std::pair<std::string, ChatSession>>::iterator> m_session_by_id;
+    std::unordered_map<std::string, std::filesystem::path> m_spilled_sessions;
+    // makes names of spill files unique, as they are based on hashes of session ids
+    uint64_t m_num_spill_files = 0;
+    mutable std::mutex m_mutex;
+};
+
+}  // namespace ov::genai
@@ -15,20 +15,62 @@
 #include "openvino/genai/llm_pipeline.hpp"
 #include "openvino/genai/streamer_base.hpp"
 #include "openvino/genai/visibility.hpp"
+#include "openvino/genai/visual_language/pipeline.hpp"
 #include "cache_eviction.hpp"
 
 namespace ov::genai {
 
+/**
+ * @brief Distribution of values observed during the lifetime of the pipeline.
+ */
+struct MetricsHistogram {
+    /**
+    * Upper bounds (inclusive) of buckets in ascending order, the last bucket has no upper bound
+    */
+    std::vector<double> bounds;
+
+    /**
+    * Number of observed values in each bucket, counts.size() == bounds.size() + 1
+    */
+    std::vector<size_t> counts;
+
+    /**
+    * Sum of all observed values
+    */
+    double sum = 0.0;
+
+    /**
+    * Number of observed values
+    */
+    size_t count = 0;
+};
+
 /**
  * @brief Contains general pipeline metrics, either aggregated throughout the lifetime of the generation pipeline
  * or measured at the previous generation step.
+ * Metrics are updated at each step and can be read from any thread without blocking the pipeline.
  */
-struct PipelineMetrics {
+struct OPENVINO_GENAI_EXPORTS PipelineMetrics {
     /**
      * Number of requests to be processed by the pipeline.
      */
     size_t requests = 0;
 
+    /**
+     * Number of requests which wait for their prompts to be processed at the previous step of the pipeline.
+     */
+    size_t waiting_requests = 0;
+
+    /**
+     * Number of requests which are being processed at the previous step of the pipeline.
+     */
+    size_t running_requests = 0;
+
+    /**
+     * Number of requests which were preempted and wait to be scheduled again at the previous step of the pipeline.
+     */
+    size_t preempted_requests = 0;
+
     /**
      * Number of requests that were scheduled for processing at the previous step of the pipeline.
      */
@@ -48,8 +90,86 @@ struct PipelineMetrics {
     * Running average of the KV cache usage during the lifetime of the pipeline, with max window size of 1000 steps
     */
     float avg_cache_usage = 0.0;
+
+    /**
+    * Number of KV cache blocks occupied by sequences in the last generation step.
+    */
+    size_t used_kv_blocks = 0;
+
+    /**
+    * Number of KV cache blocks available for allocation in the last generation step, including cached ones.
+    */
+    size_t free_kv_blocks = 0;
+
+    /**
+    * Number of free KV cache blocks which keep prefixes of finished sequences for prefix caching.
+    */
+    size_t cached_kv_blocks = 0;
+
+    /**
+    * Number of preemptions of sequence groups by recompute during the lifetime of the pipeline
+    */
+    size_t num_preemptions = 0;
+
+    /**
+    * Number of preemptions which released only a part of sequence group blocks, other preemptions release all blocks
+    */
+    size_t num_partial_preemptions = 0;
+
+    /**
+    * Total number of prompt tokens of requests added to the pipeline
+    */
+    size_t prompt_tokens = 0;
+
+    /**
+    * Number of prompt tokens whose KV cache was restored from the prefix cache instead of being computed
+    */
+    size_t cached_prompt_tokens = 0;
+
+    /**
+    * Total number of tokens generated by the pipeline
+    */
+    size_t generated_tokens = 0;
+
+    /**
+    * Number of draft tokens proposed by speculative decoding or prompt lookup
+    */
+    size_t draft_tokens = 0;
+
+    /**
+    * Number of draft tokens accepted by the main model
+    */
+    size_t accepted_draft_tokens = 0;
+
+    /**
+    * Histogram of durations of generation steps in milliseconds
+    */
+    MetricsHistogram step_duration;
+
+    /**
+    * Histogram of numbers of tokens scheduled for processing in a generation step
+    */
+    MetricsHistogram tokens_per_step;
+
+    /**
+    * Returns metrics in Prometheus text exposition format, e.g. to be served by an HTTP endpoint or passed to a callback
+    * @param prefix Prefix of metric names
+    */
+    std::string to_prometheus(const std::string& prefix = "ov_genai") const;
+
+    /**
+    * Writes metrics in Prometheus text exposition format to a file, e.g. for node_exporter textfile collector.
+    * The file is replaced atomically, so readers never see a partially written file.
+    */
+    void write_prometheus(const std::filesystem::path& path, const std::string& prefix = "ov_genai") const;
 };
 
+/**
+ * @brief Serves multiple requests in continuous batching manner using PagedAttention.
+ * If models_path contains a VLM (openvino_language_model.xml, openvino_text_embeddings_model.xml
+ * and vision models), the pipeline also accepts images: prompts and images are converted to
+ * embeddings which are passed to the language model instead of token ids.
+ */
 class OPENVINO_GENAI_EXPORTS ContinuousBatchingPipeline {
 protected:
     class IContinuousBatchingPipeline;
@@ -67,6 +187,10 @@ protected:
 
     std::shared_ptr<IContinuousBatchingPipeline> m_impl;
 
+    class ContinuousBatchingEngine;
+    // performs generation steps in a background thread after start_engine() is called
+    std::shared_ptr<ContinuousBatchingEngine> m_engine;
+
     ContinuousBatchingPipeline() = default;
 
 public:
@@ -132,14 +256,61 @@ public:
     GenerationHandle add_request(uint64_t request_id, const ov::Tensor& input_ids, const ov::genai::GenerationConfig& sampling_params);
     GenerationHandle add_request(uint64_t request_id, const std::string& prompt, const ov::genai::GenerationConfig& sampling_params);
 
+    /**
+    * @brief Adds a request with a prompt and uint8 RGB images with [NHWC] or [HWC] layout.
+    * Supported only by pipelines created from VLM models.
+    *
+    * @param request_id Request identifier
+    * @param prompt A prompt to respond to
+    * @param images Images to be prepended to the prompt
+    * @param sampling_params A config to follow for text generation
+    */
+    GenerationHandle add_request(uint64_t request_id, const std::string& prompt, const std::vector<ov::Tensor>& images, const ov::genai::GenerationConfig& sampling_params);
+
     void step();
 
     bool has_non_finished_requests();
 
+    /**
+    * @brief Starts a background thread which performs generation steps while there are requests to process and sleeps
+    * otherwise. Requests added by add_request() wake the thread up, their outputs are read from generation handles or
+    * passed to callbacks set by GenerationHandle::set_output_callback(). step() and generate() can't be called while
+    * the engine is running. If a generation step throws, the engine stops, all requests get IGNORED status with empty
+    * outputs, so their readers and callbacks don't wait forever, and the exception is rethrown by the next
+    * add_request() or stop_engine() call.
+    *
+    * @param max_waiting_requests if non-zero, add_request() throws when this number of requests wait for their
+    * prompts to be processed, so that a server can reject requests instead of queueing them without bound
+    */
+    void start_engine(size_t max_waiting_requests = 0);
+
+    /**
+    * @brief Stops the background thread after the current generation step. Unfinished requests stay in the pipeline
+    * and are processed by step() or after the engine is started again.
+    */
+    void stop_engine();
+
+    bool is_engine_running() const;
+
     // more high level interface, which can process multiple prompts in continuous batching manner
     std::vector<EncodedGenerationResult> generate(const std::vector<ov::Tensor>& input_ids, const std::vector<ov::genai::GenerationConfig>& sampling_params, const ov::genai::StreamerVariant& streamer=std::monostate{});
     std::vector<GenerationResult> generate(const std::vector<std::string>& prompts, const std::vector<ov::genai::GenerationConfig>& sampling_params, const ov::genai::StreamerVariant& streamer=std::monostate{});
 
+    /**
+    * @brief Generates responses for prompts with images in continuous batching manner.
+    * Supported only by pipelines created from VLM models.
+    *
+    * @param prompts Prompts to respond to
+    * @param images Images for each prompt, uint8 RGB tensors with [NHWC] or [HWC] layout
+    * @param sampling_params Generation configs for each prompt
+    * @param streamer optional streamer, supported only for a single prompt
+    */
+    std::vector<VLMDecodedResults> generate(
+        const std::vector<std::string>& prompts,
+        const std::vector<std::vector<ov::Tensor>>& images,
+        const std::vector<ov::genai::GenerationConfig>& sampling_params,
+        const ov::genai::StreamerVariant& streamer=std::monostate{});
+
     /**
     * @brief start chat with keeping history in kv cache.
     * @param system_message optional system message.
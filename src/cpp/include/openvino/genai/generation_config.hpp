@@ -5,6 +5,7 @@
 
 #include <filesystem>
 #include <limits>
+#include <optional>
 #include <variant>
 #include <string>
 
@@ -25,6 +26,34 @@ namespace genai {
  */
 enum class StopCriteria { EARLY, HEURISTIC, NEVER };
 
+/**
+ * @brief scheduling priority of a request in continuous batching pipelines. The following values are possible:
+ *        "HIGH" is meant for latency sensitive requests, e.g. interactive chat. These requests are scheduled first,
+ *        preempted last and may use the part of the token budget reserved by SchedulerConfig::high_priority_tokens_share.
+ *        "NORMAL" requests are scheduled after HIGH priority ones.
+ *        "LOW" is meant for offline batch jobs, which only fill the capacity left by requests of higher priorities
+ *        and are preempted first.
+ */
+enum class RequestPriority { HIGH, NORMAL, LOW };
+
+/**
+ * @brief Structure to keep parameters of structured output generation. Generated tokens are constrained,
+ * so the whole output matches one of the following descriptions. Exactly one of them should be set.
+ *
+ * @param json_schema if set, the output is a JSON document valid against the JSON schema.
+ * @param regex if set, the output matches the regex.
+ * @param grammar if set, the output matches EBNF grammar in GBNF notation with `root` rule. Recursive rules are not supported.
+ */
+struct OPENVINO_GENAI_EXPORTS StructuredOutputConfig {
+    std::optional<std::string> json_schema;
+    std::optional<std::string> regex;
+    std::optional<std::string> grammar;
+
+    /// @brief checks that exactly one of json_schema, regex or grammar is set.
+    /// @throws Exception if config is invalid.
+    void validate() const;
+};
+
 /**
  * @brief Structure to keep generation config parameters. For a selected method of decoding, only parameters from that group
  * and generic parameters are used. For example, if do_sample is set to true, then only generic parameters and random sampling parameters will
@@ -77,8 +106,22 @@ enum class StopCriteria { EARLY, HEURISTIC, NEVER };
  * @param assistant_confidence_threshold the lower token probability of candidate to be validated by main model in case of dynamic strategy candidates number update.
  * @param num_assistant_tokens the defined candidates number to be generated by draft model/prompt lookup in case of static strategy candidates number update.
  * @param max_ngram_size is maximum ngram to use when looking for matches in the prompt.
+ * @param num_assistant_branches the number of alternative candidate sequences proposed by prompt lookup. All branches are validated
+ * by the main model in a single step and the one with the longest accepted prefix is kept. Supported by greedy decoding only.
  *
  * @param apply_chat_template whether or not to apply chat_template for non-chat scenarios
+ *
+ * @param structured_output_config if set, the output is constrained by a JSON schema, regex or grammar. Not supported by beam search.
+ *
+ * @param cache_eviction_config if set, overrides the cache eviction config of the pipeline for this request, e.g. to select
+ * another eviction policy or cache budget. Requires SchedulerConfig::use_cache_eviction. `apply_rotation` and
+ * `score_aggregation_interval` are taken from the pipeline config.
+ *
+ * Scheduling parameters (continuous batching pipelines only):
+ * @param priority scheduling priority of the request, see RequestPriority.
+ * @param deadline_ms time in milliseconds since the request is added by which its first token is expected. Among requests of
+ * the same priority, the ones with earlier deadlines are scheduled first, followed by the ones without deadline in the order
+ * of arrival. 0 means no deadline.
  */
 
 class OPENVINO_GENAI_EXPORTS GenerationConfig {
@@ -127,12 +170,21 @@ public:
     float assistant_confidence_threshold = 0.f;
     size_t num_assistant_tokens = 0;
     size_t max_ngram_size = 0;
+    size_t num_assistant_branches = 1;
 
     std::optional<AdapterConfig> adapters;
 
     // set to true if chat template should be applied for non-chat scenarios, set to false otherwise
     bool apply_chat_template = true;
 
+    std::optional<StructuredOutputConfig> structured_output_config;
+
+    std::optional<CacheEvictionConfig> cache_eviction_config;
+
+    // Scheduling
+    RequestPriority priority = RequestPriority::NORMAL;
+    size_t deadline_ms = 0;
+
     /** @brief sets eos_token_id to tokenizer_eos_token_id if eos_token_id is less than 0.
      * Otherwise verifies eos_token_id == tokenizer_eos_token_id.
      */
@@ -193,9 +245,17 @@ extern OPENVINO_GENAI_EXPORTS ov::Property<size_t> rng_seed;
 
 static constexpr ov::Property<float> assistant_confidence_threshold{"assistant_confidence_threshold"};
 static constexpr ov::Property<size_t> num_assistant_tokens{"num_assistant_tokens"};
+static constexpr ov::Property<size_t> num_assistant_branches{"num_assistant_branches"};
 
 static constexpr ov::Property<bool> apply_chat_template{"apply_chat_template"};
 
+static constexpr ov::Property<StructuredOutputConfig> structured_output_config{"structured_output_config"};
+
+static constexpr ov::Property<CacheEvictionConfig> cache_eviction_config{"cache_eviction_config"};
+
+static constexpr ov::Property<RequestPriority> priority{"priority"};
+static constexpr ov::Property<size_t> deadline_ms{"deadline_ms"};
+
 // Predefined Configs
 
 OPENVINO_DEPRECATED("Please, use individual parameters instead of predefined configs. This method will be removed in 2026.0.0 release")
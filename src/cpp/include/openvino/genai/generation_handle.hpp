@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <unordered_map>
 
@@ -15,7 +16,7 @@ namespace ov::genai {
 enum class GenerationStatus {
     RUNNING = 0, // Default status for ongoing generation
     FINISHED = 1, // Status set when generation has been finished
-    IGNORED = 2, // Status set when generation run into out-of-memory condition and could not be continued
+    IGNORED = 2, // Status set when generation run into out-of-memory condition or a failed step and could not be continued
     CANCEL = 3, // Status set when generation handle is cancelled. The last prompt and all generated tokens will be dropped from history, KV cache will include history but last step.
     STOP = 4, // Status set when generation handle is stopped. History will be kept, KV cache will include the last prompt and generated tokens.
     DROPPED_BY_HANDLE OPENVINO_ENUM_DEPRECATED("Please, use `STOP` instead of `DROPPED_BY_HANDLE`.") = GenerationStatus::STOP // Status set when generation handle is dropped.
@@ -110,6 +111,17 @@ public:
     GenerationOutputs read();
     // Reads all generated tokens for all sequences
     std::vector<GenerationOutput> read_all();
+
+    /**
+     * Sets a callback which receives outputs of each generation step instead of read() / read_all(), along with the
+     * status of the generation: FINISHED or IGNORED with the last outputs of the request, RUNNING otherwise.
+     * The callback is called from the thread performing generation steps, so it must be fast and must not block.
+     * Outputs produced before the callback is set are passed to it immediately. If they have been read already and
+     * the generation has finished, the callback gets empty outputs with the final status.
+     * Calls of the callback don't overlap and the callback may use the handle. An exception thrown by the callback fails
+     * the generation step, so all requests of the pipeline are dropped and get IGNORED status.
+     */
+    void set_output_callback(std::function<void(GenerationOutputs, GenerationStatus)> callback);
 };
 
 using GenerationHandle = std::shared_ptr<GenerationHandleImpl>;
@@ -111,6 +111,14 @@ struct OPENVINO_GENAI_EXPORTS ImageGenerationConfig {
      */
     int max_sequence_length = -1;
 
+    /**
+     * Inference step starting from which classifier-free guidance is truncated and
+     * only conditional branch of denoising model is computed. Currently, it's used only for SD.
+     * Default value -1 means that guidance is applied on all inference steps.
+     * Note, that UNet reshaped to a static batch still computes both branches on truncated steps.
+     */
+    int64_t cfg_truncation_step = -1;
+
     /**
      * Strength parameter used in Image to imaage / Inpainting pipelines.
      * Must be 1.0 for text to image generation as no initial image is provided in such scenario.
@@ -236,6 +244,14 @@ extern OPENVINO_GENAI_EXPORTS ov::Property<size_t> rng_seed;
  */
 static constexpr ov::Property<int> max_sequence_length{"max_sequence_length"};
 
+/**
+ * Truncates classifier-free guidance starting from a given inference step: unconditional branch of UNet
+ * is not computed anymore and noise prediction of conditional branch is used as is.
+ * Late denoising steps are much less sensitive to guidance, so truncation saves up to a half of UNet computations
+ * on these steps with negligible impact on image quality. Currently, it's used only for SD.
+ */
+static constexpr ov::Property<int64_t> cfg_truncation_step{"cfg_truncation_step"};
+
 /**
  * User callback for image generation pipelines, which is called within a pipeline with the following arguments:
  * - Current inference step
@@ -106,7 +106,17 @@ private:
 
     class UNetInferenceDynamic;
     class UNetInferenceStaticBS1;
+    class UNetInferenceParallelCFG;
 };
 
+/**
+ * Compile property which enables parallel execution of classifier-free guidance branches.
+ * Unconditional and conditional halves of UNet batch are inferred concurrently on two infer requests
+ * instead of a single inference with doubled batch. On CPU, each request runs on its own stream with half of the cores
+ * (unless 'ov::num_streams' is specified explicitly), which is faster than a single batch-2 inference on multi-socket systems.
+ * Ignored for NPU, where UNet is always inferred with batch 1 requests.
+ */
+static constexpr ov::Property<bool> parallel_cfg{"parallel_cfg"};
+
 } // namespace genai
 } // namespace ov
@@ -9,6 +9,7 @@
 #include <filesystem>
 
 #include "openvino/core/any.hpp"
+#include "openvino/genai/chat_session.hpp"
 #include "openvino/genai/generation_config.hpp"
 #include "openvino/genai/tokenizer.hpp"
 #include "openvino/genai/streamer_base.hpp"
@@ -274,6 +275,19 @@ public:
     * Turns off keeping KV cache between generate calls.
     */
     void finish_chat();
+
+    /**
+    * @brief Exports the current chat conversation with its KV cache, so that it can be continued later by
+    * import_chat_session() after other conversations are processed by the pipeline.
+    * Supported only by the stateful pipeline, i.e. with ATTENTION_BACKEND set to SDPA.
+    */
+    ChatSession export_chat_session();
+
+    /**
+    * @brief Starts chat from a session exported by export_chat_session(), discarding the current conversation.
+    * The KV cache of the session is restored, so its history is not recomputed.
+    */
+    void import_chat_session(const ChatSession& session);
 private:
     std::unique_ptr<LLMPipelineImplBase> m_pimpl;
 };
@@ -325,5 +339,23 @@ static constexpr ov::Property<SchedulerConfig> scheduler_config{"scheduler_confi
 */
 static constexpr ov::Property<bool> prompt_lookup{"prompt_lookup"};
 
+/**
+* @brief prompt_lookup_shared_index_size property sets the number of tokens of recent outputs of prompt lookup decoding,
+* which are indexed to look up candidates for other requests in addition to their own prompts and outputs. It increases
+* the number of accepted candidates when responses repeat templated text. 0 (default) disables lookup in recent outputs.
+*/
+static constexpr ov::Property<size_t> prompt_lookup_shared_index_size{"prompt_lookup_shared_index_size"};
+
+/**
+* @brief prefill_chunk_size property sets the maximum number of prompt tokens processed by a single inference of
+* the stateful (SDPA) pipeline. Longer prompts are processed in chunks, which bounds peak memory of intermediate
+* tensors and allows to stop or cancel generation between chunks via StreamerBase::get_status().
+* 0 (default) processes prompts at once. The property selects SDPA attention backend, so it can't be combined with
+* ATTENTION_BACKEND "PA" or properties which require PagedAttention backend, e.g. scheduler_config. PagedAttention
+* backend splits prompts according to SchedulerConfig::max_num_batched_tokens when SchedulerConfig::dynamic_split_fuse
+* is enabled.
+*/
+static constexpr ov::Property<size_t> prefill_chunk_size{"prefill_chunk_size"};
+
 }  // namespace genai
 }  // namespace ov
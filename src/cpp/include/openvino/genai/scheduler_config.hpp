@@ -19,9 +19,18 @@ struct SchedulerConfig {
     // total size of KV cache in GB
     std::size_t cache_size = 0;
 
+    // upper bound of KV cache size in GB when the cache is allocated dynamically (both num_kv_blocks and cache_size are 0)
+    // if 0, the size of physical memory is used for CPU and free device memory for GPU
+    std::size_t cache_size_limit = 0;
+
     // whether to split prompt / generate to different scheduling phases
     bool dynamic_split_fuse = true;
 
+    // share of max_num_batched_tokens reserved for requests of RequestPriority::HIGH, in range [0, 1)
+    // requests of lower priorities are scheduled within the rest of the budget, so a new high priority request
+    // gets tokens even when running requests of lower priorities could use the whole budget
+    float high_priority_tokens_share = 0.f;
+
 
     /**
      * Whether to use cache eviction for all sequences processed by this pipeline. When cache eviction is enabled,
@@ -53,8 +62,9 @@ struct SchedulerConfig {
 
     bool operator==(const SchedulerConfig& other) const {
         return max_num_batched_tokens == other.max_num_batched_tokens && num_kv_blocks == other.num_kv_blocks &&
-               cache_size == other.cache_size &&
-               dynamic_split_fuse == other.dynamic_split_fuse && use_cache_eviction == other.use_cache_eviction &&
+               cache_size == other.cache_size && cache_size_limit == other.cache_size_limit &&
+               dynamic_split_fuse == other.dynamic_split_fuse && high_priority_tokens_share == other.high_priority_tokens_share &&
+               use_cache_eviction == other.use_cache_eviction &&
                max_num_seqs == other.max_num_seqs && enable_prefix_caching == other.enable_prefix_caching;
     }
 };
@@ -38,6 +38,12 @@ public:
         OPENVINO_SUPPRESS_DEPRECATED_END
     };
 
+    /// @brief get_status is called while a long prompt is processed in chunks, before the first token is generated
+    /// @return StreamingStatus flag to indicate whether generation should continue to run or be stopped or cancelled
+    virtual StreamingStatus get_status() {
+        return StreamingStatus::RUNNING;
+    }
+
     /// @brief end is called at the end of generation. It can be used to flush cache if your own streamer has one
     virtual void end() = 0;
 
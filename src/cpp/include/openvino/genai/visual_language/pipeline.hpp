@@ -200,4 +200,13 @@ private:
 */
 static constexpr ov::Property<ov::Tensor> image{"image"};
 static constexpr ov::Property<std::vector<ov::Tensor>> images{"images"};
+
+/**
+ * @brief Max total size in bytes of image embeddings cached by VLMPipeline.
+ * Embeddings of images which have been already encoded (e.g. the same image
+ * passed on every chat turn) are taken from the cache instead of running
+ * vision models again. 0 disables the cache. Default is 128 MiB.
+ * Passed to VLMPipeline constructor: VLMPipeline(models_path, device, ov::genai::image_embeddings_cache_size(0)).
+ */
+static constexpr ov::Property<size_t> image_embeddings_cache_size{"image_embeddings_cache_size"};
 }
@@ -18,6 +18,8 @@ class KVCacheBlock {
     int m_ref_count;
     int m_index;
     size_t m_hash;
+    // identity of prompt content the block was computed for, see Sequence::get_prefix_check()
+    uint64_t m_prefix_check = 0;
     std::chrono::time_point<std::chrono::system_clock> m_timestamp;
 public:
     using Ptr = std::shared_ptr<KVCacheBlock>;
@@ -61,6 +63,14 @@ public:
         m_hash = hash;
     }
 
+    uint64_t get_prefix_check() const {
+        return m_prefix_check;
+    }
+
+    void set_prefix_check(uint64_t prefix_check) {
+        m_prefix_check = prefix_check;
+    }
+
     void set_timestamp(const std::chrono::time_point<std::chrono::system_clock>& timestamp) {
         m_timestamp = timestamp;
     }
@@ -112,11 +122,12 @@ class OverwritableBlocksHashStore {
       * Retrieves KV cache blocks from storage by their hash (expected to be identical for all layers) for their contents
       * to be reused by another sequence. Returned blocks will have reference counters equal to 1.
       * @param hash The hash value to look up in the store.
+      * @param prefix_check Identity of prompt content, which must match the one of stored blocks.
       * @return A vector of KV cache blocks (one for each decoder layer) previously stored under this hash.
       */
-    BlocksPerLayer get_block_to_restore(size_t hash) {
+    BlocksPerLayer get_block_to_restore(size_t hash, uint64_t prefix_check = 0) {
         auto it = m_blocks.find(hash);
-        if (it == m_blocks.end())
+        if (it == m_blocks.end() || it->second[0]->get_prefix_check() != prefix_check)
         {
             return {};
         }
@@ -243,6 +254,43 @@ public:
         m_total_num_blocks = new_kv_blocks_count;
     }
 
+    /**
+     * Decreases the number of KV blocks by releasing the blocks at the end of the index range which are free in
+     * all layers. Blocks stored for prefix caching are kept.
+     * @param min_kv_blocks_count The number of blocks to keep at least.
+     * @return The new number of KV blocks.
+     */
+    size_t shrink_kv_blocks_number(size_t min_kv_blocks_count) {
+        if (min_kv_blocks_count >= m_total_num_blocks) {
+            return m_total_num_blocks;
+        }
+
+        // number of layers in which the block with a given index is free
+        std::vector<size_t> num_free_layers(m_total_num_blocks - min_kv_blocks_count, 0);
+        for (const auto& per_layer_block_list : m_free_blocks) {
+            for (const auto& block : per_layer_block_list) {
+                const size_t block_idx = block->get_index();
+                if (block_idx >= min_kv_blocks_count) {
+                    ++num_free_layers[block_idx - min_kv_blocks_count];
+                }
+            }
+        }
+
+        size_t new_kv_blocks_count = m_total_num_blocks;
+        while (new_kv_blocks_count > min_kv_blocks_count && num_free_layers[new_kv_blocks_count - min_kv_blocks_count - 1] == m_num_layers) {
+            --new_kv_blocks_count;
+        }
+
+        for (size_t layer_idx = 0; layer_idx < m_num_layers; ++layer_idx) {
+            m_free_blocks[layer_idx].remove_if([new_kv_blocks_count](const KVCacheBlock::Ptr& block) {
+                return static_cast<size_t>(block->get_index()) >= new_kv_blocks_count;
+            });
+            m_free_blocks_num[layer_idx] -= m_total_num_blocks - new_kv_blocks_count;
+        }
+        m_total_num_blocks = new_kv_blocks_count;
+        return m_total_num_blocks;
+    }
+
 
     /**
      * Returns the number of free blocks for a given layer.
@@ -410,10 +458,11 @@ public:
      * @param[in,out] cached_blocks The map of known hashes to already allocated and filled blocks. If the blocks are freshly allocated,
      * it is added to this map under `hash`. If the blocks are reused from the internal overwritable block store,
      * the previous hash entry for these is deleted and the reused blocks are likewise stored in the map under the (new) `hash`.
+     * @param[in] prefix_check Identity of prompt content of the new block, which is verified when the block is restored.
      * @return A vector of blocks (one for each layer), either freshly allocated or reused for overwriting,
      * or an empty vector if cache is exhausted.
      */
-    BlocksPerLayer allocate_block(size_t hash, std::map<uint64_t, BlocksPerLayer>& cached_blocks) {
+    BlocksPerLayer allocate_block(size_t hash, std::map<uint64_t, BlocksPerLayer>& cached_blocks, uint64_t prefix_check = 0) {
         OPENVINO_ASSERT(m_enable_prefix_caching);
         OPENVINO_ASSERT(can_allocate_blocks(1));
 
@@ -425,6 +474,7 @@ public:
                 KVCacheBlock::Ptr allocated_block = m_free_blocks[i].front();
                 allocated_block->increment();
                 allocated_block->set_hash(hash);
+                allocated_block->set_prefix_check(prefix_check);
                 allocated_blocks.push_back(allocated_block);
                 m_free_blocks[i].pop_front();
                 --m_free_blocks_num[i];
@@ -440,6 +490,7 @@ public:
             // update block with new hash
             for (auto& block : blocks_for_all_layers) {
                 block->set_hash(hash);
+                block->set_prefix_check(prefix_check);
             }
             cached_blocks[hash] = blocks_for_all_layers;
             return blocks_for_all_layers;
@@ -454,16 +505,18 @@ public:
      *
      * @param hash The hash of the blocks to be looked up.
      * @param cached_blocks The map of known hashes to already allocated and filled blocks.
+     * @param prefix_check Identity of prompt content, which must match the one of found blocks, so blocks of
+     * a different prompt with a colliding hash are not reused.
      * @return A vector of blocks (one for each layer) corresponding to this hash, or an empty vector if the hash is not found in the map.
      */
-    BlocksPerLayer get_cached_block(size_t hash, std::map<uint64_t, BlocksPerLayer>& cached_blocks) {
-        auto blocks_for_all_layers = m_overwriteable_blocks.get_block_to_restore(hash);
+    BlocksPerLayer get_cached_block(size_t hash, std::map<uint64_t, BlocksPerLayer>& cached_blocks, uint64_t prefix_check = 0) {
+        auto blocks_for_all_layers = m_overwriteable_blocks.get_block_to_restore(hash, prefix_check);
         if (!blocks_for_all_layers.empty()) {
             // use cached block from internal store
             return blocks_for_all_layers;
         }
         auto it = cached_blocks.find(hash);
-        if (it != cached_blocks.end()) {
+        if (it != cached_blocks.end() && it->second[0]->get_prefix_check() == prefix_check) {
             // use cached block from cached_blocks
             // TODO: add tokens validation in case of hash collision
             blocks_for_all_layers = it->second;
@@ -662,6 +715,13 @@ public:
         return m_allocator.num_free_blocks(0); // relying on the invariant that all layers have identical number of blocks
     }
 
+    /**
+     * @return The number of free KV cache blocks which keep contents of finished sequences for prefix caching.
+     */
+    size_t num_overwriteable_blocks() const {
+        return m_allocator.num_overwriteable_blocks();
+    }
+
     /**
      * @param num_blocks A number of KV cache blocks
      * @return Whether this number of KV cache blocks may be assigned to new sequences.
@@ -710,6 +770,7 @@ public:
             if (block_table.size() > 0) {
                 KVCacheBlock::Ptr last_block = block_table.back();
                 auto hash = sequence->get_hash(block_table.size() * m_block_size);
+                auto prefix_check = sequence->get_prefix_check(block_table.size() * m_block_size);
                 auto prev_hash = last_block->get_hash();
                 if (prev_hash != hash) {
                     BlocksPerLayer last_blocks_vec;
@@ -717,6 +778,7 @@ public:
                     for (size_t layer_idx = 0; layer_idx < m_num_layers; layer_idx++) {
                         auto& lst_blk = m_block_table[sequence_id][layer_idx].back();
                         lst_blk->set_hash(hash);
+                        lst_blk->set_prefix_check(prefix_check);
                         m_prefix_hash_to_occupied_block_map.erase(prev_hash);
                         last_blocks_vec.push_back(lst_blk);
                     }
@@ -729,7 +791,8 @@ public:
                     num_hashed_tokens = content_length;
                 }
                 auto hash = sequence->get_hash(num_hashed_tokens);
-                auto blocks_for_all_layers = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map);
+                auto prefix_check = sequence->get_prefix_check(num_hashed_tokens);
+                auto blocks_for_all_layers = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map, prefix_check);
                 for (size_t layer_idx = 0; layer_idx < blocks_for_all_layers.size(); layer_idx++) {
                     m_block_table[sequence_id][layer_idx].push_back(blocks_for_all_layers[layer_idx]);
                 }
@@ -752,6 +815,15 @@ public:
         m_allocator.increase_kv_blocks_number(num_blocks);
     }
 
+    /**
+     * Decreases the number of KV blocks by releasing free blocks at the end of the index range.
+     * @param min_num_blocks The number of blocks to keep at least.
+     * @return The new number of KV blocks.
+     */
+    size_t shrink_kv_blocks_number(size_t min_num_blocks) {
+        return m_allocator.shrink_kv_blocks_number(min_num_blocks);
+    }
+
     /**
      * @return The total number of KV blocks .
      */
@@ -1034,7 +1106,7 @@ public:
                     new_blocks_for_all_layers.reserve(effective_num_layers);
                     if (m_enable_prefix_caching) {
                         auto hash = sequence->get_hash();
-                        new_blocks_for_all_layers = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map);
+                        new_blocks_for_all_layers = m_allocator.allocate_block(hash, m_prefix_hash_to_occupied_block_map, sequence->get_prefix_check());
                     } else {
                         for (size_t i = 0; i < effective_num_layers; i++) {
                             new_blocks_for_all_layers.push_back(m_allocator.allocate_block(i));
@@ -1055,9 +1127,11 @@ public:
                         // update hash of block
                         auto prev_hash = last_blocks[0]->get_hash();
                         auto hash = sequence->get_hash();
+                        auto prefix_check = sequence->get_prefix_check();
                         for (size_t i = 0; i < effective_num_layers; i++) {
                             auto& last_block = last_blocks[i];
                             last_block->set_hash(hash);
+                            last_block->set_prefix_check(prefix_check);
                         }
                         m_prefix_hash_to_occupied_block_map.erase(prev_hash);
                         m_prefix_hash_to_occupied_block_map[hash] = last_blocks;
@@ -1094,7 +1168,7 @@ public:
             }
             // restore fully filled blocks
             auto full_block_hash = sequence->get_hash(content_len);
-            auto blocks = m_allocator.get_cached_block(full_block_hash, m_prefix_hash_to_occupied_block_map);
+            auto blocks = m_allocator.get_cached_block(full_block_hash, m_prefix_hash_to_occupied_block_map, sequence->get_prefix_check(content_len));
             auto timestamp = std::chrono::system_clock::now();
             if (!blocks.empty()) {
                 for (size_t layer_idx = 0; layer_idx < block_table.size(); layer_idx++) {
@@ -1110,7 +1184,7 @@ public:
                         break;
                     }
                     auto hash = sequence->get_hash(prev_iteration_content_len + i);
-                    auto blocks = m_allocator.get_cached_block(hash, m_prefix_hash_to_occupied_block_map);
+                    auto blocks = m_allocator.get_cached_block(hash, m_prefix_hash_to_occupied_block_map, sequence->get_prefix_check(prev_iteration_content_len + i));
                     if (!blocks.empty()) {
                         auto timestamp = std::chrono::system_clock::now();
 
@@ -6,8 +6,12 @@
 namespace ov::genai {
     CacheEvictionAlgorithm::CacheEvictionAlgorithm(const CacheEvictionConfig &eviction_config, size_t block_size,
                                                    size_t num_decoder_layers) :
-            m_eviction_config(eviction_config), m_block_size(block_size), m_num_decoder_layers(num_decoder_layers),
-            m_cache_counter(num_decoder_layers), m_scores(num_decoder_layers) {
+            m_eviction_config(eviction_config),
+            m_start_size(eviction_config.policy == CacheEvictionPolicy::H2O ? 0 : eviction_config.get_start_size()),
+            m_evictable_size(eviction_config.get_max_cache_size() - m_start_size - eviction_config.get_recent_size()),
+            // SnapKV scores come from a single step, so there's nothing to normalize
+            m_aggregation_mode(eviction_config.policy == CacheEvictionPolicy::SNAPKV ? AggregationMode::SUM : eviction_config.aggregation_mode),
+            m_block_size(block_size), m_num_decoder_layers(num_decoder_layers) {
             OPENVINO_ASSERT(!(m_eviction_config.get_start_size() % m_block_size),
                             "CacheEvictionConfig.start_size in tokens must be a multiple of block size ", m_block_size);
             OPENVINO_ASSERT(!(m_eviction_config.get_recent_size() % m_block_size),
@@ -15,6 +19,26 @@ namespace ov::genai {
             OPENVINO_ASSERT(!(m_eviction_config.get_max_cache_size() % m_block_size),
                             "CacheEvictionConfig.max_cache_size in tokens must be a multiple of block size ", m_block_size);
             OPENVINO_ASSERT(m_num_decoder_layers, "num_decoder_layers must be non-zero");
+            OPENVINO_ASSERT(m_eviction_config.score_aggregation_interval, "CacheEvictionConfig.score_aggregation_interval must be non-zero");
+
+            if (m_eviction_config.score_layers.empty()) {
+                for (size_t decoder_layer_idx = 0; decoder_layer_idx < m_num_decoder_layers; decoder_layer_idx++) {
+                    m_layers_for_scores.push_back({decoder_layer_idx});
+                }
+            } else {
+                for (size_t decoder_layer_idx : m_eviction_config.score_layers) {
+                    OPENVINO_ASSERT(decoder_layer_idx < m_num_decoder_layers,
+                                    "CacheEvictionConfig.score_layers contains layer ", decoder_layer_idx, ", but the model has ", m_num_decoder_layers, " decoder layers");
+                }
+                m_layers_for_scores.push_back(m_eviction_config.score_layers);
+            }
+            m_scores.resize(m_layers_for_scores.size());
+            m_token_registration_idx.resize(m_layers_for_scores.size());
+            m_num_registered_tokens.resize(m_layers_for_scores.size(), 0);
+    }
+
+    std::size_t CacheEvictionAlgorithm::get_score_idx(size_t decoder_layer_idx) const {
+        return m_layers_for_scores.size() == m_num_decoder_layers ? decoder_layer_idx : 0;
     }
 
     std::size_t CacheEvictionAlgorithm::get_max_cache_size_after_eviction() const {
@@ -36,30 +60,41 @@ namespace ov::genai {
         // tokens was being computed.
 
         std::vector<std::set<size_t>> retval(m_num_decoder_layers);
+        if (m_is_compressed) {
+            return retval;
+        }
+        // SnapKV compresses the prompt once, even if it already fits into the cache
+        m_is_compressed = m_eviction_config.policy == CacheEvictionPolicy::SNAPKV;
 
-
-        for (size_t decoder_layer_idx = 0; decoder_layer_idx < m_scores.size(); decoder_layer_idx++) {
-            const auto &accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
-            auto scores_length = accumulated_scores_for_current_decoder_layer.size();
-            if (scores_length + m_eviction_config.get_start_size() <= get_max_cache_size_after_eviction()) {
+        for (size_t score_idx = 0; score_idx < m_scores.size(); score_idx++) {
+            const auto &accumulated_scores = m_scores[score_idx];
+            auto scores_length = accumulated_scores.size();
+            if (scores_length + m_start_size <= get_max_cache_size_after_eviction()) {
                 // KV cache is not yet filled, keep all currently occupied blocks
                 continue;
             }
 
             // Only the blocks in the "intermediate" part of the logical KV cache will be considered for eviction
-            auto scores_for_all_evictable_blocks = get_scores_for_all_evictable_blocks(decoder_layer_idx);
-            size_t num_blocks_to_evict = get_num_blocks_to_evict(decoder_layer_idx);
+            auto scores_for_all_evictable_blocks = get_scores_for_all_evictable_blocks(score_idx);
+            size_t num_blocks_to_evict = get_num_blocks_to_evict(m_layers_for_scores[score_idx].front());
             auto evicted_block_indices = get_indices_of_blocks_to_evict(scores_for_all_evictable_blocks, num_blocks_to_evict);
 
             m_num_evicted_tokens += evicted_block_indices.size() * m_block_size;
 
             // No longer need to track the overall "heavy-hitter" attention scores for freshly evicted blocks
-            remove_scores_of_evicted_blocks(evicted_block_indices, decoder_layer_idx);
+            remove_scores_of_evicted_blocks(evicted_block_indices, score_idx);
 
             // Adjust indices to account for start area
-            for (auto &idx: evicted_block_indices) idx += get_num_blocks(m_eviction_config.get_start_size());
+            for (auto &idx: evicted_block_indices) idx += get_num_blocks(m_start_size);
             // auto remaining_block_indices = get_remaining_block_indices(evicted_block_indices);
-            for (auto &idx: evicted_block_indices) retval[decoder_layer_idx].insert(idx);
+            if (m_layers_for_scores.size() == m_num_decoder_layers) {
+                retval[score_idx].insert(evicted_block_indices.begin(), evicted_block_indices.end());
+            } else {
+                // scores aggregated across layers determine the same blocks for all layers
+                for (auto &evicted_blocks_for_layer : retval) {
+                    evicted_blocks_for_layer.insert(evicted_block_indices.begin(), evicted_block_indices.end());
+                }
+            }
         }
         return retval;
     }
@@ -69,74 +104,75 @@ namespace ov::genai {
     }
 
     CacheEvictionAlgorithm::CacheEvictionRange CacheEvictionAlgorithm::get_evictable_block_range(size_t layer_idx) const {
-        std::size_t current_sequence_length = m_eviction_config.get_start_size() + m_scores[layer_idx].size();
+        std::size_t current_sequence_length = m_start_size + m_scores[get_score_idx(layer_idx)].size();
         if (current_sequence_length <= get_max_cache_size_after_eviction()) {
             return CacheEvictionRange::invalid(); // purposely invalid range since no eviction can take place yet
         }
-        std::size_t start = m_eviction_config.get_start_size() / m_block_size;
+        std::size_t start = m_start_size / m_block_size;
         std::size_t end = current_sequence_length / m_block_size - (m_eviction_config.get_recent_size() / m_block_size);
         return {start, end};
     }
 
+    namespace {
+    // plain loop over non-aliasing arrays, which is vectorized by compilers
+    void accumulate_scores(double* accumulated_scores, const float* new_scores, size_t num_scores) {
+        for (size_t idx = 0; idx < num_scores; ++idx) {
+            accumulated_scores[idx] += new_scores[idx];
+        }
+    }
+    }  // namespace
+
     void CacheEvictionAlgorithm::register_new_token_scores(
             const AttentionScoresForEachDecoderLayer &attention_scores_for_all_decoder_layers) {
-        for (size_t decoder_layer_idx = 0; decoder_layer_idx < m_cache_counter.size(); decoder_layer_idx++) {
-
-            const auto &attention_scores = attention_scores_for_all_decoder_layers[decoder_layer_idx];
+        if (m_is_compressed) {
+            return;
+        }
+        for (size_t score_idx = 0; score_idx < m_scores.size(); score_idx++) {
+            const auto &layers_for_score = m_layers_for_scores[score_idx];
             // "Start" tokens are never evicted, won't track scores for these
             // "Recent" tokens are also not evicted just yet, but need to accumulate their scores since they may
             // ultimately move into the "intermediate" eviction region of cache
             // Taking the [1, start_size:seq_len] span of the attention scores:
-            auto attn_shape = attention_scores.get_shape();
-            size_t kv_cache_size_in_tokens = attn_shape[0];
-            if (kv_cache_size_in_tokens <= m_eviction_config.get_start_size() + 1) {
+            size_t kv_cache_size_in_tokens = attention_scores_for_all_decoder_layers[layers_for_score.front()].get_shape()[0];
+            if (kv_cache_size_in_tokens <= m_start_size + 1) {
                 return;
             }
+            size_t num_tracked_tokens = kv_cache_size_in_tokens - m_start_size;
+
+            auto &accumulated_scores = m_scores[score_idx];
+            size_t old_size_in_tokens = accumulated_scores.size();
+            OPENVINO_ASSERT(num_tracked_tokens >= old_size_in_tokens,
+                            "Attention scores must cover all tokens tracked for eviction, got ", num_tracked_tokens, " tokens while tracking ", old_size_in_tokens);
+            size_t num_new_tokens = num_tracked_tokens - old_size_in_tokens;
+
+            if (accumulated_scores.capacity() < num_tracked_tokens) {
+                // the number of tracked tokens is capped by eviction, so reserving the capped size at once
+                // avoids reallocations when the sequence grows
+                accumulated_scores.reserve(std::max(num_tracked_tokens, get_max_cache_size_after_eviction() + m_block_size));
+            }
+            accumulated_scores.resize(num_tracked_tokens, 0.0);
+            if (m_eviction_config.policy == CacheEvictionPolicy::SNAPKV) {
+                // only the scores of the latest step, i.e. of the observation window, are used
+                std::fill(accumulated_scores.begin(), accumulated_scores.end(), 0.0);
+            }
+            for (size_t decoder_layer_idx : layers_for_score) {
+                const auto &attention_scores = attention_scores_for_all_decoder_layers[decoder_layer_idx];
+                OPENVINO_ASSERT(attention_scores.get_shape()[0] == kv_cache_size_in_tokens,
+                                "Attention scores of all decoder layers must have the same length");
+                accumulate_scores(accumulated_scores.data(), attention_scores.data<float>() + m_start_size, num_tracked_tokens);
+            }
 
-            auto hh_score = ov::Tensor(
-                    attention_scores,
-                    ov::Coordinate{m_eviction_config.get_start_size()},
-                    ov::Coordinate{kv_cache_size_in_tokens}
-            );
-
-            auto &accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
-
-            if (accumulated_scores_for_current_decoder_layer.empty()) {
-                accumulated_scores_for_current_decoder_layer = std::vector<double>(hh_score.get_size());
-                for (size_t idx = 0; idx < accumulated_scores_for_current_decoder_layer.size(); idx++) {
-                    accumulated_scores_for_current_decoder_layer[idx] = hh_score.data<float>()[idx];
+            if (m_aggregation_mode == AggregationMode::NORM_SUM) {
+                // New tokens are registered as if they were added one-by-one from the standpoint of the occurrence
+                // tracker, so the i-th of N new tokens has a lifetime of N - i tokens after this step
+                auto &registration_idx = m_token_registration_idx[score_idx];
+                if (registration_idx.capacity() < num_tracked_tokens) {
+                    registration_idx.reserve(accumulated_scores.capacity());
                 }
-                if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
-                    // New sequence to track - will simulate that the tokens comprising the sequence were added one-by-one
-                    // from the standpoint of the occurrence tracker
-                    std::size_t new_scores_size = hh_score.get_size();
-                    std::vector<std::size_t> counter(new_scores_size);
-                    std::generate(counter.begin(), counter.begin() + new_scores_size,
-                                  [&new_scores_size] { return new_scores_size--; });
-                    m_cache_counter[decoder_layer_idx] = counter;
-                }
-            } else {
-                size_t old_size_in_tokens = accumulated_scores_for_current_decoder_layer.size();
-                size_t num_new_tokens = hh_score.get_size() - accumulated_scores_for_current_decoder_layer.size();
-                if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
-                    // Increment occurrence counts of all currently tracked cache blocks
-                    auto &counter_for_current_decoder_layer = m_cache_counter[decoder_layer_idx];
-                    for (auto it = counter_for_current_decoder_layer.begin();
-                         it != counter_for_current_decoder_layer.end(); it++) {
-                        *it += num_new_tokens;
-                    }
-                    // Add occurrence counts for new tokens like above
-                    counter_for_current_decoder_layer.resize(hh_score.get_size());
-                    for (size_t i = 0; i < num_new_tokens; i++) {
-                        auto idx = old_size_in_tokens + i;
-                        counter_for_current_decoder_layer[idx] = num_new_tokens - i;
-                    }
-                }
-                accumulated_scores_for_current_decoder_layer.resize(hh_score.get_size());
-                auto hh_score_data = hh_score.data<float>();
-                for (size_t i = 0; i < hh_score.get_size(); ++i) {
-                    accumulated_scores_for_current_decoder_layer[i] += hh_score_data[i];
+                for (size_t i = 0; i < num_new_tokens; i++) {
+                    registration_idx.push_back(m_num_registered_tokens[score_idx] + i);
                 }
+                m_num_registered_tokens[score_idx] += num_new_tokens;
             }
         }
     }
@@ -152,35 +188,36 @@ namespace ov::genai {
 
     std::size_t CacheEvictionAlgorithm::get_num_blocks_to_evict(size_t layer_idx) const {
         auto num_evictable_blocks = get_num_evictable_blocks(layer_idx);
-        std::size_t num_evictable_blocks_to_keep_after_eviction = get_num_blocks(m_eviction_config.get_evictable_size());
+        std::size_t num_evictable_blocks_to_keep_after_eviction = get_num_blocks(m_evictable_size);
         if (num_evictable_blocks < num_evictable_blocks_to_keep_after_eviction) {
             return 0;
         }
         return num_evictable_blocks - num_evictable_blocks_to_keep_after_eviction;
     }
 
-    std::vector<double> CacheEvictionAlgorithm::get_scores_for_all_evictable_blocks(size_t decoder_layer_idx) const {
-        auto accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
-        auto num_tracked_tokens = accumulated_scores_for_current_decoder_layer.size();
-        auto counter_for_current_decoder_layer = m_cache_counter[decoder_layer_idx];
+    std::vector<double> CacheEvictionAlgorithm::get_scores_for_all_evictable_blocks(size_t score_idx) const {
+        const auto &accumulated_scores = m_scores[score_idx];
+        auto num_tracked_tokens = accumulated_scores.size();
+        const auto &registration_idx = m_token_registration_idx[score_idx];
+        size_t num_registered_tokens = m_num_registered_tokens[score_idx];
 
         // Make sure that there is at least one block that can be completely evicted
-        OPENVINO_ASSERT((num_tracked_tokens + m_eviction_config.get_start_size()) > get_max_cache_size_after_eviction(),
+        OPENVINO_ASSERT((num_tracked_tokens + m_start_size) > get_max_cache_size_after_eviction(),
                         "KV cache must be filled before scores for evictable blocks can be computed");
 
-        size_t num_evictable_blocks = get_num_evictable_blocks(decoder_layer_idx);
+        size_t num_evictable_blocks = get_num_evictable_blocks(m_layers_for_scores[score_idx].front());
 
         std::vector<double> block_scores(num_evictable_blocks);
         for (size_t i = 0; i < num_evictable_blocks; ++i) {
             double normalized_accumulated_attn_score_for_block = 0.0;
             for (size_t j = 0; j < m_block_size; ++j) {
                 size_t token_offset = m_block_size * i + j;
-                if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
-                    normalized_accumulated_attn_score_for_block +=
-                            accumulated_scores_for_current_decoder_layer[token_offset] /
-                            counter_for_current_decoder_layer[token_offset];
+                if (m_aggregation_mode == AggregationMode::NORM_SUM) {
+                    // lifetime of the token in tokens registered since it was added
+                    size_t token_lifetime = num_registered_tokens - registration_idx[token_offset];
+                    normalized_accumulated_attn_score_for_block += accumulated_scores[token_offset] / token_lifetime;
                 } else {
-                    normalized_accumulated_attn_score_for_block += accumulated_scores_for_current_decoder_layer[token_offset];
+                    normalized_accumulated_attn_score_for_block += accumulated_scores[token_offset];
                 }
             }
             block_scores[i] = normalized_accumulated_attn_score_for_block;
@@ -224,32 +261,22 @@ namespace ov::genai {
     }
 
     void CacheEvictionAlgorithm::remove_scores_of_evicted_blocks(const std::vector<std::size_t> &evicted_block_indices,
-                                                                 size_t decoder_layer_idx) {
+                                                                 size_t score_idx) {
         if (evicted_block_indices.empty()) {
             return;
         }
 
-        const auto &accumulated_scores_for_current_decoder_layer = m_scores[decoder_layer_idx];
-        const auto &counter_for_current_decoder_layer = m_cache_counter[decoder_layer_idx];
-
-        if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
-            OPENVINO_ASSERT(
-                    accumulated_scores_for_current_decoder_layer.size() == counter_for_current_decoder_layer.size());
-        }
-
-        auto old_size = accumulated_scores_for_current_decoder_layer.size();
-        auto new_size =
-                accumulated_scores_for_current_decoder_layer.size() - evicted_block_indices.size() * m_block_size;
-
-        std::vector<double> new_scores;
-        new_scores.reserve(new_size);
+        auto &accumulated_scores = m_scores[score_idx];
+        auto &registration_idx = m_token_registration_idx[score_idx];
+        const bool is_norm_sum = m_aggregation_mode == AggregationMode::NORM_SUM;
 
-        std::vector<size_t> new_counter;
-
-        if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
-            new_counter.reserve(new_size);
+        if (is_norm_sum) {
+            OPENVINO_ASSERT(accumulated_scores.size() == registration_idx.size());
         }
 
+        // compact remaining scores in place to keep the allocated storage
+        size_t old_size = accumulated_scores.size();
+        size_t new_size = 0;
         for (size_t token_idx = 0, evicted_block_idx = 0; token_idx < old_size;) {
             if (evicted_block_idx < evicted_block_indices.size() &&
                 token_idx == evicted_block_indices[evicted_block_idx] * m_block_size) {
@@ -257,15 +284,18 @@ namespace ov::genai {
                 token_idx += m_block_size;
                 continue;
             }
-            new_scores.push_back(accumulated_scores_for_current_decoder_layer[token_idx]);
-            if (m_eviction_config.aggregation_mode == AggregationMode::NORM_SUM) {
-                new_counter.push_back(counter_for_current_decoder_layer[token_idx]);
+            accumulated_scores[new_size] = accumulated_scores[token_idx];
+            if (is_norm_sum) {
+                registration_idx[new_size] = registration_idx[token_idx];
             }
+            ++new_size;
             ++token_idx;
         }
 
-        m_scores[decoder_layer_idx] = new_scores;
-        m_cache_counter[decoder_layer_idx] = new_counter;
+        accumulated_scores.resize(new_size);
+        if (is_norm_sum) {
+            registration_idx.resize(new_size);
+        }
     }
 
     CacheRotationCalculator::CacheRotationCalculator(size_t block_size,
@@ -43,6 +43,9 @@ namespace ov::genai {
  * determined as the tokens between the fixed-size *start area* and the fixed-size *end area*, so at a given eviction step
  * there are in general more tokens considered for eviction than the specified *evictable* size.
  *
+ * The policy set in the configuration modifies this scheme: CacheEvictionPolicy::H2O treats the *start area* as a part
+ * of the *evictable* area, and CacheEvictionPolicy::SNAPKV evicts blocks only once, based on the latest registered
+ * scores, and then keeps the remaining and all future blocks.
  */
 class CacheEvictionAlgorithm {
 public:
@@ -103,18 +106,33 @@ private:
 
     CacheEvictionRange get_evictable_block_range(size_t layer_idx) const;
 
-    std::vector<double> get_scores_for_all_evictable_blocks(size_t decoder_layer_idx) const;
+    std::vector<double> get_scores_for_all_evictable_blocks(size_t score_idx) const;
 
     std::vector<std::size_t> get_indices_of_blocks_to_evict(const std::vector<double>& scores_for_each_evictable_block, size_t num_blocks_to_evict) const;
 
-    void remove_scores_of_evicted_blocks(const std::vector<std::size_t>& evicted_block_indices, size_t decoder_layer_idx);
+    void remove_scores_of_evicted_blocks(const std::vector<std::size_t>& evicted_block_indices, size_t score_idx);
+
+    // index of the accumulated scores which determine evicted blocks of a decoder layer
+    std::size_t get_score_idx(size_t decoder_layer_idx) const;
 
     CacheEvictionConfig m_eviction_config;
+    // sizes of the never evicted start area and of the evictable area after eviction, which depend on the policy
+    std::size_t m_start_size;
+    std::size_t m_evictable_size;
+    AggregationMode m_aggregation_mode;
+    // for SNAPKV policy: whether the prompt was already compressed
+    bool m_is_compressed = false;
     std::size_t m_block_size;
     std::size_t m_num_evicted_tokens = 0;
     std::size_t m_num_decoder_layers;
+    // decoder layers whose scores are summed into each of the accumulated scores
+    std::vector<std::vector<size_t>> m_layers_for_scores;
+    // accumulated scores of tracked tokens, capacity is kept after eviction to avoid reallocations at each step
     std::vector<std::vector<double>> m_scores;
-    std::vector<std::vector<size_t>> m_cache_counter;
+    // for NORM_SUM mode: value of m_num_registered_tokens when a token was registered, so that its lifetime
+    // is computed on demand instead of incrementing lifetimes of all tokens at each step
+    std::vector<std::vector<size_t>> m_token_registration_idx;
+    std::vector<size_t> m_num_registered_tokens;
 };
 
 /**
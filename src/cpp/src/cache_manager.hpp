@@ -3,11 +3,15 @@
 
 #pragma once
 
+#include <cstring>
+#include <limits>
 #include <vector>
 #include <list>
 
+#include "openvino/core/parallel.hpp"
 #include "openvino/runtime/tensor.hpp"
 #include "paged_attention_transformations.hpp"
+#include "virtual_memory.hpp"
 
 namespace ov::genai {
 
@@ -18,7 +22,10 @@ class CacheManager {
     std::vector<ov::element::Type> m_key_precisions, m_value_precisions;
     std::vector<ov::PartialShape> m_key_shapes, m_value_shapes;
     std::vector<ov::Tensor> m_key_cache, m_value_cache;
+    // on CPU, address space for the largest cache is reserved for each tensor, so the cache grows in place
+    std::vector<std::shared_ptr<VirtualMemoryRegion>> m_key_memory, m_value_memory;
     size_t m_num_allocated_kv_blocks = 0, m_block_size_in_bytes = 0;
+    size_t m_max_num_kv_blocks = std::numeric_limits<size_t>::max();
     ov::InferRequest m_request;
     size_t m_k_head_size = 0;
 
@@ -27,6 +34,22 @@ class CacheManager {
         return pshape.get_shape();
     }
 
+    bool is_gpu() const {
+        return m_device.find("GPU") != std::string::npos;
+    }
+
+    static size_t get_block_byte_size(const ov::PartialShape& pshape, ov::element::Type precision) {
+        return pshape[1].get_length() * pshape[2].get_length() * pshape[3].get_length() * precision.size();
+    }
+
+    std::shared_ptr<VirtualMemoryRegion> create_memory_region(const ov::PartialShape& pshape, ov::element::Type precision) const {
+        auto region = std::make_shared<VirtualMemoryRegion>(m_max_num_kv_blocks * get_block_byte_size(pshape, precision));
+        // every inference reads caches of all sequences from threads on all sockets, so pages are spread evenly
+        // across NUMA nodes instead of being placed on the node of the thread which touches them first
+        region->interleave_numa_nodes();
+        return region;
+    }
+
     void update_request_tensor(size_t decoder_layer_id) {
         m_request.set_tensor(std::string("key_cache.") + std::to_string(decoder_layer_id), m_key_cache[decoder_layer_id]);
         m_request.set_tensor(std::string("value_cache.") + std::to_string(decoder_layer_id), m_value_cache[decoder_layer_id]);
@@ -93,8 +116,7 @@ public:
         
         // set block_size depending on device
         const size_t cpu_block_size = 32, gpu_block_size = 16;
-        const bool is_gpu = m_device.find("GPU") != std::string::npos;
-        m_block_size = is_gpu ? gpu_block_size : cpu_block_size;
+        m_block_size = is_gpu() ? gpu_block_size : cpu_block_size;
 
         // extract information about KV cache precisions and shapes
         size_t kv_input_index = 0;
@@ -105,13 +127,13 @@ public:
 
                 if (name.find("key_cache.") == 0) {
                     pshape = to_partial_shape(kv_cache_config[kv_input_index], cache_precision, true);
-                    m_block_size_in_bytes += pshape[1].get_length() * pshape[2].get_length() * pshape[3].get_length() * cache_precision.size();
+                    m_block_size_in_bytes += get_block_byte_size(pshape, cache_precision);
                     m_key_shapes.push_back(pshape);
                     m_key_precisions.push_back(cache_precision);
                     break;
                 } else if (name.find("value_cache.") == 0) {
                     pshape = to_partial_shape(kv_cache_config[kv_input_index], cache_precision, false);
-                    m_block_size_in_bytes += pshape[1].get_length() * pshape[2].get_length() * pshape[3].get_length() * cache_precision.size();
+                    m_block_size_in_bytes += get_block_byte_size(pshape, cache_precision);
                     m_value_shapes.push_back(pshape);
                     m_value_precisions.push_back(cache_precision);
                     ++kv_input_index;
@@ -122,6 +144,10 @@ public:
 
         m_num_decoder_layers = m_value_precisions.size();
         OPENVINO_ASSERT(m_num_decoder_layers == m_key_precisions.size(), "Invalid case: a different number of K and V caches in a LLM model");
+
+        if (!is_gpu()) {
+            m_max_num_kv_blocks = get_physical_memory_size() / m_block_size_in_bytes;
+        }
     }
 
     size_t get_num_decoder_layers() const {
@@ -150,50 +176,41 @@ public:
         return m_block_size_in_bytes;
     }
 
+    /**
+     * Sets the upper bound of the number of KV cache blocks. Must be called before the cache is allocated.
+     * By default, the bound is given by the size of physical memory for CPU and is not set for GPU.
+     */
+    void set_max_num_kv_blocks(size_t max_num_kv_blocks) {
+        OPENVINO_ASSERT(m_num_allocated_kv_blocks == 0, "The upper bound of KV cache size must be set before the cache is allocated");
+        OPENVINO_ASSERT(max_num_kv_blocks > 0, "The upper bound of KV cache size must be non-zero");
+        m_max_num_kv_blocks = max_num_kv_blocks;
+    }
+
+    size_t get_max_num_kv_blocks() const {
+        return m_max_num_kv_blocks;
+    }
+
     void allocate_cache_if_needed(size_t num_kv_blocks) {
         if (m_num_allocated_kv_blocks >= num_kv_blocks) {
             return;
         }
 
+        OPENVINO_ASSERT(num_kv_blocks <= m_max_num_kv_blocks, "Number of KV cache blocks ", num_kv_blocks, " exceeds the upper bound ", m_max_num_kv_blocks);
         m_num_allocated_kv_blocks = num_kv_blocks;
 
-        ov::Coordinate start_key{0,0,0,0};
-        ov::Coordinate start_value{0,0,0,0};
-
-        if (m_device.find("GPU") == std::string::npos) {// Allocate KV caches
+        if (!is_gpu()) {
+            // tensors are placed at the beginning of reserved regions, so larger tensors keep contents of the previous ones
             for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
-                ov::Shape value_cache_shape = set_kv_blocks(m_value_shapes[decoder_layer_id], num_kv_blocks);
-                ov::Shape key_cache_shape = set_kv_blocks(m_key_shapes[decoder_layer_id], num_kv_blocks);
-
-                ov::element::Type key_precision = get_key_cache_precision(decoder_layer_id);
-                ov::element::Type value_precision = get_value_cache_precision(decoder_layer_id);
-
-                ov::Tensor key_cache(key_precision, key_cache_shape);
-                ov::Tensor value_cache(value_precision, value_cache_shape);
-
-                auto key_cache_roi_end = static_cast<unsigned char*>(key_cache.data());
-                auto value_cache_roi_end = static_cast<unsigned char*>(value_cache.data());
-                size_t key_roi_size_byte = 0;
-                size_t value_roi_size_byte = 0;
-
-                if (m_key_cache.size() > decoder_layer_id) {
-                    ov::Coordinate end_key = m_key_cache[decoder_layer_id].get_shape();
-                    ov::Coordinate end_value = m_value_cache[decoder_layer_id].get_shape();
-
-                    key_roi_size_byte = m_key_cache[decoder_layer_id].get_byte_size();
-                    value_roi_size_byte = m_value_cache[decoder_layer_id].get_byte_size();
-                    key_cache_roi_end = static_cast<unsigned char*>(key_cache.data()) + key_roi_size_byte;
-                    value_cache_roi_end = static_cast<unsigned char*>(value_cache.data()) + value_roi_size_byte;
-                    
-                    // copy current cache data
-                    ov::Tensor dst_key_roi(key_cache, start_key, end_key);
-                    ov::Tensor dst_value_roi(value_cache, start_value, end_value);
-
-                    m_key_cache[decoder_layer_id].copy_to(dst_key_roi);
-                    m_value_cache[decoder_layer_id].copy_to(dst_value_roi);
-
+                if (m_key_memory.size() == decoder_layer_id) {
+                    m_key_memory.push_back(create_memory_region(m_key_shapes[decoder_layer_id], get_key_cache_precision(decoder_layer_id)));
+                    m_value_memory.push_back(create_memory_region(m_value_shapes[decoder_layer_id], get_value_cache_precision(decoder_layer_id)));
                 }
 
+                ov::Tensor key_cache(get_key_cache_precision(decoder_layer_id), set_kv_blocks(m_key_shapes[decoder_layer_id], num_kv_blocks),
+                                     VirtualMemoryAllocator(m_key_memory[decoder_layer_id]));
+                ov::Tensor value_cache(get_value_cache_precision(decoder_layer_id), set_kv_blocks(m_value_shapes[decoder_layer_id], num_kv_blocks),
+                                       VirtualMemoryAllocator(m_value_memory[decoder_layer_id]));
+
                 // set new cache tensors
                 if (m_key_cache.size() > decoder_layer_id) {
                     m_key_cache[decoder_layer_id] = key_cache;
@@ -206,6 +223,8 @@ public:
                 update_request_tensor(decoder_layer_id);
             }
         } else {
+            ov::Coordinate start_key{0,0,0,0};
+            ov::Coordinate start_value{0,0,0,0};
             auto remote_context = m_request.get_compiled_model().get_context();
 
             for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
@@ -237,6 +256,29 @@ public:
         }
     }
 
+    /**
+     * Releases memory of the blocks with indices starting from `num_kv_blocks`, which must not be used anymore.
+     * @return Whether the memory was released; cache on GPU is not shrunk.
+     */
+    bool shrink_cache(size_t num_kv_blocks) {
+        if (is_gpu() || num_kv_blocks >= m_num_allocated_kv_blocks) {
+            return false;
+        }
+
+        m_num_allocated_kv_blocks = num_kv_blocks;
+        for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+            m_key_cache[decoder_layer_id] = ov::Tensor(get_key_cache_precision(decoder_layer_id), set_kv_blocks(m_key_shapes[decoder_layer_id], num_kv_blocks),
+                                                       VirtualMemoryAllocator(m_key_memory[decoder_layer_id]));
+            m_value_cache[decoder_layer_id] = ov::Tensor(get_value_cache_precision(decoder_layer_id), set_kv_blocks(m_value_shapes[decoder_layer_id], num_kv_blocks),
+                                                         VirtualMemoryAllocator(m_value_memory[decoder_layer_id]));
+            update_request_tensor(decoder_layer_id);
+
+            m_key_memory[decoder_layer_id]->decommit(m_key_cache[decoder_layer_id].get_byte_size());
+            m_value_memory[decoder_layer_id]->decommit(m_value_cache[decoder_layer_id].get_byte_size());
+        }
+        return true;
+    }
+
     ov::Tensor get_key_cache(size_t decoder_layer_id) const {
         OPENVINO_ASSERT(decoder_layer_id < m_key_cache.size(), "decoder_layer_id = ", decoder_layer_id, ", num_layers = ", m_key_cache.size());
         return m_key_cache[decoder_layer_id];
@@ -252,36 +294,58 @@ public:
     }
 
     void copy_blocks(const std::map<size_t, std::list<size_t>>& block_copy_map) {
+        std::vector<std::pair<size_t, size_t>> src_dst_block_ids;
         for (const auto & blocks_pair : block_copy_map) {
-            size_t src_block_id = blocks_pair.first;
-            const std::list<size_t>& dst_block_ids = blocks_pair.second;
-            for (size_t dst_block_id : dst_block_ids) {
-                for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
-                    ov::Shape key_shape = set_kv_blocks(m_key_shapes[decoder_layer_id], m_num_allocated_kv_blocks);
-                    ov::Shape value_shape = set_kv_blocks(m_value_shapes[decoder_layer_id], m_num_allocated_kv_blocks);
-                    ov::Coordinate key_src_start_roi(key_shape.size(), 0);
-                    ov::Coordinate key_src_end_roi = key_shape;
-                    ov::Coordinate key_dst_start_roi(key_shape.size(), 0);
-                    ov::Coordinate key_dst_end_roi = key_shape;
-            
-                    ov::Coordinate value_src_start_roi(value_shape.size(), 0);
-                    ov::Coordinate value_src_end_roi = value_shape;
-                    ov::Coordinate value_dst_start_roi(value_shape.size(), 0);
-                    ov::Coordinate value_dst_end_roi = value_shape;
-                    key_src_end_roi[0] = (key_src_start_roi[0] = src_block_id) + 1;
-                    value_src_end_roi[0] = (value_src_start_roi[0] = src_block_id) + 1;
-                    key_dst_end_roi[0] = (key_dst_start_roi[0] = dst_block_id) + 1;
-                    value_dst_end_roi[0] = (value_dst_start_roi[0] = dst_block_id) + 1;
-
-                    ov::Tensor key_src_cache_roi(m_key_cache[decoder_layer_id], key_src_start_roi, key_src_end_roi);
-                    ov::Tensor key_dst_cache_roi(m_key_cache[decoder_layer_id], key_dst_start_roi, key_dst_end_roi);
-
-                    ov::Tensor value_src_cache_roi(m_value_cache[decoder_layer_id], value_src_start_roi, value_src_end_roi);
-                    ov::Tensor value_dst_cache_roi(m_value_cache[decoder_layer_id], value_dst_start_roi, value_dst_end_roi);
-
-                    key_src_cache_roi.copy_to(key_dst_cache_roi);
-                    value_src_cache_roi.copy_to(value_dst_cache_roi);
-                }
+            for (size_t dst_block_id : blocks_pair.second) {
+                src_dst_block_ids.emplace_back(blocks_pair.first, dst_block_id);
+            }
+        }
+        if (src_dst_block_ids.empty()) {
+            return;
+        }
+
+        if (!is_gpu()) {
+            // blocks are contiguous in host memory, so all K and V copies of all layers are done in one parallel pass
+            const size_t num_copies_per_layer = 2 * src_dst_block_ids.size();
+            ov::parallel_for(m_num_decoder_layers * num_copies_per_layer, [&](size_t copy_idx) {
+                const size_t decoder_layer_id = copy_idx / num_copies_per_layer;
+                const bool is_key = copy_idx % num_copies_per_layer < src_dst_block_ids.size();
+                const auto& src_dst_block_id = src_dst_block_ids[copy_idx % src_dst_block_ids.size()];
+
+                const ov::Tensor& cache = is_key ? m_key_cache[decoder_layer_id] : m_value_cache[decoder_layer_id];
+                const size_t block_byte_size = cache.get_byte_size() / m_num_allocated_kv_blocks;
+                uint8_t* data = static_cast<uint8_t*>(cache.data());
+                std::memcpy(data + src_dst_block_id.second * block_byte_size, data + src_dst_block_id.first * block_byte_size, block_byte_size);
+            });
+            return;
+        }
+
+        for (const auto& [src_block_id, dst_block_id] : src_dst_block_ids) {
+            for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; ++decoder_layer_id) {
+                ov::Shape key_shape = set_kv_blocks(m_key_shapes[decoder_layer_id], m_num_allocated_kv_blocks);
+                ov::Shape value_shape = set_kv_blocks(m_value_shapes[decoder_layer_id], m_num_allocated_kv_blocks);
+                ov::Coordinate key_src_start_roi(key_shape.size(), 0);
+                ov::Coordinate key_src_end_roi = key_shape;
+                ov::Coordinate key_dst_start_roi(key_shape.size(), 0);
+                ov::Coordinate key_dst_end_roi = key_shape;
+
+                ov::Coordinate value_src_start_roi(value_shape.size(), 0);
+                ov::Coordinate value_src_end_roi = value_shape;
+                ov::Coordinate value_dst_start_roi(value_shape.size(), 0);
+                ov::Coordinate value_dst_end_roi = value_shape;
+                key_src_end_roi[0] = (key_src_start_roi[0] = src_block_id) + 1;
+                value_src_end_roi[0] = (value_src_start_roi[0] = src_block_id) + 1;
+                key_dst_end_roi[0] = (key_dst_start_roi[0] = dst_block_id) + 1;
+                value_dst_end_roi[0] = (value_dst_start_roi[0] = dst_block_id) + 1;
+
+                ov::Tensor key_src_cache_roi(m_key_cache[decoder_layer_id], key_src_start_roi, key_src_end_roi);
+                ov::Tensor key_dst_cache_roi(m_key_cache[decoder_layer_id], key_dst_start_roi, key_dst_end_roi);
+
+                ov::Tensor value_src_cache_roi(m_value_cache[decoder_layer_id], value_src_start_roi, value_src_end_roi);
+                ov::Tensor value_dst_cache_roi(m_value_cache[decoder_layer_id], value_dst_start_roi, value_dst_end_roi);
+
+                key_src_cache_roi.copy_to(key_dst_cache_roi);
+                value_src_cache_roi.copy_to(value_dst_cache_roi);
             }
         }
     }
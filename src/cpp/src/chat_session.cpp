@@ -0,0 +1,332 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "openvino/genai/chat_session.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+
+#include "openvino/core/except.hpp"
+
+namespace {
+
+// identifies files written by ChatSession::save() and the version of their layout
+constexpr char CHAT_SESSION_MAGIC[] = "OVGENAI_CHAT_SESSION";
+constexpr uint32_t CHAT_SESSION_VERSION = 1;
+
+// fixed length hex representation of a value
+std::string to_hex(uint64_t value) {
+    static const char hex_digits[] = "0123456789abcdef";
+    std::string hex(2 * sizeof(value), '0');
+    for (size_t i = hex.size(); i > 0; --i, value >>= 4) {
+        hex[i - 1] = hex_digits[value & 0xF];
+    }
+    return hex;
+}
+
+class Writer {
+public:
+    explicit Writer(std::ostream& stream) : m_stream(stream) {}
+
+    template <typename T>
+    void value(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        m_stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void bytes(const void* data, size_t size) {
+        value<uint64_t>(size);
+        m_stream.write(static_cast<const char*>(data), size);
+    }
+
+    void string(const std::string& str) {
+        bytes(str.data(), str.size());
+    }
+
+    void tokens(const std::vector<int64_t>& tokens) {
+        bytes(tokens.data(), tokens.size() * sizeof(int64_t));
+    }
+
+    void tensor(const ov::Tensor& tensor) {
+        value<uint8_t>(static_cast<bool>(tensor));
+        if (!tensor) {
+            return;
+        }
+        string(tensor.get_element_type().get_type_name());
+        const ov::Shape& shape = tensor.get_shape();
+        value<uint64_t>(shape.size());
+        for (size_t dim : shape) {
+            value<uint64_t>(dim);
+        }
+        bytes(tensor.data(), tensor.get_byte_size());
+    }
+
+private:
+    std::ostream& m_stream;
+};
+
+class Reader {
+public:
+    explicit Reader(std::istream& stream) : m_stream(stream) {
+        // sizes read from the stream are checked against its remaining length before anything is allocated
+        const std::streampos begin = m_stream.tellg();
+        m_stream.seekg(0, std::ios::end);
+        m_remaining_size = static_cast<size_t>(m_stream.tellg() - begin);
+        m_stream.seekg(begin);
+    }
+
+    template <typename T>
+    T value() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value;
+        read(&value, sizeof(T));
+        return value;
+    }
+
+    // Reads a number of items, each of which takes at least min_item_size bytes of the stream
+    size_t count(size_t min_item_size) {
+        const uint64_t count = value<uint64_t>();
+        OPENVINO_ASSERT(count <= m_remaining_size / min_item_size, "Chat session file is truncated");
+        return static_cast<size_t>(count);
+    }
+
+    std::string string() {
+        std::string str(count(1), '\0');
+        read(str.data(), str.size());
+        return str;
+    }
+
+    std::vector<int64_t> tokens() {
+        const size_t size = count(1);
+        OPENVINO_ASSERT(size % sizeof(int64_t) == 0, "Chat session file is corrupted");
+        std::vector<int64_t> tokens(size / sizeof(int64_t));
+        read(tokens.data(), size);
+        return tokens;
+    }
+
+    ov::Tensor tensor() {
+        if (!value<uint8_t>()) {
+            return {};
+        }
+        const ov::element::Type element_type{string()};
+        ov::Shape shape(count(sizeof(uint64_t)));
+        for (size_t& dim : shape) {
+            dim = value<uint64_t>();
+        }
+        const size_t byte_size = count(1);
+        // the shape must not exceed the stored byte size, which is checked without overflows before the tensor is allocated
+        if (std::find(shape.begin(), shape.end(), 0) == shape.end()) {
+            size_t num_bits = element_type.bitwidth();
+            for (size_t dim : shape) {
+                OPENVINO_ASSERT(num_bits <= 8 * byte_size / dim, "Chat session file is corrupted");
+                num_bits *= dim;
+            }
+        }
+        ov::Tensor tensor(element_type, shape);
+        OPENVINO_ASSERT(tensor.get_byte_size() == byte_size, "Chat session file is corrupted");
+        read(tensor.data(), byte_size);
+        return tensor;
+    }
+
+private:
+    void read(void* data, size_t size) {
+        OPENVINO_ASSERT(size <= m_remaining_size, "Chat session file is truncated");
+        m_stream.read(static_cast<char*>(data), size);
+        OPENVINO_ASSERT(m_stream.gcount() == static_cast<std::streamsize>(size), "Chat session file is truncated");
+        m_remaining_size -= size;
+    }
+
+    std::istream& m_stream;
+    size_t m_remaining_size = 0;
+};
+
+size_t get_byte_size(const ov::Tensor& tensor) {
+    return tensor ? tensor.get_byte_size() : 0;
+}
+
+}  // namespace
+
+namespace ov::genai {
+
+size_t ChatSession::get_byte_size() const {
+    size_t byte_size = ::get_byte_size(attention_mask) + (history_tokens.size() + kv_cache_tokens.size()) * sizeof(int64_t);
+    for (const auto& [name, state] : states) {
+        byte_size += ::get_byte_size(state);
+    }
+    return byte_size;
+}
+
+void ChatSession::save(const std::filesystem::path& path) const {
+    std::ofstream file(path, std::ios::binary);
+    OPENVINO_ASSERT(file.is_open(), "Cannot open file ", path.string(), " to save chat session");
+
+    Writer writer(file);
+    writer.string(CHAT_SESSION_MAGIC);
+    writer.value<uint32_t>(CHAT_SESSION_VERSION);
+
+    writer.value<uint64_t>(history.size());
+    for (const auto& message : history) {
+        writer.value<uint64_t>(message.size());
+        for (const auto& [key, value] : message) {
+            writer.string(key);
+            writer.string(value);
+        }
+    }
+    writer.string(templated_history);
+    writer.tokens(history_tokens);
+    writer.value<uint8_t>(encoded_inputs);
+    writer.tokens(kv_cache_tokens);
+    writer.value<uint64_t>(num_kv_cache_tokens_to_trim);
+    writer.tensor(attention_mask);
+    writer.value<uint64_t>(states.size());
+    for (const auto& [name, state] : states) {
+        writer.string(name);
+        writer.tensor(state);
+    }
+    OPENVINO_ASSERT(file.good(), "Cannot write chat session to ", path.string());
+}
+
+ChatSession ChatSession::load(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    OPENVINO_ASSERT(file.is_open(), "Cannot open chat session file ", path.string());
+
+    Reader reader(file);
+    OPENVINO_ASSERT(reader.string() == CHAT_SESSION_MAGIC, path.string(), " is not a chat session file");
+    const uint32_t version = reader.value<uint32_t>();
+    OPENVINO_ASSERT(version == CHAT_SESSION_VERSION, "Unsupported version ", version, " of chat session file ", path.string());
+
+    ChatSession session;
+    // a message takes at least its number of fields, a field takes at least sizes of its key and value
+    session.history.resize(reader.count(sizeof(uint64_t)));
+    for (auto& message : session.history) {
+        const size_t num_fields = reader.count(2 * sizeof(uint64_t));
+        for (size_t i = 0; i < num_fields; ++i) {
+            std::string key = reader.string();
+            message[key] = reader.string();
+        }
+    }
+    session.templated_history = reader.string();
+    session.history_tokens = reader.tokens();
+    session.encoded_inputs = reader.value<uint8_t>();
+    session.kv_cache_tokens = reader.tokens();
+    session.num_kv_cache_tokens_to_trim = reader.value<uint64_t>();
+    session.attention_mask = reader.tensor();
+    const size_t num_states = reader.count(sizeof(uint64_t));
+    for (size_t i = 0; i < num_states; ++i) {
+        std::string name = reader.string();
+        session.states[name] = reader.tensor();
+    }
+    return session;
+}
+
+ChatSessionCache::ChatSessionCache(size_t max_memory_size, const std::filesystem::path& spill_dir) :
+    m_max_memory_size(max_memory_size),
+    m_spill_dir(spill_dir) {
+    if (!m_spill_dir.empty()) {
+        std::filesystem::create_directories(m_spill_dir);
+    }
+}
+
+ChatSessionCache::~ChatSessionCache() {
+    // spilled sessions are owned by the cache
+    for (const auto& [session_id, path] : m_spilled_sessions) {
+        std::error_code error;
+        std::filesystem::remove(path, error);
+    }
+}
+
+void ChatSessionCache::put(const std::string& session_id, ChatSession session) {
+    const size_t byte_size = session.get_byte_size();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    OPENVINO_ASSERT(byte_size <= m_max_memory_size || !m_spill_dir.empty(),
+                    "Chat session '", session_id, "' of ", byte_size, " bytes exceeds the memory budget of ", m_max_memory_size,
+                    " bytes and can't be spilled, because the spill directory is not set");
+    remove_locked(session_id);
+
+    // a session larger than the budget is spilled right away, so sessions in memory are never spilled for nothing
+    if (byte_size > m_max_memory_size) {
+        std::filesystem::path path = get_spill_path(session_id);
+        session.save(path);
+        m_spilled_sessions[session_id] = path;
+        return;
+    }
+
+    m_memory_size += byte_size;
+    m_sessions.emplace_front(session_id, std::move(session));
+    m_session_by_id[session_id] = m_sessions.begin();
+
+    // the new session fits into the budget, so it's never spilled here
+    while (m_memory_size > m_max_memory_size) {
+        spill_least_recently_used();
+    }
+}
+
+std::optional<ChatSession> ChatSessionCache::take(const std::string& session_id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto it = m_session_by_id.find(session_id); it != m_session_by_id.end()) {
+        ChatSession session = std::move(it->second->second);
+        m_memory_size -= session.get_byte_size();
+        m_sessions.erase(it->second);
+        m_session_by_id.erase(it);
+        return session;
+    }
+    if (auto it = m_spilled_sessions.find(session_id); it != m_spilled_sessions.end()) {
+        ChatSession session = ChatSession::load(it->second);
+        std::filesystem::remove(it->second);
+        m_spilled_sessions.erase(it);
+        return session;
+    }
+    return std::nullopt;
+}
+
+bool ChatSessionCache::contains(const std::string& session_id) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_session_by_id.count(session_id) > 0 || m_spilled_sessions.count(session_id) > 0;
+}
+
+void ChatSessionCache::remove(const std::string& session_id) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    remove_locked(session_id);
+}
+
+void ChatSessionCache::remove_locked(const std::string& session_id) {
+    if (auto it = m_session_by_id.find(session_id); it != m_session_by_id.end()) {
+        m_memory_size -= it->second->second.get_byte_size();
+        m_sessions.erase(it->second);
+        m_session_by_id.erase(it);
+    }
+    if (auto it = m_spilled_sessions.find(session_id); it != m_spilled_sessions.end()) {
+        std::filesystem::remove(it->second);
+        m_spilled_sessions.erase(it);
+    }
+}
+
+size_t ChatSessionCache::get_memory_size() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_memory_size;
+}
+
+std::filesystem::path ChatSessionCache::get_spill_path(const std::string& session_id) {
+    // session ids are arbitrary strings of any length, so file names are made of a hash of the id and a counter to keep
+    // them short and unique. Existing files, e.g. of another cache sharing the directory, are skipped
+    std::filesystem::path path;
+    do {
+        path = m_spill_dir / (to_hex(std::hash<std::string>{}(session_id)) + "_" + to_hex(m_num_spill_files++) + ".ovchat");
+    } while (std::filesystem::exists(path));
+    return path;
+}
+
+void ChatSessionCache::spill_least_recently_used() {
+    auto& [session_id, session] = m_sessions.back();
+    if (!m_spill_dir.empty()) {
+        std::filesystem::path path = get_spill_path(session_id);
+        session.save(path);
+        m_spilled_sessions[session_id] = path;
+    }
+    m_memory_size -= session.get_byte_size();
+    m_session_by_id.erase(session_id);
+    m_sessions.pop_back();
+}
+
+}  // namespace ov::genai
@@ -0,0 +1,139 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "continuous_batching_engine.hpp"
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+ContinuousBatchingPipeline::ContinuousBatchingEngine::ContinuousBatchingEngine(std::function<void()> step,
+                                                                               std::function<bool()> has_non_finished_requests,
+                                                                               std::function<size_t()> get_num_waiting_requests,
+                                                                               std::function<void()> drop_requests,
+                                                                               size_t max_waiting_requests) :
+    m_step(std::move(step)),
+    m_has_non_finished_requests(std::move(has_non_finished_requests)),
+    m_get_num_waiting_requests(std::move(get_num_waiting_requests)),
+    m_drop_requests(std::move(drop_requests)),
+    m_max_waiting_requests(max_waiting_requests) {
+    // requests added before the engine is started are processed right away
+    m_has_new_requests = true;
+    m_thread = std::thread(&ContinuousBatchingEngine::run, this);
+}
+
+ContinuousBatchingPipeline::ContinuousBatchingEngine::~ContinuousBatchingEngine() {
+    try {
+        stop();
+    } catch (...) {
+        // an exception of a failed step is reported by stop() or add_request() only
+    }
+}
+
+GenerationHandle ContinuousBatchingPipeline::ContinuousBatchingEngine::add_request(const std::function<GenerationHandle()>& add) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_step_exception) {
+            std::rethrow_exception(m_step_exception);
+        }
+        OPENVINO_ASSERT(!m_stop_requested, "Continuous batching engine is stopped");
+
+        if (m_max_waiting_requests > 0) {
+            const size_t num_waiting_requests = m_get_num_waiting_requests() + m_num_admitted_requests;
+            OPENVINO_ASSERT(num_waiting_requests < m_max_waiting_requests,
+                            "Request is rejected: ", num_waiting_requests, " requests wait for processing, the limit is ", m_max_waiting_requests);
+        }
+        ++m_num_admitted_requests;
+    }
+
+    GenerationHandle handle;
+    try {
+        handle = add();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_num_admitted_requests;
+        throw;
+    }
+
+    std::exception_ptr step_exception;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        step_exception = m_step_exception;
+        ++m_num_added_requests;
+        m_has_new_requests = true;
+    }
+    if (step_exception) {
+        // a step has failed while the request was being added, so the request is dropped after the other ones
+        drop_requests();
+        std::rethrow_exception(step_exception);
+    }
+    m_cv.notify_one();
+    return handle;
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingEngine::stop() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop_requested = true;
+    }
+    m_cv.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    std::exception_ptr step_exception;
+    std::swap(step_exception, m_step_exception);
+    if (step_exception) {
+        std::rethrow_exception(step_exception);
+    }
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingEngine::run() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this] { return m_stop_requested || m_has_new_requests; });
+            if (m_stop_requested) {
+                return;
+            }
+            m_has_new_requests = false;
+        }
+
+        // requests added during the steps are pulled by them, so the thread sleeps only when the pipeline is idle
+        try {
+            while (!m_stop_requested && m_has_non_finished_requests()) {
+                // requests added before the step are pulled by it and counted by get_num_waiting_requests() after it,
+                // the ones added during the step stay admitted until the next one
+                size_t num_pulled_requests = 0;
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    std::swap(num_pulled_requests, m_num_added_requests);
+                }
+                m_step();
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_num_admitted_requests -= num_pulled_requests;
+                }
+            }
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_step_exception = std::current_exception();
+            }
+            // requests added after the exception is stored are rejected or dropped by add_request()
+            drop_requests();
+            return;
+        }
+    }
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingEngine::drop_requests() {
+    std::lock_guard<std::mutex> lock(m_drop_mutex);
+    try {
+        m_drop_requests();
+    } catch (...) {
+        // the exception of the failed step is reported instead
+    }
+}
+
+}  // namespace ov::genai
@@ -0,0 +1,83 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "openvino/genai/continuous_batching_pipeline.hpp"
+
+namespace ov::genai {
+
+/**
+ * Performs generation steps of a pipeline in a background thread while there are requests to process.
+ * The thread sleeps when the pipeline is idle and is woken up when a request is added by add_request().
+ */
+class ContinuousBatchingPipeline::ContinuousBatchingEngine {
+public:
+    /**
+     * Starts the background thread.
+     * @param step Performs a single generation step.
+     * @param has_non_finished_requests Checks whether there are requests to process.
+     * @param get_num_waiting_requests Returns the number of requests which wait for their prompts to be processed.
+     * @param drop_requests Removes all requests from the pipeline and moves their handles to a final status, called
+     * after a step has failed, so that readers and output callbacks of the requests are not left waiting.
+     * @param max_waiting_requests add_request() rejects requests when this number of requests wait for processing. 0 means no limit.
+     */
+    ContinuousBatchingEngine(std::function<void()> step,
+                             std::function<bool()> has_non_finished_requests,
+                             std::function<size_t()> get_num_waiting_requests,
+                             std::function<void()> drop_requests,
+                             size_t max_waiting_requests = 0);
+
+    ~ContinuousBatchingEngine();
+
+    ContinuousBatchingEngine(const ContinuousBatchingEngine&) = delete;
+    ContinuousBatchingEngine& operator=(const ContinuousBatchingEngine&) = delete;
+
+    /**
+     * Admits a request, adds it to the pipeline by calling `add` and wakes the background thread up.
+     * Throws if too many requests wait for processing or if a generation step has failed. If `add` throws,
+     * the request is not counted as waiting.
+     */
+    GenerationHandle add_request(const std::function<GenerationHandle()>& add);
+
+    /**
+     * Stops the background thread after the current step and rethrows an exception of a failed step, if any.
+     */
+    void stop();
+
+private:
+    void run();
+
+    // drops requests after a failed step, may be called by the background thread and by add_request()
+    void drop_requests();
+
+    std::function<void()> m_step;
+    std::function<bool()> m_has_non_finished_requests;
+    std::function<size_t()> m_get_num_waiting_requests;
+    std::function<void()> m_drop_requests;
+    const size_t m_max_waiting_requests;
+
+    std::mutex m_mutex;
+    // requests which were admitted, but are not counted by get_num_waiting_requests() yet, because no step has
+    // pulled them to the pipeline. Guarded by m_mutex, so that admission checks and updates the counter atomically
+    size_t m_num_admitted_requests = 0;
+    // admitted requests which are added to the pipeline, so the next step pulls them
+    size_t m_num_added_requests = 0;
+    std::condition_variable m_cv;
+    bool m_has_new_requests = false;
+    std::atomic<bool> m_stop_requested = false;
+    std::exception_ptr m_step_exception;
+    // serializes drops of requests after a failed step
+    std::mutex m_drop_mutex;
+
+    std::thread m_thread;
+};
+
+}  // namespace ov::genai
@@ -1,15 +1,18 @@
 // Copyright (C) 2023-2025 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <atomic>
 #include <thread>
 
 #include "openvino/genai/text_streamer.hpp"
+#include "openvino/core/parallel.hpp"
 #include "continuous_batching_impl.hpp"
 #include "utils.hpp"
 #include "paged_attention_transformations.hpp"
 #include "lora_helper.hpp"
 #include "cache_state_dumper.hpp"
+#include "tracing.hpp"
 #include "utils.hpp"
 
 namespace {
@@ -121,6 +124,27 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::ContinuousBatchingImpl(
     initialize_pipeline(model, scheduler_config, device, properties, kv_cache_config);
 }
 
+ContinuousBatchingPipeline::ContinuousBatchingImpl::ContinuousBatchingImpl(
+    const std::shared_ptr<ov::Model>& model,
+    const std::shared_ptr<InputsEmbedder>& inputs_embedder,
+    const Tokenizer& tokenizer,
+    const SchedulerConfig& scheduler_config,
+    const std::string& device,
+    const ov::AnyMap& properties,
+    const ov::genai::GenerationConfig& generation_config) {
+    OPENVINO_ASSERT(inputs_embedder, "InputsEmbedder must be set");
+    m_tokenizer = tokenizer;
+    m_generation_config = generation_config;
+    m_inputs_embedder = inputs_embedder;
+
+    bool is_need_per_layer_cache_control = scheduler_config.use_cache_eviction;
+    bool allow_cache_rotation = scheduler_config.cache_eviction_config.apply_rotation;
+    auto kv_cache_config = utils::apply_paged_attention_transformations(model, is_need_per_layer_cache_control, allow_cache_rotation);
+    utils::apply_gather_before_matmul_transformation(model);
+
+    initialize_pipeline(model, scheduler_config, device, properties, kv_cache_config);
+}
+
 ContinuousBatchingPipeline::ContinuousBatchingImpl::~ContinuousBatchingImpl() {
     if (m_scheduler) {
         m_scheduler->release();
@@ -129,9 +153,25 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::~ContinuousBatchingImpl() {
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::_pull_awaiting_requests() {
     std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+    for (const auto& sequence_group : m_awaiting_requests) {
+        // for just added requests processed tokens are the ones restored from prefix cache
+        PipelineMetricsCollector::add(m_pipeline_metrics->prompt_tokens, sequence_group->get_prompt_len());
+        PipelineMetricsCollector::add(m_pipeline_metrics->cached_prompt_tokens, sequence_group->get_num_processed_tokens());
+    }
+    _insert_awaiting_requests();
+    PipelineMetricsCollector::set(m_pipeline_metrics->requests, m_requests.size());
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_insert_awaiting_requests() {
+    if (m_awaiting_requests.empty()) {
+        return;
+    }
     m_requests.insert(m_requests.end(), m_awaiting_requests.begin(), m_awaiting_requests.end());
     m_awaiting_requests.clear();
-    m_pipeline_metrics.requests = m_requests.size();
+    // stable, so requests of the same priority keep the order of arrival
+    std::stable_sort(m_requests.begin(), m_requests.end(), [](const SequenceGroup::Ptr& lhs, const SequenceGroup::Ptr& rhs) {
+        return lhs->is_scheduled_before(*rhs);
+    });
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::initialize_pipeline(
@@ -174,6 +214,14 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::initialize_pipeline(
         normalized_config.num_kv_blocks = size_in_bytes / cache_manager->get_block_size_in_bytes();
     }
 
+    // the upper bound is used to reserve address space, so the cache grows without copying
+    if (normalized_config.num_kv_blocks > 0) {
+        cache_manager->set_max_num_kv_blocks(normalized_config.num_kv_blocks);
+    } else if (normalized_config.cache_size_limit > 0) {
+        size_t size_in_bytes = normalized_config.cache_size_limit * 1024 * 1024 * 1024; // convert GBs to bytes
+        cache_manager->set_max_num_kv_blocks(std::max<size_t>(size_in_bytes / cache_manager->get_block_size_in_bytes(), 1));
+    }
+
     bool can_use_partial_preemption = true;
     if (device.find("GPU") != std::string::npos && !normalized_config.dynamic_split_fuse) {
         // in case of executing a `vLLM-like` pipeline, it's better not to use partial eviction on the GPU,
@@ -231,8 +279,17 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::initialize_pipeline(
             std::make_shared<ModelRunner>(infer_request, m_block_size, m_num_decoder_layers);
     }
 
+    if (m_inputs_embedder) {
+        const ov::PartialShape inputs_embeds_shape = compiled_model.input("inputs_embeds").get_partial_shape();
+        const ov::Dimension hidden_size = inputs_embeds_shape[inputs_embeds_shape.rank().get_length() - 1];
+        OPENVINO_ASSERT(hidden_size.is_static(), "Hidden size of 'inputs_embeds' input must be static");
+        // own infer request is used, so generated tokens can be embedded while add_request() computes prompt embeddings
+        m_model_runner->set_embedding_model(m_inputs_embedder->get_embedding_model().clone(), hidden_size.get_length());
+    }
+
     m_sampler = std::make_shared<Sampler>(m_tokenizer, sampler_num_threads);
     m_sampler->set_seed(m_generation_config.rng_seed);
+    m_sampler->set_vocab_size(utils::get_vocab_size(compiled_model));
 
     // If eos_token_id was not provided, take value
     if (m_generation_config.eos_token_id == -1)
@@ -251,8 +308,30 @@ ContinuousBatchingPipeline::ContinuousBatchingImpl::add_request(uint64_t request
     if (sampling_params.eos_token_id == -1)
         sampling_params.set_eos_token_id(m_generation_config.eos_token_id);
     sampling_params.validate();
+    if (sampling_params.structured_output_config.has_value()) {
+        // rejects an invalid constraint here rather than failing a step of all requests, the sampler looks it up then
+        m_sampler->compile_structured_output(*sampling_params.structured_output_config);
+    }
+    if (sampling_params.cache_eviction_config.has_value()) {
+        OPENVINO_ASSERT(m_scheduler->get_config().use_cache_eviction,
+                        "'cache_eviction_config' of a request requires SchedulerConfig.use_cache_eviction to be enabled for the pipeline");
+        // validates the config against the model
+        CacheEvictionAlgorithm(*sampling_params.cache_eviction_config, m_block_size, m_num_decoder_layers);
+    }
+
+    ov::Tensor inputs = input_ids;
+    if (m_inputs_embedder && input_ids.get_element_type() == ov::element::i64) {
+        // the model consumes embeddings, so text-only requests are embedded here
+        std::lock_guard<std::mutex> lock{m_inputs_embedder_mutex};
+        const ov::Tensor inputs_embeds = m_inputs_embedder->get_embedding_model().infer(input_ids);
+        inputs = ov::Tensor(inputs_embeds.get_element_type(), inputs_embeds.get_shape());
+        inputs_embeds.copy_to(inputs);
+    }
+    OPENVINO_ASSERT(m_inputs_embedder || inputs.get_element_type() == ov::element::i64,
+        "Prompt embeddings are supported only by pipelines created from VLM models");
+    OPENVINO_ASSERT(!m_inputs_embedder || !sampling_params.echo, "'echo' is not supported by pipelines created from VLM models");
 
-    SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(request_id, input_ids, sampling_params, m_block_size);
+    SequenceGroup::Ptr sequence_group = std::make_shared<SequenceGroup>(request_id, inputs, sampling_params, m_block_size);
 
     if (m_scheduler->get_config().enable_prefix_caching) {
         m_scheduler->restore_cached_blocks(sequence_group);
@@ -270,10 +349,9 @@ GenerationHandle
 ContinuousBatchingPipeline::ContinuousBatchingImpl::add_request(uint64_t request_id,
                                                                 const std::string& prompt,
                                                                 ov::genai::GenerationConfig sampling_params) {
-    static ManualTimer timer("tokenize");
-    timer.start();
+    TraceSpan tokenize_span("tokenize");
     ov::Tensor input_ids = m_tokenizer.encode(prompt).input_ids;
-    timer.end();
+    tokenize_span.arg("prompt_tokens", input_ids.get_size());
 
     return add_request(request_id, input_ids, sampling_params);
 }
@@ -284,24 +362,22 @@ bool ContinuousBatchingPipeline::ContinuousBatchingImpl::has_non_finished_reques
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
-    static ManualTimer step_timer("step()");
-    step_timer.start();
+    TraceSpan step_span("step");
+    const auto step_start_time = std::chrono::steady_clock::now();
 
     _pull_awaiting_requests();
+    step_span.arg("requests", m_requests.size());
 
     Scheduler::Output scheduler_output;
 
     {
-        static ManualTimer scheduling_timer("scheduling");
-        scheduling_timer.start();
+        TraceSpan schedule_span("schedule");
         scheduler_output = m_scheduler->schedule(m_requests);
-        scheduling_timer.end();
+        schedule_span.arg("scheduled_requests", scheduler_output.m_scheduled_sequence_groups_ids.size())
+                     .arg("scheduled_tokens", scheduler_output.m_total_num_scheduled_tokens)
+                     .arg("cache_usage", static_cast<int64_t>(scheduler_output.m_cache_usage));
 
-        m_pipeline_metrics.scheduled_requests = scheduler_output.m_scheduled_sequence_groups_ids.size();
-        m_pipeline_metrics.cache_usage = scheduler_output.m_cache_usage;
-        m_pipeline_metrics.max_cache_usage = std::max(m_pipeline_metrics.max_cache_usage, scheduler_output.m_cache_usage);
-        _register_step_cache_usage(scheduler_output.m_cache_usage);
-        m_pipeline_metrics.avg_cache_usage = _get_current_running_average_cache_usage();
+        _update_step_metrics(scheduler_output);
 
         const auto& sched_config = m_scheduler->get_config();
         if (sched_config.use_cache_eviction && sched_config.cache_eviction_config.apply_rotation) {
@@ -326,11 +402,35 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
     }
     ov::Tensor logits;
 
+    // attention scores are collected only at steps when cache blocks are evicted
+    const auto& sched_config = m_scheduler->get_config();
+    bool is_eviction_step = false;
+    if (sched_config.use_cache_eviction) {
+        is_eviction_step = m_step_idx++ % sched_config.cache_eviction_config.score_aggregation_interval == 0;
+        // SnapKV requires scores of the step which completes the prompt
+        for (size_t seq_group_id : scheduler_output.m_scheduled_sequence_groups_ids) {
+            const SequenceGroup::CPtr sequence_group = m_requests[seq_group_id];
+            is_eviction_step = is_eviction_step || (m_scheduler->get_cache_eviction_config(sequence_group).policy == CacheEvictionPolicy::SNAPKV &&
+                                                    !sequence_group->can_generate_tokens() &&
+                                                    sequence_group->get_context_len() >= sequence_group->get_prompt_len());
+        }
+        m_model_runner->set_collect_attention_scores(is_eviction_step);
+    }
+
     {
-        static ManualTimer timer("forward");
-        timer.start();
+        TraceSpan forward_span("forward");
+        if (forward_span.is_recording()) {
+            // batch composition: requests processing prompts and generating new tokens
+            size_t num_prefill_requests = 0;
+            for (size_t seq_group_id : scheduler_output.m_scheduled_sequence_groups_ids) {
+                const SequenceGroup::CPtr sequence_group = m_requests[seq_group_id];
+                num_prefill_requests += sequence_group->get_num_processed_tokens() < sequence_group->get_prompt_len();
+            }
+            forward_span.arg("batch_tokens", scheduler_output.m_total_num_scheduled_tokens)
+                        .arg("prefill_requests", num_prefill_requests)
+                        .arg("decode_requests", scheduler_output.m_scheduled_sequence_groups_ids.size() - num_prefill_requests);
+        }
         logits = m_model_runner->forward(m_requests, scheduler_output);
-        timer.end();
     }
 
 #ifdef DEBUG_CACHE_STATE_DUMP
@@ -339,9 +439,12 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
 #endif
 
     // evict unimportant blocks from KV cache, if requested
-    const auto& sched_config = m_scheduler->get_config();
-    if (sched_config.use_cache_eviction) {
+    if (is_eviction_step) {
         _maybe_evict_cache_blocks(sched_config);
+    } else if (sched_config.use_cache_eviction) {
+        // blocks evicted at the previous step were already rotated at this step
+        m_previous_evicted_block_logical_indices_per_sequence.clear();
+        m_previous_num_blocks_before_eviction_per_sequence.clear();
     }
 
 #ifdef DEBUG_CACHE_STATE_DUMP
@@ -355,49 +458,86 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::step() {
 
     SamplerOutput sampler_output;
     {
-        static ManualTimer timer("sample");
-        timer.start();
+        TraceSpan sample_span("sample");
         sampler_output = m_sampler->sample(m_requests, logits, m_is_validation_mode_enabled);
         m_batch_size = sampler_output.num_generated_tokens;
-        timer.end();
+        sample_span.arg("generated_tokens", sampler_output.num_generated_tokens);
+        PipelineMetricsCollector::add(m_pipeline_metrics->generated_tokens, sampler_output.num_generated_tokens);
     }
 
     // process sampler_output (e.g. fork or drop sequences from BlockScheduler)
     {
-        static ManualTimer free_fork_timer("fork / free sequence");
-        free_fork_timer.start();
+        TraceSpan fork_free_span("fork / free sequence");
+        fork_free_span.arg("forked_sequences", sampler_output.m_forked_sequences.size())
+                      .arg("dropped_sequences", sampler_output.m_dropped_sequences.size());
 
         for (const auto& pair : sampler_output.m_forked_sequences) {
             uint64_t parent_id = pair.first;
             const std::list<uint64_t>& child_ids = pair.second;
-            for (auto& child_id : child_ids)
+            auto parent_cache_eviction_algo_it = m_seq_group_id_to_cache_eviction_algo_map.find(parent_id);
+            for (auto& child_id : child_ids) {
                 m_scheduler->fork_sequence(parent_id, child_id);
+                // children share the KV cache of the parent, so they inherit its scores
+                if (parent_cache_eviction_algo_it != m_seq_group_id_to_cache_eviction_algo_map.end())
+                    m_seq_group_id_to_cache_eviction_algo_map[child_id] = parent_cache_eviction_algo_it->second;
+            }
         }
 
-        for (auto seq_id : sampler_output.m_dropped_sequences)
+        for (auto seq_id : sampler_output.m_dropped_sequences) {
             m_scheduler->free_sequence(seq_id);
-
-        free_fork_timer.end();
+            m_seq_group_id_to_cache_eviction_algo_map.erase(seq_id);
+        }
     }
 
     // notify requests dropped by handle
     {
-        static ManualTimer report_tokens_timer("notify requests dropped by handle");
-        report_tokens_timer.start();
+        TraceSpan notify_span("notify requests dropped by handle");
         _notify_requests_dropped_by_handle();
-        report_tokens_timer.end();
     }
 
     // free non running requests for current step
 
     {
-        static ManualTimer clean_up_requests_timer("free non running requests");
-        clean_up_requests_timer.start();
+        TraceSpan clean_up_span("free non running requests");
         _free_non_running_requests();
-        clean_up_requests_timer.end();
     }
 
-    step_timer.end();
+    const std::chrono::duration<double, std::milli> step_duration = std::chrono::steady_clock::now() - step_start_time;
+    m_pipeline_metrics->step_duration.observe(step_duration.count());
+}
+
+void ContinuousBatchingPipeline::ContinuousBatchingImpl::_update_step_metrics(const Scheduler::Output& scheduler_output) {
+    size_t num_running_requests = 0, num_waiting_requests = 0, num_preempted_requests = 0;
+    for (const auto& sequence_group : m_requests) {
+        if (sequence_group->is_scheduled()) {
+            ++num_running_requests;
+        } else if (sequence_group->is_preempted()) {
+            ++num_preempted_requests;
+        } else if (sequence_group->get_num_processed_tokens() < sequence_group->get_prompt_len()) {
+            ++num_waiting_requests;
+        } else {
+            // requests generating tokens keep their KV cache even if they are not scheduled at vLLM prompt steps
+            ++num_running_requests;
+        }
+    }
+
+    PipelineMetricsCollector& metrics = *m_pipeline_metrics;
+    PipelineMetricsCollector::set(metrics.running_requests, num_running_requests);
+    PipelineMetricsCollector::set(metrics.waiting_requests, num_waiting_requests);
+    PipelineMetricsCollector::set(metrics.preempted_requests, num_preempted_requests);
+    PipelineMetricsCollector::set(metrics.scheduled_requests, scheduler_output.m_scheduled_sequence_groups_ids.size());
+
+    PipelineMetricsCollector::set(metrics.cache_usage, scheduler_output.m_cache_usage);
+    PipelineMetricsCollector::set(metrics.max_cache_usage, std::max(metrics.max_cache_usage.load(std::memory_order_relaxed), scheduler_output.m_cache_usage));
+    _register_step_cache_usage(scheduler_output.m_cache_usage);
+    PipelineMetricsCollector::set(metrics.avg_cache_usage, _get_current_running_average_cache_usage());
+    PipelineMetricsCollector::set(metrics.used_kv_blocks, scheduler_output.m_num_used_blocks);
+    PipelineMetricsCollector::set(metrics.free_kv_blocks, scheduler_output.m_num_free_blocks);
+    PipelineMetricsCollector::set(metrics.cached_kv_blocks, scheduler_output.m_num_cached_blocks);
+
+    PipelineMetricsCollector::set(metrics.num_preemptions, m_scheduler->get_num_preemptions());
+    PipelineMetricsCollector::set(metrics.num_partial_preemptions, m_scheduler->get_num_partial_preemptions());
+    metrics.tokens_per_step.observe(scheduler_output.m_total_num_scheduled_tokens);
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::set_adapters(const std::optional<AdapterConfig>& adapters) {
@@ -523,6 +663,7 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::_free_non_running_reque
                 if (m_scheduler->has_block_table(sequence->get_id())) {
                     m_scheduler->free_sequence(sequence->get_id());
                 }
+                m_seq_group_id_to_cache_eviction_algo_map.erase(sequence->get_id());
             }
             m_sampler->clear_request_info(request->get_request_id());
             requests_iterator = m_requests.erase(requests_iterator);
@@ -553,6 +694,11 @@ float ContinuousBatchingPipeline::ContinuousBatchingImpl::_get_current_running_a
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::drop_requests() {
+    std::vector<SequenceGroup::Ptr> dropped_requests;
+    {
+        std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+        dropped_requests.swap(m_awaiting_requests);
+    }
     for (const std::shared_ptr<ov::genai::SequenceGroup> request : m_requests) {
         for (const auto& sequence: request->get_sequences()) {
             if (m_scheduler->has_block_table(sequence->get_id())) {
@@ -560,8 +706,17 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::drop_requests() {
             }
         }
         m_sampler->clear_request_info(request->get_request_id());
+        dropped_requests.push_back(request);
     }
     m_requests.clear();
+
+    for (const auto& request : dropped_requests) {
+        try {
+            request->get_generation_stream()->abort();
+        } catch (...) {
+            // an exception of an output callback must not keep the rest of requests waiting
+        }
+    }
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::_compute_cache_rotation_data(const std::vector<SequenceGroup::Ptr>& sequence_groups,
@@ -637,8 +792,9 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::_compute_cache_rotation
 
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::_maybe_evict_cache_blocks(const SchedulerConfig& sched_config) {
+    TraceSpan evict_span("evict cache blocks");
     std::unordered_map<SequenceGroup::Ptr, size_t> seq_group_to_num_blocks_evicted_map;
-    auto sequence_attention_scores = m_model_runner->get_last_attention_scores();
+    const auto& sequence_attention_scores = m_model_runner->get_last_attention_scores();
 
     OPENVINO_ASSERT(!sequence_attention_scores.empty());
     size_t num_decoder_layers = sequence_attention_scores.begin()->second.size();
@@ -646,32 +802,60 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::_maybe_evict_cache_bloc
     m_previous_evicted_block_logical_indices_per_sequence.clear();
     m_previous_num_blocks_before_eviction_per_sequence.clear();
 
-    for (auto& seq_id_and_attention_scores : sequence_attention_scores) {
+    std::unordered_map<size_t, SequenceGroup::Ptr> seq_id_to_seq_group;
+    for (const auto& sequence_group : m_requests) {
+        for (const auto& sequence : sequence_group->get_sequences()) {
+            seq_id_to_seq_group[sequence->get_id()] = sequence_group;
+        }
+    }
+
+    struct SequenceEvictionState {
+        size_t seq_id;
+        SequenceGroup::Ptr seq_group;
+        CacheEvictionAlgorithm* cache_eviction_algo;
+        const AttentionScoresForEachDecoderLayer* attention_scores;
+        bool can_evict;
+        std::vector<std::set<size_t>> logical_blocks_to_evict;
+    };
+    std::vector<SequenceEvictionState> sequences;
+    sequences.reserve(sequence_attention_scores.size());
+    for (const auto& seq_id_and_attention_scores : sequence_attention_scores) {
         auto seq_id = seq_id_and_attention_scores.first;
-        const auto& attention_scores_for_all_decoder_layers = seq_id_and_attention_scores.second;
+        auto seq_group_it = seq_id_to_seq_group.find(seq_id);
+        OPENVINO_ASSERT(seq_group_it != seq_id_to_seq_group.end(), "could not find sequence group with sequence ", seq_id);
+        const SequenceGroup::Ptr& seq_group = seq_group_it->second;
+        const CacheEvictionConfig& eviction_config = m_scheduler->get_cache_eviction_config(seq_group);
         if (m_seq_group_id_to_cache_eviction_algo_map.find(seq_id) == m_seq_group_id_to_cache_eviction_algo_map.end()) {
-            m_seq_group_id_to_cache_eviction_algo_map[seq_id] = CacheEvictionAlgorithm(sched_config.cache_eviction_config, m_block_size, num_decoder_layers);
+            m_seq_group_id_to_cache_eviction_algo_map[seq_id] = CacheEvictionAlgorithm(eviction_config, m_block_size, num_decoder_layers);
         }
-        auto& cache_eviction_algo = m_seq_group_id_to_cache_eviction_algo_map[seq_id];
-        cache_eviction_algo.register_new_token_scores(attention_scores_for_all_decoder_layers);
-
-        auto seq_group_ptr_it = std::find_if(m_requests.begin(), m_requests.end(), [seq_id](const SequenceGroup::Ptr& val) { return val->has_sequence_with_id(seq_id); });
-        OPENVINO_ASSERT(seq_group_ptr_it != m_requests.end(), "could not find sequence group with sequence ", seq_id);
-        auto seq_group_ptr = *seq_group_ptr_it;
+        // SnapKV compresses the prompt at the step which completes it, other policies do not evict during prefill
+        bool can_evict = seq_group->can_generate_tokens() ||
+                         (eviction_config.policy == CacheEvictionPolicy::SNAPKV && seq_group->get_context_len() >= seq_group->get_prompt_len());
+        sequences.push_back({seq_id, seq_group, &m_seq_group_id_to_cache_eviction_algo_map[seq_id], &seq_id_and_attention_scores.second, can_evict, {}});
+    }
+
+    // score aggregation and selection of blocks are independent for each sequence
+    ov::parallel_for(sequences.size(), [&](size_t sequence_idx) {
+        SequenceEvictionState& state = sequences[sequence_idx];
+        state.cache_eviction_algo->register_new_token_scores(*state.attention_scores);
+        if (state.can_evict) {
+            state.logical_blocks_to_evict = state.cache_eviction_algo->evict_logical_blocks();
+        }
+    });
 
-         if (!seq_group_ptr->can_generate_tokens()) {
-             // do not evict during prefill
-             continue;
-         }
+    for (auto& state : sequences) {
+        if (!state.can_evict) {
+            continue;
+        }
+        auto seq_id = state.seq_id;
+        auto seq_group_ptr = state.seq_group;
 
         m_previous_num_blocks_before_eviction_per_sequence[seq_id] = seq_group_ptr->get_num_logical_blocks();
 
-        auto logical_blocks_to_evict = cache_eviction_algo.evict_logical_blocks();
-        m_previous_evicted_block_logical_indices_per_sequence[seq_id] = logical_blocks_to_evict;
-
-        m_scheduler->free_blocks_from_sequence(seq_id, logical_blocks_to_evict);
+        m_scheduler->free_blocks_from_sequence(seq_id, state.logical_blocks_to_evict);
 
-        size_t num_blocks_evicted = logical_blocks_to_evict[0].size();
+        size_t num_blocks_evicted = state.logical_blocks_to_evict[0].size();
+        m_previous_evicted_block_logical_indices_per_sequence[seq_id] = std::move(state.logical_blocks_to_evict);
 
         if (seq_group_to_num_blocks_evicted_map.find(seq_group_ptr) != seq_group_to_num_blocks_evicted_map.end()) {
             OPENVINO_ASSERT(seq_group_to_num_blocks_evicted_map[seq_group_ptr] == num_blocks_evicted, "internal error - each sequence in the same group must have the same number of blocks evicted");
@@ -681,12 +865,15 @@ void ContinuousBatchingPipeline::ContinuousBatchingImpl::_maybe_evict_cache_bloc
 
     }
 
+    size_t total_num_blocks_evicted = 0;
     for (const auto& seq_group_ptr_and_num_blocks_evicted : seq_group_to_num_blocks_evicted_map) {
         // Assuming that the evicted blocks are always full (since they by design are only selected from intermediate-age blocks)
         auto seq_group_ptr = seq_group_ptr_and_num_blocks_evicted.first;
         auto num_blocks_evicted = seq_group_ptr_and_num_blocks_evicted.second;
         seq_group_ptr->register_token_eviction(num_blocks_evicted * m_block_size);
+        total_num_blocks_evicted += num_blocks_evicted;
     }
+    evict_span.arg("evicted_blocks", total_num_blocks_evicted);
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingImpl::_fill_prompt_log_probs(std::vector<SequenceGroup::Ptr>& sequence_groups, ov::Tensor& logits) {
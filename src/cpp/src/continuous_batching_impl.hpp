@@ -25,6 +25,8 @@ protected:
     std::mutex m_awaiting_requests_mutex;
 
     std::map<size_t, CacheEvictionAlgorithm> m_seq_group_id_to_cache_eviction_algo_map;
+    // number of performed steps, used to aggregate attention scores once per CacheEvictionConfig::score_aggregation_interval steps
+    size_t m_step_idx = 0;
 
     static const size_t AVG_CACHE_USAGE_WINDOW_SIZE_IN_STEPS = 1000;
     std::deque<float> m_previous_step_cache_usages;
@@ -69,6 +71,12 @@ protected:
      */
     virtual void _pull_awaiting_requests();
 
+    /**
+     * Moves awaiting requests to running queue, so that the queue stays ordered by scheduling priority.
+     * Scheduler serves requests from the front of the queue and preempts them from the back.
+     */
+    void _insert_awaiting_requests();
+
     /**
      * Releases non-running (finished, dropped or OOM) requests from running queue
      */
@@ -91,9 +99,12 @@ protected:
 
     void _register_step_cache_usage(float step_cache_usage);
     float _get_current_running_average_cache_usage() const;
-    void _compute_cache_rotation_data(const std::vector<SequenceGroup::Ptr>& sequence_groups, const Scheduler::Output& scheduler_output);
 
-    virtual void drop_requests();
+    /**
+     * Updates queue sizes, KV cache usage and scheduling counters of pipeline metrics after scheduling
+     */
+    void _update_step_metrics(const Scheduler::Output& scheduler_output);
+    void _compute_cache_rotation_data(const std::vector<SequenceGroup::Ptr>& sequence_groups, const Scheduler::Output& scheduler_output);
 
 public:
     ContinuousBatchingImpl(const std::shared_ptr<ov::Model>& model,
@@ -104,6 +115,17 @@ public:
                            const ov::genai::GenerationConfig& generation_config,
                            bool is_validation_mode_enabled = false);
     
+    /**
+     * Constructs a pipeline for VLM language model which consumes inputs_embeds computed by inputs_embedder
+     */
+    ContinuousBatchingImpl(const std::shared_ptr<ov::Model>& model,
+                           const std::shared_ptr<InputsEmbedder>& inputs_embedder,
+                           const Tokenizer& tokenizer,
+                           const SchedulerConfig& scheduler_config,
+                           const std::string& device,
+                           const ov::AnyMap& properties,
+                           const ov::genai::GenerationConfig& generation_config);
+
     virtual ~ContinuousBatchingImpl();
 
     GenerationHandle add_request(uint64_t request_id,
@@ -118,6 +140,8 @@ public:
 
     void step() override;
 
+    void drop_requests() override;
+
     std::vector<EncodedGenerationResult>
     generate(const std::vector<ov::Tensor>& input_ids,
              const std::vector<GenerationConfig>& sampling_params,
@@ -10,8 +10,11 @@
 #include "openvino/genai/generation_handle.hpp"
 #include "openvino/genai/tokenizer.hpp"
 #include "continuous_batching_impl.hpp"
+#include "continuous_batching_engine.hpp"
 #include "speculative_decoding/speculative_decoding_impl.hpp"
 #include "prompt_lookup/prompt_lookup_impl.hpp"
+#include "visual_language/inputs_embedder.hpp"
+#include "visual_language/vlm_config.hpp"
 #include "timer.hpp"
 #include "utils.hpp"
 #include "debug_utils.hpp"
@@ -38,6 +41,36 @@ extract_prompt_lookup_from_config(ov::AnyMap& config) {
     return res;
 }
 
+inline std::optional<size_t>
+extract_image_embeddings_cache_size_from_config(ov::AnyMap& config) {
+    std::optional<size_t> res;
+    if (config.find(ov::genai::image_embeddings_cache_size.name()) != config.end()) {
+        res = config.at(ov::genai::image_embeddings_cache_size.name()).as<size_t>();
+        config.erase(ov::genai::image_embeddings_cache_size.name());
+    }
+    return res;
+}
+
+// VLM directory contains a language model consuming inputs_embeds instead of openvino_model.xml
+inline bool is_vlm_model(const std::filesystem::path& models_path) {
+    return std::filesystem::exists(models_path / "openvino_language_model.xml") &&
+        std::filesystem::exists(models_path / "openvino_text_embeddings_model.xml");
+}
+
+inline std::shared_ptr<InputsEmbedder>
+create_inputs_embedder(const std::filesystem::path& models_path, const std::string& device, ov::AnyMap& properties) {
+    auto image_embeddings_cache_size = extract_image_embeddings_cache_size_from_config(properties);
+    auto vlm_config = utils::from_config_json_if_exists<VLMConfig>(models_path, "config.json");
+    // Qwen2-VL requires 3D rotary position ids which are not supported by PagedAttention models
+    OPENVINO_ASSERT(vlm_config.model_type != VLMModelType::QWEN2_VL, "Qwen2-VL is not supported by ContinuousBatchingPipeline");
+
+    auto inputs_embedder = std::make_shared<InputsEmbedder>(vlm_config, models_path, device, properties);
+    if (image_embeddings_cache_size.has_value()) {
+        inputs_embedder->set_image_embeddings_cache_size(*image_embeddings_cache_size);
+    }
+    return inputs_embedder;
+}
+
 inline float get_load_time(std::chrono::steady_clock::time_point start_time) {
     auto stop_time = std::chrono::steady_clock::now();
     return std::chrono::duration_cast<std::chrono::milliseconds>(stop_time - start_time).count();
@@ -53,10 +86,20 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline( const std::filesystem::p
     auto properties_without_draft_model = properties;
     auto draft_model_desr = extract_draft_model_from_config(properties_without_draft_model);
     auto is_prompt_lookup_enabled = extract_prompt_lookup_from_config(properties_without_draft_model);
+    auto generation_config = utils::from_config_json_if_exists(models_path);
+
+    if (is_vlm_model(models_path)) {
+        OPENVINO_ASSERT(!is_prompt_lookup_enabled && draft_model_desr.model == nullptr,
+            "Speculative decoding and prompt lookup decoding are not supported for VLM models");
+        auto inputs_embedder = create_inputs_embedder(models_path, device, properties_without_draft_model);
+        auto model = utils::singleton_core().read_model(models_path / "openvino_language_model.xml", {}, properties_without_draft_model);
+        m_impl = std::make_shared<ContinuousBatchingImpl>(model, inputs_embedder, inputs_embedder->get_tokenizer(), scheduler_config, device, properties_without_draft_model, generation_config);
+        m_impl->m_load_time_ms = get_load_time(start_time);
+        return;
+    }
 
     auto model = utils::singleton_core().read_model(models_path / "openvino_model.xml", {}, properties);
     auto tokenizer = ov::genai::Tokenizer(models_path, tokenizer_properties);
-    auto generation_config = utils::from_config_json_if_exists(models_path);
 
     if (is_prompt_lookup_enabled) {
         OPENVINO_ASSERT(draft_model_desr.model == nullptr, "Speculative decoding and prompt lookup decoding are mutually exclusive");
@@ -82,9 +125,20 @@ ContinuousBatchingPipeline::ContinuousBatchingPipeline(
     auto properties_without_draft_model = properties;
     auto draft_model_desr = extract_draft_model_from_config(properties_without_draft_model);
     auto is_prompt_lookup_enabled = extract_prompt_lookup_from_config(properties_without_draft_model);
+    auto generation_config = utils::from_config_json_if_exists(models_path);
+
+    if (is_vlm_model(models_path)) {
+        OPENVINO_ASSERT(!is_prompt_lookup_enabled && draft_model_desr.model == nullptr,
+            "Speculative decoding and prompt lookup decoding are not supported for VLM models");
+        auto inputs_embedder = create_inputs_embedder(models_path, device, properties_without_draft_model);
+        auto model = utils::singleton_core().read_model(models_path / "openvino_language_model.xml", {}, properties_without_draft_model);
+        m_impl = std::make_shared<ContinuousBatchingImpl>(model, inputs_embedder, tokenizer, scheduler_config, device, properties_without_draft_model, generation_config);
+        m_impl->m_load_time_ms = get_load_time(start_time);
+        return;
+    }
+
     std::filesystem::path openvino_model_name = "openvino_model.xml";
     auto model = utils::singleton_core().read_model(models_path / openvino_model_name, {}, properties_without_draft_model);
-    auto generation_config = utils::from_config_json_if_exists(models_path);
 
     if (is_prompt_lookup_enabled) {
         OPENVINO_ASSERT(draft_model_desr.model == nullptr, "Speculative decoding and prompt lookup decoding are mutually exclusive");
@@ -140,14 +194,28 @@ PipelineMetrics ContinuousBatchingPipeline::get_metrics() const{
 }
 
 GenerationHandle ContinuousBatchingPipeline::add_request(uint64_t request_id, const std::string& prompt, const ov::genai::GenerationConfig& sampling_params) {
+    if (m_engine) {
+        return m_engine->add_request([&] { return m_impl->add_request(request_id, prompt, sampling_params); });
+    }
     return m_impl->add_request(request_id, prompt, sampling_params);
 }
 
 GenerationHandle ContinuousBatchingPipeline::add_request(uint64_t request_id, const ov::Tensor& input_ids, const ov::genai::GenerationConfig& sampling_params) {
+    if (m_engine) {
+        return m_engine->add_request([&] { return m_impl->add_request(request_id, input_ids, sampling_params); });
+    }
     return m_impl->add_request(request_id, input_ids, sampling_params);
 }
 
+GenerationHandle ContinuousBatchingPipeline::add_request(uint64_t request_id, const std::string& prompt, const std::vector<ov::Tensor>& images, const ov::genai::GenerationConfig& sampling_params) {
+    if (m_engine) {
+        return m_engine->add_request([&] { return m_impl->add_request(request_id, prompt, images, sampling_params); });
+    }
+    return m_impl->add_request(request_id, prompt, images, sampling_params);
+}
+
 void ContinuousBatchingPipeline::step() {
+    OPENVINO_ASSERT(!m_engine, "step() cannot be called while the engine of ContinuousBatchingPipeline is running");
     m_impl->step();
 }
 
@@ -155,7 +223,29 @@ bool ContinuousBatchingPipeline::has_non_finished_requests() {
     return m_impl->has_non_finished_requests();
 }
 
+void ContinuousBatchingPipeline::start_engine(size_t max_waiting_requests) {
+    OPENVINO_ASSERT(!m_engine, "The engine of ContinuousBatchingPipeline is already running");
+    auto impl = m_impl;
+    m_engine = std::make_shared<ContinuousBatchingEngine>(
+        [impl] { impl->step(); },
+        [impl] { return impl->has_non_finished_requests(); },
+        [impl] { return impl->get_metrics().waiting_requests; },
+        [impl] { impl->drop_requests(); },
+        max_waiting_requests);
+}
+
+void ContinuousBatchingPipeline::stop_engine() {
+    OPENVINO_ASSERT(m_engine, "The engine of ContinuousBatchingPipeline is not running");
+    auto engine = std::move(m_engine);
+    engine->stop();
+}
+
+bool ContinuousBatchingPipeline::is_engine_running() const {
+    return m_engine != nullptr;
+}
+
 std::vector<EncodedGenerationResult> ContinuousBatchingPipeline::generate(const std::vector<ov::Tensor>& input_ids, const std::vector<ov::genai::GenerationConfig>& sampling_params, const StreamerVariant& streamer) {
+    OPENVINO_ASSERT(!m_engine, "generate() cannot be called while the engine of ContinuousBatchingPipeline is running");
     auto encoded_results = m_impl->generate(input_ids, sampling_params, streamer);
 
     for (auto& encoded_result : encoded_results) {
@@ -166,6 +256,7 @@ std::vector<EncodedGenerationResult> ContinuousBatchingPipeline::generate(const
 }
 
 std::vector<GenerationResult> ContinuousBatchingPipeline::generate(const std::vector<std::string>& prompts, const std::vector<ov::genai::GenerationConfig>& sampling_params, const StreamerVariant& streamer) {
+    OPENVINO_ASSERT(!m_engine, "generate() cannot be called while the engine of ContinuousBatchingPipeline is running");
     auto decoded_results = m_impl->generate(prompts, sampling_params, streamer);
 
     for (auto& decoded_result : decoded_results) {
@@ -175,6 +266,21 @@ std::vector<GenerationResult> ContinuousBatchingPipeline::generate(const std::ve
     return decoded_results;
 }
 
+std::vector<VLMDecodedResults> ContinuousBatchingPipeline::generate(
+    const std::vector<std::string>& prompts,
+    const std::vector<std::vector<ov::Tensor>>& images,
+    const std::vector<ov::genai::GenerationConfig>& sampling_params,
+    const StreamerVariant& streamer) {
+    OPENVINO_ASSERT(!m_engine, "generate() cannot be called while the engine of ContinuousBatchingPipeline is running");
+    auto decoded_results = m_impl->generate(prompts, images, sampling_params, streamer);
+
+    for (auto& decoded_result : decoded_results) {
+        decoded_result.perf_metrics.load_time = m_impl->m_load_time_ms;
+    }
+
+    return decoded_results;
+}
+
 void ContinuousBatchingPipeline::start_chat(const std::string& system_message) {
     m_impl->start_chat(system_message);
 };
@@ -89,6 +89,7 @@ GenerationConfig::GenerationConfig(const std::filesystem::path& json_path) {
     read_json_param(data, "assistant_confidence_threshold", assistant_confidence_threshold);
     read_json_param(data, "num_assistant_tokens", num_assistant_tokens);
     read_json_param(data, "max_ngram_size", max_ngram_size);
+    read_json_param(data, "num_assistant_branches", num_assistant_branches);
 
     // append EOS to stop_token_ids
     if (eos_token_id != -1)
@@ -122,6 +123,10 @@ void GenerationConfig::update_generation_config(const ov::AnyMap& properties) {
     read_anymap_param(properties, "num_return_sequences", num_return_sequences);
     read_anymap_param(properties, "adapters", adapters);
     read_anymap_param(properties, "apply_chat_template", apply_chat_template);
+    read_anymap_param(properties, "structured_output_config", structured_output_config);
+    read_anymap_param(properties, "cache_eviction_config", cache_eviction_config);
+    read_anymap_param(properties, "priority", priority);
+    read_anymap_param(properties, "deadline_ms", deadline_ms);
 
     // penalties
     read_anymap_param(properties, "frequency_penalty", frequency_penalty);
@@ -148,6 +153,7 @@ void GenerationConfig::update_generation_config(const ov::AnyMap& properties) {
     read_anymap_param(properties, "assistant_confidence_threshold", assistant_confidence_threshold);
     read_anymap_param(properties, "num_assistant_tokens", num_assistant_tokens);
     read_anymap_param(properties, "max_ngram_size", max_ngram_size);
+    read_anymap_param(properties, "num_assistant_branches", num_assistant_branches);
 }
 
 size_t GenerationConfig::get_max_new_tokens(size_t prompt_length) const {
@@ -265,6 +271,24 @@ void GenerationConfig::validate() const {
     if (num_assistant_tokens == 0) {
         OPENVINO_ASSERT(max_ngram_size == 0, "'max_ngram_size' should be set to default value 0 when prompt lookup is disabled");
     }
+
+    OPENVINO_ASSERT(num_assistant_branches > 0, "'num_assistant_branches' must be greater than 0");
+    if (num_assistant_branches > 1) {
+        OPENVINO_ASSERT(is_prompt_lookup() && is_greedy_decoding(), "'num_assistant_branches' > 1 is supported only by prompt lookup decoding with greedy sampling");
+    }
+
+    // structured output
+
+    if (structured_output_config.has_value()) {
+        structured_output_config->validate();
+        OPENVINO_ASSERT(!is_beam_search(), "'structured_output_config' is not supported by beam search");
+    }
+}
+
+void StructuredOutputConfig::validate() const {
+    const size_t num_constraints = json_schema.has_value() + regex.has_value() + grammar.has_value();
+    OPENVINO_ASSERT(num_constraints == 1,
+                    "Exactly one of 'json_schema', 'regex' or 'grammar' should be set in 'structured_output_config', but got ", num_constraints);
 }
 
 GenerationConfig beam_search() {
@@ -42,9 +42,15 @@ void GenerationHandleImpl::cancel() {
 
 std::unordered_map<uint64_t, GenerationOutput> GenerationHandleImpl::read() {
     OPENVINO_ASSERT(!is_stopped() && !is_cancelled(), "GenerationHandle cannot be used after it is stopped / cancelled.");
+    OPENVINO_ASSERT(!m_generation_stream->has_output_callback(), "GenerationHandle outputs are passed to the output callback and cannot be read.");
     return m_generation_stream->read();
 }
 
+void GenerationHandleImpl::set_output_callback(std::function<void(GenerationOutputs, GenerationStatus)> callback) {
+    OPENVINO_ASSERT(callback, "Output callback must be set");
+    m_generation_stream->set_output_callback(std::move(callback));
+}
+
 void add_partial_result(std::unordered_map<uint64_t, GenerationOutput>& partial_results, std::unordered_map<uint64_t, GenerationOutput>& iteration_results) {
     for (auto& iteration_result: iteration_results) {
         auto partial_result_iter = partial_results.find(iteration_result.first);
@@ -65,6 +71,7 @@ void add_partial_result(std::unordered_map<uint64_t, GenerationOutput>& partial_
 
 std::vector<GenerationOutput> GenerationHandleImpl::read_all() {
     OPENVINO_ASSERT(!is_stopped() && !is_cancelled(), "GenerationHandle cannot be used after it is stopped / cancelled.");
+    OPENVINO_ASSERT(!m_generation_stream->has_output_callback(), "GenerationHandle outputs are passed to the output callback and cannot be read.");
     std::vector<GenerationOutput> results;
     std::unordered_map<uint64_t, GenerationOutput> partial_results;
     // We iterate until generation is running or there are tokens we haven't read yet
@@ -4,6 +4,8 @@
 #pragma once
 #include <mutex>
 #include <atomic>
+#include <deque>
+#include <functional>
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 #include "openvino/genai/generation_handle.hpp"
 #include "synchronized_queue.hpp"
@@ -13,6 +15,40 @@ class GenerationStream {
     std::mutex m_mutex;
     GenerationStatus m_status = GenerationStatus::RUNNING;
     SynchronizedQueue<GenerationOutputs> m_output_queue;
+    // if set, outputs are passed to the callback instead of the queue
+    std::mutex m_callback_mutex;
+    std::function<void(GenerationOutputs, GenerationStatus)> m_output_callback;
+    // outputs waiting to be passed to the callback. They are passed in order by a single thread at a time outside of
+    // m_callback_mutex, so the callback may call methods of the stream
+    std::deque<std::pair<GenerationOutputs, GenerationStatus>> m_pending_outputs;
+    bool m_is_delivering = false;
+    // whether outputs were pushed after generation had finished, i.e. the last outputs of the request
+    bool m_is_final_output_pushed = false;
+
+    // must be called by a thread which has set m_is_delivering
+    void deliver_pending_outputs() {
+        while (true) {
+            std::function<void(GenerationOutputs, GenerationStatus)> callback;
+            std::pair<GenerationOutputs, GenerationStatus> output;
+            {
+                std::lock_guard<std::mutex> lock(m_callback_mutex);
+                if (m_pending_outputs.empty()) {
+                    m_is_delivering = false;
+                    return;
+                }
+                output = std::move(m_pending_outputs.front());
+                m_pending_outputs.pop_front();
+                callback = m_output_callback;
+            }
+            try {
+                callback(std::move(output.first), output.second);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(m_callback_mutex);
+                m_is_delivering = false;
+                throw;
+            }
+        }
+    }
 
 public:
     using Ptr = std::shared_ptr<GenerationStream>;
@@ -25,7 +61,70 @@ public:
     }
 
     void push(GenerationOutputs outputs) {
-        m_output_queue.push(std::move(outputs));
+        {
+            std::lock_guard<std::mutex> lock(m_callback_mutex);
+            const GenerationStatus status = get_status();
+            m_is_final_output_pushed = status != GenerationStatus::RUNNING;
+            if (!m_output_callback) {
+                m_output_queue.push(std::move(outputs));
+                return;
+            }
+            m_pending_outputs.emplace_back(std::move(outputs), status);
+            // outputs are passed by the thread which is passing previous ones already
+            if (m_is_delivering) {
+                return;
+            }
+            m_is_delivering = true;
+        }
+        deliver_pending_outputs();
+    }
+
+    // Finishes a generation which cannot be continued: a running one gets IGNORED status, and empty outputs are pushed
+    // to wake readers up and pass the final status to the callback, unless the last outputs have been pushed already
+    void abort() {
+        {
+            std::lock_guard<std::mutex> lock(m_callback_mutex);
+            if (m_is_final_output_pushed) {
+                return;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_status == GenerationStatus::RUNNING) {
+                m_status = GenerationStatus::IGNORED;
+            }
+        }
+        push({});
+    }
+
+    void set_output_callback(std::function<void(GenerationOutputs, GenerationStatus)> callback) {
+        {
+            std::lock_guard<std::mutex> lock(m_callback_mutex);
+            // outputs pushed before the callback is set are passed to it in order, only the last ones get the final status.
+            // If they have been read already, the callback gets the final status with empty outputs
+            std::vector<GenerationOutputs> pushed_outputs;
+            while (!m_output_queue.empty()) {
+                pushed_outputs.push_back(m_output_queue.pull());
+            }
+            const GenerationStatus status = m_is_final_output_pushed ? get_status() : GenerationStatus::RUNNING;
+            for (size_t i = 0; i < pushed_outputs.size(); ++i) {
+                m_pending_outputs.emplace_back(std::move(pushed_outputs[i]), i + 1 == pushed_outputs.size() ? status : GenerationStatus::RUNNING);
+            }
+            if (pushed_outputs.empty() && !m_output_callback && m_is_final_output_pushed) {
+                m_pending_outputs.emplace_back(GenerationOutputs{}, status);
+            }
+            m_output_callback = std::move(callback);
+            if (m_is_delivering || m_pending_outputs.empty()) {
+                return;
+            }
+            m_is_delivering = true;
+        }
+        deliver_pending_outputs();
+    }
+
+    bool has_output_callback() {
+        std::lock_guard<std::mutex> lock(m_callback_mutex);
+        return static_cast<bool>(m_output_callback);
     }
 
     GenerationOutputs read() {
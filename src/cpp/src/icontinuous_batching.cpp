@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "icontinuous_batching.hpp"
+#include "tracing.hpp"
 
 namespace ov::genai {
 
@@ -10,6 +11,10 @@ GenerationConfig ContinuousBatchingPipeline::IContinuousBatchingPipeline::get_co
 }
 
 PipelineMetrics ContinuousBatchingPipeline::IContinuousBatchingPipeline::get_metrics() const {
+    return m_pipeline_metrics->get();
+}
+
+std::shared_ptr<PipelineMetricsCollector> ContinuousBatchingPipeline::IContinuousBatchingPipeline::get_metrics_collector() const {
     return m_pipeline_metrics;
 }
 
@@ -38,23 +43,22 @@ ContinuousBatchingPipeline::IContinuousBatchingPipeline::generate(
     auto start_time =  std::chrono::steady_clock::now();
 
     std::vector<MicroSeconds> tokenization_durations;
-    static ManualTimer timer("tokenize");
     if (m_is_chat_conversation) {
         OPENVINO_ASSERT(1 == prompts.size(), "Can't chat with multiple prompts");
         m_history.push_back({{"role", "user"}, {"content", prompts.at(0)}});
         constexpr bool add_generation_prompt = true;
         std::string history = m_tokenizer.apply_chat_template(m_history, add_generation_prompt);
-        timer.start();
+        TraceSpan tokenize_span("tokenize");
         const auto encode_start = std::chrono::steady_clock::now();
         // ov::genai::add_special_tokens(false) is aligned with stateful pipeline
         input_ids.push_back(m_tokenizer.encode(history, ov::genai::add_special_tokens(false)).input_ids);
         tokenization_durations.emplace_back(PerfMetrics::get_microsec(std::chrono::steady_clock::now() - encode_start));
-        timer.end();
+        tokenize_span.arg("prompt_tokens", input_ids.back().get_size());
     } else {
         input_ids.reserve(prompts.size());
-        timer.start();
         for (size_t i = 0; i < prompts.size(); i++) {
             const std::string& prompt = prompts.at(i);
+            TraceSpan tokenize_span("tokenize");
             const auto encode_start = std::chrono::steady_clock::now();
             ov::Tensor encoded_inputs;
             if (sampling_params.at(i).apply_chat_template && !m_tokenizer.get_chat_template().empty()) {
@@ -69,8 +73,8 @@ ContinuousBatchingPipeline::IContinuousBatchingPipeline::generate(
             }
             input_ids.push_back(encoded_inputs);
             tokenization_durations.emplace_back(PerfMetrics::get_microsec(std::chrono::steady_clock::now() - encode_start));
+            tokenize_span.arg("prompt_tokens", encoded_inputs.get_size());
         }
-        timer.end();
     }
 
     std::vector<EncodedGenerationResult> encoded = generate(input_ids, sampling_params, streamer);
@@ -86,6 +90,8 @@ ContinuousBatchingPipeline::IContinuousBatchingPipeline::generate(
         std::vector<std::string> generated;
         generated.reserve(res.m_generation_ids.size());
         for (size_t idx = 0; idx < res.m_generation_ids.size(); ++idx) {
+            TraceSpan detokenize_span("detokenize");
+            detokenize_span.arg("generated_tokens", res.m_generation_ids.at(idx).size());
             const auto decode_start = std::chrono::steady_clock::now();
             generated.push_back(m_tokenizer.decode(res.m_generation_ids.at(idx)));
             raw_counters.detokenization_durations.emplace_back(std::chrono::steady_clock::now() - decode_start);
@@ -117,6 +123,120 @@ ContinuousBatchingPipeline::IContinuousBatchingPipeline::generate(
     return decoded;
 }
 
+ov::Tensor ContinuousBatchingPipeline::IContinuousBatchingPipeline::get_inputs_embeds(
+    const std::string& prompt,
+    const std::vector<ov::Tensor>& rgbs,
+    const GenerationConfig& sampling_params,
+    VLMPerfMetrics& metrics) {
+    OPENVINO_ASSERT(m_inputs_embedder, "Images are supported only by pipelines created from VLM models");
+    OPENVINO_ASSERT(!sampling_params.echo, "'echo' is not supported for requests with images");
+
+    std::lock_guard<std::mutex> lock{m_inputs_embedder_mutex};
+    m_inputs_embedder->set_apply_chat_template_status(sampling_params.apply_chat_template);
+    const ov::Tensor inputs_embeds = m_inputs_embedder->get_inputs_embeds(prompt, rgbs, metrics);
+    // requests are independent, so tokens must not be accumulated in the embedder between them
+    m_inputs_embedder->get_kv_cache_state().reset_state();
+
+    // output of InputsEmbedder can be overwritten by its next call
+    ov::Tensor inputs_embeds_copy(inputs_embeds.get_element_type(), inputs_embeds.get_shape());
+    inputs_embeds.copy_to(inputs_embeds_copy);
+    return inputs_embeds_copy;
+}
+
+GenerationHandle ContinuousBatchingPipeline::IContinuousBatchingPipeline::add_request(
+    uint64_t request_id,
+    const std::string& prompt,
+    const std::vector<ov::Tensor>& rgbs,
+    GenerationConfig sampling_params) {
+    VLMPerfMetrics metrics;
+    ov::Tensor inputs_embeds = get_inputs_embeds(prompt, rgbs, sampling_params, metrics);
+    return add_request(request_id, inputs_embeds, sampling_params);
+}
+
+std::vector<VLMDecodedResults>
+ContinuousBatchingPipeline::IContinuousBatchingPipeline::generate(
+    const std::vector<std::string>& prompts,
+    const std::vector<std::vector<ov::Tensor>>& rgbs,
+    const std::vector<GenerationConfig>& sampling_params,
+    const StreamerVariant& streamer) {
+    OPENVINO_ASSERT(m_inputs_embedder, "Images are supported only by pipelines created from VLM models");
+    OPENVINO_ASSERT(!m_is_chat_conversation, "Chat mode is not supported for requests with images");
+    OPENVINO_ASSERT(prompts.size() == rgbs.size() && prompts.size() == sampling_params.size(),
+        "Number of prompts, images and generation configs must be the same");
+    auto start_time = std::chrono::steady_clock::now();
+
+    // images of all prompts are encoded together in batched vision encoder inferences,
+    // so embeddings of each prompt below take prefetched image embeddings
+    float batched_encoding_duration = 0.0f;
+    if (prompts.size() > 1) {
+        const auto encoding_start = std::chrono::steady_clock::now();
+        std::vector<ov::Tensor> all_rgbs;
+        for (const std::vector<ov::Tensor>& prompt_rgbs : rgbs) {
+            all_rgbs.insert(all_rgbs.end(), prompt_rgbs.begin(), prompt_rgbs.end());
+        }
+        std::lock_guard<std::mutex> lock{m_inputs_embedder_mutex};
+        m_inputs_embedder->prefetch_image_embeddings(all_rgbs);
+        batched_encoding_duration = PerfMetrics::get_microsec(std::chrono::steady_clock::now() - encoding_start);
+    }
+
+    std::vector<ov::Tensor> inputs_embeds;
+    std::vector<VLMPerfMetrics> embeddings_metrics(prompts.size());
+    std::vector<MicroSeconds> prepare_embeddings_durations;
+    inputs_embeds.reserve(prompts.size());
+    try {
+        for (size_t i = 0; i < prompts.size(); ++i) {
+            const auto embeddings_start = std::chrono::steady_clock::now();
+            inputs_embeds.push_back(get_inputs_embeds(prompts[i], rgbs[i], sampling_params[i], embeddings_metrics[i]));
+            prepare_embeddings_durations.emplace_back(PerfMetrics::get_microsec(std::chrono::steady_clock::now() - embeddings_start)
+                + batched_encoding_duration / prompts.size());
+        }
+    } catch (...) {
+        std::lock_guard<std::mutex> lock{m_inputs_embedder_mutex};
+        m_inputs_embedder->release_prefetched_image_embeddings();
+        throw;
+    }
+    {
+        std::lock_guard<std::mutex> lock{m_inputs_embedder_mutex};
+        m_inputs_embedder->release_prefetched_image_embeddings();
+    }
+
+    std::vector<EncodedGenerationResult> encoded = generate(inputs_embeds, sampling_params, streamer);
+
+    std::vector<VLMDecodedResults> decoded;
+    decoded.reserve(encoded.size());
+    for (size_t i = 0; i < encoded.size(); ++i) {
+        EncodedGenerationResult& res = encoded[i];
+        VLMDecodedResults result;
+        result.perf_metrics = VLMPerfMetrics(res.perf_metrics);
+        auto& raw_counters = result.perf_metrics.raw_metrics;
+        const auto& embeddings_tokenization_durations = embeddings_metrics[i].raw_metrics.tokenization_durations;
+        raw_counters.tokenization_durations.insert(raw_counters.tokenization_durations.end(),
+            embeddings_tokenization_durations.begin(), embeddings_tokenization_durations.end());
+
+        for (size_t idx = 0; idx < res.m_generation_ids.size(); ++idx) {
+            TraceSpan detokenize_span("detokenize");
+            detokenize_span.arg("generated_tokens", res.m_generation_ids.at(idx).size());
+            const auto decode_start = std::chrono::steady_clock::now();
+            result.texts.push_back(m_tokenizer.decode(res.m_generation_ids.at(idx)));
+            raw_counters.detokenization_durations.emplace_back(std::chrono::steady_clock::now() - decode_start);
+        }
+        result.scores = std::move(res.m_scores);
+
+        // VLM specific perf metrics
+        result.perf_metrics.vlm_raw_metrics.prepare_embeddings_durations.emplace_back(prepare_embeddings_durations[i]);
+
+        // The same perf metrics for each sequence, only tokenization/detokenization will differ.
+        raw_counters.generate_durations.clear();
+        raw_counters.generate_durations.emplace_back(PerfMetrics::get_microsec(std::chrono::steady_clock::now() - start_time));
+        result.perf_metrics.m_evaluated = false;
+        result.perf_metrics.evaluate_statistics(start_time);
+
+        decoded.push_back(std::move(result));
+    }
+
+    return decoded;
+}
+
 void ContinuousBatchingPipeline::IContinuousBatchingPipeline::stream_tokens(
     const std::shared_ptr<ThreadedStreamerWrapper>& streamer_ptr,
     const GenerationHandle& handle
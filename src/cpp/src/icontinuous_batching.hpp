@@ -8,8 +8,10 @@
 #include "cache_manager.hpp"
 #include "sampler.hpp"
 #include "model_runner.hpp"
+#include "pipeline_metrics_collector.hpp"
 #include "scheduler.hpp"
 #include "threaded_streamer.hpp"
+#include "visual_language/inputs_embedder.hpp"
 
 namespace ov::genai {
 
@@ -24,7 +26,7 @@ protected:
     // and pipeline only uses default rng_seed and some special tokens.
     GenerationConfig m_generation_config;
 
-    PipelineMetrics m_pipeline_metrics;
+    std::shared_ptr<PipelineMetricsCollector> m_pipeline_metrics = std::make_shared<PipelineMetricsCollector>();
 
     struct PerfTime {
         float m_paged_attention_time_ms = 0.0f;
@@ -43,14 +45,32 @@ protected:
     bool m_is_chat_conversation = false;
     ChatHistory m_history;
 
+    // set for VLMs: computes prompt embeddings from text and images
+    std::shared_ptr<InputsEmbedder> m_inputs_embedder;
+    // InputsEmbedder is stateful and add_request can be called from different threads
+    std::mutex m_inputs_embedder_mutex;
+
     float m_load_time_ms = 0.0f;
     // to access m_load_time_ms
     friend class ContinuousBatchingPipeline;
 
     void stream_tokens(const std::shared_ptr<ThreadedStreamerWrapper>& streamer_ptr, const GenerationHandle& handle);
+
+    /**
+     * Computes embeddings of a prompt with images using InputsEmbedder
+     */
+    ov::Tensor get_inputs_embeds(const std::string& prompt,
+                                 const std::vector<ov::Tensor>& rgbs,
+                                 const GenerationConfig& sampling_params,
+                                 VLMPerfMetrics& metrics);
 public:
     GenerationConfig get_config() const;
     PipelineMetrics get_metrics() const;
+
+    /**
+     * Allows pipelines on top of this one to report their metrics to the same collector
+     */
+    std::shared_ptr<PipelineMetricsCollector> get_metrics_collector() const;
     Tokenizer get_tokenizer();
 
     /**
@@ -68,6 +88,15 @@ public:
                                          const std::string& prompt,
                                          GenerationConfig sampling_params) = 0;
     
+    /**
+     * Adds request with a prompt and images to awaiting queue
+     * This step also computes embeddings of images and text with InputsEmbedder, so it's supported by VLMs only
+     */
+    GenerationHandle add_request(uint64_t request_id,
+                                 const std::string& prompt,
+                                 const std::vector<ov::Tensor>& rgbs,
+                                 GenerationConfig sampling_params);
+
     /**
      * Checks whether server (pipeline) has non-finished requests and step() should be called within a loop
      */
@@ -78,6 +107,12 @@ public:
      */
     virtual void step() = 0;
 
+    /**
+     * Removes running and awaiting requests from the pipeline after a failed step. Their handles get IGNORED status
+     * and empty outputs, so readers and output callbacks are not left waiting
+     */
+    virtual void drop_requests() = 0;
+
     /**
      * Performs monolitic generation based on encoded prompts
      */
@@ -94,6 +129,15 @@ public:
              std::vector<GenerationConfig> sampling_params,
              const StreamerVariant& streamer);
 
+    /**
+     * Performs monolitic generation based on text prompts and images, supported by VLMs only
+     */
+    std::vector<VLMDecodedResults>
+    generate(const std::vector<std::string>& prompts,
+             const std::vector<std::vector<ov::Tensor>>& rgbs,
+             const std::vector<GenerationConfig>& sampling_params,
+             const StreamerVariant& streamer);
+
     /**
      * Starts chat with a given system prompt
      * 
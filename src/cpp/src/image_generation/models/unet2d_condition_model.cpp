@@ -4,6 +4,7 @@
 #include "openvino/genai/image_generation/unet2d_condition_model.hpp"
 #include "image_generation/models/unet_inference_dynamic.hpp"
 #include "image_generation/models/unet_inference_static_bs1.hpp"
+#include "image_generation/models/unet_inference_parallel_cfg.hpp"
 
 #include <fstream>
 
@@ -79,14 +80,24 @@ UNet2DConditionModel& UNet2DConditionModel::reshape(int batch_size, int height,
 UNet2DConditionModel& UNet2DConditionModel::compile(const std::string& device, const ov::AnyMap& properties) {
     OPENVINO_ASSERT(m_model, "Model has been already compiled. Cannot re-compile already compiled model");
 
+    std::optional<AdapterConfig> adapters;
+    auto filtered_properties = extract_adapters_from_properties(properties, &adapters);
+
+    bool is_parallel_cfg = false;
+    auto parallel_cfg_it = filtered_properties->find(ov::genai::parallel_cfg.name());
+    if (parallel_cfg_it != filtered_properties->end()) {
+        is_parallel_cfg = parallel_cfg_it->second.as<bool>();
+        filtered_properties.fork().erase(ov::genai::parallel_cfg.name());
+    }
+
     if (device == "NPU") {
         m_impl = std::make_shared<UNet2DConditionModel::UNetInferenceStaticBS1>();
+    } else if (is_parallel_cfg) {
+        m_impl = std::make_shared<UNet2DConditionModel::UNetInferenceParallelCFG>();
     } else {
         m_impl = std::make_shared<UNet2DConditionModel::UNetInferenceDynamic>();
     }
 
-    std::optional<AdapterConfig> adapters;
-    auto filtered_properties = extract_adapters_from_properties(properties, &adapters);
     if (adapters) {
         adapters->set_tensor_name_prefix(adapters->get_tensor_name_prefix().value_or("lora_unet"));
         m_adapter_controller = AdapterController(m_model, *adapters, device);
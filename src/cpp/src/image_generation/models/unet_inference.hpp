@@ -14,6 +14,8 @@ public:
     virtual void compile(std::shared_ptr<ov::Model> model, const std::string& device, const ov::AnyMap& properties) = 0;
     virtual void set_hidden_states(const std::string& tensor_name, ov::Tensor encoder_hidden_states) = 0;
     virtual void set_adapters(AdapterController& adapter_controller, const AdapterConfig& adapters) = 0;
+    // 'sample' can have half of a batch size of hidden states, which means that classifier-free guidance
+    // is truncated and only conditional (second) half of hidden states must be used
     virtual ov::Tensor infer(ov::Tensor sample, ov::Tensor timestep) = 0;
 
     // utility function to resize model given optional dimensions.
@@ -62,6 +64,15 @@ public:
 
         model->reshape(name_to_shape);
     }
+
+protected:
+    // wraps a [begin, end) range of a batch dimension as a separate tensor without a copy
+    static ov::Tensor get_batch_slice(ov::Tensor tensor, size_t begin, size_t end) {
+        ov::Shape slice_shape = tensor.get_shape();
+        slice_shape[0] = end - begin;
+        char* slice_data = static_cast<char*>(tensor.data()) + begin * tensor.get_strides()[0];
+        return ov::Tensor(tensor.get_element_type(), slice_shape, slice_data, tensor.get_strides());
+    }
 };
 
 }  // namespace genai
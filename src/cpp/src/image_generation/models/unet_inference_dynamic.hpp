@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <map>
+
 #include "image_generation/models/unet_inference.hpp"
 #include "lora_helper.hpp"
 #include "utils.hpp"
@@ -13,6 +15,9 @@ namespace genai {
 class UNet2DConditionModel::UNetInferenceDynamic : public UNet2DConditionModel::UNetInference {
 public:
     virtual void compile(std::shared_ptr<ov::Model> model, const std::string& device, const ov::AnyMap& properties) override {
+        // model reshaped to a static classifier-free guidance batch cannot infer a half of it
+        m_is_static_batch = model->input("sample").get_partial_shape()[0].is_static();
+
         ov::CompiledModel compiled_model = utils::singleton_core().compile_model(model, device, properties);
         ov::genai::utils::print_compiled_model_properties(compiled_model, "UNet 2D Condition dynamic model");
         m_request = compiled_model.create_infer_request();
@@ -21,6 +26,8 @@ public:
     virtual void set_hidden_states(const std::string& tensor_name, ov::Tensor encoder_hidden_states) override {
         OPENVINO_ASSERT(m_request, "UNet model must be compiled first");
         m_request.set_tensor(tensor_name, encoder_hidden_states);
+        m_hidden_states[tensor_name] = encoder_hidden_states;
+        m_conditional_only = false;
     }
 
     virtual void set_adapters(AdapterController &adapter_controller, const AdapterConfig& adapters) override {
@@ -31,6 +38,40 @@ public:
     virtual ov::Tensor infer(ov::Tensor sample, ov::Tensor timestep) override {
         OPENVINO_ASSERT(m_request, "UNet model must be compiled first. Cannot infer non-compiled model");
 
+        // in case of truncated classifier-free guidance, only conditional half of hidden states is used
+        const size_t batch_size = sample.get_shape()[0];
+        auto encoder_hidden_states_it = m_hidden_states.find("encoder_hidden_states");
+        const bool conditional_only = encoder_hidden_states_it != m_hidden_states.end() &&
+            encoder_hidden_states_it->second.get_shape()[0] == 2 * batch_size;
+
+        if (conditional_only && m_is_static_batch) {
+            // static model still computes both branches, so sample is duplicated and unconditional half of output is dropped
+            ov::Shape cfg_sample_shape = sample.get_shape();
+            cfg_sample_shape[0] *= 2;
+            if (!m_cfg_sample || m_cfg_sample.get_shape() != cfg_sample_shape) {
+                m_cfg_sample = ov::Tensor(sample.get_element_type(), cfg_sample_shape);
+            }
+            sample.copy_to(get_batch_slice(m_cfg_sample, 0, batch_size));
+            sample.copy_to(get_batch_slice(m_cfg_sample, batch_size, 2 * batch_size));
+
+            return get_batch_slice(run_inference(m_cfg_sample, timestep, false), batch_size, 2 * batch_size);
+        }
+
+        return run_inference(sample, timestep, conditional_only);
+    }
+
+private:
+    ov::Tensor run_inference(ov::Tensor sample, ov::Tensor timestep, bool conditional_only) {
+        if (conditional_only != m_conditional_only) {
+            const size_t batch_size = sample.get_shape()[0];
+            for (const auto& [tensor_name, hidden_states] : m_hidden_states) {
+                const size_t hidden_states_bs = hidden_states.get_shape()[0];
+                m_request.set_tensor(tensor_name, conditional_only && hidden_states_bs == 2 * batch_size ?
+                    get_batch_slice(hidden_states, batch_size, hidden_states_bs) : hidden_states);
+            }
+            m_conditional_only = conditional_only;
+        }
+
         m_request.set_tensor("sample", sample);
         m_request.set_tensor("timestep", timestep);
 
@@ -39,8 +80,12 @@ public:
         return m_request.get_output_tensor();
     }
 
-private:
     ov::InferRequest m_request;
+    std::map<std::string, ov::Tensor> m_hidden_states;
+    bool m_conditional_only = false;
+    bool m_is_static_batch = false;
+    // doubled sample for truncated guidance steps of a static model
+    ov::Tensor m_cfg_sample;
 };
 
 }  // namespace genai
@@ -0,0 +1,144 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <map>
+
+#include "image_generation/models/unet_inference.hpp"
+#include "lora_helper.hpp"
+#include "utils.hpp"
+
+namespace ov {
+namespace genai {
+
+// Parallel classifier-free guidance variant of UNetInference.
+// Instead of a single inference with doubled batch, unconditional and conditional halves of the batch
+// are inferred concurrently on two infer requests, each running on its own stream with half of the device cores.
+class UNet2DConditionModel::UNetInferenceParallelCFG : public UNet2DConditionModel::UNetInference {
+public:
+    virtual void compile(std::shared_ptr<ov::Model> model, const std::string& device, const ov::AnyMap& properties) override {
+        // if the model has been reshaped to a static CFG batch, each request processes only half of it
+        const ov::PartialShape sample_shape = model->input("sample").get_partial_shape();
+        if (sample_shape[0].is_static() && sample_shape[0].get_length() % 2 == 0) {
+            UNetInference::reshape(model, sample_shape[0].get_length() / 2);
+        }
+
+        ov::AnyMap branch_properties = properties;
+        if (device == "CPU") {
+            // two streams split CPU cores in halves; explicit user value has higher priority
+            branch_properties.insert(ov::num_streams(2));
+        }
+
+        ov::CompiledModel compiled_model = utils::singleton_core().compile_model(model, device, branch_properties);
+        ov::genai::utils::print_compiled_model_properties(compiled_model, "UNet 2D Condition parallel CFG model");
+
+        for (auto& request : m_requests) {
+            request = compiled_model.create_infer_request();
+        }
+    }
+
+    virtual void set_hidden_states(const std::string& tensor_name, ov::Tensor encoder_hidden_states) override {
+        OPENVINO_ASSERT(m_requests[0], "UNet model must be compiled first");
+        m_hidden_states[tensor_name] = encoder_hidden_states;
+        // hidden states are bound to requests lazily, once batch layout of 'sample' is known
+        m_bound_mode = Mode::UNDEFINED;
+    }
+
+    virtual void set_adapters(AdapterController& adapter_controller, const AdapterConfig& adapters) override {
+        OPENVINO_ASSERT(m_requests[0], "UNet model must be compiled first");
+        for (auto& request : m_requests) {
+            adapter_controller.apply(request, adapters);
+        }
+    }
+
+    virtual ov::Tensor infer(ov::Tensor sample, ov::Tensor timestep) override {
+        OPENVINO_ASSERT(m_requests[0], "UNet model must be compiled first. Cannot infer non-compiled model");
+
+        const size_t batch_size = sample.get_shape()[0];
+        const size_t hidden_states_batch_size = get_hidden_states_batch_size();
+
+        Mode mode = Mode::FULL;
+        if (hidden_states_batch_size == 2 * batch_size) {
+            mode = Mode::CONDITIONAL_ONLY;
+        } else if (batch_size == hidden_states_batch_size && batch_size % 2 == 0) {
+            mode = Mode::SPLIT;
+        }
+
+        if (mode != m_bound_mode) {
+            bind_hidden_states(mode, batch_size);
+            m_bound_mode = mode;
+        }
+
+        ov::Tensor out_sample(sample.get_element_type(), sample.get_shape());
+
+        if (mode == Mode::SPLIT) {
+            const size_t half_batch_size = batch_size / 2;
+            for (size_t i = 0; i < m_requests.size(); ++i) {
+                const size_t begin = i * half_batch_size, end = begin + half_batch_size;
+                m_requests[i].set_tensor("timestep", timestep);
+                m_requests[i].set_tensor("sample", get_batch_slice(sample, begin, end));
+                m_requests[i].set_output_tensor(get_batch_slice(out_sample, begin, end));
+                m_requests[i].start_async();
+            }
+
+            for (auto& request : m_requests) {
+                request.wait();
+            }
+        } else {
+            // the whole batch is processed by a single request: either CFG is disabled or truncated,
+            // so only conditional branch is computed
+            ov::InferRequest& request = mode == Mode::CONDITIONAL_ONLY ? m_requests[1] : m_requests[0];
+            request.set_tensor("timestep", timestep);
+            request.set_tensor("sample", sample);
+            request.set_output_tensor(out_sample);
+            request.infer();
+        }
+
+        return out_sample;
+    }
+
+private:
+    enum class Mode {
+        UNDEFINED,
+        // whole batch on the first request
+        FULL,
+        // first half of batch (unconditional) on the first request, second half (conditional) on the second one
+        SPLIT,
+        // only conditional half of hidden states is used on the second request
+        CONDITIONAL_ONLY
+    };
+
+    size_t get_hidden_states_batch_size() const {
+        auto it = m_hidden_states.find("encoder_hidden_states");
+        OPENVINO_ASSERT(it != m_hidden_states.end(), "UNetInferenceParallelCFG: 'encoder_hidden_states' must be set before inference");
+        return it->second.get_shape()[0];
+    }
+
+    void bind_hidden_states(Mode mode, size_t batch_size) {
+        for (const auto& [tensor_name, hidden_states] : m_hidden_states) {
+            const size_t hidden_states_bs = hidden_states.get_shape()[0];
+
+            if (mode == Mode::SPLIT && hidden_states_bs == batch_size) {
+                const size_t half_batch_size = batch_size / 2;
+                m_requests[0].set_tensor(tensor_name, get_batch_slice(hidden_states, 0, half_batch_size));
+                m_requests[1].set_tensor(tensor_name, get_batch_slice(hidden_states, half_batch_size, batch_size));
+            } else if (mode == Mode::CONDITIONAL_ONLY && hidden_states_bs == 2 * batch_size) {
+                m_requests[1].set_tensor(tensor_name, get_batch_slice(hidden_states, batch_size, hidden_states_bs));
+            } else {
+                // tensors without batch semantic (e.g. 'timestep_cond') are shared between requests
+                for (auto& request : m_requests) {
+                    request.set_tensor(tensor_name, hidden_states);
+                }
+            }
+        }
+    }
+
+    std::array<ov::InferRequest, 2> m_requests;
+    std::map<std::string, ov::Tensor> m_hidden_states;
+    Mode m_bound_mode = Mode::UNDEFINED;
+};
+
+}  // namespace genai
+}  // namespace ov
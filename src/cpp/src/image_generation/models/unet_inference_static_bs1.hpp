@@ -92,8 +92,12 @@ public:
         OPENVINO_ASSERT(m_native_batch_size && m_native_batch_size == m_requests.size(),
                         "UNet model must be compiled first");
 
-        OPENVINO_ASSERT(sample.get_shape()[0] == m_native_batch_size,
+        // in case of truncated classifier-free guidance, sample has half of native batch size
+        // and only requests of the conditional (second) half are used
+        const size_t batch_size = sample.get_shape()[0];
+        OPENVINO_ASSERT(batch_size == m_native_batch_size || 2 * batch_size == m_native_batch_size,
                         "sample batch size must match native batch size");
+        const size_t first_request = m_native_batch_size - batch_size;
 
         char* pSample = (char*)sample.data();
         size_t sample_batch_stride_bytes = sample.get_strides()[0];
@@ -105,7 +109,7 @@ public:
         auto bs1_sample_shape = sample.get_shape();
         bs1_sample_shape[0] = 1;
 
-        for (int i = 0; i < m_native_batch_size; i++) {
+        for (size_t i = first_request; i < m_native_batch_size; i++) {
             m_requests[i].set_tensor("timestep", timestep);
 
             //wrap a portion of sample tensor as a batch-1 tensor, as set this as input tensor.
@@ -128,7 +132,7 @@ public:
             m_requests[i].start_async();
         }
 
-        for (int i = 0; i < m_native_batch_size; i++) {
+        for (size_t i = first_request; i < m_native_batch_size; i++) {
             // wait for infer to complete.
             m_requests[i].wait();
         }
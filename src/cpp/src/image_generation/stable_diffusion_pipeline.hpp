@@ -81,6 +81,7 @@ public:
         set_scheduler(Scheduler::from_config(root_dir / "scheduler/scheduler_config.json"));
 
         auto updated_properties = update_adapters_in_properties(properties, &DiffusionPipeline::derived_adapters);
+        const ov::AnyMap unet_properties = extract_unet_properties(updated_properties);
 
         const std::string text_encoder = data["text_encoder"][1].get<std::string>();
         if (text_encoder == "CLIPTextModel") {
@@ -91,7 +92,7 @@ public:
 
         const std::string unet = data["unet"][1].get<std::string>();
         if (unet == "UNet2DConditionModel") {
-            m_unet = std::make_shared<UNet2DConditionModel>(root_dir / "unet", device, *updated_properties);
+            m_unet = std::make_shared<UNet2DConditionModel>(root_dir / "unet", device, unet_properties);
         } else {
             OPENVINO_THROW("Unsupported '", unet, "' UNet type");
         }
@@ -154,9 +155,10 @@ public:
     void compile(const std::string& device, const ov::AnyMap& properties) override {
         update_adapters_from_properties(properties, m_generation_config.adapters);
         auto updated_properties = update_adapters_in_properties(properties, &DiffusionPipeline::derived_adapters);
+        const ov::AnyMap unet_properties = extract_unet_properties(updated_properties);
 
         m_clip_text_encoder->compile(device, *updated_properties);
-        m_unet->compile(device, *updated_properties);
+        m_unet->compile(device, unet_properties);
         m_vae->compile(device, *updated_properties);
     }
 
@@ -318,9 +320,23 @@ public:
 
         for (size_t inference_step = 0; inference_step < timesteps.size(); inference_step++) {
             auto step_start = std::chrono::steady_clock::now();
+
+            // after truncation step, UNet computes only conditional branch
+            const bool is_cfg_truncated = batch_size_multiplier > 1 && generation_config.cfg_truncation_step >= 0 &&
+                inference_step >= static_cast<size_t>(generation_config.cfg_truncation_step);
+            const size_t step_batch_size_multiplier = is_cfg_truncated ? 1 : batch_size_multiplier;
+            if (is_cfg_truncated && latent_cfg.get_shape()[0] != latent.get_shape()[0]) {
+                latent_cfg.set_shape(latent.get_shape());
+                if (is_inpainting_model()) {
+                    // all batch elements of mask and masked image latent are the same, so the first ones can be taken
+                    mask = take_batch(mask, generation_config.num_images_per_prompt);
+                    masked_image_latent = take_batch(masked_image_latent, generation_config.num_images_per_prompt);
+                }
+            }
+
             numpy_utils::batch_copy(latent, latent_cfg, 0, 0, generation_config.num_images_per_prompt);
             // concat the same latent twice along a batch dimension in case of CFG
-            if (batch_size_multiplier > 1) {
+            if (step_batch_size_multiplier > 1) {
                 numpy_utils::batch_copy(latent, latent_cfg, 0, generation_config.num_images_per_prompt, generation_config.num_images_per_prompt);
             }
 
@@ -334,9 +350,9 @@ public:
             m_perf_metrics.raw_metrics.unet_inference_durations.emplace_back(MicroSeconds(infer_duration));
 
             ov::Shape noise_pred_shape = noise_pred_tensor.get_shape();
-            noise_pred_shape[0] /= batch_size_multiplier;
+            noise_pred_shape[0] /= step_batch_size_multiplier;
 
-            if (batch_size_multiplier > 1) {
+            if (step_batch_size_multiplier > 1) {
                 noisy_residual_tensor.set_shape(noise_pred_shape);
 
                 // perform guidance
@@ -403,6 +419,23 @@ protected:
         return m_unet->get_config().in_channels;
     }
 
+    // 'parallel_cfg' property is consumed by UNet only and must not be passed to other models
+    static ov::AnyMap extract_unet_properties(utils::SharedOptional<const ov::AnyMap>& properties) {
+        ov::AnyMap unet_properties = *properties;
+        if (properties->find(ov::genai::parallel_cfg.name()) != properties->end()) {
+            properties.fork().erase(ov::genai::parallel_cfg.name());
+        }
+        return unet_properties;
+    }
+
+    static ov::Tensor take_batch(ov::Tensor tensor, size_t batch_size) {
+        ov::Shape shape = tensor.get_shape();
+        shape[0] = batch_size;
+        ov::Tensor result(tensor.get_element_type(), shape);
+        numpy_utils::batch_copy(tensor, result, 0, 0, batch_size);
+        return result;
+    }
+
     void compute_dim(int64_t & generation_config_value, ov::Tensor initial_image, int dim_idx) {
         const size_t vae_scale_factor = m_vae->get_vae_scale_factor();
         const auto& unet_config = m_unet->get_config();
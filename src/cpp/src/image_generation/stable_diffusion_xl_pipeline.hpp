@@ -45,6 +45,7 @@ public:
         set_scheduler(Scheduler::from_config(root_dir / "scheduler/scheduler_config.json"));
 
         auto updated_properties = update_adapters_in_properties(properties, &DiffusionPipeline::derived_adapters);
+        const ov::AnyMap unet_properties = extract_unet_properties(updated_properties);
         // updated_properies are for passing to the pipeline subcomponents only, not for the generation config
 
         const std::string text_encoder = data["text_encoder"][1].get<std::string>();
@@ -71,7 +72,7 @@ public:
 
         const std::string unet = data["unet"][1].get<std::string>();
         if (unet == "UNet2DConditionModel") {
-            m_unet = std::make_shared<UNet2DConditionModel>(root_dir / "unet", device, *updated_properties);
+            m_unet = std::make_shared<UNet2DConditionModel>(root_dir / "unet", device, unet_properties);
         } else {
             OPENVINO_THROW("Unsupported '", unet, "' UNet type");
         }
@@ -140,11 +141,12 @@ public:
     void compile(const std::string& device, const ov::AnyMap& properties) override {
         update_adapters_from_properties(properties, m_generation_config.adapters);
         auto updated_properties = update_adapters_in_properties(properties, &DiffusionPipeline::derived_adapters);
+        const ov::AnyMap unet_properties = extract_unet_properties(updated_properties);
         // updated_properies are for passing to the pipeline subcomponents only, not for the generation config
 
         m_clip_text_encoder->compile(device, *updated_properties);
         m_clip_text_encoder_with_projection->compile(device, *updated_properties);
-        m_unet->compile(device, *updated_properties);
+        m_unet->compile(device, unet_properties);
         m_vae->compile(device, *updated_properties);
     }
 
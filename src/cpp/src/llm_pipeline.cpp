@@ -40,13 +40,23 @@ std::pair<ov::AnyMap, std::string> extract_attention_backend(const ov::AnyMap& e
     ov::AnyMap properties = external_properties;
 
     auto it = properties.find("ATTENTION_BACKEND");
-    if (it != properties.end()) {
+    const bool is_attention_backend_set = it != properties.end();
+    if (is_attention_backend_set) {
         attention_backend = it->second.as<std::string>();
         OPENVINO_ASSERT(attention_backend == PA_BACKEND || attention_backend == SDPA_BACKEND,
             "Attention backend must be either '", PA_BACKEND, "' or '", SDPA_BACKEND, "', got '", attention_backend, "'");
         properties.erase(it);
     }
 
+    // prompts are processed in chunks by the stateful pipeline only, so prefill_chunk_size selects SDPA backend.
+    // It's kept in the properties for the stateful pipeline
+    if (properties.find(ov::genai::prefill_chunk_size.name()) != properties.end()) {
+        OPENVINO_ASSERT(!explicitly_requires_paged_attention(properties) && (!is_attention_backend_set || attention_backend == SDPA_BACKEND),
+            "'", ov::genai::prefill_chunk_size.name(), "' is supported by 'SDPA' attention backend only. PagedAttention backend "
+            "splits prompts according to SchedulerConfig::max_num_batched_tokens when SchedulerConfig::dynamic_split_fuse is enabled");
+        attention_backend = SDPA_BACKEND;
+    }
+
     if (explicitly_requires_paged_attention(properties)) {
         OPENVINO_ASSERT(attention_backend == PA_BACKEND,
             "User properties are conflicting: some of them requires PagedAttention backend, while 'ATTENTION_BACKEND' is set to 'SDPA'");
@@ -301,6 +311,14 @@ void ov::genai::LLMPipeline::finish_chat() {
     m_pimpl->finish_chat();
 }
 
+ov::genai::ChatSession ov::genai::LLMPipeline::export_chat_session() {
+    return m_pimpl->export_chat_session();
+}
+
+void ov::genai::LLMPipeline::import_chat_session(const ChatSession& session) {
+    m_pimpl->import_chat_session(session);
+}
+
 void ov::genai::LLMPipeline::set_generation_config(const GenerationConfig& config) {
     m_pimpl->set_generation_config(config);
 }
@@ -54,6 +54,14 @@ public:
     virtual void start_chat(const std::string& system_message) = 0;
     virtual void finish_chat() = 0;
 
+    virtual ChatSession export_chat_session() {
+        OPENVINO_THROW("Chat sessions are supported only by the stateful (SDPA) pipeline");
+    }
+
+    virtual void import_chat_session(const ChatSession& /* session */) {
+        OPENVINO_THROW("Chat sessions are supported only by the stateful (SDPA) pipeline");
+    }
+
     virtual ~LLMPipelineImplBase() = default;
 
     void save_load_time(std::chrono::steady_clock::time_point start_time) {
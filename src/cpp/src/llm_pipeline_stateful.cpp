@@ -47,7 +47,18 @@ StatefulLLMPipeline::StatefulLLMPipeline(
     if (!m_use_full_chat_history)
         m_kv_history_trim_manager.kv_cache_seq_length_axis = ov::genai::utils::get_kv_axes_pos(model).seq_len;
 
-    auto filtered_properties = extract_adapters_from_properties(properties, &m_generation_config.adapters);
+    ov::AnyMap properties_without_chunk_size = properties;
+    auto chunk_size_it = properties_without_chunk_size.find(ov::genai::prefill_chunk_size.name());
+    if (chunk_size_it != properties_without_chunk_size.end()) {
+        // Python passes integer properties as int64_t
+        const int64_t chunk_size = chunk_size_it->second.is<int64_t>() ? chunk_size_it->second.as<int64_t>()
+                                                                       : static_cast<int64_t>(chunk_size_it->second.as<size_t>());
+        OPENVINO_ASSERT(chunk_size >= 0, "prefill_chunk_size must be non-negative, got ", chunk_size);
+        m_prefill_chunk_size = static_cast<size_t>(chunk_size);
+        properties_without_chunk_size.erase(chunk_size_it);
+    }
+
+    auto filtered_properties = extract_adapters_from_properties(properties_without_chunk_size, &m_generation_config.adapters);
     if (m_generation_config.adapters) {
         m_generation_config.adapters->set_tensor_name_prefix("base_model.model.");
         m_adapter_controller = AdapterController(model, *m_generation_config.adapters, device);   // TODO: Make the prefix name configurable
@@ -61,6 +72,7 @@ StatefulLLMPipeline::StatefulLLMPipeline(
         m_generation_config.set_eos_token_id(m_tokenizer.get_eos_token_id());
 
     m_sampler.set_seed(m_generation_config.rng_seed);
+    m_sampler.set_vocab_size(utils::get_vocab_size(compiled_model));
 }
 
 StatefulLLMPipeline::StatefulLLMPipeline(
@@ -113,8 +125,7 @@ DecodedResults StatefulLLMPipeline::generate(
             m_history.push_back({{"role", "user"}, {"content", prompt}});
             constexpr bool add_generation_prompt = true;
             auto new_templated_chat_history = m_tokenizer.apply_chat_template(m_history, add_generation_prompt);
-            // Do not add special tokens in chat scenario to be aligned with HF.
-            auto new_chat_tokens = m_tokenizer.encode(new_templated_chat_history, ov::genai::add_special_tokens(false));
+            auto new_chat_tokens = encode_chat_history(new_templated_chat_history);
 
             if (m_use_full_chat_history) {
                 encoded_input = new_chat_tokens;
@@ -148,6 +159,8 @@ DecodedResults StatefulLLMPipeline::generate(
         if (m_chat_generation_finish_status == ov::genai::GenerationStatus::CANCEL) {
             // If chat generation process was cancelled by user, let's rollback to previous state of history
             m_history.pop_back();
+            m_templated_chat_history.clear();
+            m_templated_chat_history_tokens.clear();
         } else {
             // Tail of chat template is missing in KV cache.
             // Find the tail to concatenate it with the next input prompt.
@@ -314,7 +327,7 @@ EncodedResults StatefulLLMPipeline::generate(
     }
 
     ov::genai::utils::GenerationFinishInfo finish_info = get_lm_encoded_results(m_model_runner, input_ids, concatenated_attention_mask, streamer_ptr, m_sampler,
-                                                                                requests, position_ids, m_kv_cache_state, std::nullopt, std::nullopt);
+                                                                                requests, position_ids, m_kv_cache_state, std::nullopt, std::nullopt, m_prefill_chunk_size);
     ov::genai::EncodedResults& result = finish_info.results;
     m_chat_generation_finish_status = finish_info.streaming_finish_status;
 
@@ -377,8 +390,97 @@ void StatefulLLMPipeline::finish_chat() {
         m_model_runner.get_tensor("attention_mask").set_shape({1, 0});
         m_history.clear();
         m_tokenized_chat_history.clear();
+        m_templated_chat_history.clear();
+        m_templated_chat_history_tokens.clear();
         m_kv_cache_state.reset_state();
     }
 }
 
+ChatSession StatefulLLMPipeline::export_chat_session() {
+    OPENVINO_ASSERT(is_chat_conversation, "Chat session can be exported only in chat mode, call start_chat() first");
+
+    auto copy_tensor = [](const ov::Tensor& tensor) {
+        ov::Tensor copy(tensor.get_element_type(), tensor.get_shape());
+        tensor.copy_to(copy);
+        return copy;
+    };
+
+    ChatSession session;
+    session.history = m_history;
+    session.encoded_inputs = m_chat_input_type == ov::genai::utils::GenerationChatInputsType::ENCODED_INPUTS;
+    if (session.encoded_inputs) {
+        session.history_tokens = m_tokenized_chat_history;
+    } else {
+        session.templated_history = m_templated_chat_history;
+        session.history_tokens = m_templated_chat_history_tokens;
+    }
+    session.kv_cache_tokens = m_kv_cache_state.get_state();
+    session.num_kv_cache_tokens_to_trim = m_kv_history_trim_manager.num_tokens_to_trim;
+    session.attention_mask = copy_tensor(m_model_runner.get_tensor("attention_mask"));
+    for (auto& state : m_model_runner.query_state()) {
+        // LoRA adapters are not a part of the conversation
+        if (m_adapter_controller && m_adapter_controller->has_state_name(state.get_name())) {
+            continue;
+        }
+        session.states[state.get_name()] = copy_tensor(state.get_state());
+    }
+    return session;
+}
+
+void StatefulLLMPipeline::import_chat_session(const ChatSession& session) {
+    finish_chat();
+    is_chat_conversation = true;
+
+    m_history = session.history;
+    if (session.encoded_inputs) {
+        m_chat_input_type = ov::genai::utils::GenerationChatInputsType::ENCODED_INPUTS;
+        m_tokenized_chat_history = session.history_tokens;
+    } else {
+        // the type of inputs is defined by the first generate() call of the chat
+        m_chat_input_type = session.kv_cache_tokens.empty() ? ov::genai::utils::GenerationChatInputsType::UNDEF
+                                                            : ov::genai::utils::GenerationChatInputsType::STRING;
+        m_templated_chat_history = session.templated_history;
+        m_templated_chat_history_tokens = session.history_tokens;
+    }
+    m_kv_cache_state.get_state() = session.kv_cache_tokens;
+    m_kv_history_trim_manager.num_tokens_to_trim = session.num_kv_cache_tokens_to_trim;
+
+    if (session.kv_cache_tokens.empty()) {
+        return;
+    }
+    size_t num_restored_states = 0;
+    for (auto& state : m_model_runner.query_state()) {
+        auto it = session.states.find(state.get_name());
+        if (it != session.states.end()) {
+            state.set_state(it->second);
+            ++num_restored_states;
+        }
+    }
+    OPENVINO_ASSERT(num_restored_states == session.states.size(), "Chat session was exported from a different model");
+
+    ov::Tensor attention_mask(session.attention_mask.get_element_type(), session.attention_mask.get_shape());
+    session.attention_mask.copy_to(attention_mask);
+    m_model_runner.set_tensor("attention_mask", attention_mask);
+}
+
+TokenizedInputs StatefulLLMPipeline::encode_chat_history(const std::string& templated_chat_history) {
+    auto encode = [this](const std::string& text) {
+        // Do not add special tokens in chat scenario to be aligned with HF.
+        ov::Tensor input_ids = m_tokenizer.encode(text, ov::genai::add_special_tokens(false)).input_ids;
+        return std::vector<int64_t>(input_ids.data<int64_t>(), input_ids.data<int64_t>() + input_ids.get_size());
+    };
+
+    // Templates usually render the previous turns the same way, so the history can be encoded incrementally.
+    // Otherwise (e.g. a template drops reasoning of previous answers), the whole history is encoded again.
+    utils::encode_appended_text(encode, m_templated_chat_history, templated_chat_history, m_templated_chat_history_tokens);
+    m_templated_chat_history = templated_chat_history;
+
+    TokenizedInputs encoded_input;
+    encoded_input.input_ids = ov::Tensor(ov::element::i64, {1, m_templated_chat_history_tokens.size()});
+    std::copy(m_templated_chat_history_tokens.begin(), m_templated_chat_history_tokens.end(), encoded_input.input_ids.data<int64_t>());
+    encoded_input.attention_mask = ov::Tensor(ov::element::i64, {1, m_templated_chat_history_tokens.size()});
+    std::fill_n(encoded_input.attention_mask.data<int64_t>(), m_templated_chat_history_tokens.size(), 1);
+    return encoded_input;
+}
+
 } // namespace ov::genai
@@ -26,10 +26,16 @@ class StatefulLLMPipeline final : public LLMPipelineImplBase {
     ov::genai::GenerationStatus m_chat_generation_finish_status = ov::genai::GenerationStatus::RUNNING;
     // if True, full history will be used as prompt on each chat generation
     bool m_use_full_chat_history = false;
+    // maximum number of prompt tokens processed by a single inference, 0 means no limit
+    size_t m_prefill_chunk_size = 0;
     // reflection of tokens contained in the kv cache
     KVCacheState m_kv_cache_state;
+    // templated chat history of the previous turn and its tokens, so that only new messages are encoded on the next turn
+    std::string m_templated_chat_history;
+    std::vector<int64_t> m_templated_chat_history_tokens;
 
     void reset_kv_state();
+    TokenizedInputs encode_chat_history(const std::string& templated_chat_history);
 public:
 
     StatefulLLMPipeline(
@@ -74,6 +80,10 @@ public:
     void start_chat(const std::string& system_message) override;
 
     void finish_chat() override;
+
+    ChatSession export_chat_session() override;
+
+    void import_chat_session(const ChatSession& session) override;
 };
 
 } // namespace ov::genai
@@ -972,7 +972,7 @@ EncodedResults StatefulLLMPipeline::generate(
 
     OPENVINO_ASSERT(sequence_group->get_finished_sequences().size() == 1u);
     auto sequence = sequence_group->get_finished_sequences().front();
-    results.tokens[0] = sequence->get_generated_ids();
+    results.tokens[0] = sequence->get_generated_ids().to_vector();
     results.scores[0] = sequence->get_cumulative_log_prob();
     m_chat_generation_finish_status = sequence_group->get_generation_stream()->get_status();
     m_sampler.clear_request_info(sequence_group->get_request_id());
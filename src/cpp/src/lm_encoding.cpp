@@ -50,6 +50,20 @@ void update_3d_position_ids(ov::Tensor&& position_ids, const ov::Tensor& attenti
     }
 }
 
+/**
+ * Copies the [begin, end) range of the sequence dimension of input ids, embeddings, attention mask or position ids
+ */
+ov::Tensor slice_sequence(const ov::Tensor& tensor, size_t begin, size_t end) {
+    const ov::Shape& shape = tensor.get_shape();
+    ov::Coordinate roi_begin(shape.size(), 0), roi_end(shape);
+    roi_begin[1] = begin;
+    roi_end[1] = end;
+    ov::Tensor roi(tensor, roi_begin, roi_end);
+    ov::Tensor slice(tensor.get_element_type(), roi.get_shape());
+    roi.copy_to(slice);
+    return slice;
+}
+
 void update_attention_mask_with_beams(ov::Tensor&& attention_mask, std::vector<int32_t> next_beams) {
     ov::Tensor original_mask{ov::element::i64, attention_mask.get_shape()};
     ov::Shape original_shape = original_mask.get_shape();
@@ -84,7 +98,8 @@ ov::genai::utils::GenerationFinishInfo get_lm_encoded_results(
     std::optional<ov::Tensor> position_ids,
     KVCacheState& kv_cache_state,
     std::optional<EmbeddingsModel> m_embedding,
-    std::optional<int64_t> rope_delta
+    std::optional<int64_t> rope_delta,
+    size_t prefill_chunk_size
 ) {
     std::vector<GenerationHandle> generations;
     for (SequenceGroup::Ptr sequence_group : sequence_groups) {
@@ -129,31 +144,68 @@ ov::genai::utils::GenerationFinishInfo get_lm_encoded_results(
 
     // Initialize inputs
 
-    if (m_embedding.has_value()) {
-        m_llm.set_tensor("inputs_embeds", input_ids);
-    } else {
-        kv_cache_state.add_inputs(input_ids);
-        m_llm.set_tensor("input_ids", input_ids);
-    }
-    m_llm.set_tensor("attention_mask", attention_mask);
-    if (position_ids.has_value())
-        m_llm.set_tensor("position_ids", *position_ids);
-
     ov::Tensor beam_idx = ov::Tensor(ov::element::i32, {batch_size});
     std::fill_n(beam_idx.data<int32_t>(), batch_size, 0);
     m_llm.set_tensor("beam_idx", beam_idx);
 
     // "Prompt" phase
+    // Long prompts are processed in chunks to bound the size of intermediate tensors. Only logits of the last token
+    // of a chunk are computed by the model, so the chunks cost the same as a single inference except for them.
+    // 3D position ids of multimodal rotary embeddings are not split, so such prompts are processed at once.
+
+    const size_t prompt_len = input_ids.get_shape().at(1);
+    const size_t history_len = attention_mask.get_shape().at(1) - prompt_len;
+    const bool split_prompt = prefill_chunk_size > 0 && prefill_chunk_size < prompt_len &&
+        (!position_ids.has_value() || position_ids->get_shape().size() == 2);
+    const size_t chunk_size = split_prompt ? prefill_chunk_size : prompt_len;
+
+    bool prefill_interrupted = false;
+    MicroSeconds prefill_duration(0.0f);
+    for (size_t chunk_begin = 0; chunk_begin < prompt_len; chunk_begin += chunk_size) {
+        const size_t chunk_end = std::min(chunk_begin + chunk_size, prompt_len);
+
+        if (chunk_begin > 0 && streamer_ptr) {
+            auto streaming_status = streamer_ptr->get_status();
+            if (streaming_status != ov::genai::StreamingStatus::RUNNING) {
+                streaming_status == ov::genai::StreamingStatus::CANCEL ? generations.at(0)->cancel() : generations.at(0)->stop();
+                prefill_interrupted = true;
+                break;
+            }
+        }
+
+        ov::Tensor chunk_input_ids = split_prompt ? slice_sequence(input_ids, chunk_begin, chunk_end) : input_ids;
+        if (m_embedding.has_value()) {
+            m_llm.set_tensor("inputs_embeds", chunk_input_ids);
+        } else {
+            kv_cache_state.add_inputs(chunk_input_ids);
+            m_llm.set_tensor("input_ids", chunk_input_ids);
+        }
+        m_llm.set_tensor("attention_mask", split_prompt ? slice_sequence(attention_mask, 0, history_len + chunk_end) : attention_mask);
+        if (position_ids.has_value())
+            m_llm.set_tensor("position_ids", split_prompt ? slice_sequence(*position_ids, chunk_begin, chunk_end) : *position_ids);
+
+        const auto infer_start = std::chrono::steady_clock::now();
+        m_llm.infer();
+        prefill_duration += MicroSeconds(PerfMetrics::get_microsec(std::chrono::steady_clock::now() - infer_start));
+    }
 
-    const auto infer_start = std::chrono::steady_clock::now();
-    m_llm.infer();
     const auto infer_end = std::chrono::steady_clock::now();
-    const auto infer_ms = PerfMetrics::get_microsec(infer_end - infer_start);
-    raw_perf_counters.m_inference_durations[0] += MicroSeconds(infer_ms);
-    raw_perf_counters.m_token_infer_durations.emplace_back(infer_ms);
+    raw_perf_counters.m_inference_durations[0] += prefill_duration;
+    raw_perf_counters.m_token_infer_durations.emplace_back(prefill_duration);
     raw_perf_counters.m_new_token_times.emplace_back(infer_end);
     raw_perf_counters.m_batch_sizes.emplace_back(batch_size);
 
+    if (prefill_interrupted) {
+        streamer_ptr->end();
+        for (auto& sequence_group : sequence_groups) {
+            finish_info.results.tokens.emplace_back();
+            finish_info.results.scores.push_back(0.0f);
+            sampler.clear_request_info(sequence_group->get_request_id());
+        }
+        finish_info.streaming_finish_status = sequence_groups[0]->get_generation_stream()->get_status();
+        return finish_info;
+    }
+
     auto logits = m_llm.get_tensor("logits");
 
     int64_t output_sequence_len = logits.get_shape().at(1);
@@ -279,7 +331,7 @@ ov::genai::utils::GenerationFinishInfo get_lm_encoded_results(
             const auto & sequence = sequences[seq_id];
             const float score = sampling_params.is_beam_search() ? sequence->get_beam_search_score(sampling_params) : sequence->get_cumulative_log_prob();
 
-            finish_info.results.tokens.push_back(sequence->get_generated_ids());
+            finish_info.results.tokens.push_back(sequence->get_generated_ids().to_vector());
             finish_info.results.scores.push_back(score);
         }
     }
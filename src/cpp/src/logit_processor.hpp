@@ -7,6 +7,8 @@
 #include <cmath>
 
 #include "openvino/genai/generation_config.hpp"
+#include "structured_output.hpp"
+#include "token_store.hpp"
 
 struct Token {
     float m_log_prob = 0.;
@@ -155,81 +157,133 @@ protected:
 };
 
 
-class IPenaltyTransformer : public ILogitTransformer {
+// Occurrence counts of tokens kept in a dense array indexed by token ID, so updates and lookups don't chase pointers.
+// IDs of tokens with non-zero counts are listed separately, so penalties visit only tokens which have occurred.
+class TokenCounts {
 public:
-    void set_unique_generated_token_ids(const std::shared_ptr<std::map<int64_t, size_t>>& unique_generated_token_ids) {
-        if (unique_generated_token_ids != nullptr) {
-            m_unique_generated_token_ids = unique_generated_token_ids;
-        } else {
-            m_unique_generated_token_ids = std::shared_ptr<std::map<int64_t, size_t>>(new std::map<int64_t, size_t>);
+    void add(int64_t token_id) {
+        OPENVINO_ASSERT(token_id >= 0, "input_ids token out of bounds");
+        if (static_cast<size_t>(token_id) >= m_counts.size()) {
+            const size_t new_size = std::max(static_cast<size_t>(token_id) + 1, m_counts.size() + m_counts.size() / 2);
+            m_counts.resize(new_size, 0);
+            m_positions.resize(new_size, 0);
+        }
+        if (m_counts[token_id]++ == 0) {
+            m_positions[token_id] = static_cast<uint32_t>(m_token_ids.size());
+            m_token_ids.push_back(token_id);
         }
     }
 
-    void extract_generated_tokens(const TokenIds& input_ids) {
-        set_unique_generated_token_ids(m_unique_generated_token_ids);
-
-        for (const auto& input_id : input_ids) {
-            if (m_unique_generated_token_ids->count(input_id)) {
-                m_unique_generated_token_ids->at(input_id)++;
-            } else {
-                m_unique_generated_token_ids->insert({input_id, 1});
-            }
+    void remove(int64_t token_id) {
+        OPENVINO_ASSERT(count(token_id) > 0);
+        if (--m_counts[token_id] == 0) {
+            // keep the list dense by moving the last token to the freed position
+            const int64_t last_token_id = m_token_ids.back();
+            m_token_ids[m_positions[token_id]] = last_token_id;
+            m_positions[last_token_id] = m_positions[token_id];
+            m_token_ids.pop_back();
         }
     }
 
-protected:
-    std::shared_ptr<std::map<int64_t, size_t>> m_unique_generated_token_ids = nullptr;
-    double m_penalty = 0.f;
+    size_t count(int64_t token_id) const {
+        return token_id >= 0 && static_cast<size_t>(token_id) < m_counts.size() ? m_counts[token_id] : 0;
+    }
+
+    // IDs of tokens with non-zero counts in order of their first occurrence
+    const TokenIds& get_token_ids() const {
+        return m_token_ids;
+    }
+
+private:
+    std::vector<uint32_t> m_counts;
+    // position of a token in m_token_ids
+    std::vector<uint32_t> m_positions;
+    TokenIds m_token_ids;
 };
 
-class RepetitionPenaltyTransform : public IPenaltyTransformer {
+// Applies repetition, presence and frequency penalties in a single pass: logits of generated tokens are gathered
+// into a contiguous buffer, penalized by a branchless loop, which compiler vectorizes, and scattered back.
+class PenaltyTransform : public ILogitTransformer {
 public:
-    RepetitionPenaltyTransform(double repetition_penalty) {
-        m_penalty = repetition_penalty;
-    };
+    PenaltyTransform(float repetition_penalty, float presence_penalty, float frequency_penalty) :
+        m_repetition_penalty(repetition_penalty), m_presence_penalty(presence_penalty), m_frequency_penalty(frequency_penalty) {}
+
+    // Unique IDs of prompt tokens, which are penalized by repetition penalty only
+    void set_prompt_token_ids(const std::shared_ptr<const TokenIds>& prompt_token_ids) {
+        m_prompt_token_ids = prompt_token_ids;
+    }
+
+    // Counts of generated tokens, which are updated by the owner of the transform
+    void set_generated_token_counts(const std::shared_ptr<TokenCounts>& generated_token_counts) {
+        m_generated_token_counts = generated_token_counts;
+    }
 
     void apply(Logits& logits) override {
-        size_t vocab_size = logits.m_size;
-        for (const auto& prompt_id : *m_unique_prompt_token_ids) {
-            OPENVINO_ASSERT((prompt_id >= 0) && (prompt_id < vocab_size), "input_ids token out of bounds");
-            if (logits.m_data[prompt_id] >= 0) {
-                logits.m_data[prompt_id] /= m_penalty;
-            } else {
-                logits.m_data[prompt_id] *= m_penalty;
-            };
-        }
-        for (const auto& input_id_pair : *m_unique_generated_token_ids) {
-            const auto& input_id = input_id_pair.first;
-            if (1 == m_unique_prompt_token_ids->count(input_id)) {
-                // repetition_penalty was already accounted by the for
-                // loop above.
-                continue;
+        const size_t vocab_size = logits.m_size;
+        if (m_repetition_penalty != 1.0f) {
+            for (const auto& prompt_id : *m_prompt_token_ids) {
+                OPENVINO_ASSERT((prompt_id >= 0) && (prompt_id < vocab_size), "input_ids token out of bounds");
+                // generated tokens are penalized below, repetition penalty is applied once
+                if (m_generated_token_counts->count(prompt_id) == 0) {
+                    float& logit = logits.m_data[prompt_id];
+                    logit = logit >= 0 ? logit / m_repetition_penalty : logit * m_repetition_penalty;
+                }
             }
+        }
+
+        const TokenIds& generated_ids = m_generated_token_counts->get_token_ids();
+        const size_t num_generated_ids = generated_ids.size();
+        m_gathered_logits.resize(num_generated_ids);
+        m_gathered_counts.resize(num_generated_ids);
+        for (size_t i = 0; i < num_generated_ids; ++i) {
+            const int64_t input_id = generated_ids[i];
             OPENVINO_ASSERT((input_id >= 0) && (input_id < vocab_size), "input_ids token out of bounds");
-            if (logits.m_data[input_id] >= 0) {
-                logits.m_data[input_id] /= m_penalty;
-            } else {
-                logits.m_data[input_id] *= m_penalty;
-            };
+            m_gathered_logits[i] = logits.m_data[input_id];
+            m_gathered_counts[i] = static_cast<float>(m_generated_token_counts->count(input_id));
         }
-    }
 
-    void apply(Logits& logits, const TokenIds& input_ids) {
-        set_unique_prompt_token_ids(nullptr);
-        extract_generated_tokens(input_ids);
-        apply(logits);
+        // penalties are applied one after another, as each of them depends on a sign of the penalized logit
+        const float repetition_penalty = m_repetition_penalty, presence_penalty = m_presence_penalty, frequency_penalty = m_frequency_penalty;
+        float* gathered_logits = m_gathered_logits.data();
+        const float* gathered_counts = m_gathered_counts.data();
+        for (size_t i = 0; i < num_generated_ids; ++i) {
+            float logit = gathered_logits[i];
+            logit = logit >= 0 ? logit / repetition_penalty : logit * repetition_penalty;
+            logit = logit >= 0 ? logit - presence_penalty : logit + presence_penalty;
+            const float frequency = frequency_penalty * gathered_counts[i];
+            logit = logit >= 0 ? logit - frequency : logit + frequency;
+            gathered_logits[i] = logit;
+        }
+
+        for (size_t i = 0; i < num_generated_ids; ++i) {
+            logits.m_data[generated_ids[i]] = m_gathered_logits[i];
+        }
     }
 
-    void set_unique_prompt_token_ids(const std::shared_ptr<std::set<int64_t>>& unique_prompt_token_ids) {
-        if (unique_prompt_token_ids != nullptr) {
-            m_unique_prompt_token_ids = unique_prompt_token_ids;
-        } else {
-            m_unique_prompt_token_ids = std::shared_ptr<std::set<int64_t>>(new std::set<int64_t>);
+    // Penalizes input_ids as generated tokens. Used when the transform is applied standalone
+    void apply(Logits& logits, const TokenIds& input_ids) {
+        for (const auto& input_id : input_ids) {
+            m_generated_token_counts->add(input_id);
         }
+        apply(logits);
     }
 
 protected:
-    std::shared_ptr<std::set<int64_t>> m_unique_prompt_token_ids = nullptr;
+    float m_repetition_penalty = 1.0f;
+    float m_presence_penalty = 0.0f;
+    float m_frequency_penalty = 0.0f;
+
+    std::shared_ptr<const TokenIds> m_prompt_token_ids = std::make_shared<const TokenIds>();
+    std::shared_ptr<TokenCounts> m_generated_token_counts = std::make_shared<TokenCounts>();
+
+    // buffers reused by apply() calls
+    std::vector<float> m_gathered_logits;
+    std::vector<float> m_gathered_counts;
+};
+
+class RepetitionPenaltyTransform : public PenaltyTransform {
+public:
+    RepetitionPenaltyTransform(double repetition_penalty) : PenaltyTransform(repetition_penalty, 0.0f, 0.0f) {}
 };
 
 class EOSPenaltyTransform : public ILogitTransformer {
@@ -254,56 +308,100 @@ protected:
     std::set<int64_t> m_stop_token_ids;
 };
 
-class FrequencyPenaltyTransform : public IPenaltyTransformer {
+class FrequencyPenaltyTransform : public PenaltyTransform {
 public:
-    FrequencyPenaltyTransform(double value) {
-        m_penalty = value;
-    };
+    FrequencyPenaltyTransform(double value) : PenaltyTransform(1.0f, 0.0f, value) {}
+};
 
-    void apply(Logits& logits) override {
-        size_t vocab_size = logits.m_size;
-        for (const auto& input_id_pair : *m_unique_generated_token_ids) {
-            const auto& input_id = input_id_pair.first;
-            OPENVINO_ASSERT((input_id >= 0) && (input_id < vocab_size), "input_ids token out of bounds");
-            if (logits.m_data[input_id] >= 0) {
-                logits.m_data[input_id] -= m_penalty * input_id_pair.second;
-            } else {
-                logits.m_data[input_id] += m_penalty * input_id_pair.second;
-            };
-        }
+class PresencePenaltyTransform : public PenaltyTransform {
+public:
+    PresencePenaltyTransform(double value) : PenaltyTransform(1.0f, value, 0.0f) {}
+};
+
+class StructuredOutputTransform : public ILogitTransformer {
+public:
+    StructuredOutputTransform(std::shared_ptr<ov::genai::StructuredOutputGrammar> grammar, const std::set<int64_t>& stop_token_ids) :
+        m_grammar(std::move(grammar)), m_stop_token_ids(stop_token_ids) {}
+
+    // Selects a sequence and a number of its generated tokens, which constrain the next apply() call
+    void set_current_sequence(uint64_t sequence_id, const ov::genai::TokenStore& generated_ids, size_t num_tokens) {
+        m_current_state = advance(sequence_id, generated_ids, num_tokens);
     }
 
-    void apply(Logits& logits, const TokenIds& input_ids) {
-        extract_generated_tokens(input_ids);
-        apply(logits);
+    // Starts computation of a mask for the next token by a thread pool, so it's ready by the next sampling step
+    void prefetch_next_token_mask(uint64_t sequence_id, const ov::genai::TokenStore& generated_ids, ThreadPool& thread_pool) {
+        m_grammar->prefetch_mask(advance(sequence_id, generated_ids, generated_ids.size()), thread_pool);
     }
-};
 
-class PresencePenaltyTransform : public IPenaltyTransformer {
-public:
-    PresencePenaltyTransform(double value) {
-        m_penalty = value;
-    };
+    // Drops states of a sequence, which is not generated anymore (e.g. dropped by sampling)
+    void drop_sequence(uint64_t sequence_id) {
+        m_sequence_states.erase(sequence_id);
+    }
 
     void apply(Logits& logits) override {
-        size_t vocab_size = logits.m_size;
-        for (const auto& input_id_pair : *m_unique_generated_token_ids) {
-            const auto& input_id = input_id_pair.first;
-            OPENVINO_ASSERT((input_id >= 0) && (input_id < vocab_size), "input_ids token out of bounds");
-            if (logits.m_data[input_id] >= 0) {
-                logits.m_data[input_id] -= m_penalty;
-            } else {
-                logits.m_data[input_id] += m_penalty;
-            };
+        // mask is applied to raw logits, where element order matches token ids
+        OPENVINO_ASSERT(!logits.is_vector_initialized(), "Structured output must be applied before top_p and top_k filters");
+        const auto mask = m_grammar->get_mask(m_current_state);
+
+        // stop tokens are allowed when output is complete, or when there is no other way to continue
+        const bool allow_stop = m_grammar->is_accepting(m_current_state) || mask->num_allowed_tokens == 0;
+        std::vector<float> stop_token_logits;
+        for (int64_t stop_token_id : m_stop_token_ids) {
+            stop_token_logits.push_back(stop_token_id < logits.m_size ? logits.m_data[stop_token_id] : 0.f);
+        }
+
+        constexpr float minus_inf = -std::numeric_limits<float>::infinity();
+        for (size_t word_idx = 0; word_idx * 32 < logits.m_size; ++word_idx) {
+            const uint32_t word = word_idx < mask->words.size() ? mask->words[word_idx] : 0u;
+            const size_t begin = word_idx * 32, end = std::min(begin + 32, logits.m_size);
+            if (word == ~0u) {
+                continue;
+            } else if (word == 0u) {
+                std::fill(logits.m_data + begin, logits.m_data + end, minus_inf);
+                continue;
+            }
+            for (size_t token_id = begin; token_id < end; ++token_id) {
+                if (!(word >> (token_id - begin) & 1u))
+                    logits.m_data[token_id] = minus_inf;
+            }
+        }
+
+        if (allow_stop) {
+            size_t i = 0;
+            for (int64_t stop_token_id : m_stop_token_ids) {
+                if (stop_token_id < logits.m_size)
+                    logits.m_data[stop_token_id] = stop_token_logits[i];
+                ++i;
+            }
         }
     }
 
-    void apply(Logits& logits, const TokenIds& input_ids) {
-        extract_generated_tokens(input_ids);
-        apply(logits);
+protected:
+    // Returns automaton state after first num_tokens generated tokens of a sequence.
+    // States after each token are kept, so only tokens appended or replaced since the previous call are fed to automaton.
+    int32_t advance(uint64_t sequence_id, const ov::genai::TokenStore& generated_ids, size_t num_tokens) {
+        auto& history = m_sequence_states[sequence_id];
+        size_t num_matched_tokens = 0;
+        const size_t max_matched_tokens = std::min(history.size(), num_tokens);
+        while (num_matched_tokens < max_matched_tokens && history[num_matched_tokens].first == generated_ids[num_matched_tokens]) {
+            ++num_matched_tokens;
+        }
+        history.resize(num_matched_tokens);
+
+        int32_t state = history.empty() ? ov::genai::RegexAutomaton::INITIAL_STATE : history.back().second;
+        for (size_t i = num_matched_tokens; i < num_tokens; ++i) {
+            state = m_grammar->next_state(state, generated_ids, i);
+            history.emplace_back(generated_ids[i], state);
+        }
+        return state;
     }
-};
 
+    std::shared_ptr<ov::genai::StructuredOutputGrammar> m_grammar;
+    std::set<int64_t> m_stop_token_ids;
+    int32_t m_current_state = ov::genai::RegexAutomaton::INITIAL_STATE;
+    // sequence ID => { token ID, automaton state after the token } for each generated token
+    std::unordered_map<uint64_t, std::vector<std::pair<int64_t, int32_t>>> m_sequence_states;
+};
 
 } // namespace LogitTransformers
 
@@ -311,21 +409,19 @@ class LogitProcessor {
 protected:
     std::vector<std::shared_ptr<LogitTransformers::ILogitTransformer>> m_logit_transformers;
     
-    std::shared_ptr<std::map<int64_t, size_t>> m_unique_generated_token_ids = std::shared_ptr<std::map<int64_t, size_t>>(new std::map<int64_t, size_t>);
-    std::shared_ptr<std::set<int64_t>> m_unique_prompt_token_ids = std::shared_ptr<std::set<int64_t>>(new std::set<int64_t>);
+    // counts of generated tokens are kept only if penalties are enabled
+    std::shared_ptr<LogitTransformers::TokenCounts> m_generated_token_counts;
     size_t m_generated_tokens = 0;
 
     // speculative decoding parameters
     float m_assistant_confidence_threshold = 0.f;
 
+    std::shared_ptr<LogitTransformers::StructuredOutputTransform> m_structured_output;
+
 
 public:
     LogitProcessor(const ov::genai::GenerationConfig& sampling_params,
                    const LogitTransformers::TokenIds& input_ids) {
-        for (const auto& input_id : input_ids) {
-            m_unique_prompt_token_ids->insert(input_id);
-        }
-
         if (sampling_params.min_new_tokens > 0) {
             m_logit_transformers.emplace_back(
                 new LogitTransformers::EOSPenaltyTransform(sampling_params.stop_token_ids, sampling_params.min_new_tokens)
@@ -333,24 +429,17 @@ public:
         }
 
         if (sampling_params.is_multinomial() || sampling_params.is_greedy_decoding()) {
-            if (sampling_params.repetition_penalty != 1.0f) {
-                std::shared_ptr<LogitTransformers::RepetitionPenaltyTransform> transformer = 
-                    std::shared_ptr<LogitTransformers::RepetitionPenaltyTransform>(new LogitTransformers::RepetitionPenaltyTransform(sampling_params.repetition_penalty));
-                transformer->set_unique_prompt_token_ids(m_unique_prompt_token_ids);
-                transformer->set_unique_generated_token_ids(m_unique_generated_token_ids);
-                m_logit_transformers.push_back(transformer);
-            }
-            if (sampling_params.presence_penalty != 0.0f) {
-                std::shared_ptr<LogitTransformers::PresencePenaltyTransform> transformer = 
-                    std::shared_ptr<LogitTransformers::PresencePenaltyTransform>(new LogitTransformers::PresencePenaltyTransform(sampling_params.presence_penalty)); 
-                transformer->set_unique_generated_token_ids(m_unique_generated_token_ids);
-                m_logit_transformers.push_back(transformer);
-                
-            }
-            if (sampling_params.frequency_penalty != 0.0f) {
-                std::shared_ptr<LogitTransformers::FrequencyPenaltyTransform> transformer = 
-                    std::shared_ptr<LogitTransformers::FrequencyPenaltyTransform>(new LogitTransformers::FrequencyPenaltyTransform(sampling_params.frequency_penalty));
-                transformer->set_unique_generated_token_ids(m_unique_generated_token_ids);
+            if (sampling_params.repetition_penalty != 1.0f || sampling_params.presence_penalty != 0.0f || sampling_params.frequency_penalty != 0.0f) {
+                auto transformer = std::make_shared<LogitTransformers::PenaltyTransform>(
+                    sampling_params.repetition_penalty, sampling_params.presence_penalty, sampling_params.frequency_penalty);
+                if (sampling_params.repetition_penalty != 1.0f) {
+                    auto prompt_token_ids = std::make_shared<LogitTransformers::TokenIds>(input_ids);
+                    std::sort(prompt_token_ids->begin(), prompt_token_ids->end());
+                    prompt_token_ids->erase(std::unique(prompt_token_ids->begin(), prompt_token_ids->end()), prompt_token_ids->end());
+                    transformer->set_prompt_token_ids(prompt_token_ids);
+                }
+                m_generated_token_counts = std::make_shared<LogitTransformers::TokenCounts>();
+                transformer->set_generated_token_counts(m_generated_token_counts);
                 m_logit_transformers.push_back(transformer);
             }
 
@@ -373,6 +462,39 @@ public:
         return m_assistant_confidence_threshold;
     }
 
+    // Constrains generated tokens by a grammar. The constraint is applied right after min_new_tokens penalty,
+    // so the following penalties and filters work with allowed tokens only
+    void set_structured_output(std::shared_ptr<ov::genai::StructuredOutputGrammar> grammar, const std::set<int64_t>& stop_token_ids) {
+        m_structured_output = std::make_shared<LogitTransformers::StructuredOutputTransform>(std::move(grammar), stop_token_ids);
+        auto it = m_logit_transformers.begin();
+        while (it != m_logit_transformers.end() && std::dynamic_pointer_cast<LogitTransformers::EOSPenaltyTransform>(*it)) {
+            ++it;
+        }
+        m_logit_transformers.insert(it, m_structured_output);
+    }
+
+    bool has_structured_output() const {
+        return m_structured_output != nullptr;
+    }
+
+    void set_current_sequence(uint64_t sequence_id, const ov::genai::TokenStore& generated_ids, size_t num_tokens) {
+        if (m_structured_output) {
+            m_structured_output->set_current_sequence(sequence_id, generated_ids, num_tokens);
+        }
+    }
+
+    void prefetch_next_token_mask(uint64_t sequence_id, const ov::genai::TokenStore& generated_ids, ThreadPool& thread_pool) {
+        if (m_structured_output) {
+            m_structured_output->prefetch_next_token_mask(sequence_id, generated_ids, thread_pool);
+        }
+    }
+
+    void drop_sequence(uint64_t sequence_id) {
+        if (m_structured_output) {
+            m_structured_output->drop_sequence(sequence_id);
+        }
+    }
+
     void apply(Logits& logits) {
         for (const auto& transformer : m_logit_transformers) {
             if (transformer->is_applicable(m_generated_tokens)) {
@@ -390,17 +512,15 @@ public:
     }
 
     void register_new_generated_token(int64_t new_token_id) {
-        auto it = m_unique_generated_token_ids->find(new_token_id);
-        if (it == m_unique_generated_token_ids->end()) {
-            m_unique_generated_token_ids->insert({new_token_id, 1});
-        } else {
-            it->second++;
+        if (m_generated_token_counts) {
+            m_generated_token_counts->add(new_token_id);
         }
     }
 
     void decrease_generated_token_occurance(int64_t token_id) {
-        OPENVINO_ASSERT(m_unique_generated_token_ids->count(token_id) > 0);
-        m_unique_generated_token_ids->at(token_id)--;
+        if (m_generated_token_counts) {
+            m_generated_token_counts->remove(token_id);
+        }
     }
 
 };
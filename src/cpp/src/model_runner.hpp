@@ -12,8 +12,10 @@
 #include "sequence_group.hpp"
 #include "scheduler.hpp"
 #include "timer.hpp"
+#include "tracing.hpp"
 
 #include "attention_output.hpp"
+#include "visual_language/embedding_model.hpp"
 
 namespace ov::genai {
 
@@ -40,6 +42,10 @@ class ModelRunner {
     std::vector<ov::Tensor> m_cache_rotation_deltas_for_each_layer;
     ov::Tensor m_cache_rotation_trig_lut;
 
+    // set for models consuming inputs_embeds instead of input_ids (e.g. language models of VLMs)
+    EmbeddingsModel m_embedding;
+    size_t m_hidden_size = 0;
+
 public:
     /**
      * Constructs the ModelRunner.
@@ -84,6 +90,25 @@ public:
         return m_last_attention_scores;
     }
 
+    /**
+     * Enables or disables collection of attention scores at the next `forward` calls, e.g. to aggregate the scores
+     * only once per several generation steps. Scores can be collected only if the model has attention score outputs.
+     */
+    void set_collect_attention_scores(bool collect_attention_scores) {
+        m_collect_attention_scores = collect_attention_scores;
+    }
+
+    /**
+     * Switches the runner to models consuming "inputs_embeds" instead of "input_ids".
+     * @param embedding A model to compute embeddings of generated tokens. Prompt embeddings are taken from sequence groups.
+     * @param hidden_size Size of a single token embedding.
+     */
+    void set_embedding_model(const EmbeddingsModel& embedding, size_t hidden_size) {
+        OPENVINO_ASSERT(hidden_size > 0, "hidden_size must be non-zero");
+        m_embedding = embedding;
+        m_hidden_size = hidden_size;
+    }
+
     void set_cache_rotation_trig_lut(ov::Tensor&& rotation_trig_lut) {
         m_cache_rotation_trig_lut = std::move(rotation_trig_lut);
     }
@@ -120,8 +145,11 @@ public:
             max_context_len_val = std::max(max_context_len_val, sequence_group->get_context_len());
         }
 
+        const bool use_inputs_embeds = m_hidden_size > 0;
+
         ov::Tensor
-            input_ids(ov::element::i64, {total_num_tokens}),
+            input_ids(ov::element::i64, {use_inputs_embeds ? 0 : total_num_tokens}),
+            inputs_embeds(ov::element::f32, {use_inputs_embeds ? total_num_tokens : 0, m_hidden_size}),
             position_ids(ov::element::i64, {total_num_tokens}),
             // PA specific parameters
             past_lens(ov::element::i32, {batch_size_in_sequences}),
@@ -136,6 +164,11 @@ public:
         int64_t
             * input_ids_data = input_ids.data<int64_t>(),
             * position_ids_data = position_ids.data<int64_t>();
+        float* inputs_embeds_data = inputs_embeds.data<float>();
+        // generated tokens are embedded by a single embeddings model inference after the loop
+        std::vector<int64_t> generated_ids_to_embed;
+        std::vector<size_t> generated_token_indices;
+        size_t current_token_idx = 0;
         int32_t 
             * past_lens_data = past_lens.data<int32_t>(),
             * subsequence_begins_data = subsequence_begins.data<int32_t>(),
@@ -172,11 +205,21 @@ public:
             for (size_t seq_id = 0; seq_id < num_running_sequences; ++seq_id) {
                 output_seq_len = 0;
                 Sequence::CPtr sequence = running_sequences[seq_id];
-                for (size_t token_id = 0, position_id = group_position_id; token_id < num_scheduled_tokens; ++token_id, ++position_id, ++gathering_current_index) {
-                    // compute token for current sequence
-                    input_ids_data[token_id] = position_id < prompt_len ?
-                        sequence_group->get_prompt_ids()[position_id] :
-                        sequence->get_generated_ids()[position_id - prompt_len];
+                for (size_t token_id = 0, position_id = group_position_id; token_id < num_scheduled_tokens; ++token_id, ++position_id, ++gathering_current_index, ++current_token_idx) {
+                    if (use_inputs_embeds) {
+                        if (position_id < prompt_len) {
+                            const float* prompt_embed = sequence_group->get_prompt_embeds().data<float>() + position_id * m_hidden_size;
+                            std::copy_n(prompt_embed, m_hidden_size, inputs_embeds_data + current_token_idx * m_hidden_size);
+                        } else {
+                            generated_ids_to_embed.push_back(sequence->get_generated_ids()[position_id - prompt_len]);
+                            generated_token_indices.push_back(current_token_idx);
+                        }
+                    } else {
+                        // compute token for current sequence
+                        input_ids_data[token_id] = position_id < prompt_len ?
+                            sequence_group->get_prompt_ids()[position_id] :
+                            sequence->get_generated_ids()[position_id - prompt_len];
+                    }
 
                     position_ids_data[token_id] = position_id;
 
@@ -204,7 +247,8 @@ public:
                 block_indices_begins_data[1] = block_indices_begins_data[0] + num_blocks;
 
                 // apply strides to shift to a next sequence
-                input_ids_data += num_scheduled_tokens;
+                if (!use_inputs_embeds)
+                    input_ids_data += num_scheduled_tokens;
                 position_ids_data += num_scheduled_tokens;
                 past_lens_data += 1;
                 subsequence_begins_data += 1;
@@ -214,7 +258,12 @@ public:
         }
 
         // typical LLM parameters
-        m_request.set_tensor("input_ids", input_ids);
+        if (use_inputs_embeds) {
+            _embed_generated_tokens(generated_ids_to_embed, generated_token_indices, inputs_embeds);
+            m_request.set_tensor("inputs_embeds", inputs_embeds);
+        } else {
+            m_request.set_tensor("input_ids", input_ids);
+        }
         m_request.set_tensor("position_ids", position_ids);
 
         // PA specific parameters
@@ -246,10 +295,9 @@ public:
         // print_tensor("max_context_len", max_context_len);
 
         {
-            static ManualTimer timer("pure generate inference");
-            timer.start();
+            TraceSpan infer_span("infer");
+            infer_span.arg("batch_tokens", total_num_tokens);
             m_request.infer();
-            timer.end();
         }
 
         if (m_collect_attention_scores) {
@@ -263,6 +311,22 @@ public:
     }
 
 private:
+    void _embed_generated_tokens(const std::vector<int64_t>& token_ids, const std::vector<size_t>& token_indices, ov::Tensor& inputs_embeds) {
+        if (token_ids.empty()) {
+            return;
+        }
+
+        ov::Tensor ids(ov::element::i64, {1, token_ids.size()}, const_cast<int64_t*>(token_ids.data()));
+        const ov::Tensor embeds = m_embedding.infer(ids);
+        OPENVINO_ASSERT(embeds.get_size() == token_ids.size() * m_hidden_size, "Unexpected shape of embeddings model output ", embeds.get_shape());
+
+        const float* embeds_data = embeds.data<float>();
+        float* inputs_embeds_data = inputs_embeds.data<float>();
+        for (size_t i = 0; i < token_indices.size(); ++i) {
+            std::copy_n(embeds_data + i * m_hidden_size, m_hidden_size, inputs_embeds_data + token_indices[i] * m_hidden_size);
+        }
+    }
+
     void _fill_indices_from_block_tables(
         const std::vector<std::string>& dst_tensor_names,
         const std::vector<SequenceGroup::Ptr>& sequence_groups,
@@ -406,18 +470,22 @@ private:
             }
         }
 
+        // score outputs are looked up once per step rather than for each sequence
+        std::vector<ov::Tensor> attention_scores_for_each_decoder_layer(m_num_decoder_layers);
+        for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; decoder_layer_id++) {
+            attention_scores_for_each_decoder_layer[decoder_layer_id] = m_request.get_tensor(get_paged_attention_score_output_for_decoder_layer(decoder_layer_id));
+        }
+
         for (const auto& seq_id_and_score_span : running_sequence_group_ids_and_kvcache_spans) {
-            auto attention_scores_across_decoder_layers_for_current_sequence = AttentionScoresForEachDecoderLayer(m_num_decoder_layers);
             size_t global_sequence_id = seq_id_and_score_span.first;
             IndexSpan span = seq_id_and_score_span.second;
+            auto& attention_scores_across_decoder_layers_for_current_sequence = m_last_attention_scores[global_sequence_id];
+            attention_scores_across_decoder_layers_for_current_sequence.resize(m_num_decoder_layers);
             for (size_t decoder_layer_id = 0; decoder_layer_id < m_num_decoder_layers; decoder_layer_id++) {
-                auto attention_score = m_request.get_tensor(get_paged_attention_score_output_for_decoder_layer(decoder_layer_id));
-                auto scores_for_cache_of_current_sequence_group = ov::Tensor(attention_score, ov::Coordinate{span.first}, ov::Coordinate{span.second});
-                auto copied_tensor = ov::Tensor(scores_for_cache_of_current_sequence_group.get_element_type(), ov::Shape{span.second - span.first});
-                scores_for_cache_of_current_sequence_group.copy_to(copied_tensor);
-                attention_scores_across_decoder_layers_for_current_sequence[decoder_layer_id] = scores_for_cache_of_current_sequence_group;
+                // scores are consumed before the next inference, so views into the output tensors are used without copying
+                attention_scores_across_decoder_layers_for_current_sequence[decoder_layer_id] =
+                    ov::Tensor(attention_scores_for_each_decoder_layer[decoder_layer_id], ov::Coordinate{span.first}, ov::Coordinate{span.second});
             }
-            m_last_attention_scores[global_sequence_id] = attention_scores_across_decoder_layers_for_current_sequence;
         }
     }
 };
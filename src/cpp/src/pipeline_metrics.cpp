@@ -0,0 +1,114 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "openvino/genai/continuous_batching_pipeline.hpp"
+
+namespace ov::genai {
+
+namespace {
+
+class PrometheusWriter {
+public:
+    explicit PrometheusWriter(const std::string& prefix) : m_prefix(prefix) {
+        // enough to keep integer gauges exact and not to expose binary rounding of bucket bounds
+        m_stream << std::setprecision(12);
+    }
+
+    void gauge(const std::string& name, const std::string& help, double value) {
+        header(name, help, "gauge");
+        m_stream << m_prefix << "_" << name << " " << value << "\n";
+    }
+
+    void counter(const std::string& name, const std::string& help, size_t value) {
+        header(name + "_total", help, "counter");
+        m_stream << m_prefix << "_" << name << "_total " << value << "\n";
+    }
+
+    void counter(const std::string& name, const std::string& help, const std::string& label, const std::vector<std::pair<std::string, size_t>>& values) {
+        header(name + "_total", help, "counter");
+        for (const auto& [label_value, value] : values)
+            m_stream << m_prefix << "_" << name << "_total{" << label << "=\"" << label_value << "\"} " << value << "\n";
+    }
+
+    // scale converts histogram values to base units, e.g. milliseconds to seconds
+    void histogram(const std::string& name, const std::string& help, const MetricsHistogram& histogram, double scale = 1.0) {
+        header(name, help, "histogram");
+        // Prometheus buckets are cumulative
+        size_t cumulative_count = 0;
+        for (size_t bucket_idx = 0; bucket_idx < histogram.counts.size(); ++bucket_idx) {
+            cumulative_count += histogram.counts[bucket_idx];
+            m_stream << m_prefix << "_" << name << "_bucket{le=\"";
+            if (bucket_idx < histogram.bounds.size())
+                m_stream << histogram.bounds[bucket_idx] * scale;
+            else
+                m_stream << "+Inf";
+            m_stream << "\"} " << cumulative_count << "\n";
+        }
+        m_stream << m_prefix << "_" << name << "_sum " << histogram.sum * scale << "\n";
+        m_stream << m_prefix << "_" << name << "_count " << histogram.count << "\n";
+    }
+
+    std::string str() const {
+        return m_stream.str();
+    }
+
+private:
+    void header(const std::string& name, const std::string& help, const std::string& type) {
+        m_stream << "# HELP " << m_prefix << "_" << name << " " << help << "\n";
+        m_stream << "# TYPE " << m_prefix << "_" << name << " " << type << "\n";
+    }
+
+    std::string m_prefix;
+    std::ostringstream m_stream;
+};
+
+}  // namespace
+
+std::string PipelineMetrics::to_prometheus(const std::string& prefix) const {
+    PrometheusWriter writer(prefix);
+
+    writer.gauge("requests", "Number of requests to be processed by the pipeline.", requests);
+    writer.gauge("waiting_requests", "Number of requests waiting for their prompts to be processed.", waiting_requests);
+    writer.gauge("running_requests", "Number of requests being processed.", running_requests);
+    writer.gauge("preempted_requests", "Number of preempted requests waiting to be scheduled again.", preempted_requests);
+    writer.gauge("scheduled_requests", "Number of requests scheduled at the previous step.", scheduled_requests);
+
+    writer.gauge("kv_cache_usage_percent", "KV cache usage at the previous step.", cache_usage);
+    writer.gauge("kv_cache_max_usage_percent", "Max KV cache usage during the lifetime of the pipeline.", max_cache_usage);
+    writer.gauge("kv_cache_avg_usage_percent", "Running average of KV cache usage.", avg_cache_usage);
+    writer.gauge("kv_cache_used_blocks", "Number of KV cache blocks occupied by sequences.", used_kv_blocks);
+    writer.gauge("kv_cache_free_blocks", "Number of KV cache blocks available for allocation, including cached ones.", free_kv_blocks);
+    writer.gauge("kv_cache_cached_blocks", "Number of free KV cache blocks which keep prefixes for prefix caching.", cached_kv_blocks);
+
+    writer.counter("preemptions", "Number of preemptions of requests by recompute.", "kind",
+                   {{"full", num_preemptions - num_partial_preemptions}, {"partial", num_partial_preemptions}});
+    writer.counter("prompt_tokens", "Number of prompt tokens of requests added to the pipeline.", prompt_tokens);
+    writer.counter("prefix_cache_hit_tokens", "Number of prompt tokens restored from prefix cache.", cached_prompt_tokens);
+    writer.counter("generated_tokens", "Number of generated tokens.", generated_tokens);
+    writer.counter("draft_tokens", "Number of draft tokens proposed by speculative decoding.", draft_tokens);
+    writer.counter("accepted_draft_tokens", "Number of draft tokens accepted by the main model.", accepted_draft_tokens);
+
+    writer.histogram("step_duration_seconds", "Duration of generation steps.", step_duration, 1e-3);
+    writer.histogram("step_tokens", "Number of tokens processed in a generation step.", tokens_per_step);
+
+    return writer.str();
+}
+
+void PipelineMetrics::write_prometheus(const std::filesystem::path& path, const std::string& prefix) const {
+    // collectors can read the file at any moment, so it's written aside and then renamed
+    std::filesystem::path tmp_path = path;
+    tmp_path += ".tmp";
+    {
+        std::ofstream file(tmp_path);
+        OPENVINO_ASSERT(file.is_open(), "Cannot open file ", tmp_path.string(), " to write metrics");
+        file << to_prometheus(prefix);
+        OPENVINO_ASSERT(file.good(), "Cannot write metrics to ", tmp_path.string());
+    }
+    std::filesystem::rename(tmp_path, path);
+}
+
+}  // namespace ov::genai
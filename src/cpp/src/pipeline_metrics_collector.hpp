@@ -0,0 +1,119 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "openvino/genai/continuous_batching_pipeline.hpp"
+
+namespace ov::genai {
+
+// Histogram which is updated by a single thread and can be read by any thread without locks
+class AtomicHistogram {
+public:
+    explicit AtomicHistogram(std::vector<double> bounds) :
+        m_bounds(std::move(bounds)),
+        m_counts(std::make_unique<std::atomic<size_t>[]>(m_bounds.size() + 1)) {
+        for (size_t bucket_idx = 0; bucket_idx <= m_bounds.size(); ++bucket_idx)
+            m_counts[bucket_idx].store(0, std::memory_order_relaxed);
+    }
+
+    void observe(double value) {
+        const size_t bucket_idx = std::lower_bound(m_bounds.begin(), m_bounds.end(), value) - m_bounds.begin();
+        m_counts[bucket_idx].fetch_add(1, std::memory_order_relaxed);
+        // single writer, so load + store doesn't lose updates
+        m_sum.store(m_sum.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    MetricsHistogram get() const {
+        MetricsHistogram histogram;
+        histogram.bounds = m_bounds;
+        histogram.counts.resize(m_bounds.size() + 1);
+        for (size_t bucket_idx = 0; bucket_idx <= m_bounds.size(); ++bucket_idx)
+            histogram.counts[bucket_idx] = m_counts[bucket_idx].load(std::memory_order_relaxed);
+        histogram.sum = m_sum.load(std::memory_order_relaxed);
+        // count is derived from buckets to be consistent with them
+        histogram.count = 0;
+        for (size_t count : histogram.counts)
+            histogram.count += count;
+        return histogram;
+    }
+
+private:
+    const std::vector<double> m_bounds;
+    std::unique_ptr<std::atomic<size_t>[]> m_counts;
+    std::atomic<double> m_sum{0.0};
+};
+
+/**
+ * Storage of PipelineMetrics which is updated by the thread calling step() and can be polled from other threads
+ * without blocking generation. Pipelines built on top of other pipelines (speculative decoding, prompt lookup)
+ * share the collector of the main pipeline.
+ */
+struct PipelineMetricsCollector {
+    std::atomic<size_t> requests{0};
+    std::atomic<size_t> waiting_requests{0};
+    std::atomic<size_t> running_requests{0};
+    std::atomic<size_t> preempted_requests{0};
+    std::atomic<size_t> scheduled_requests{0};
+
+    std::atomic<float> cache_usage{0.0f};
+    std::atomic<float> max_cache_usage{0.0f};
+    std::atomic<float> avg_cache_usage{0.0f};
+    std::atomic<size_t> used_kv_blocks{0};
+    std::atomic<size_t> free_kv_blocks{0};
+    std::atomic<size_t> cached_kv_blocks{0};
+
+    std::atomic<size_t> num_preemptions{0};
+    std::atomic<size_t> num_partial_preemptions{0};
+
+    std::atomic<size_t> prompt_tokens{0};
+    std::atomic<size_t> cached_prompt_tokens{0};
+    std::atomic<size_t> generated_tokens{0};
+    std::atomic<size_t> draft_tokens{0};
+    std::atomic<size_t> accepted_draft_tokens{0};
+
+    // step durations in milliseconds
+    AtomicHistogram step_duration{{1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000}};
+    AtomicHistogram tokens_per_step{{1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192}};
+
+    static void add(std::atomic<size_t>& counter, size_t value) {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    template <typename T, typename U>
+    static void set(std::atomic<T>& gauge, U value) {
+        gauge.store(static_cast<T>(value), std::memory_order_relaxed);
+    }
+
+    PipelineMetrics get() const {
+        PipelineMetrics metrics;
+        metrics.requests = requests.load(std::memory_order_relaxed);
+        metrics.waiting_requests = waiting_requests.load(std::memory_order_relaxed);
+        metrics.running_requests = running_requests.load(std::memory_order_relaxed);
+        metrics.preempted_requests = preempted_requests.load(std::memory_order_relaxed);
+        metrics.scheduled_requests = scheduled_requests.load(std::memory_order_relaxed);
+        metrics.cache_usage = cache_usage.load(std::memory_order_relaxed);
+        metrics.max_cache_usage = max_cache_usage.load(std::memory_order_relaxed);
+        metrics.avg_cache_usage = avg_cache_usage.load(std::memory_order_relaxed);
+        metrics.used_kv_blocks = used_kv_blocks.load(std::memory_order_relaxed);
+        metrics.free_kv_blocks = free_kv_blocks.load(std::memory_order_relaxed);
+        metrics.cached_kv_blocks = cached_kv_blocks.load(std::memory_order_relaxed);
+        metrics.num_preemptions = num_preemptions.load(std::memory_order_relaxed);
+        metrics.num_partial_preemptions = num_partial_preemptions.load(std::memory_order_relaxed);
+        metrics.prompt_tokens = prompt_tokens.load(std::memory_order_relaxed);
+        metrics.cached_prompt_tokens = cached_prompt_tokens.load(std::memory_order_relaxed);
+        metrics.generated_tokens = generated_tokens.load(std::memory_order_relaxed);
+        metrics.draft_tokens = draft_tokens.load(std::memory_order_relaxed);
+        metrics.accepted_draft_tokens = accepted_draft_tokens.load(std::memory_order_relaxed);
+        metrics.step_duration = step_duration.get();
+        metrics.tokens_per_step = tokens_per_step.get();
+        return metrics;
+    }
+};
+
+}  // namespace ov::genai
@@ -3,6 +3,13 @@
 
 #include "continuous_batching_for_prompt_lookup.hpp"
 
+namespace {
+
+// maximum size of n-grams of the index of recent outputs, which is shared by requests with different `max_ngram_size`
+constexpr size_t RECENT_OUTPUTS_MAX_NGRAM_SIZE = 4;
+
+}  // namespace
+
 namespace ov::genai {
 
 std::map<uint64_t, ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::SequenceLen>
@@ -17,67 +24,90 @@ ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::get_generated
     return result;
 }
 
-TokenIds ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::generate_candidates(const TokenIds& input_ids, size_t num_pred_tokens, size_t max_ngram_size) {
-    if (num_pred_tokens == 0) {
-        return std::vector<int64_t>{};
+void ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::set_recent_outputs_index_size(size_t max_num_tokens) {
+    if (max_num_tokens > 0) {
+        m_recent_outputs_index.emplace(RECENT_OUTPUTS_MAX_NGRAM_SIZE, max_num_tokens);
+    } else {
+        m_recent_outputs_index.reset();
     }
+}
 
-    const size_t input_length = input_ids.size();
-
-    for (int32_t ngram_size = max_ngram_size; ngram_size > 0; ngram_size--) {
-        // extract last ngram_size tokens as search ngram
-        std::vector<int64_t> ngram = std::vector<int64_t>{input_ids.cend() - ngram_size, input_ids.cend()};
-
-        // find ngram match in input_ids
-        size_t ngram_i = 0;
-        for (size_t input_i = 0; input_i < input_length - ngram_size; input_i++) {
-            if (ngram[ngram_i] != input_ids[input_i]) {
-                ngram_i = 0;
-                continue;
-            }
-
-            ngram_i++;
-
-            if (ngram_i < ngram_size) {
-                continue;
-            }
-
-            // match found with the end at input_i
-            size_t avaliable_num_pred = std::min(input_length - (input_i + 1), num_pred_tokens);
-
-            // return candidates with length of avaliable_num_pred
-            return std::vector<int64_t>{input_ids.cbegin() + input_i + 1,
-                                        input_ids.cbegin() + input_i + 1 + avaliable_num_pred};
+void ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::update_recent_outputs_index() {
+    // request IDs can be reused, so requests are compared by pointers
+    std::set<SequenceGroup*> requests;
+    for (const auto& request : m_requests) {
+        requests.insert(request.get());
+    }
+    for (auto it = m_request_ngram_indexes.begin(); it != m_request_ngram_indexes.end();) {
+        if (requests.count(it->second.request.get())) {
+            ++it;
+            continue;
+        }
+        const auto& sequences = it->second.request->get_sequences();
+        if (m_recent_outputs_index && !sequences.empty()) {
+            m_recent_outputs_index->add_output(sequences.front()->get_generated_ids().to_vector());
         }
+        it = m_request_ngram_indexes.erase(it);
     }
-
-    return std::vector<int64_t>{};
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl::generate_candidates() {
+    update_recent_outputs_index();
     for (auto& request : m_requests) {
-        const auto prompt = request->get_prompt_ids();
+        const auto& prompt = request->get_prompt_ids();
+        const auto sampling_params = request->get_sampling_parameters();
+        auto& index = m_request_ngram_indexes.try_emplace(request->get_request_id(),
+                                                          RequestNgramIndex{request, NgramIndex(sampling_params.max_ngram_size)}).first->second.index;
         size_t max_validation_len = 0;
         for (auto& running_sequence : request->get_running_sequences()) {
-            const auto generated_tokens = running_sequence->get_generated_ids();
-            TokenIds full_input_ids = prompt;
-            full_input_ids.insert(full_input_ids.end(), generated_tokens.begin(), generated_tokens.end());
+            // candidates of the previous step are validated at this point, so indexed tokens stay the same
+            // and only new tokens are added to the index
+            const auto& generated_tokens = running_sequence->get_generated_ids();
+            const size_t num_tokens = prompt.size() + generated_tokens.size();
+            if (index.size() > num_tokens) {
+                index.clear();
+            }
+            for (size_t token_idx = index.size(); token_idx < num_tokens; ++token_idx) {
+                index.add_token(token_idx < prompt.size() ? prompt[token_idx] : generated_tokens[token_idx - prompt.size()]);
+            }
 
             size_t min_num_assistant_tokens = 0;
-            const auto sampling_params = request->get_sampling_parameters();
             {
                 const auto generated_len = running_sequence->get_generated_len();
                 const auto left_generated_len = std::min(sampling_params.max_new_tokens, sampling_params.max_length) - generated_len - 1;
                 min_num_assistant_tokens = std::min(sampling_params.num_assistant_tokens, left_generated_len);
             }
-            TokenIds candidates = generate_candidates(full_input_ids, min_num_assistant_tokens, sampling_params.max_ngram_size);
+            // alternative branches are forked from a sequence, which already has its KV cache blocks
+            const bool can_fork = request->num_running_seqs() == 1 && running_sequence->get_generated_len() > 0 &&
+                                  m_scheduler->has_block_table(running_sequence->get_id());
+            const size_t num_branches = can_fork ? sampling_params.num_assistant_branches : 1;
+            std::vector<TokenIds> branches;
+            index.find_continuations(index.get_tokens(), sampling_params.max_ngram_size, min_num_assistant_tokens, num_branches, branches);
+            if (m_recent_outputs_index) {
+                m_recent_outputs_index->find_continuations(index.get_tokens(), sampling_params.max_ngram_size, min_num_assistant_tokens, num_branches, branches);
+            }
+            if (branches.empty()) {
+                continue;
+            }
 
-            if (!candidates.empty()) {
-                for (const auto& candidate : candidates) {
-                    running_sequence->append_token(candidate, 0);
+            // branches are validated together, so they have the same length as the first one
+            const size_t num_candidates = branches.front().size();
+            branches.erase(std::remove_if(branches.begin(), branches.end(), [num_candidates](const TokenIds& branch) {
+                return branch.size() < num_candidates;
+            }), branches.end());
+
+            // forked branches share KV cache blocks of the sequence and are validated by the main model in the same step
+            for (size_t branch_id = 1; branch_id < branches.size(); ++branch_id) {
+                Sequence::Ptr branch = request->fork_branch(running_sequence);
+                m_scheduler->fork_sequence(running_sequence->get_id(), branch->get_id());
+                for (size_t i = 0; i < num_candidates; ++i) {
+                    branch->append_token(branches[branch_id][i], 0);
                 }
-                max_validation_len = std::max(max_validation_len, candidates.size());
             }
+            for (const auto& candidate : branches.front()) {
+                running_sequence->append_token(candidate, 0);
+            }
+            max_validation_len = std::max(max_validation_len, num_candidates);
         }
         request->set_num_validated_tokens(max_validation_len);
     }
@@ -6,6 +6,7 @@
 #include "openvino/genai/continuous_batching_pipeline.hpp"
 
 #include "continuous_batching_impl.hpp"
+#include "ngram_index.hpp"
 
 namespace ov::genai {
 class ContinuousBatchingPipeline::ContinuousBatchingForPromptLookupImpl : public ContinuousBatchingPipeline::ContinuousBatchingImpl {
@@ -39,8 +40,22 @@ public:
 
     size_t get_processed_tokens_per_iteration();
 
+    // Enables lookup of candidates in outputs of recent requests, which keeps at most max_num_tokens tokens
+    void set_recent_outputs_index_size(size_t max_num_tokens);
+
     using ContinuousBatchingPipeline::ContinuousBatchingImpl::drop_requests;
 protected:
-    TokenIds generate_candidates(const TokenIds& input_ids, size_t num_pred_tokens, size_t max_ngram_size);
+    // n-gram index of prompt and validated generated tokens of a request
+    struct RequestNgramIndex {
+        SequenceGroup::Ptr request;
+        NgramIndex index;
+    };
+
+    // Moves outputs of requests which left the pipeline to the index of recent outputs
+    void update_recent_outputs_index();
+
+    // request ID => n-gram index of the request
+    std::map<uint64_t, RequestNgramIndex> m_request_ngram_indexes;
+    std::optional<RecentOutputsIndex> m_recent_outputs_index;
 };
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "ngram_index.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// n-grams are hashed from the last token to the first one by xxHash64 rounds, so hashes of all n-grams
+// ending at a position are computed in a single pass
+constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+uint64_t hash_round(uint64_t state, int64_t token_id) {
+    state += static_cast<uint64_t>(token_id) * PRIME64_2;
+    state = (state << 31) | (state >> 33);
+    return state * PRIME64_1;
+}
+
+uint64_t hash_finalize(uint64_t state, size_t ngram_size) {
+    state ^= static_cast<uint64_t>(ngram_size) * PRIME64_5;
+    state ^= state >> 33;
+    state *= PRIME64_2;
+    state ^= state >> 29;
+    state *= PRIME64_3;
+    state ^= state >> 32;
+    return state;
+}
+
+}  // namespace
+
+namespace ov::genai {
+
+NgramIndex::NgramIndex(size_t max_ngram_size) :
+    m_max_ngram_size(max_ngram_size) {}
+
+size_t NgramIndex::ContinuationKeyHash::operator()(const ContinuationKey& key) const {
+    return static_cast<size_t>(hash_finalize(hash_round(key.ngram_hash, key.token_id), 1));
+}
+
+void NgramIndex::add_token(int64_t token_id) {
+    const size_t position = m_tokens.size();
+    const size_t document_begin = m_document_begins.empty() ? 0 : m_document_begins.back();
+    m_tokens.push_back(token_id);
+
+    uint64_t state = PRIME64_5;
+    for (size_t ngram_size = 1; ngram_size <= std::min(m_max_ngram_size, position - document_begin); ++ngram_size) {
+        state = hash_round(state, m_tokens[position - ngram_size]);
+        const uint64_t ngram_hash = hash_finalize(state, ngram_size);
+        Continuation& continuation = m_continuations.try_emplace({ngram_hash, token_id}, Continuation{token_id, 0, position, position}).first->second;
+        ++continuation.count;
+        continuation.last_position = position;
+        rank(m_ranked_continuations[ngram_hash], continuation);
+    }
+}
+
+void NgramIndex::rank(std::vector<const Continuation*>& ranked_continuations, const Continuation& continuation) {
+    // more frequent continuations go first, continuations of the same frequency keep the order of first occurrence
+    auto is_ranked_before = [](const Continuation* lhs, const Continuation* rhs) {
+        return lhs->count > rhs->count || (lhs->count == rhs->count && lhs->first_position < rhs->first_position);
+    };
+
+    auto it = std::find(ranked_continuations.begin(), ranked_continuations.end(), &continuation);
+    if (it == ranked_continuations.end()) {
+        if (ranked_continuations.size() < MAX_RANKED_CONTINUATIONS) {
+            ranked_continuations.push_back(&continuation);
+        } else if (is_ranked_before(&continuation, ranked_continuations.back())) {
+            ranked_continuations.back() = &continuation;
+        } else {
+            return;
+        }
+        it = ranked_continuations.end() - 1;
+    }
+    // the count has only grown, so the continuation can only move up
+    for (; it != ranked_continuations.begin() && is_ranked_before(*it, *(it - 1)); --it) {
+        std::iter_swap(it, it - 1);
+    }
+}
+
+void NgramIndex::start_document() {
+    const size_t document_begin = m_document_begins.empty() ? 0 : m_document_begins.back();
+    if (m_tokens.size() > document_begin) {
+        m_document_begins.push_back(m_tokens.size());
+    }
+}
+
+void NgramIndex::clear() {
+    m_tokens.clear();
+    m_document_begins.clear();
+    m_continuations.clear();
+    m_ranked_continuations.clear();
+}
+
+size_t NgramIndex::get_document_end(size_t position) const {
+    auto it = std::upper_bound(m_document_begins.begin(), m_document_begins.end(), position);
+    return it != m_document_begins.end() ? *it : m_tokens.size();
+}
+
+void NgramIndex::find_continuations(const std::vector<int64_t>& context,
+                                    size_t max_ngram_size,
+                                    size_t max_num_tokens,
+                                    size_t max_num_continuations,
+                                    std::vector<std::vector<int64_t>>& continuations) const {
+    if (max_num_tokens == 0) {
+        return;
+    }
+
+    const size_t context_ngram_size = std::min({max_ngram_size, m_max_ngram_size, context.size()});
+    std::vector<uint64_t> ngram_hashes(context_ngram_size + 1);
+    uint64_t state = PRIME64_5;
+    for (size_t ngram_size = 1; ngram_size <= context_ngram_size; ++ngram_size) {
+        state = hash_round(state, context[context.size() - ngram_size]);
+        ngram_hashes[ngram_size] = hash_finalize(state, ngram_size);
+    }
+
+    for (size_t ngram_size = context_ngram_size; ngram_size > 0 && continuations.size() < max_num_continuations; --ngram_size) {
+        auto it = m_ranked_continuations.find(ngram_hashes[ngram_size]);
+        if (it == m_ranked_continuations.end()) {
+            continue;
+        }
+
+        for (const Continuation* continuation : it->second) {
+            if (continuations.size() == max_num_continuations) {
+                break;
+            }
+            const bool is_found = std::any_of(continuations.begin(), continuations.end(), [continuation](const std::vector<int64_t>& tokens) {
+                return tokens.front() == continuation->token_id;
+            });
+            // hashes of different n-grams may collide, so the n-gram is compared with the context
+            const auto ngram_begin = m_tokens.begin() + (continuation->first_position - ngram_size);
+            if (is_found || !std::equal(context.end() - ngram_size, context.end(), ngram_begin)) {
+                continue;
+            }
+
+            // the most recent occurrence is preferred, unless the first one gives a longer continuation
+            size_t position = continuation->last_position;
+            if (get_document_end(position) - position < max_num_tokens) {
+                position = continuation->first_position;
+            }
+            const size_t end = std::min(position + max_num_tokens, get_document_end(position));
+            continuations.emplace_back(m_tokens.begin() + position, m_tokens.begin() + end);
+        }
+    }
+}
+
+RecentOutputsIndex::RecentOutputsIndex(size_t max_ngram_size, size_t max_num_tokens) :
+    m_max_num_tokens(max_num_tokens),
+    m_current(max_ngram_size),
+    m_previous(max_ngram_size) {}
+
+void RecentOutputsIndex::add_output(const std::vector<int64_t>& output) {
+    // each of the indexes keeps at most a half of tokens
+    const size_t max_index_size = m_max_num_tokens / 2;
+    const size_t num_tokens = std::min(output.size(), max_index_size);
+    if (num_tokens == 0) {
+        return;
+    }
+    if (m_current.size() + num_tokens > max_index_size) {
+        std::swap(m_current, m_previous);
+        m_current.clear();
+    }
+    m_current.start_document();
+    m_current.add_tokens(output.end() - num_tokens, output.end());
+}
+
+void RecentOutputsIndex::find_continuations(const std::vector<int64_t>& context,
+                                            size_t max_ngram_size,
+                                            size_t max_num_tokens,
+                                            size_t max_num_continuations,
+                                            std::vector<std::vector<int64_t>>& continuations) const {
+    m_current.find_continuations(context, max_ngram_size, max_num_tokens, max_num_continuations, continuations);
+    m_previous.find_continuations(context, max_ngram_size, max_num_tokens, max_num_continuations, continuations);
+}
+
+}  // namespace ov::genai
@@ -0,0 +1,132 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ov::genai {
+
+/**
+ * @brief Index of n-grams of a token sequence, which maps each n-gram to the tokens following it.
+ * Appending a token updates the index in O(max_ngram_size), so a growing sequence is indexed incrementally.
+ * The sequence can consist of several documents, e.g. outputs of different requests: n-grams don't cross
+ * document boundaries and continuations don't run into the next document.
+ * Only MAX_RANKED_CONTINUATIONS most frequent continuations of each n-gram are looked up.
+ */
+class NgramIndex {
+public:
+    static constexpr size_t MAX_RANKED_CONTINUATIONS = 8;
+
+    explicit NgramIndex(size_t max_ngram_size);
+
+    // ranked continuations point to continuations in the index, so it can be moved, but not copied
+    NgramIndex(const NgramIndex&) = delete;
+    NgramIndex& operator=(const NgramIndex&) = delete;
+    NgramIndex(NgramIndex&&) = default;
+    NgramIndex& operator=(NgramIndex&&) = default;
+
+    void add_token(int64_t token_id);
+
+    template <typename Iterator>
+    void add_tokens(Iterator begin, Iterator end) {
+        for (auto it = begin; it != end; ++it) {
+            add_token(*it);
+        }
+    }
+
+    // Tokens added after this call belong to a new document
+    void start_document();
+
+    void clear();
+
+    /**
+     * Finds continuations of the longest n-gram at the end of the context, which occurs in the index.
+     * Continuations of shorter n-grams are taken if there are not enough of them. Continuations of n-grams
+     * of the same size are ranked by frequency of their first token, then by its first occurrence.
+     * @param context Tokens whose last max_ngram_size tokens (at most) are looked up.
+     * @param max_ngram_size Maximum size of looked up n-grams, limited by the size the index is built for.
+     * @param max_num_tokens Maximum number of tokens of a continuation.
+     * @param max_num_continuations Continuations are appended to `continuations` until it has that many of them.
+     * @param continuations Output continuations. They start with distinct tokens, so continuations whose
+     * first token is already there are skipped.
+     */
+    void find_continuations(const std::vector<int64_t>& context,
+                            size_t max_ngram_size,
+                            size_t max_num_tokens,
+                            size_t max_num_continuations,
+                            std::vector<std::vector<int64_t>>& continuations) const;
+
+    const std::vector<int64_t>& get_tokens() const {
+        return m_tokens;
+    }
+
+    size_t size() const {
+        return m_tokens.size();
+    }
+
+private:
+    struct Continuation {
+        int64_t token_id;
+        size_t count;
+        // positions of the first token of the continuation, the first one gives the longest continuation,
+        // the last one is the most recent context
+        size_t first_position;
+        size_t last_position;
+    };
+
+    struct ContinuationKey {
+        uint64_t ngram_hash;
+        int64_t token_id;
+
+        bool operator==(const ContinuationKey& other) const {
+            return ngram_hash == other.ngram_hash && token_id == other.token_id;
+        }
+    };
+
+    struct ContinuationKeyHash {
+        size_t operator()(const ContinuationKey& key) const;
+    };
+
+    size_t get_document_end(size_t position) const;
+
+    // moves the continuation, whose count has grown, up in the ranking of its n-gram
+    static void rank(std::vector<const Continuation*>& ranked_continuations, const Continuation& continuation);
+
+    size_t m_max_ngram_size;
+    std::vector<int64_t> m_tokens;
+    // start positions of documents except the first one
+    std::vector<size_t> m_document_begins;
+    // hash of n-gram and the token following it => continuation
+    std::unordered_map<ContinuationKey, Continuation, ContinuationKeyHash> m_continuations;
+    // hash of n-gram => its most frequent continuations in the order of ranking
+    std::unordered_map<uint64_t, std::vector<const Continuation*>> m_ranked_continuations;
+};
+
+/**
+ * @brief Index of recent outputs of requests, which keeps at most max_num_tokens tokens.
+ * Outputs are added to the current index. When it's full, it replaces the previous one, so the oldest outputs
+ * are dropped without removing separate entries from the index.
+ */
+class RecentOutputsIndex {
+public:
+    RecentOutputsIndex(size_t max_ngram_size, size_t max_num_tokens);
+
+    void add_output(const std::vector<int64_t>& output);
+
+    void find_continuations(const std::vector<int64_t>& context,
+                            size_t max_ngram_size,
+                            size_t max_num_tokens,
+                            size_t max_num_continuations,
+                            std::vector<std::vector<int64_t>>& continuations) const;
+
+private:
+    size_t m_max_num_tokens;
+    NgramIndex m_current;
+    NgramIndex m_previous;
+};
+
+}  // namespace ov::genai
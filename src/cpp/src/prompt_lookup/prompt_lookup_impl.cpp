@@ -50,7 +50,6 @@ void ContinuousBatchingPipeline::PromptLookupImpl::step() {
     m_pipeline->step();
     main_timer.end();
     m_sd_metrics.main_duration += main_timer.get_duration();
-    m_pipeline_metrics = m_pipeline->get_metrics();
     auto generated_len_after = m_pipeline->get_generated_request_len();
 
     for (const auto request : generated_len_before) {
@@ -70,6 +69,8 @@ void ContinuousBatchingPipeline::PromptLookupImpl::step() {
         }        
         m_sd_metrics.update_acceptance_rate(request_id, acceptance_rate * 100);
         m_sd_metrics.update_draft_accepted_tokens(request_id, num_matches);
+        PipelineMetricsCollector::add(m_pipeline_metrics->draft_tokens, prev_validation_len);
+        PipelineMetricsCollector::add(m_pipeline_metrics->accepted_draft_tokens, num_matches);
     }
 
     // update perf metrics
@@ -17,7 +17,6 @@ protected:
     SpeculativeDecodingMetrics m_sd_metrics;
     PerfMetrics m_perf_metrics;
 
-    void drop_requests();
 
 public:
     PromptLookupImpl(const std::shared_ptr<ov::Model>& model,
@@ -27,7 +26,20 @@ public:
                      const ov::AnyMap& properties,
                      const ov::genai::GenerationConfig& generation_config) {
         m_tokenizer = tokenizer;
-        m_pipeline = std::make_shared<ContinuousBatchingForPromptLookupImpl>(model, tokenizer, scheduler_config, device, properties, generation_config);
+        auto properties_without_shared_index = properties;
+        size_t shared_index_size = 0;
+        auto shared_index_size_it = properties_without_shared_index.find(ov::genai::prompt_lookup_shared_index_size.name());
+        if (shared_index_size_it != properties_without_shared_index.end()) {
+            // Python passes integer properties as int64_t
+            const int64_t size = shared_index_size_it->second.is<int64_t>() ? shared_index_size_it->second.as<int64_t>()
+                                                                            : static_cast<int64_t>(shared_index_size_it->second.as<size_t>());
+            OPENVINO_ASSERT(size >= 0, "prompt_lookup_shared_index_size must be non-negative, got ", size);
+            shared_index_size = static_cast<size_t>(size);
+            properties_without_shared_index.erase(shared_index_size_it);
+        }
+        m_pipeline = std::make_shared<ContinuousBatchingForPromptLookupImpl>(model, tokenizer, scheduler_config, device, properties_without_shared_index, generation_config);
+        m_pipeline->set_recent_outputs_index_size(shared_index_size);
+        m_pipeline_metrics = m_pipeline->get_metrics_collector();
     };
 
     GenerationHandle add_request(uint64_t request_id,
@@ -41,6 +53,8 @@ public:
 
     void step() override;
 
+    void drop_requests() override;
+
     std::vector<EncodedGenerationResult>
     generate(const std::vector<ov::Tensor>& input_ids,
              const std::vector<GenerationConfig>& sampling_params,
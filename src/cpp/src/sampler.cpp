@@ -96,91 +96,6 @@ std::vector<int64_t> encode_and_process_string(const std::string& stop_string, o
     return encoded_stop_string;
 }
 
-struct MatchStopStringResult {
-    size_t to_remove = 0;
-    // int64_t last_token_id = 0;
-    // bool is_to_update_last_token = false;
-    bool is_matched = false;
-};
-
-// Return number of last tokens that match one of the stop_strings. If there's no match 0 is returned.
-MatchStopStringResult match_stop_string(Tokenizer& tokenizer,
-                      const TokenIds& generated_tokens,
-                      const std::pair<size_t, std::set<std::string>>& stop_strings,
-                      bool is_include_to_output,
-                      size_t draft_generated_tokens = 0) {
-    MatchStopStringResult result;
-    if (generated_tokens.size() >= stop_strings.first) {
-        // draft_generated_tokens is to handle case with >= 1 generated tokens per step
-        size_t offset = generated_tokens.size() - draft_generated_tokens;
-        if (offset < stop_strings.first) {
-            return result;
-        }
-        offset -= stop_strings.first;
-        TokenIds buffer(generated_tokens.begin() + offset, generated_tokens.end());
-        std::string decoded_buffer = tokenizer.decode(buffer);
-        for (const auto& stop_string : stop_strings.second) {
-            auto pos = decoded_buffer.find(stop_string);
-            if (pos != std::string::npos) {
-                result.is_matched = true;
-
-                auto stop_string_len = is_include_to_output ? stop_string.length() : 0;
-                decoded_buffer = decoded_buffer.substr(0, pos + stop_string_len);
-                // to remove word splitting symbols from tail
-                while (decoded_buffer.back() == ' ' || decoded_buffer.back() == '\n') {
-                    decoded_buffer.pop_back();
-                }
-                if (decoded_buffer.empty()) {
-                    result.to_remove = buffer.size();
-                    return result;
-                }
-
-                // find token cnt to be removed from sequence by decoding token by token
-                std::string decoded_partially_string;
-                for (size_t i = 0; i < buffer.size(); ++i) {
-                    decoded_partially_string = tokenizer.decode(TokenIds{buffer.begin(), buffer.begin() + i + 1});
-                    if (decoded_partially_string.find(decoded_buffer) != std::string::npos) {
-                        result.to_remove = buffer.size() - i - 1;
-                        break;
-                    }
-                }
-                return result;
-            }
-        }
-    }
-    return result;
-}
-
-// Return number of last tokens that match one of the stop_strings. If there's no match 0 is returned.
-// Number of tokens might not be exact as if there's no direct token match, we decode generated tokens incrementally expanding decoding scope
-// with 4 next tokens with each iteration until we check all tokens.
-int match_stop_string2(Tokenizer & tokenizer, const TokenIds & generated_tokens, const std::set<std::string> & stop_strings) {
-    for (auto stop_string: stop_strings) {
-        auto stop_tokens_ov = tokenizer.encode(stop_string).input_ids;
-        size_t num_tokens = stop_tokens_ov.get_size();
-        if(num_tokens > generated_tokens.size())
-            continue;
-
-        // Check direct token match
-        std::vector<int64_t> stop_tokens(stop_tokens_ov.data<int64_t>(), stop_tokens_ov.data<int64_t>() + num_tokens);
-        std::vector<int64_t> last_generated_tokens(generated_tokens.end()-num_tokens, generated_tokens.end());
-        if (stop_tokens == last_generated_tokens)
-            return num_tokens;
-        
-        // Continue checking chunks of 4 tokens
-        num_tokens += 4;
-        while (num_tokens <= generated_tokens.size()) {
-            std::vector<int64_t> last_generated_tokens(generated_tokens.end()-num_tokens, generated_tokens.end());
-            std::string decoded_last_tokens = tokenizer.decode(last_generated_tokens);
-            if (decoded_last_tokens.find(stop_string) != std::string::npos) {
-                return num_tokens;
-            }
-            num_tokens += 4;
-        }
-    }
-    return 0;
-}
-
 void Sampler::GroupBeamSearcher::finalize(SamplerOutput& sampler_output) {
     for (Group& group : m_groups) {
         if (!group.done) {
@@ -242,7 +157,7 @@ std::map<size_t, int32_t> Sampler::GroupBeamSearcher::get_beam_idxs() {
 
 void Sampler::GroupBeamSearcher::select_next_tokens(const ov::Tensor& logits,
     SamplerOutput& sampler_output,
-    const std::pair<size_t, std::set<std::string>>& stop_strings) {
+    StopStringMatcher* stop_strings) {
     assert(m_parameters.num_beams % m_parameters.num_beam_groups == 0 &&
         "number of beams should be divisible by number of groups");
     size_t group_size = m_parameters.num_beams / m_parameters.num_beam_groups;
@@ -334,7 +249,9 @@ void Sampler::GroupBeamSearcher::select_next_tokens(const ov::Tensor& logits,
             }
 
             // apply n_gramm
-            std::vector<int64_t> full_text{m_sequence_group->get_prompt_ids()};
+            std::vector<int64_t> full_text;
+            if (m_sequence_group->get_sequence_group_type() == SequenceGroupType::TOKENS)
+                full_text = m_sequence_group->get_prompt_ids();
             full_text.insert(full_text.end(), beam.m_sequence->get_generated_ids().begin(), beam.m_sequence->get_generated_ids().end());
             if (full_text.size() > 1 && full_text.size() >= m_parameters.no_repeat_ngram_size) {
                 auto tail_start = full_text.end() - ptrdiff_t(m_parameters.no_repeat_ngram_size) + 1;
@@ -385,12 +302,9 @@ void Sampler::GroupBeamSearcher::select_next_tokens(const ov::Tensor& logits,
                 continue;
             }
 
-            if (!m_parameters.stop_strings.empty()) {
-                // We need to include candidate token to already generated tokens to check if stop string has been generated
-                // There's probably a better way to do that, than copying whole vector...
-                std::vector<int64_t> token_ids = candidate.m_sequence->get_generated_ids();
-                token_ids.push_back(candidate.m_token_id);
-                auto match_result = match_stop_string(m_tokenizer, token_ids, stop_strings, m_parameters.include_stop_str_in_output);
+            if (stop_strings) {
+                // candidate token is not appended to a sequence yet, so it's matched on top of already generated tokens
+                auto match_result = stop_strings->match_candidate(candidate.m_sequence->get_generated_ids(), candidate.m_token_id);
                 if (match_result.is_matched) {
                     // If beam_token does not belong to top num_beams tokens, it should not be added
                     if (cand_idx >= group_size)
@@ -551,7 +465,7 @@ std::vector<Token> Sampler::_multinomial_sample(const Logits& logits, size_t num
     return out_tokens;
 }
 
-std::vector<int64_t> Sampler::_try_finish_generation(SequenceGroup::Ptr & sequence_group) {
+std::vector<int64_t> Sampler::_try_finish_generation(SequenceGroup::Ptr & sequence_group, StopStringMatcher* stop_strings) {
     auto sampling_params = sequence_group->get_sampling_parameters();
     std::vector<int64_t> dropped_seq_ids;
     for (auto& running_sequence : sequence_group->get_running_sequences()) {
@@ -571,10 +485,9 @@ std::vector<int64_t> Sampler::_try_finish_generation(SequenceGroup::Ptr & sequen
             continue;
         }
 
-        if (!sampling_params.stop_strings.empty()) {
-            auto& stop_strings = m_stop_strings.at(sequence_group->get_request_id());
-            auto match_result = match_stop_string(m_tokenizer, running_sequence->get_generated_ids(), stop_strings,
-                                                  sampling_params.include_stop_str_in_output, sequence_group->get_num_tokens_to_validate());
+        if (stop_strings) {
+            auto match_result = stop_strings->match(running_sequence->get_id(), running_sequence->get_generated_ids(),
+                                                    sequence_group->get_num_tokens_to_validate());
             if (match_result.is_matched) {
                 running_sequence->remove_last_tokens(match_result.to_remove);
 
@@ -647,12 +560,48 @@ stop_sample_tokens(Sequence::Ptr running_sequence,
     max_removed_tokens_per_request = std::max(max_removed_tokens_per_request, token_idx);
 }
 
+// Registers or unregisters tokens of a candidate branch, which were validated or sampled at the current step, in penalties
+void
+update_branch_token_occurrences(Sequence::Ptr branch,
+                                size_t validation_start_len,
+                                LogitProcessor& logit_processor,
+                                bool is_register) {
+    const auto& generated_token_ids = branch->get_generated_ids();
+    for (size_t i = validation_start_len; i < branch->get_generated_len(); ++i) {
+        if (is_register) {
+            logit_processor.register_new_generated_token(generated_token_ids[i]);
+        } else {
+            logit_processor.decrease_generated_token_occurance(generated_token_ids[i]);
+        }
+    }
+}
+
+// Keeps the candidate branch with the longest accepted prefix, other branches are dropped
+size_t
+keep_longest_branch(SequenceGroup::Ptr sequence_group,
+                    const std::vector<Sequence::Ptr>& branches,
+                    SamplerOutput& sampler_output) {
+    size_t best_branch_id = 0;
+    for (size_t branch_id = 1; branch_id < branches.size(); ++branch_id) {
+        if (branches[branch_id]->get_generated_len() > branches[best_branch_id]->get_generated_len()) {
+            best_branch_id = branch_id;
+        }
+    }
+    for (size_t branch_id = 0; branch_id < branches.size(); ++branch_id) {
+        if (branch_id != best_branch_id) {
+            sampler_output.m_dropped_sequences.push_back(branches[branch_id]->get_id());
+            sequence_group->remove_sequence(branches[branch_id]->get_id());
+        }
+    }
+    return best_branch_id;
+}
+
 void
 align_all_sequence_len(SequenceGroup::Ptr& sequence_group,
                        size_t min_generated_tokens,
                        LogitProcessor& logit_processor) {
     for (auto& sequence : sequence_group->get_running_sequences()) {
-        const auto generated_token_ids = sequence->get_generated_ids();
+        const auto& generated_token_ids = sequence->get_generated_ids();
         auto generated_len = sequence->get_generated_len();
         if (generated_len > min_generated_tokens) {
             auto removed_token_cnt = generated_len - min_generated_tokens;
@@ -739,21 +688,17 @@ float get_p_prime(Sequence::Ptr& running_sequence,
     return p_prime;
 }
 
-std::pair<size_t, std::set<std::string>>
-process_stop_strings(const std::set<std::string>& stop_strings, Tokenizer& tokenizer) {
-    std::pair<size_t, std::set<std::string>> result;
+// Max number of tokens in encoded stop strings, which is used as a number of last tokens to hold from streaming
+size_t get_max_encoded_length(const std::set<std::string>& stop_strings, Tokenizer& tokenizer) {
+    size_t max_encoded_length = 0;
     for (const auto& stop_string : stop_strings) {
-        auto encoded_stop_string = encode_and_process_string(stop_string, tokenizer);
-        if (result.first < encoded_stop_string.size()) {
-            result.first = encoded_stop_string.size();
-        }
-        result.second.insert(stop_string);
+        max_encoded_length = std::max(max_encoded_length, encode_and_process_string(stop_string, tokenizer).size());
     }
-    return result;
+    return max_encoded_length;
 }
 
 SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr sequence_group, ov::Tensor sequence_group_logits, 
-                                                              LogitProcessor& logit_processor, const std::pair<size_t, std::set<std::string>>& stop_strings, 
+                                                              LogitProcessor& logit_processor, StopStringMatcher* stop_strings,
                                                               bool is_validation_mode_enabled) {
     SequenceGroupSamplingInfo sg_sampling_info;
     // Assistant pipeline info is relevant for speculative and prompt lookup decoding
@@ -772,12 +717,23 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
     if (sampling_params.is_greedy_decoding() || sampling_params.is_multinomial()) {
         std::vector<Sequence::Ptr> running_sequences = sequence_group->get_running_sequences();
         size_t num_running_sequences = sequence_group->num_running_seqs();
+        // several running sequences of greedy decoding are alternative candidate branches proposed by prompt lookup,
+        // each of them is validated separately and only the one with the longest accepted prefix is kept
+        const bool is_branch_validation = sampling_params.is_greedy_decoding() && num_running_sequences > 1;
         if (sampling_params.is_greedy_decoding()) {
-            OPENVINO_ASSERT(num_running_sequences == 1);
+            OPENVINO_ASSERT(num_running_sequences == 1 || is_validation_mode_enabled);
         }
+        // { num_generated_tokens, max_removed_tokens } of each candidate branch
+        std::vector<std::pair<size_t, size_t>> branch_sampling_results;
+        // generated length of branches before their candidates, which is common for all branches
+        const size_t validation_start_len = is_branch_validation ? running_sequences[0]->get_generated_len() - num_tokens_to_process : 0;
         for (size_t running_sequence_id = 0; running_sequence_id < num_running_sequences; ++running_sequence_id) {
             auto& running_sequence = running_sequences[running_sequence_id];
             bool is_validation_passed = true;
+            if (is_branch_validation) {
+                sg_sampling_info.sampler_output.num_generated_tokens = 0;
+                assisting_pipeline_info.max_removed_tokens_per_request = 0;
+            }
             // make `num_tokens_to_process` iteration to validate a candidate generated by `draft_model` + 1 iteration to generate one more token by `main_model`
             for (size_t i = 0; i <= num_tokens_to_process; ++i) {
                 sg_sampling_info.sampler_output.num_generated_tokens++;
@@ -801,6 +757,7 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
                 }
 
                 auto logit_vector = _get_logit_vector(sequence_group_logits, running_sequence_id, token_offset);
+                logit_processor.set_current_sequence(running_sequence->get_id(), running_sequence->get_generated_ids(), generated_and_verified_len);
                 logit_processor.apply(logit_vector);
 
                 Token sampled_token;
@@ -854,11 +811,29 @@ SequenceGroupSamplingInfo Sampler::sample_from_sequence_group(SequenceGroup::Ptr
                 }
             }
             assisting_pipeline_info.min_generated_len = std::min(assisting_pipeline_info.min_generated_len, running_sequence->get_generated_len());
+            if (is_branch_validation) {
+                branch_sampling_results.emplace_back(sg_sampling_info.sampler_output.num_generated_tokens,
+                                                     assisting_pipeline_info.max_removed_tokens_per_request);
+                // tokens of the branch must not be penalized while other branches are validated
+                update_branch_token_occurrences(running_sequence, validation_start_len, logit_processor, false);
+            }
+        }
+        if (is_branch_validation) {
+            const size_t best_branch_id = keep_longest_branch(sequence_group, running_sequences, sg_sampling_info.sampler_output);
+            auto& best_branch = running_sequences[best_branch_id];
+            update_branch_token_occurrences(best_branch, validation_start_len, logit_processor, true);
+            sg_sampling_info.sampler_output.num_generated_tokens = branch_sampling_results[best_branch_id].first;
+            assisting_pipeline_info.max_removed_tokens_per_request = branch_sampling_results[best_branch_id].second;
+            assisting_pipeline_info.min_generated_len = best_branch->get_generated_len();
         }
         align_all_sequence_len(sequence_group, assisting_pipeline_info.min_generated_len, logit_processor);
-        for (const auto& dropped_seq_id : _try_finish_generation(sequence_group)) {
+        for (const auto& dropped_seq_id : _try_finish_generation(sequence_group, stop_strings)) {
             sg_sampling_info.sampler_output.m_dropped_sequences.push_back(dropped_seq_id);
         }
+        // masks for the next tokens are computed while the model infers their logits
+        for (const auto& running_sequence : sequence_group->get_running_sequences()) {
+            logit_processor.prefetch_next_token_mask(running_sequence->get_id(), running_sequence->get_generated_ids(), m_thread_pool);
+        }
     } else if (sampling_params.is_beam_search()) {
         uint64_t request_id = sequence_group->get_request_id();
 
@@ -911,14 +886,21 @@ SamplerOutput Sampler::sample(const std::vector<SequenceGroup::Ptr> & sequence_g
 
         const auto request_id = sequence_group->get_request_id();
         if (!m_logit_processors.count(request_id)) {
-            m_logit_processors.insert({request_id, LogitProcessor(sampling_params, sequence_group->get_prompt_ids())});
+            // prompt ids of embeddings based requests are not token ids, so only generated tokens are penalized
+            const TokenIds& prompt_ids = sequence_group->get_sequence_group_type() == SequenceGroupType::TOKENS ? sequence_group->get_prompt_ids() : TokenIds{};
+            m_logit_processors.insert({request_id, LogitProcessor(sampling_params, prompt_ids)});
         }
-        if (!m_stop_strings.count(request_id)) {
-            auto processed_stop_string = process_stop_strings(sampling_params.stop_strings, m_tokenizer);
-            m_stop_strings.insert({request_id, processed_stop_string});
-            sequence_group->set_stream_window_size(processed_stop_string.first);
+        if (!sampling_params.stop_strings.empty() && !m_stop_strings.count(request_id)) {
+            m_stop_strings.emplace(request_id, StopStringMatcher(sampling_params.stop_strings, get_token_bytes(vocab_size), sampling_params.include_stop_str_in_output));
+            sequence_group->set_stream_window_size(get_max_encoded_length(sampling_params.stop_strings, m_tokenizer));
         }
-        const auto& stop_strings = m_stop_strings.at(request_id);
+        if (sampling_params.structured_output_config.has_value() && !m_logit_processors.at(request_id).has_structured_output()) {
+            m_logit_processors.at(request_id).set_structured_output(get_structured_output_grammar(*sampling_params.structured_output_config, vocab_size),
+                                                                    sampling_params.stop_token_ids);
+        }
+        // pointer is used by sampling tasks, as other requests are inserted to the map in parallel
+        auto stop_strings_it = m_stop_strings.find(request_id);
+        StopStringMatcher* stop_strings = stop_strings_it != m_stop_strings.end() ? &stop_strings_it->second : nullptr;
         auto& logit_processor = m_logit_processors.at(request_id);
         const void * sequence_group_logits_data = logits_data + vocab_size * currently_processed_tokens;
         ov::Tensor sequence_group_logits(ov::element::f32, ov::Shape{num_running_sequences, output_seq_len, vocab_size}, (void *)sequence_group_logits_data);
@@ -944,6 +926,16 @@ SamplerOutput Sampler::sample(const std::vector<SequenceGroup::Ptr> & sequence_g
             sg_sampling_info = sg_sampling_future_map[request_id].get();
             sampler_output.num_generated_tokens += sg_sampling_info.sampler_output.num_generated_tokens;
 
+            // states of stop strings matching and structured output are not needed for dropped sequences anymore
+            auto stop_strings_it = m_stop_strings.find(request_id);
+            auto& logit_processor = get_logit_processor(request_id);
+            for (uint64_t dropped_seq_id : sg_sampling_info.sampler_output.m_dropped_sequences) {
+                if (stop_strings_it != m_stop_strings.end()) {
+                    stop_strings_it->second.drop_sequence(dropped_seq_id);
+                }
+                logit_processor.drop_sequence(dropped_seq_id);
+            }
+
             // Merge sampler output from sequence group to the main one
             sampler_output.m_dropped_sequences.insert(
                 sampler_output.m_dropped_sequences.end(),
@@ -977,6 +969,99 @@ SamplerOutput Sampler::sample(const std::vector<SequenceGroup::Ptr> & sequence_g
     return sampler_output;
 }
 
+void Sampler::set_vocab_size(size_t vocab_size) {
+    m_vocab_size = vocab_size;
+    m_token_bytes.reset();
+    m_sorted_vocabulary.reset();
+    m_structured_output_grammars.clear();
+    m_token_bytes_future = {};
+    if (m_vocab_size == 0) {
+        return;
+    }
+    // vocabulary is decoded in background, so the first request with stop strings or structured output
+    // doesn't decode it in the middle of a generation step
+    m_token_bytes_future = std::async(std::launch::async, [tokenizer = m_tokenizer, vocab_size]() mutable {
+        return std::make_shared<const TokenBytesTable>(TokenBytesTable::build(tokenizer, vocab_size));
+    }).share();
+}
+
+std::shared_ptr<const TokenBytesTable> Sampler::get_token_bytes(size_t vocab_size) {
+    if (!m_token_bytes && m_token_bytes_future.valid() && m_vocab_size == vocab_size) {
+        m_token_bytes = m_token_bytes_future.get();
+        m_token_bytes_future = {};
+    }
+    // vocabulary is decoded once and shared by all requests
+    if (!m_token_bytes || m_token_bytes->size() != vocab_size) {
+        m_token_bytes = std::make_shared<const TokenBytesTable>(TokenBytesTable::build(m_tokenizer, vocab_size));
+        m_sorted_vocabulary.reset();
+        m_structured_output_grammars.clear();
+    }
+    return m_token_bytes;
+}
+
+namespace {
+
+std::string get_structured_output_key(const StructuredOutputConfig& config) {
+    if (config.json_schema.has_value()) {
+        return "json_schema:" + *config.json_schema;
+    } else if (config.regex.has_value()) {
+        return "regex:" + *config.regex;
+    } else if (config.grammar.has_value()) {
+        return "grammar:" + *config.grammar;
+    }
+    return {};
+}
+
+// grammars and automata in use are kept alive by logit processors of their requests
+constexpr size_t max_cached_grammars = 64;
+
+}  // namespace
+
+std::shared_ptr<const RegexAutomaton> Sampler::compile_structured_output(const StructuredOutputConfig& config) {
+    const std::string key = get_structured_output_key(config);
+    {
+        std::lock_guard<std::mutex> lock(m_structured_output_automata_mutex);
+        auto it = m_structured_output_automata.find(key);
+        if (it != m_structured_output_automata.end()) {
+            return it->second;
+        }
+    }
+
+    // compiled outside of the lock, so a complex constraint doesn't block other requests
+    std::shared_ptr<const RegexAutomaton> automaton;
+    try {
+        automaton = std::make_shared<const RegexAutomaton>(structured_output_to_regex(config));
+    } catch (const std::exception& error) {
+        OPENVINO_THROW("Invalid structured output constraint: ", error.what());
+    }
+
+    std::lock_guard<std::mutex> lock(m_structured_output_automata_mutex);
+    if (m_structured_output_automata.size() >= max_cached_grammars) {
+        m_structured_output_automata.clear();
+    }
+    return m_structured_output_automata.emplace(key, automaton).first->second;
+}
+
+std::shared_ptr<StructuredOutputGrammar> Sampler::get_structured_output_grammar(const StructuredOutputConfig& config, size_t vocab_size) {
+    std::shared_ptr<const TokenBytesTable> token_bytes = get_token_bytes(vocab_size);
+    if (!m_sorted_vocabulary) {
+        m_sorted_vocabulary = std::make_shared<const SortedVocabulary>(token_bytes);
+    }
+
+    const std::string key = get_structured_output_key(config);
+    auto it = m_structured_output_grammars.find(key);
+    if (it != m_structured_output_grammars.end()) {
+        return it->second;
+    }
+    if (m_structured_output_grammars.size() >= max_cached_grammars) {
+        m_structured_output_grammars.clear();
+    }
+    // the constraint is compiled by add_request() of continuous batching pipelines already, so it's only looked up
+    auto grammar = std::make_shared<StructuredOutputGrammar>(compile_structured_output(config), m_sorted_vocabulary);
+    m_structured_output_grammars.emplace(key, grammar);
+    return grammar;
+}
+
 LogitProcessor& Sampler::get_logit_processor(uint64_t request_id) {
     OPENVINO_ASSERT(m_logit_processors.count(request_id));
     return m_logit_processors.at(request_id);
@@ -11,6 +11,7 @@
 #include <map>
 #include <algorithm>
 #include <cmath>
+#include <future>
 #include <random>
 #include <set>
 
@@ -19,6 +20,8 @@
 #include "logit_processor.hpp"
 #include "scheduler.hpp"
 #include "sequence_group.hpp"
+#include "stop_string_matcher.hpp"
+#include "structured_output.hpp"
 #include "threadpool.hpp"
 
 namespace ov::genai {
@@ -64,15 +67,18 @@ class Sampler {
     Logits _get_logit_vector(ov::Tensor logits, size_t batch_idx, size_t token_idx);
     Token _greedy_sample(const Logits& logits, size_t top_logprobs) const;
     std::vector<Token> _multinomial_sample(const Logits& logits, size_t num_tokens_per_sequence);
-    std::vector<int64_t> _try_finish_generation(SequenceGroup::Ptr & sequence_group);
+    std::vector<int64_t> _try_finish_generation(SequenceGroup::Ptr & sequence_group, StopStringMatcher* stop_strings);
 
     bool validate_candidate(Sequence::Ptr running_sequence, size_t& token_idx, Token& sampled_token,
                             bool& is_extend_sequence, size_t& max_removed_tokens, bool do_sample);
 
     SequenceGroupSamplingInfo sample_from_sequence_group(SequenceGroup::Ptr sequence_group, ov::Tensor sequence_group_logits,
-                                                        LogitProcessor& logit_processor, const std::pair<size_t, std::set<std::string>>& stop_strings,
+                                                        LogitProcessor& logit_processor, StopStringMatcher* stop_strings,
                                                         bool is_validation_mode_enabled);
 
+    std::shared_ptr<const TokenBytesTable> get_token_bytes(size_t vocab_size);
+    std::shared_ptr<StructuredOutputGrammar> get_structured_output_grammar(const StructuredOutputConfig& config, size_t vocab_size);
+
     // request ID => beam search tracking information
     std::map<uint64_t, GroupBeamSearcher> m_beam_search_info;
     std::mutex m_beam_search_info_mutex;
@@ -81,8 +87,20 @@ class Sampler {
     size_t seed = rng_engine.default_seed;
     // { request_id, logit_processor }
     std::map<uint64_t, LogitProcessor> m_logit_processors;
-    // { request_id, { max_encoded_len, { stop_strings }}}
-    std::map<int64_t, std::pair<size_t, std::set<std::string>>> m_stop_strings;
+    // { request_id, stop_strings_matcher }
+    std::map<int64_t, StopStringMatcher> m_stop_strings;
+    // decoded vocabulary, built in background when both tokenizer and vocabulary size are set,
+    // or on the first request with stop strings or structured output otherwise
+    std::shared_ptr<const TokenBytesTable> m_token_bytes;
+    std::shared_future<std::shared_ptr<const TokenBytesTable>> m_token_bytes_future;
+    size_t m_vocab_size = 0;
+    std::shared_ptr<const SortedVocabulary> m_sorted_vocabulary;
+    // { constraint, grammar } compiled grammars with cached token masks, shared by requests with the same constraint
+    std::map<std::string, std::shared_ptr<StructuredOutputGrammar>> m_structured_output_grammars;
+    // { constraint, automaton } constraints compiled by compile_structured_output(). It's called when requests are added,
+    // possibly by other threads than sample(), so the map is guarded by m_structured_output_automata_mutex
+    std::map<std::string, std::shared_ptr<const RegexAutomaton>> m_structured_output_automata;
+    std::mutex m_structured_output_automata_mutex;
 
     Tokenizer m_tokenizer;
 
@@ -103,10 +121,19 @@ public:
 
     void set_tokenizer(const Tokenizer& tokenizer) {
         m_tokenizer = tokenizer;
+        set_vocab_size(m_vocab_size);
     }
 
+    // Sets a number of logits of the model, so the vocabulary is decoded for stop strings and structured output
+    // before the first request using them
+    void set_vocab_size(size_t vocab_size);
+
     void clear_request_info(uint64_t request_id);
 
+    // Compiles a structured output constraint of a request and caches it for sample(), so an invalid or too complex
+    // constraint is rejected when the request is added instead of failing a generation step
+    std::shared_ptr<const RegexAutomaton> compile_structured_output(const StructuredOutputConfig& config);
+
     LogitProcessor& get_logit_processor(uint64_t request_id);
     void create_logit_processor(uint64_t request_id, const GenerationConfig& sampling_parameters, const TokenIds& prompt);
 
@@ -153,7 +180,7 @@ class Sampler::GroupBeamSearcher {
 public:
     explicit GroupBeamSearcher(SequenceGroup::Ptr sequence_group, Tokenizer tokenizer);
 
-    void select_next_tokens(const ov::Tensor& logits, SamplerOutput& sampler_output, const std::pair<size_t, std::set<std::string>>& stop_strings);
+    void select_next_tokens(const ov::Tensor& logits, SamplerOutput& sampler_output, StopStringMatcher* stop_strings);
     void finalize(SamplerOutput& sampler_output);
     std::map<size_t, int32_t> get_beam_idxs();
 };
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdlib>
 #include <vector>
 
@@ -13,6 +14,7 @@
 #include "sequence_group.hpp"
 #include "cache_manager.hpp"
 #include "timer.hpp"
+#include "tracing.hpp"
 #include "utils.hpp"
 
 namespace ov::genai {
@@ -28,8 +30,19 @@ class Scheduler {
     // Dynamic KV-cache allocation params
     size_t m_kv_blocks_initial_multiplier = 2;
     const float m_cache_growth_factor = 2; // commmon values 1.5 or 2
+    // number of KV blocks allocated at start, the cache is not shrunk below it
+    size_t m_num_initial_kv_blocks = 0;
+    // the cache is shrunk after this number of consecutive steps with usage below m_cache_shrink_usage_threshold percent
+    const size_t m_cache_shrink_num_steps = 100;
+    const float m_cache_shrink_usage_threshold = 25;
+    size_t m_num_low_cache_usage_steps = 0;
 
     std::shared_ptr<CacheManager> m_cache_manager;
+
+    // total number of preemptions by recompute
+    size_t m_num_preemptions = 0;
+    // number of preemptions by recompute which released only a part of sequence group blocks
+    size_t m_num_partial_preemptions = 0;
 public:
     struct Output {
         // IDs of scheduled groups
@@ -42,6 +55,12 @@ public:
         bool is_prompt = false;
         // current cache usage
         float m_cache_usage = 0.0;
+        // number of KV cache blocks occupied by sequences
+        size_t m_num_used_blocks = 0;
+        // number of KV cache blocks available for allocation, including cached ones
+        size_t m_num_free_blocks = 0;
+        // number of free KV cache blocks which keep prefixes for prefix caching
+        size_t m_num_cached_blocks = 0;
     };
 
     Scheduler(size_t block_size, std::shared_ptr<CacheManager> cache_manager, const SchedulerConfig & config = {}, size_t num_layers = 1, bool can_use_partial_preemption = true) :
@@ -50,6 +69,8 @@ public:
         m_config(config) {
         m_block_manager = std::make_shared<BlockManager>(m_config.num_kv_blocks, m_config.enable_prefix_caching, block_size, num_layers);
         OPENVINO_ASSERT(num_layers != 0, "num_layers must be non-zero");
+        OPENVINO_ASSERT(m_config.high_priority_tokens_share >= 0.f && m_config.high_priority_tokens_share < 1.f,
+                        "SchedulerConfig.high_priority_tokens_share must be in range [0, 1)");
     }
 
     void release() {
@@ -90,11 +111,21 @@ public:
         m_cache_manager->allocate_cache_if_needed(m_block_manager->get_total_number_of_kv_blocks());
         _clear_waiting_sequences(sequence_groups);
         scheduler_output.m_cache_usage = m_block_manager->get_used_percentage();
-
-        static ManualTimer copy_blocks_timer("copy block");
-        copy_blocks_timer.start();
-        m_cache_manager->copy_blocks(block_copy_map);
-        copy_blocks_timer.end();
+        scheduler_output.m_num_free_blocks = m_block_manager->num_free_blocks();
+        scheduler_output.m_num_used_blocks = m_block_manager->get_total_number_of_kv_blocks() - scheduler_output.m_num_free_blocks;
+        scheduler_output.m_num_cached_blocks = m_block_manager->num_overwriteable_blocks();
+        _maybe_shrink_cache(scheduler_output);
+
+        {
+            TraceSpan copy_blocks_span("copy blocks");
+            if (copy_blocks_span.is_recording()) {
+                size_t num_block_copies = 0;
+                for (const auto& src_and_dst_blocks : block_copy_map)
+                    num_block_copies += src_and_dst_blocks.second.size();
+                copy_blocks_span.arg("block_copies", num_block_copies);
+            }
+            m_cache_manager->copy_blocks(block_copy_map);
+        }
 
         return scheduler_output;
     }
@@ -140,6 +171,20 @@ public:
         return m_config;
     }
 
+    // cache eviction config of the request has priority over the config of the pipeline
+    const CacheEvictionConfig& get_cache_eviction_config(const SequenceGroup::CPtr& sequence_group) const {
+        const auto& request_eviction_config = sequence_group->get_sampling_parameters().cache_eviction_config;
+        return request_eviction_config.has_value() ? *request_eviction_config : m_config.cache_eviction_config;
+    }
+
+    size_t get_num_preemptions() const {
+        return m_num_preemptions;
+    }
+
+    size_t get_num_partial_preemptions() const {
+        return m_num_partial_preemptions;
+    }
+
     void free_blocks_from_sequence(size_t seq_id, const std::vector<std::set<size_t>>& per_layer_logical_block_indices_to_free) {
         m_block_manager->free_blocks_from_sequence(seq_id, per_layer_logical_block_indices_to_free);
     }
@@ -162,6 +207,7 @@ private:
         size_t preempted_tokens = 0;
         size_t num_blocks_occupied_by_sequence = m_block_manager->get_number_of_blocks_occupied_by_sequence(sequence_group);
         bool was_evicted_from = (sequence_group->get_num_evicted_tokens() != 0);
+        ++m_num_preemptions;
 
         if (num_blocks_occupied_by_sequence <= blocks_needed || !m_can_use_partial_preemption || was_evicted_from) {
             auto sequences = sequence_group->get_not_finished_sequences();
@@ -203,12 +249,38 @@ private:
                     m_block_manager->free_sequence(seq_id);
                 }
             }
+        } else {
+            ++m_num_partial_preemptions;
         }
         sequence_group->preempt_tokens(preempted_tokens);
         sequence_group->set_waiting();
         return m_block_manager->num_free_blocks() > prev_blocks_count;
     }
 
+    /**
+     * @return The number of tokens in a batch which can be used by a given sequence group. Tokens reserved for
+     * high priority requests are not available to requests of lower priorities.
+     */
+    size_t _get_token_budget(const SequenceGroup::CPtr& sequence_group) const {
+        if (sequence_group->get_sampling_parameters().priority == RequestPriority::HIGH) {
+            return m_config.max_num_batched_tokens;
+        }
+        const size_t num_reserved_tokens = m_config.max_num_batched_tokens * m_config.high_priority_tokens_share;
+        return m_config.max_num_batched_tokens - num_reserved_tokens;
+    }
+
+    size_t _get_num_available_tokens_in_megabatch(const SequenceGroup::CPtr& sequence_group, const Output& scheduler_output) const {
+        const size_t token_budget = _get_token_budget(sequence_group);
+        return token_budget > scheduler_output.m_total_num_scheduled_tokens ? token_budget - scheduler_output.m_total_num_scheduled_tokens : 0;
+    }
+
+    static bool _has_waiting_high_priority_prompts(const std::vector<SequenceGroup::Ptr>& sequence_groups) {
+        return std::any_of(sequence_groups.begin(), sequence_groups.end(), [] (const SequenceGroup::Ptr& sequence_group) {
+            return sequence_group->get_sampling_parameters().priority == RequestPriority::HIGH && !sequence_group->can_generate_tokens() &&
+                   !sequence_group->handle_stopped() && !sequence_group->handle_cancelled();
+        });
+    }
+
     static size_t _get_low_priority_sequence_group_id(const std::vector<SequenceGroup::Ptr>& sequence_groups) {
         for (size_t seq_group_id = 0, num_groups = sequence_groups.size(); seq_group_id < num_groups; ++seq_group_id) {
             size_t group_idx = num_groups - seq_group_id - 1;
@@ -260,12 +332,24 @@ private:
                 Sequence::Ptr sequence = (*sequence_group)[0];
                 uint64_t seq_id = sequence->get_id();
 
-                size_t num_tokens_in_megabatch = m_config.max_num_batched_tokens - scheduler_output.m_total_num_scheduled_tokens;
+                size_t num_tokens_in_megabatch = _get_num_available_tokens_in_megabatch(sequence_group, scheduler_output);
                 size_t num_available_tokens = sequence_group->get_num_available_tokens_for_batching();
 
                 // apply megabatch limitations
                 size_t num_scheduled_tokens = std::min(num_tokens_in_megabatch, num_available_tokens);
 
+                // SnapKV compresses the prompt based on attention of its last tokens, so they are processed separately
+                if (m_config.use_cache_eviction) {
+                    const auto& eviction_config = get_cache_eviction_config(sequence_group);
+                    size_t prompt_len = sequence_group->get_prompt_len();
+                    size_t observation_window_begin = prompt_len - std::min(prompt_len, eviction_config.get_recent_size());
+                    size_t num_processed_tokens = sequence_group->get_num_processed_tokens();
+                    if (eviction_config.policy == CacheEvictionPolicy::SNAPKV && prompt_len > eviction_config.get_max_cache_size() &&
+                        num_processed_tokens < observation_window_begin) {
+                        num_scheduled_tokens = std::min(num_scheduled_tokens, observation_window_begin - num_processed_tokens);
+                    }
+                }
+
                 // apply KV cache limitations
                 size_t block_size = get_block_size();
                 size_t currently_allocated_token_slots = sequence_group->get_num_blocks() * block_size;
@@ -319,7 +403,7 @@ private:
             if (sequence_group->can_generate_tokens() && !sequence_group->is_waiting() && !sequence_group->handle_stopped() && !sequence_group->handle_cancelled()) {
                 OPENVINO_ASSERT(!sequence_group->has_finished());
                 size_t num_running_seqs = sequence_group->num_running_seqs();
-                size_t num_tokens_in_megabatch = m_config.max_num_batched_tokens - scheduler_output.m_total_num_scheduled_tokens;
+                size_t num_tokens_in_megabatch = _get_num_available_tokens_in_megabatch(sequence_group, scheduler_output);
                 size_t available_tokens_per_seq_in_megabatch = num_tokens_in_megabatch / num_running_seqs;
 
                 // we cannot schedule even a single token per each sequence in a group
@@ -391,6 +475,9 @@ private:
 
         // TODO: it currently does not handle beam search, where beam width should contribute to total number of "num running sequences"
         size_t num_running_sequence_groups = _num_running_sequence_groups(sequence_groups);
+        // prompts are scheduled in a single shot, so tokens are reserved only while a high priority prompt waits.
+        // Otherwise a lower priority prompt longer than its token budget would block all prompts after it forever
+        const bool has_waiting_high_priority_prompts = _has_waiting_high_priority_prompts(sequence_groups);
 
         for (size_t sequence_group_id = 0; sequence_group_id < sequence_groups.size(); ++sequence_group_id) {
             SequenceGroup::Ptr sequence_group = sequence_groups[sequence_group_id];
@@ -402,7 +489,9 @@ private:
                 // here we also assume that sequence must be scheduler in a single shot and has no already generated context
                 if (!m_config.enable_prefix_caching)
                     OPENVINO_ASSERT(sequence_group->get_context_len() == 0);
-                size_t num_available_tokens_in_megabatch = m_config.max_num_batched_tokens - scheduler_output.m_total_num_scheduled_tokens;
+                size_t num_available_tokens_in_megabatch = has_waiting_high_priority_prompts ?
+                    _get_num_available_tokens_in_megabatch(sequence_group, scheduler_output) :
+                    m_config.max_num_batched_tokens - scheduler_output.m_total_num_scheduled_tokens;
                 size_t sequence_len = sequence_group->get_num_available_tokens_for_batching();
 
                 // TODO: better handling
@@ -506,17 +595,44 @@ private:
             }
             blocks_sum += blocks_num;
         }
+        blocks_sum = std::min(blocks_sum, m_cache_manager->get_max_num_kv_blocks());
         m_block_manager->increase_kv_blocks_number(blocks_sum);
+        m_num_initial_kv_blocks = blocks_sum;
         m_dynamic_memory_allocation = true;
     }
 
+    void _maybe_shrink_cache(const Output& scheduler_output) {
+        // GPU cache can't be shrunk in place
+        if (!m_dynamic_memory_allocation || m_cache_manager->get_device().find("GPU") != std::string::npos) {
+            return;
+        }
+
+        if (scheduler_output.m_cache_usage >= m_cache_shrink_usage_threshold) {
+            m_num_low_cache_usage_steps = 0;
+            return;
+        }
+        if (++m_num_low_cache_usage_steps < m_cache_shrink_num_steps) {
+            return;
+        }
+        m_num_low_cache_usage_steps = 0;
+
+        // keep space for the currently used blocks to double, which is the next growth step
+        size_t min_num_kv_blocks = std::max(scheduler_output.m_num_used_blocks * static_cast<size_t>(m_cache_growth_factor), m_num_initial_kv_blocks);
+        size_t new_num_kv_blocks = m_block_manager->shrink_kv_blocks_number(min_num_kv_blocks);
+        m_cache_manager->shrink_cache(new_num_kv_blocks);
+    }
+
     bool _try_increase_cache() {
         if (!m_dynamic_memory_allocation) {
             return false;
         }
         auto device = m_cache_manager->get_device();
         size_t current_num_of_kv_blocks = m_block_manager->get_total_number_of_kv_blocks();
-        size_t new_blocks_num = current_num_of_kv_blocks * m_cache_growth_factor;
+        const size_t max_num_of_kv_blocks = m_cache_manager->get_max_num_kv_blocks();
+        if (current_num_of_kv_blocks >= max_num_of_kv_blocks) {
+            return false;
+        }
+        size_t new_blocks_num = std::min<size_t>(current_num_of_kv_blocks * m_cache_growth_factor, max_num_of_kv_blocks);
 
         if (device.find("GPU") == std::string::npos) {
             m_block_manager->increase_kv_blocks_number(new_blocks_num);
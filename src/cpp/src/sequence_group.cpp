@@ -1,63 +1,138 @@
 // Copyright (C) 2023-2025 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
-#include <string_view>
 #include "sequence_group.hpp"
 
+#include <cstring>
+
 namespace ov {
 namespace genai {
 
 std::mutex Sequence::m_counter_mutex;
 
-size_t Sequence::_make_hash(size_t content_length) {
-        auto sequence_group = get_sequence_group_ptr();
-        auto block_size = sequence_group->get_block_size();
-        size_t block_start_idx = content_length - (content_length % block_size);
-        if (block_start_idx == content_length) {
-            block_start_idx -= block_size;
-        }
+namespace {
 
-        // hash of current block depends on prefix hashes
-        std::vector<int64_t> content;
-        size_t prefix_hashes_needed_count = block_start_idx / block_size;
-        OPENVINO_ASSERT(prefix_hashes_needed_count <= m_prefix_hashes.size()); 
-        content.insert(content.end(), m_prefix_hashes.begin(), m_prefix_hashes.begin() + prefix_hashes_needed_count);
-
-        // get tokens corresponding to current block
-        const auto prompt_ids = sequence_group->get_prompt_ids();
-        OPENVINO_ASSERT(content_length <= prompt_ids.size() + m_generated_ids.size());
-        if (block_start_idx < prompt_ids.size()) {
-            content.insert(content.end(), prompt_ids.begin() + block_start_idx, prompt_ids.begin() + std::min(prompt_ids.size(), content_length));
-        }
-        if (content_length > prompt_ids.size()) {
-            size_t start = block_start_idx < prompt_ids.size() ? 0 : block_start_idx - prompt_ids.size();
-            content.insert(content.end(), m_generated_ids.begin() + start, m_generated_ids.begin() + content_length - prompt_ids.size());
-        }
-        const char* data = reinterpret_cast<const char*>(content.data());
-        std::size_t size = content.size() * sizeof(content[0]);
-        return std::hash<std::string_view>{}(std::string_view(data, size));
+// Chained hash of token IDs built of xxHash64 rounds: each token updates the state of a block,
+// which is seeded by the hash of the previous block, so a block hash depends on all preceding tokens,
+// but is computed from tokens of the block only.
+constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+uint64_t hash_round(uint64_t state, int64_t token_id) {
+    state += static_cast<uint64_t>(token_id) * PRIME64_2;
+    state = (state << 31) | (state >> 33);
+    return state * PRIME64_1;
+}
+
+uint64_t hash_finalize(uint64_t state, size_t num_tokens) {
+    state ^= static_cast<uint64_t>(num_tokens) * PRIME64_5;
+    state ^= state >> 33;
+    state *= PRIME64_2;
+    state ^= state >> 29;
+    state *= PRIME64_3;
+    state ^= state >> 32;
+    return state;
+}
+
+}  // namespace
+
+size_t Sequence::_make_hash(size_t block_idx, size_t num_tokens) {
+    auto sequence_group = get_sequence_group_ptr();
+    const size_t block_size = sequence_group->get_block_size();
+    const TokenIds& prompt_ids = sequence_group->get_prompt_ids();
+    const size_t block_start_idx = block_idx * block_size;
+    OPENVINO_ASSERT(num_tokens > 0 && num_tokens <= block_size && block_start_idx + num_tokens <= prompt_ids.size() + m_generated_ids.size());
+    OPENVINO_ASSERT(block_idx <= m_prefix_hashes.size(), "Hashes of previous blocks must be computed first");
+
+    // continue from already hashed tokens of the block, if there are any
+    size_t num_hashed_tokens = 0;
+    uint64_t state = block_idx == 0 ? PRIME64_5 : static_cast<uint64_t>(m_prefix_hashes[block_idx - 1]);
+    if (m_partial_block_len > 0 && m_partial_block_idx == block_idx && m_partial_block_len <= num_tokens) {
+        num_hashed_tokens = m_partial_block_len;
+        state = m_partial_block_state;
+    }
+
+    for (size_t token_idx = block_start_idx + num_hashed_tokens; token_idx < block_start_idx + num_tokens; ++token_idx) {
+        state = hash_round(state, token_idx < prompt_ids.size() ? prompt_ids[token_idx] : m_generated_ids[token_idx - prompt_ids.size()]);
+    }
+
+    m_partial_block_idx = block_idx;
+    m_partial_block_len = num_tokens;
+    m_partial_block_state = state;
+    return static_cast<size_t>(hash_finalize(state, num_tokens));
+}
+
+void Sequence::_trim_prefix_hashes() {
+    m_partial_block_len = 0;
+    if (m_sequence_group == nullptr || m_prefix_hashes.empty())
+        return;
+    const size_t num_full_blocks = (m_sequence_group->get_prompt_len() + get_generated_len()) / m_sequence_group->get_block_size();
+    if (m_prefix_hashes.size() > num_full_blocks) {
+        m_prefix_hashes.resize(num_full_blocks);
+    }
 }
 
 // Each KV block can be uniquely identified by 
 // the tokens within the block and the tokens in the prefix before the block.
 // hash(prefix tokens + block tokens) <--> KV Block
 size_t Sequence::get_hash(size_t content_length) {
-
     auto sequence_group = get_sequence_group_ptr();
     OPENVINO_ASSERT(sequence_group, "Hash computation requires setting of sequence_group ptr.");
     auto content_len = content_length == 0 ? sequence_group->get_context_len() : content_length;
     auto block_size = sequence_group->get_block_size();
-    size_t cur_content = block_size * (m_prefix_hashes.size() + 1);
-    while (cur_content <= content_len)
-    {
-        m_prefix_hashes.push_back(_make_hash(cur_content));
-        cur_content += block_size;
+    while (block_size * (m_prefix_hashes.size() + 1) <= content_len) {
+        m_prefix_hashes.push_back(_make_hash(m_prefix_hashes.size(), block_size));
     }
     if (content_len % block_size == 0) {
         return m_prefix_hashes[content_len / block_size - 1];
     }
-    
-    return _make_hash(content_len);
+
+    return _make_hash(content_len / block_size, content_len % block_size);
+}
+
+uint64_t Sequence::get_prefix_check(size_t content_length) {
+    auto sequence_group = get_sequence_group_ptr();
+    OPENVINO_ASSERT(sequence_group, "Prefix check computation requires setting of sequence_group ptr.");
+    return sequence_group->get_prompt_check(content_length == 0 ? sequence_group->get_context_len() : content_length);
+}
+
+// Rows of prompt embeddings are hashed by the same rounds over 8-byte words of their content.
+// Both hashes are chained through all rows, so a prompt id identifies all embeddings up to its position
+// and doesn't depend on a hash of a single row. The second hash uses another seed and verifies restored KV blocks.
+void SequenceGroup::set_prompt_embeds(const ov::Tensor& inputs_embeds) {
+    const size_t prompt_len = inputs_embeds.get_shape()[1], hidden_size = inputs_embeds.get_shape()[2];
+    OPENVINO_ASSERT(prompt_len > 0, "Prompt length cannot be 0");
+
+    // embeddings may share memory with an output of embeddings model, so a copy is stored
+    m_sequence_group_type = SequenceGroupType::EMBEDDINGS;
+    m_prompt_embeds = ov::Tensor(ov::element::f32, {prompt_len, hidden_size});
+    std::copy_n(inputs_embeds.data<float>(), m_prompt_embeds.get_size(), m_prompt_embeds.data<float>());
+
+    m_prompt_ids.resize(prompt_len);
+    m_prompt_checks.resize(prompt_len);
+    const char* embeds_data = static_cast<const char*>(m_prompt_embeds.data());
+    const size_t row_byte_size = hidden_size * sizeof(float);
+    uint64_t id_state = PRIME64_5, check_state = PRIME64_1;
+    for (size_t token_idx = 0; token_idx < prompt_len; ++token_idx) {
+        const char* row = embeds_data + token_idx * row_byte_size;
+        size_t offset = 0;
+        for (; offset + sizeof(int64_t) <= row_byte_size; offset += sizeof(int64_t)) {
+            int64_t word;
+            std::memcpy(&word, row + offset, sizeof(word));
+            id_state = hash_round(id_state, word);
+            check_state = hash_round(check_state, word);
+        }
+        if (offset < row_byte_size) {
+            int32_t word;
+            std::memcpy(&word, row + offset, sizeof(word));
+            id_state = hash_round(id_state, word);
+            check_state = hash_round(check_state, word);
+        }
+        m_prompt_ids[token_idx] = static_cast<int64_t>(hash_finalize(id_state, token_idx + 1));
+        m_prompt_checks[token_idx] = hash_finalize(check_state, token_idx + 1);
+    }
 }
 }  // namespace genai
 }  // namespace ov
\ No newline at end of file
@@ -5,14 +5,17 @@
 
 #include <vector>
 #include <cassert>
+#include <chrono>
 #include <set>
 #include <cstdlib>
+#include <functional>
 #include <string_view>
 #include <memory>
 
 #include "openvino/genai/generation_handle.hpp"
 #include "openvino/genai/generation_config.hpp"
 #include "generation_stream.hpp"
+#include "token_store.hpp"
 
 namespace ov::genai {
 enum class SequenceStatus {
@@ -22,6 +25,13 @@ enum class SequenceStatus {
     WAITING = 3
 };
 
+enum class SequenceGroupType {
+    // prompt is represented by token ids
+    TOKENS,
+    // prompt is represented by precomputed embeddings (e.g. text merged with image features in VLMs)
+    EMBEDDINGS
+};
+
 using TokenIds = std::vector<int64_t>;
 using LogProbs = std::vector<float>;
 class SequenceGroup;
@@ -34,18 +44,27 @@ class Sequence {
         return m_counter++;
     }
 
-    TokenIds m_generated_ids;
+    // shared with forked sequences, so forks don't copy generated tokens
+    TokenStore m_generated_ids;
     LogProbs m_generated_log_probs;
     uint64_t m_grouped_id;
     uint64_t m_id = _get_next_global_sequence_id();
     SequenceStatus m_status = SequenceStatus::RUNNING;
     GenerationFinishReason m_finish_reason = GenerationFinishReason::NONE;
     float m_cumulative_log_prob = 0.0f;
-    std::vector<int64_t> m_prefix_hashes;
+    // hashes of full KV blocks
+    std::vector<size_t> m_prefix_hashes;
+    // not finalized hash of the first m_partial_block_len tokens of block m_partial_block_idx,
+    // so hashes of a block which is being filled are updated by new tokens only
+    size_t m_partial_block_idx = 0, m_partial_block_len = 0;
+    uint64_t m_partial_block_state = 0;
     SequenceGroup* m_sequence_group = nullptr;
     static std::mutex m_counter_mutex;
 
-    size_t _make_hash(size_t content_length);
+    // hash of the first num_tokens tokens of a block chained with hash of the previous block
+    size_t _make_hash(size_t block_idx, size_t num_tokens);
+    // drops hashes of blocks which are not full after removal of tokens
+    void _trim_prefix_hashes();
 
     explicit Sequence(const uint64_t id) : m_grouped_id(id) {}
 
@@ -54,6 +73,11 @@ class Sequence {
         m_grouped_id(id),
         m_status(seq.m_status),
         m_cumulative_log_prob(seq.m_cumulative_log_prob),
+        // a fork has the same tokens as its parent, so hashes of full blocks are inherited
+        m_prefix_hashes(seq.m_prefix_hashes),
+        m_partial_block_idx(seq.m_partial_block_idx),
+        m_partial_block_len(seq.m_partial_block_len),
+        m_partial_block_state(seq.m_partial_block_state),
         m_sequence_group(seq.m_sequence_group) {
         OPENVINO_ASSERT(seq.m_id != m_id);
     }
@@ -126,6 +150,7 @@ public:
             m_generated_log_probs.pop_back();
             m_generated_ids.pop_back();
         }
+        _trim_prefix_hashes();
     }
 
     GenerationOutput get_last_generation_output(size_t token_cnt = 1, size_t num_token_to_ignore = 0) {
@@ -134,8 +159,8 @@ public:
             OPENVINO_ASSERT(m_generated_ids.size());
             output.score = get_cumulative_log_prob();
 
-            auto generated_token_id = get_generated_ids();
-            auto generated_log_probs = get_generated_log_probs();
+            const auto& generated_token_id = get_generated_ids();
+            const auto& generated_log_probs = get_generated_log_probs();
 
             OPENVINO_ASSERT(get_generated_len() >= token_cnt);
             if (get_generated_len() > num_token_to_ignore) {
@@ -157,7 +182,7 @@ public:
         return m_generated_ids.size();
     }
 
-    const TokenIds & get_generated_ids() const {
+    const TokenStore & get_generated_ids() const {
         return m_generated_ids;
     }
 
@@ -192,6 +217,10 @@ public:
     // the tokens within the block and the tokens in the prefix before the block.
     // hash(prefix tokens + block tokens) <--> KV Block
     size_t get_hash(size_t content_length = 0);
+
+    // Identity of prompt content of the first content_length tokens, stored along with a KV block hash
+    // and compared when the block is restored. 0 for token prompts, which ids are the content itself.
+    uint64_t get_prefix_check(size_t content_length = 0);
 };
 
 // contains a list of Sequences in generic case (beam search or parallel sampling)
@@ -203,7 +232,15 @@ class SequenceGroup  : public std::enable_shared_from_this<SequenceGroup> {
     std::vector<Sequence::Ptr> m_sequences;
     ov::genai::GenerationConfig m_sampling_params;
     std::size_t m_block_size;
+    SequenceGroupType m_sequence_group_type = SequenceGroupType::TOKENS;
+    // for EMBEDDINGS groups prompt ids are hashes of prompt embeddings: they identify KV cache content
+    // for prefix caching, but are not valid token ids
     TokenIds m_prompt_ids;
+    // [prompt_len, hidden_size], set for EMBEDDINGS groups only
+    ov::Tensor m_prompt_embeds;
+    // for EMBEDDINGS groups, independent hashes of prompt embeddings up to each position,
+    // which verify that KV blocks restored by a hash were computed for the same text and images
+    std::vector<uint64_t> m_prompt_checks;
     std::vector<float> m_prompt_log_probs;
     GenerationStream::Ptr m_generation_stream;
     size_t m_num_evicted_tokens = 0;
@@ -227,12 +264,16 @@ class SequenceGroup  : public std::enable_shared_from_this<SequenceGroup> {
 
     size_t m_num_streamed_tokens = 0, m_stream_window_size = 0;
 
+    std::chrono::steady_clock::time_point m_arrival_time = std::chrono::steady_clock::now();
+
     SequenceGroup(uint64_t request_id, const ov::genai::GenerationConfig& sampling_params, std::size_t block_size)
         : m_request_id(request_id),
           m_sampling_params(sampling_params),
           m_block_size(block_size),
           m_generation_stream(GenerationStream::create()) { }
 
+    void set_prompt_embeds(const ov::Tensor& inputs_embeds);
+
     bool out_of_memory() const {
         for (size_t seq_id = 0; seq_id < m_sequences.size(); ++seq_id) {
             if (m_sequences[seq_id]->out_of_memory()) {
@@ -250,14 +291,24 @@ public:
         : SequenceGroup(request_id, ov::Tensor(ov::element::i64, ov::Shape{input_ids.size()}, (void *)input_ids.data()), sampling_params, block_size) {
     }
 
+    /**
+     * @param input_ids Either i64 token ids with a shape [1, prompt_len] / [prompt_len] or
+     * f32 prompt embeddings with a shape [1, prompt_len, hidden_size]. The latter creates SequenceGroupType::EMBEDDINGS group.
+     */
     SequenceGroup(uint64_t request_id, const ov::Tensor input_ids, const ov::genai::GenerationConfig& sampling_params, std::size_t block_size)
         : SequenceGroup(request_id, sampling_params, block_size) {
-        size_t prompt_len = input_ids.get_size();
-        OPENVINO_ASSERT(prompt_len > 0, "Prompt length cannot be 0");
-
-        m_prompt_ids.resize(prompt_len);
-        std::copy_n(input_ids.data<int64_t>(), prompt_len, m_prompt_ids.begin());
-        m_prompt_log_probs.reserve(prompt_len);
+        if (input_ids.get_element_type() == ov::element::f32) {
+            const ov::Shape& embeds_shape = input_ids.get_shape();
+            OPENVINO_ASSERT(embeds_shape.size() == 3 && embeds_shape[0] == 1, "Prompt embeddings must have a shape [1, prompt_len, hidden_size], got ", embeds_shape);
+            set_prompt_embeds(input_ids);
+        } else {
+            size_t prompt_len = input_ids.get_size();
+            OPENVINO_ASSERT(prompt_len > 0, "Prompt length cannot be 0");
+
+            m_prompt_ids.resize(prompt_len);
+            std::copy_n(input_ids.data<int64_t>(), prompt_len, m_prompt_ids.begin());
+        }
+        m_prompt_log_probs.reserve(m_prompt_ids.size());
 
         // create a single sequence
         add_sequence(Sequence::create(m_next_sequence_id++));
@@ -404,6 +455,21 @@ public:
         return m_request_id;
     }
 
+    /**
+     * @return Whether this group should be scheduled before the other one: groups of higher priority go first, then,
+     * within the same priority, groups with earlier first token deadlines. Other groups are equivalent.
+     */
+    bool is_scheduled_before(const SequenceGroup& other) const {
+        if (m_sampling_params.priority != other.m_sampling_params.priority) {
+            return m_sampling_params.priority < other.m_sampling_params.priority;
+        }
+        if (m_sampling_params.deadline_ms == 0 || other.m_sampling_params.deadline_ms == 0) {
+            return m_sampling_params.deadline_ms != 0 && other.m_sampling_params.deadline_ms == 0;
+        }
+        return m_arrival_time + std::chrono::milliseconds(m_sampling_params.deadline_ms) <
+               other.m_arrival_time + std::chrono::milliseconds(other.m_sampling_params.deadline_ms);
+    }
+
     size_t get_num_scheduled_tokens() const {
         return m_num_scheduled_tokens;
     }
@@ -442,6 +508,11 @@ public:
     /**
      * @return Number of tokens evicted for this sequence since the start of the processing for this sequence
      */
+    // preempted sequence groups have to recompute KV cache of some of the previously processed tokens
+    bool is_preempted() const {
+        return m_num_processed_tokens < m_max_content_len;
+    }
+
     size_t get_num_evicted_tokens() const {
         return m_num_evicted_tokens;
     }
@@ -526,6 +597,24 @@ public:
         return m_prompt_ids;
     }
 
+    SequenceGroupType get_sequence_group_type() const {
+        return m_sequence_group_type;
+    }
+
+    // returns identity of the first prompt_len embeddings of EMBEDDINGS groups and 0 for token prompts
+    uint64_t get_prompt_check(size_t prompt_len) const {
+        if (m_prompt_checks.empty() || prompt_len == 0) {
+            return 0;
+        }
+        return m_prompt_checks[std::min(prompt_len, m_prompt_checks.size()) - 1];
+    }
+
+    // returns prompt embeddings with a shape [prompt_len, hidden_size] for SequenceGroupType::EMBEDDINGS groups
+    const ov::Tensor& get_prompt_embeds() const {
+        OPENVINO_ASSERT(m_sequence_group_type == SequenceGroupType::EMBEDDINGS, "Sequence group with request id ", m_request_id, " does not have prompt embeddings");
+        return m_prompt_embeds;
+    }
+
     void append_prompt_log_prob(float log_prob) {
         m_prompt_log_probs.push_back(log_prob);
     }
@@ -552,6 +641,14 @@ public:
         return forked_sequence;
     }
 
+    // Forks an alternative candidate branch of a sequence. Only one of them is kept after validation,
+    // so the branch has the same grouped ID to be streamed as the same output
+    Sequence::Ptr fork_branch(Sequence::CPtr sequence) {
+        auto branch = Sequence::fork(sequence, sequence->get_grouped_id());
+        m_sequences.emplace_back(branch);
+        return branch;
+    }
+
     const ov::genai::GenerationConfig& get_sampling_parameters() const {
         return m_sampling_params;
     }
@@ -605,7 +702,7 @@ public:
         GenerationOutputs outputs;
         for (auto& sequence: m_sequences) {
             GenerationOutput output;
-            output.generated_ids = sequence->get_generated_ids();
+            output.generated_ids = sequence->get_generated_ids().to_vector();
             output.generated_log_probs = sequence->get_generated_log_probs();
             if (m_sampling_params.echo) {
                 output.generated_ids.insert(output.generated_ids.begin(), m_prompt_ids.begin(), m_prompt_ids.end());
@@ -59,7 +59,7 @@ ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::get_ge
         for (const auto& sequence : request->get_running_sequences()) {
             const auto& sequence_id = sequence->get_grouped_id();
             OPENVINO_ASSERT(!generated_request.count(sequence_id));
-            generated_request.insert({{sequence_id, { sequence->get_generated_ids(), sequence->get_generated_log_probs() } }});
+            generated_request.insert({{sequence_id, { sequence->get_generated_ids().to_vector(), sequence->get_generated_log_probs() } }});
         }
     }
     return result;
@@ -80,8 +80,8 @@ get_prefix_len(
 
         const auto& candidate_sequence = candidates.at(sequence_id);
 
-        const std::vector<int64_t>& candidate_token_ids = candidate_sequence.token_ids,
-                                    running_token_ids = running_sequence->get_generated_ids();
+        const std::vector<int64_t>& candidate_token_ids = candidate_sequence.token_ids;
+        const TokenStore& running_token_ids = running_sequence->get_generated_ids();
 
         const size_t candidate_sequence_gen_len = candidate_token_ids.size(),
                      running_sequence_gen_len = running_sequence->get_generated_len();
@@ -105,7 +105,7 @@ size_t
 remove_tokens_from_sequence(Sequence::Ptr& sequence,
                             size_t min_generated_tokens,
                             LogitProcessor& logit_proccessor) {
-    const auto generated_token_ids = sequence->get_generated_ids(); 
+    const auto& generated_token_ids = sequence->get_generated_ids();
     const auto sequence_generated_len = generated_token_ids.size();
     OPENVINO_ASSERT(sequence_generated_len >= min_generated_tokens);
 
@@ -303,8 +303,7 @@ ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::pull_a
             awaiting_request->pause_generation(true);
         }
     }
-    m_requests.insert(m_requests.end(), m_awaiting_requests.begin(), m_awaiting_requests.end());
-    m_awaiting_requests.clear();
+    _insert_awaiting_requests();
 }
 
 void ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl::multistep() {
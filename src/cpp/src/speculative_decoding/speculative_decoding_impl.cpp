@@ -89,6 +89,8 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::SpeculativeDecodingImpl(con
     m_draft_pipeline = std::make_shared<ContinuousBatchingForSpeculativeDecodingImpl>(
         draft_model, draft_model_tokenizer, draft_model_desc.generation_config,
         draft_kv_cache_config, draft_scheduler_config, draft_device, draft_properties, false);
+    // metrics of the main pipeline are reported as metrics of speculative decoding
+    m_pipeline_metrics = m_main_pipeline->get_metrics_collector();
 
     m_perf_metrics = PerfMetrics();
     m_perf_metrics.raw_metrics.m_inference_durations =  {{ MicroSeconds(0.0f) }};
@@ -156,7 +158,6 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
     m_draft_pipeline->multistep();
     draft_timer.end();
     m_sd_metrics.draft_duration += draft_timer.get_duration();
-    m_pipeline_metrics = m_main_pipeline->get_metrics();
 
     // to generate num_matches statistic
     std::map<int64_t, UpdateRequestResult> update_sequence_info;
@@ -172,7 +173,6 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
     m_main_pipeline->step();
     main_timer.end();
     m_sd_metrics.main_duration += main_timer.get_duration();
-    m_pipeline_metrics = m_main_pipeline->get_metrics();
 
     auto main_generated_requests = m_main_pipeline->get_generated_requests();
     for (const auto& checked_sequence : main_generated_requests) {
@@ -196,6 +196,8 @@ void ContinuousBatchingPipeline::SpeculativeDecodingImpl::step() {
         float acceptance_rate = 1 - static_cast<float>(updated_seq_info.removed_tokens_cnt) / updated_seq_info.inserted_tokens_cnt;
         m_sd_metrics.update_acceptance_rate(request_id, acceptance_rate * 100);
         m_sd_metrics.update_draft_accepted_tokens(request_id, (updated_seq_info.inserted_tokens_cnt - updated_seq_info.removed_tokens_cnt));
+        PipelineMetricsCollector::add(m_pipeline_metrics->draft_tokens, updated_seq_info.inserted_tokens_cnt);
+        PipelineMetricsCollector::add(m_pipeline_metrics->accepted_draft_tokens, updated_seq_info.inserted_tokens_cnt - updated_seq_info.removed_tokens_cnt);
     }
 
     // update perf metrics
@@ -330,8 +332,10 @@ ContinuousBatchingPipeline::SpeculativeDecodingImpl::get_speculative_decoding_me
 };
 
 void ContinuousBatchingPipeline::SpeculativeDecodingImpl::drop_requests() {
-    m_draft_pipeline->finish_request();
-    m_main_pipeline->finish_request();
+    m_draft_pipeline->drop_requests();
+    m_main_pipeline->drop_requests();
+    std::lock_guard<std::mutex> lock(m_draft_generations_mutex);
+    m_draft_generations.clear();
 }
 
 
@@ -0,0 +1,268 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "stop_string_matcher.hpp"
+
+#include <algorithm>
+#include <queue>
+
+namespace {
+
+// UTF-8 bytes of U+FFFD, which detokenizers put in place of invalid or incomplete characters
+constexpr std::string_view REPLACEMENT_CHARACTER = "\xEF\xBF\xBD";
+
+// Cuts off replacement characters of incomplete characters from both ends of a decoded text
+std::string_view strip_replacement_characters(std::string_view text) {
+    while (text.substr(0, REPLACEMENT_CHARACTER.size()) == REPLACEMENT_CHARACTER) {
+        text.remove_prefix(REPLACEMENT_CHARACTER.size());
+    }
+    while (text.size() >= REPLACEMENT_CHARACTER.size() &&
+           text.substr(text.size() - REPLACEMENT_CHARACTER.size()) == REPLACEMENT_CHARACTER) {
+        text.remove_suffix(REPLACEMENT_CHARACTER.size());
+    }
+    return text;
+}
+
+}  // namespace
+
+namespace ov::genai {
+
+TokenBytesTable::TokenBytesTable(const std::vector<std::string>& token_bytes, Decoder decoder)
+    : m_decoder(std::move(decoder)) {
+    m_offsets.reserve(token_bytes.size() + 1);
+    m_offsets.push_back(0);
+    for (const std::string& bytes : token_bytes) {
+        m_bytes += bytes;
+        m_offsets.push_back(m_bytes.size());
+    }
+    if (m_decoder) {
+        m_is_partial.reserve(token_bytes.size());
+        for (const std::string& bytes : token_bytes) {
+            m_is_partial.push_back(bytes.find(REPLACEMENT_CHARACTER) != std::string::npos);
+        }
+    }
+}
+
+TokenBytesTable TokenBytesTable::build(Tokenizer& tokenizer, size_t vocab_size) {
+    // Detokenizers may drop a leading space of a decoded text (e.g. SentencePiece '▁' prefix of the first token),
+    // so each token is decoded after an anchor text, which is cut off afterwards.
+    // In such a way token text matches its text in the middle of a generated sequence.
+    ov::Tensor anchor_tensor = tokenizer.encode("a", ov::genai::add_special_tokens(false)).input_ids;
+    const TokenIds anchor(anchor_tensor.data<int64_t>(), anchor_tensor.data<int64_t>() + anchor_tensor.get_size());
+    const std::string anchor_text = anchor.empty() ? std::string{} : tokenizer.decode(anchor);
+
+    std::vector<std::string> token_bytes(vocab_size);
+    std::vector<int64_t> not_anchored_tokens;
+    // decode in chunks to limit size of detokenizer inputs
+    constexpr size_t chunk_size = 4096;
+    for (size_t chunk_begin = 0; chunk_begin < vocab_size; chunk_begin += chunk_size) {
+        const size_t chunk_end = std::min(vocab_size, chunk_begin + chunk_size);
+        std::vector<std::vector<int64_t>> batch;
+        batch.reserve(chunk_end - chunk_begin);
+        for (size_t token_id = chunk_begin; token_id < chunk_end; ++token_id) {
+            batch.push_back(anchor);
+            batch.back().push_back(static_cast<int64_t>(token_id));
+        }
+        std::vector<std::string> decoded = tokenizer.decode(batch);
+        OPENVINO_ASSERT(decoded.size() == batch.size(), "Unexpected number of decoded texts");
+        for (size_t i = 0; i < decoded.size(); ++i) {
+            if (!anchor.empty() && decoded[i].compare(0, anchor_text.size(), anchor_text) == 0) {
+                token_bytes[chunk_begin + i] = decoded[i].substr(anchor_text.size());
+            } else {
+                not_anchored_tokens.push_back(static_cast<int64_t>(chunk_begin + i));
+            }
+        }
+    }
+
+    // fallback for tokens which change anchor text (e.g. because of clean up of tokenization spaces)
+    for (size_t chunk_begin = 0; chunk_begin < not_anchored_tokens.size(); chunk_begin += chunk_size) {
+        const size_t chunk_end = std::min(not_anchored_tokens.size(), chunk_begin + chunk_size);
+        std::vector<std::vector<int64_t>> batch;
+        batch.reserve(chunk_end - chunk_begin);
+        for (size_t i = chunk_begin; i < chunk_end; ++i) {
+            batch.push_back({not_anchored_tokens[i]});
+        }
+        std::vector<std::string> decoded = tokenizer.decode(batch);
+        OPENVINO_ASSERT(decoded.size() == batch.size(), "Unexpected number of decoded texts");
+        for (size_t i = 0; i < decoded.size(); ++i) {
+            token_bytes[not_anchored_tokens[chunk_begin + i]] = std::move(decoded[i]);
+        }
+    }
+
+    // partial tokens are decoded in the same way, when they are matched with neighbouring tokens
+    Decoder decoder = [tokenizer, anchor, anchor_text](const std::vector<int64_t>& tokens) mutable {
+        std::vector<int64_t> anchored_tokens = anchor;
+        anchored_tokens.insert(anchored_tokens.end(), tokens.begin(), tokens.end());
+        std::string text = tokenizer.decode(anchored_tokens);
+        if (!anchor.empty() && text.compare(0, anchor_text.size(), anchor_text) == 0) {
+            return text.substr(anchor_text.size());
+        }
+        return tokenizer.decode(tokens);
+    };
+    return TokenBytesTable(token_bytes, std::move(decoder));
+}
+
+std::string TokenBytesTable::decode_last_token(std::vector<int64_t> window) const {
+    // bytes of the token are a difference of decoded texts of the window with and without it.
+    // The window may start in the middle of a character, its replacement characters are cut off from both texts.
+    const std::string text = m_decoder(window);
+    window.pop_back();
+    const std::string preceding_text = window.empty() ? std::string{} : m_decoder(window);
+
+    const std::string_view complete_text = strip_replacement_characters(text);
+    const std::string_view preceding_complete_text = strip_replacement_characters(preceding_text);
+    const size_t common_length = std::mismatch(complete_text.begin(), complete_text.end(),
+                                               preceding_complete_text.begin(), preceding_complete_text.end()).first - complete_text.begin();
+    return std::string(complete_text.substr(common_length));
+}
+
+StopStringMatcher::StopStringMatcher(const std::set<std::string>& stop_strings,
+                                     std::shared_ptr<const TokenBytesTable> token_bytes,
+                                     bool include_stop_str_in_output)
+    : m_token_bytes(std::move(token_bytes)),
+      m_include_stop_str_in_output(include_stop_str_in_output) {
+    OPENVINO_ASSERT(m_token_bytes, "Stop strings matching requires a table of token bytes");
+
+    std::array<int32_t, 256> no_transitions;
+    no_transitions.fill(-1);
+
+    // build a trie of stop strings
+    m_transitions.push_back(no_transitions);
+    m_match_lengths.push_back(0);
+    for (const std::string& stop_string : stop_strings) {
+        // empty stop string would stop generation right away
+        if (stop_string.empty())
+            continue;
+        int32_t state = 0;
+        for (unsigned char byte : stop_string) {
+            if (m_transitions[state][byte] < 0) {
+                m_transitions[state][byte] = static_cast<int32_t>(m_transitions.size());
+                m_transitions.push_back(no_transitions);
+                m_match_lengths.push_back(0);
+            }
+            state = m_transitions[state][byte];
+        }
+        m_match_lengths[state] = static_cast<uint32_t>(stop_string.size());
+        m_max_stop_string_length = std::max(m_max_stop_string_length, stop_string.size());
+    }
+
+    // complete transitions via failure links in BFS order, so each state knows the longest stop string ending in it
+    std::vector<int32_t> failure_links(m_transitions.size(), 0);
+    std::queue<int32_t> states;
+    for (auto& next_state : m_transitions[0]) {
+        if (next_state < 0) {
+            next_state = 0;
+        } else {
+            states.push(next_state);
+        }
+    }
+    while (!states.empty()) {
+        const int32_t state = states.front();
+        states.pop();
+        const int32_t failure_state = failure_links[state];
+        for (size_t byte = 0; byte < 256; ++byte) {
+            int32_t& next_state = m_transitions[state][byte];
+            if (next_state < 0) {
+                next_state = m_transitions[failure_state][byte];
+            } else {
+                failure_links[next_state] = m_transitions[failure_state][byte];
+                m_match_lengths[next_state] = std::max(m_match_lengths[next_state], m_match_lengths[failure_links[next_state]]);
+                states.push(next_state);
+            }
+        }
+    }
+}
+
+size_t StopStringMatcher::feed(int32_t& state, std::string_view bytes, size_t& match_length) const {
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        state = m_transitions[state][static_cast<unsigned char>(bytes[i])];
+        if (m_match_lengths[state] > 0) {
+            match_length = m_match_lengths[state];
+            return i + 1;
+        }
+    }
+    return std::string_view::npos;
+}
+
+int32_t StopStringMatcher::replay_state(const TokenSequence& tokens, size_t end) const {
+    // automaton state depends only on last m_max_stop_string_length bytes
+    std::string buffer;
+    size_t begin = end, num_bytes = 0;
+    while (begin > 0 && num_bytes < m_max_stop_string_length) {
+        --begin;
+        num_bytes += m_token_bytes->get(tokens, begin, buffer).size();
+    }
+    int32_t state = 0;
+    for (size_t i = begin; i < end; ++i) {
+        for (unsigned char byte : m_token_bytes->get(tokens, i, buffer)) {
+            state = m_transitions[state][byte];
+        }
+    }
+    return state;
+}
+
+MatchStopStringResult StopStringMatcher::get_match_result(const TokenSequence& tokens, size_t token_idx,
+                                                          size_t match_end, size_t match_length) const {
+    std::string buffer;
+    // number of bytes to remove from the end of text of [0, token_idx] tokens
+    size_t to_remove_bytes = m_token_bytes->get(tokens, token_idx, buffer).size() - match_end;
+    if (!m_include_stop_str_in_output)
+        to_remove_bytes += match_length;
+
+    // the smallest number of tokens which contain kept text, excluding word splitting symbols from its tail
+    size_t num_kept_tokens = token_idx + 1;
+    while (true) {
+        while (num_kept_tokens > 0) {
+            const size_t num_token_bytes = m_token_bytes->get(tokens, num_kept_tokens - 1, buffer).size();
+            if (num_token_bytes > to_remove_bytes)
+                break;
+            to_remove_bytes -= num_token_bytes;
+            --num_kept_tokens;
+        }
+        if (num_kept_tokens == 0)
+            break;
+        const std::string_view last_token = m_token_bytes->get(tokens, num_kept_tokens - 1, buffer);
+        const char last_byte = last_token[last_token.size() - to_remove_bytes - 1];
+        if (last_byte != ' ' && last_byte != '\n')
+            break;
+        ++to_remove_bytes;
+    }
+
+    MatchStopStringResult result;
+    result.is_matched = true;
+    result.to_remove = tokens.size() - num_kept_tokens;
+    return result;
+}
+
+MatchStopStringResult StopStringMatcher::match(uint64_t sequence_id, const TokenStore& generated_ids, size_t num_tokens_to_recheck) {
+    const TokenSequence tokens{generated_ids};
+    std::vector<int32_t>& states = m_sequence_states[sequence_id];
+    const size_t num_matched_tokens = std::min(states.size(), generated_ids.size() - std::min(generated_ids.size(), num_tokens_to_recheck));
+    states.resize(num_matched_tokens);
+
+    std::string buffer;
+    int32_t state = num_matched_tokens > 0 ? states.back() : 0;
+    for (size_t token_idx = num_matched_tokens; token_idx < generated_ids.size(); ++token_idx) {
+        size_t match_length = 0;
+        const size_t match_end = feed(state, m_token_bytes->get(tokens, token_idx, buffer), match_length);
+        states.push_back(state);
+        if (match_end != std::string_view::npos) {
+            return get_match_result(tokens, token_idx, match_end, match_length);
+        }
+    }
+    return {};
+}
+
+MatchStopStringResult StopStringMatcher::match_candidate(const TokenStore& generated_ids, int64_t candidate_token_id) const {
+    const TokenSequence tokens{generated_ids, candidate_token_id};
+    int32_t state = replay_state(tokens, generated_ids.size());
+    std::string buffer;
+    size_t match_length = 0;
+    const size_t match_end = feed(state, m_token_bytes->get(tokens, generated_ids.size(), buffer), match_length);
+    if (match_end != std::string_view::npos) {
+        return get_match_result(tokens, generated_ids.size(), match_end, match_length);
+    }
+    return {};
+}
+
+}  // namespace ov::genai
@@ -0,0 +1,153 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "openvino/genai/tokenizer.hpp"
+#include "sequence_group.hpp"
+
+namespace ov::genai {
+
+// Text of every token of a vocabulary as it appears inside of a decoded sequence.
+// Built once, so stop strings can be matched without tokenizer calls during generation.
+// Tokens which hold a part of a multi-byte UTF-8 character (e.g. byte fallback tokens or partial characters of
+// byte-level BPE) decode to U+FFFD on their own, so they are marked as partial and have to be decoded together
+// with neighbouring tokens by a decoder of the table.
+class TokenBytesTable {
+public:
+    // decodes a run of tokens as it appears inside of a decoded sequence
+    using Decoder = std::function<std::string(const std::vector<int64_t>& tokens)>;
+
+    TokenBytesTable() = default;
+    explicit TokenBytesTable(const std::vector<std::string>& token_bytes, Decoder decoder = {});
+
+    // Decodes every token of [0, vocab_size) range with a given tokenizer
+    static TokenBytesTable build(Tokenizer& tokenizer, size_t vocab_size);
+
+    size_t size() const {
+        return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+    }
+
+    // Returns empty bytes for tokens outside of the table
+    std::string_view get(int64_t token_id) const {
+        if (token_id < 0 || static_cast<size_t>(token_id) >= size())
+            return {};
+        return std::string_view(m_bytes).substr(m_offsets[token_id], m_offsets[token_id + 1] - m_offsets[token_id]);
+    }
+
+    // Whether text of a token is a replacement of a part of a multi-byte character, which can be decoded
+    bool is_partial(int64_t token_id) const {
+        return token_id >= 0 && static_cast<size_t>(token_id) < m_is_partial.size() && m_is_partial[token_id];
+    }
+
+    // Returns bytes which a token at a position adds to a decoded text of a sequence. Partial tokens are decoded
+    // together with preceding partial tokens, so a token gets bytes of characters it completes and no bytes
+    // of a character which is not complete yet. `buffer` keeps decoded bytes of a partial token.
+    template <typename Tokens>
+    std::string_view get(const Tokens& tokens, size_t token_idx, std::string& buffer) const {
+        const int64_t token_id = tokens[token_idx];
+        if (!is_partial(token_id)) {
+            return get(token_id);
+        }
+        // UTF-8 character is at most 4 bytes long, so it starts at most 3 tokens before the token completing it
+        constexpr size_t max_preceding_tokens = 3;
+        size_t begin = token_idx;
+        while (begin > 0 && token_idx - begin < max_preceding_tokens && is_partial(tokens[begin - 1])) {
+            --begin;
+        }
+        std::vector<int64_t> window;
+        for (size_t i = begin; i <= token_idx; ++i) {
+            window.push_back(tokens[i]);
+        }
+        buffer = decode_last_token(window);
+        return buffer;
+    }
+
+private:
+    // Returns bytes added to decoded text of a window by its last token
+    std::string decode_last_token(std::vector<int64_t> window) const;
+
+    std::string m_bytes;
+    std::vector<size_t> m_offsets;
+    // empty if there is no decoder
+    std::vector<bool> m_is_partial;
+    Decoder m_decoder;
+};
+
+struct MatchStopStringResult {
+    // number of last tokens to be removed from a sequence
+    size_t to_remove = 0;
+    bool is_matched = false;
+};
+
+// Matches stop strings of a request against generated tokens.
+// Stop strings are compiled once into Aho-Corasick automaton over bytes, which is advanced
+// by bytes of each new token, so each generated token costs O(token length) steps.
+class StopStringMatcher {
+public:
+    StopStringMatcher(const std::set<std::string>& stop_strings,
+                      std::shared_ptr<const TokenBytesTable> token_bytes,
+                      bool include_stop_str_in_output);
+
+    // Advances a state of a sequence by generated tokens which have not been matched yet.
+    // Last num_tokens_to_recheck tokens are matched again as they may have been replaced since the previous call
+    // (e.g. by validation of speculative decoding candidates).
+    MatchStopStringResult match(uint64_t sequence_id, const TokenStore& generated_ids, size_t num_tokens_to_recheck = 0);
+
+    // Matches generated tokens extended by a candidate token, which is not appended to a sequence yet.
+    // Does not keep any state, so it can be used for beams which are forked on every step.
+    MatchStopStringResult match_candidate(const TokenStore& generated_ids, int64_t candidate_token_id) const;
+
+    // Drops a state of a sequence, which is not generated anymore (e.g. dropped by sampling)
+    void drop_sequence(uint64_t sequence_id) {
+        m_sequence_states.erase(sequence_id);
+    }
+
+private:
+    // token at position i of generated tokens (optionally extended by a candidate token)
+    struct TokenSequence {
+        const TokenStore& generated_ids;
+        int64_t candidate_token_id = -1;
+
+        size_t size() const {
+            return generated_ids.size() + (candidate_token_id >= 0);
+        }
+
+        int64_t operator[](size_t i) const {
+            return i < generated_ids.size() ? generated_ids[i] : candidate_token_id;
+        }
+    };
+
+    // Returns automaton state after replaying last tokens of [0, end) which can affect it
+    int32_t replay_state(const TokenSequence& tokens, size_t end) const;
+
+    // Feeds bytes of a token to automaton. Returns position after the last byte of a match within the token bytes
+    // and updates match_length, or std::string_view::npos if there is no match
+    size_t feed(int32_t& state, std::string_view bytes, size_t& match_length) const;
+
+    MatchStopStringResult get_match_result(const TokenSequence& tokens, size_t token_idx,
+                                           size_t match_end, size_t match_length) const;
+
+    std::shared_ptr<const TokenBytesTable> m_token_bytes;
+    bool m_include_stop_str_in_output;
+    size_t m_max_stop_string_length = 0;
+
+    // dense transitions of automaton: { state, byte } => state
+    std::vector<std::array<int32_t, 256>> m_transitions;
+    // length of the longest stop string which ends in a state, 0 if none
+    std::vector<uint32_t> m_match_lengths;
+
+    // sequence ID => automaton states after each matched generated token
+    std::unordered_map<uint64_t, std::vector<int32_t>> m_sequence_states;
+};
+
+}  // namespace ov::genai
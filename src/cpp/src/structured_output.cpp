@@ -0,0 +1,931 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "structured_output.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cctype>
+#include <limits>
+#include <map>
+
+#include <nlohmann/json.hpp>
+
+namespace ov::genai {
+
+namespace {
+
+// limits protecting from constraints which explode into huge automata
+constexpr size_t MAX_NFA_STATES = 200000;
+constexpr size_t MAX_DFA_STATES = 20000;
+constexpr size_t UNBOUNDED = std::numeric_limits<size_t>::max();
+
+using ByteSet = std::bitset<256>;
+
+std::string encode_utf8(uint32_t codepoint) {
+    std::string bytes;
+    if (codepoint < 0x80) {
+        bytes += static_cast<char>(codepoint);
+    } else if (codepoint < 0x800) {
+        bytes += static_cast<char>(0xC0 | (codepoint >> 6));
+        bytes += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+        bytes += static_cast<char>(0xE0 | (codepoint >> 12));
+        bytes += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        bytes += static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else {
+        bytes += static_cast<char>(0xF0 | (codepoint >> 18));
+        bytes += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        bytes += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        bytes += static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+    return bytes;
+}
+
+uint32_t parse_hex(const std::string& text, size_t& pos, size_t num_digits) {
+    OPENVINO_ASSERT(pos + num_digits <= text.size(), "Unexpected end of escape sequence in: ", text);
+    uint32_t value = 0;
+    for (size_t i = 0; i < num_digits; ++i, ++pos) {
+        const char c = text[pos];
+        OPENVINO_ASSERT(std::isxdigit(static_cast<unsigned char>(c)), "Invalid hex digit '", c, "' in: ", text);
+        value = value * 16 + (std::isdigit(static_cast<unsigned char>(c)) ? c - '0' : std::tolower(c) - 'a' + 10);
+    }
+    return value;
+}
+
+std::string regex_escape(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (std::string_view("\\^$.|?*+()[]{}").find(c) != std::string_view::npos) {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+std::string alternation(const std::vector<std::string>& alternatives) {
+    std::string regex = "(";
+    for (size_t i = 0; i < alternatives.size(); ++i) {
+        regex += (i > 0 ? "|" : "") + alternatives[i];
+    }
+    return regex + ")";
+}
+
+std::string quantifier(size_t min, size_t max) {
+    if (max == UNBOUNDED) {
+        return min == 0 ? "*" : "{" + std::to_string(min) + ",}";
+    }
+    return "{" + std::to_string(min) + "," + std::to_string(max) + "}";
+}
+
+struct RegexNode {
+    enum class Type { BYTES, CONCATENATION, ALTERNATION, REPETITION };
+
+    Type type = Type::CONCATENATION;
+    ByteSet bytes;
+    std::vector<RegexNode> children;
+    size_t min = 1, max = 1;
+};
+
+RegexNode bytes_node(const ByteSet& bytes) {
+    RegexNode node;
+    node.type = RegexNode::Type::BYTES;
+    node.bytes = bytes;
+    return node;
+}
+
+RegexNode literal_node(const std::string& literal) {
+    RegexNode node;
+    for (unsigned char byte : literal) {
+        node.children.push_back(bytes_node(ByteSet().set(byte)));
+    }
+    return node;
+}
+
+class RegexParser {
+public:
+    explicit RegexParser(const std::string& regex) : m_regex(regex) {}
+
+    RegexNode parse() {
+        RegexNode node = parse_alternation();
+        OPENVINO_ASSERT(at_end(), "Unexpected '", m_regex[m_pos], "' at position ", m_pos, " of regex: ", m_regex);
+        return node;
+    }
+
+private:
+    bool at_end() const {
+        return m_pos >= m_regex.size();
+    }
+
+    char peek() const {
+        return m_regex[m_pos];
+    }
+
+    char take() {
+        OPENVINO_ASSERT(!at_end(), "Unexpected end of regex: ", m_regex);
+        return m_regex[m_pos++];
+    }
+
+    RegexNode parse_alternation() {
+        RegexNode node;
+        node.type = RegexNode::Type::ALTERNATION;
+        node.children.push_back(parse_concatenation());
+        while (!at_end() && peek() == '|') {
+            ++m_pos;
+            node.children.push_back(parse_concatenation());
+        }
+        if (node.children.size() == 1) {
+            return std::move(node.children.front());
+        }
+        return node;
+    }
+
+    RegexNode parse_concatenation() {
+        RegexNode node;
+        while (!at_end() && peek() != '|' && peek() != ')') {
+            node.children.push_back(parse_repetition());
+        }
+        if (node.children.size() == 1) {
+            return std::move(node.children.front());
+        }
+        return node;
+    }
+
+    RegexNode parse_repetition() {
+        RegexNode node = parse_atom();
+        while (!at_end()) {
+            size_t min = 0, max = UNBOUNDED;
+            if (peek() == '*') {
+                ++m_pos;
+            } else if (peek() == '+') {
+                min = 1;
+                ++m_pos;
+            } else if (peek() == '?') {
+                max = 1;
+                ++m_pos;
+            } else if (peek() != '{' || !parse_bounds(min, max)) {
+                break;
+            }
+            // lazy quantifiers match the same language
+            if (!at_end() && peek() == '?') {
+                ++m_pos;
+            }
+            RegexNode repetition;
+            repetition.type = RegexNode::Type::REPETITION;
+            repetition.min = min;
+            repetition.max = max;
+            repetition.children.push_back(std::move(node));
+            node = std::move(repetition);
+        }
+        return node;
+    }
+
+    // parses {n}, {n,} or {n,m}, returns false if '{' is a literal
+    bool parse_bounds(size_t& min, size_t& max) {
+        size_t pos = m_pos + 1;
+        auto read_number = [&](size_t& value) {
+            const size_t begin = pos;
+            for (value = 0; pos < m_regex.size() && std::isdigit(static_cast<unsigned char>(m_regex[pos])); ++pos) {
+                value = value * 10 + (m_regex[pos] - '0');
+            }
+            return pos > begin;
+        };
+        if (!read_number(min)) {
+            return false;
+        }
+        if (pos < m_regex.size() && m_regex[pos] == ',') {
+            ++pos;
+            if (!read_number(max)) {
+                max = UNBOUNDED;
+            }
+        } else {
+            max = min;
+        }
+        if (pos >= m_regex.size() || m_regex[pos] != '}') {
+            return false;
+        }
+        OPENVINO_ASSERT(min <= max, "Invalid repetition bounds in regex: ", m_regex);
+        m_pos = pos + 1;
+        return true;
+    }
+
+    RegexNode parse_atom() {
+        const char c = take();
+        switch (c) {
+        case '(': {
+            if (!at_end() && peek() == '?') {
+                ++m_pos;
+                const char group_type = take();
+                if (group_type == 'P' || group_type == '<') {
+                    // named group
+                    while (take() != '>') {}
+                } else {
+                    OPENVINO_ASSERT(group_type == ':', "Only capturing, non-capturing and named groups are supported in regex: ", m_regex);
+                }
+            }
+            RegexNode node = parse_alternation();
+            OPENVINO_ASSERT(take() == ')', "Missing ')' in regex: ", m_regex);
+            return node;
+        }
+        case '[':
+            return bytes_node(parse_class());
+        case '.':
+            return bytes_node(ByteSet().set().reset('\n'));
+        case '^':
+        case '$':
+            // the whole output is matched, so anchors are implied
+            return RegexNode{};
+        case '\\': {
+            ByteSet bytes;
+            const std::string literal = parse_escape(bytes);
+            return literal.empty() ? bytes_node(bytes) : literal_node(literal);
+        }
+        case ')':
+        case '*':
+        case '+':
+        case '?':
+            OPENVINO_THROW("Unexpected '", c, "' at position ", m_pos - 1, " of regex: ", m_regex);
+        default:
+            return bytes_node(ByteSet().set(static_cast<unsigned char>(c)));
+        }
+    }
+
+    // Parses an escape sequence after '\'. Returns UTF-8 bytes of an escaped character,
+    // or an empty string if the escape denotes a class of characters, which is added to `bytes`
+    std::string parse_escape(ByteSet& bytes) {
+        const char c = take();
+        ByteSet digits, word, space;
+        for (char d = '0'; d <= '9'; ++d)
+            digits.set(d);
+        word = digits;
+        for (char l = 'a'; l <= 'z'; ++l)
+            word.set(l).set(std::toupper(l));
+        word.set('_');
+        for (char s : std::string(" \t\n\r\f\v"))
+            space.set(s);
+
+        switch (c) {
+        case 'd': bytes |= digits; return "";
+        case 'D': bytes |= ~digits; return "";
+        case 'w': bytes |= word; return "";
+        case 'W': bytes |= ~word; return "";
+        case 's': bytes |= space; return "";
+        case 'S': bytes |= ~space; return "";
+        case 'n': return "\n";
+        case 't': return "\t";
+        case 'r': return "\r";
+        case 'f': return "\f";
+        case 'v': return "\v";
+        case '0': return std::string(1, '\0');
+        case 'x': return encode_utf8(parse_hex(m_regex, m_pos, 2));
+        case 'u': return encode_utf8(parse_hex(m_regex, m_pos, 4));
+        default: return std::string(1, c);
+        }
+    }
+
+    ByteSet parse_class() {
+        ByteSet bytes;
+        const bool negate = !at_end() && peek() == '^';
+        if (negate) {
+            ++m_pos;
+        }
+        for (bool first = true;; first = false) {
+            char c = take();
+            if (c == ']' && !first) {
+                break;
+            }
+            std::string low = c == '\\' ? parse_escape(bytes) : std::string(1, c);
+            if (low.size() != 1) {
+                // non-ASCII characters are matched by their bytes
+                for (unsigned char byte : low)
+                    bytes.set(byte);
+                continue;
+            }
+            if (m_pos + 1 < m_regex.size() && peek() == '-' && m_regex[m_pos + 1] != ']') {
+                ++m_pos;
+                c = take();
+                ByteSet high_bytes;
+                std::string high = c == '\\' ? parse_escape(high_bytes) : std::string(1, c);
+                OPENVINO_ASSERT(high.size() == 1 && static_cast<unsigned char>(low[0]) <= static_cast<unsigned char>(high[0]),
+                                "Invalid range in character class of regex: ", m_regex);
+                for (int byte = static_cast<unsigned char>(low[0]); byte <= static_cast<unsigned char>(high[0]); ++byte)
+                    bytes.set(byte);
+            } else {
+                bytes.set(static_cast<unsigned char>(low[0]));
+            }
+        }
+        return negate ? ~bytes : bytes;
+    }
+
+    const std::string& m_regex;
+    size_t m_pos = 0;
+};
+
+// Thompson's construction of NFA, where each state has either epsilon transitions or a transition by a set of bytes
+class NFA {
+public:
+    struct State {
+        std::vector<int32_t> epsilon_transitions;
+        ByteSet bytes;
+        int32_t next = -1;
+    };
+
+    explicit NFA(const RegexNode& root) {
+        std::tie(m_start, m_final) = build(root);
+    }
+
+    const State& get_state(int32_t state) const {
+        return m_states[state];
+    }
+
+    size_t size() const {
+        return m_states.size();
+    }
+
+    int32_t get_final() const {
+        return m_final;
+    }
+
+    std::vector<int32_t> get_initial_states() const {
+        return {m_start};
+    }
+
+private:
+    int32_t add_state() {
+        OPENVINO_ASSERT(m_states.size() < MAX_NFA_STATES, "Structured output constraint is too complex");
+        m_states.emplace_back();
+        return static_cast<int32_t>(m_states.size() - 1);
+    }
+
+    std::pair<int32_t, int32_t> build(const RegexNode& node) {
+        const int32_t start = add_state(), end = add_state();
+        switch (node.type) {
+        case RegexNode::Type::BYTES:
+            m_states[start].bytes = node.bytes;
+            m_states[start].next = end;
+            break;
+        case RegexNode::Type::CONCATENATION: {
+            int32_t current = start;
+            for (const RegexNode& child : node.children) {
+                const auto [child_start, child_end] = build(child);
+                m_states[current].epsilon_transitions.push_back(child_start);
+                current = child_end;
+            }
+            m_states[current].epsilon_transitions.push_back(end);
+            break;
+        }
+        case RegexNode::Type::ALTERNATION:
+            for (const RegexNode& child : node.children) {
+                const auto [child_start, child_end] = build(child);
+                m_states[start].epsilon_transitions.push_back(child_start);
+                m_states[child_end].epsilon_transitions.push_back(end);
+            }
+            break;
+        case RegexNode::Type::REPETITION: {
+            int32_t current = start;
+            for (size_t i = 0; i < node.min; ++i) {
+                const auto [child_start, child_end] = build(node.children.front());
+                m_states[current].epsilon_transitions.push_back(child_start);
+                current = child_end;
+            }
+            if (node.max == UNBOUNDED) {
+                const auto [child_start, child_end] = build(node.children.front());
+                m_states[current].epsilon_transitions.push_back(child_start);
+                m_states[child_end].epsilon_transitions.push_back(child_start);
+                m_states[child_end].epsilon_transitions.push_back(end);
+            } else {
+                for (size_t i = node.min; i < node.max; ++i) {
+                    const auto [child_start, child_end] = build(node.children.front());
+                    m_states[current].epsilon_transitions.push_back(child_start);
+                    m_states[current].epsilon_transitions.push_back(end);
+                    current = child_end;
+                }
+            }
+            m_states[current].epsilon_transitions.push_back(end);
+            break;
+        }
+        }
+        return {start, end};
+    }
+
+    std::vector<State> m_states;
+    int32_t m_start = 0, m_final = 0;
+};
+
+class JsonSchemaConverter {
+public:
+    explicit JsonSchemaConverter(const nlohmann::ordered_json& root) : m_root(root) {}
+
+    std::string convert(const nlohmann::ordered_json& schema) {
+        if (schema.is_boolean()) {
+            OPENVINO_ASSERT(schema.get<bool>(), "JSON schema 'false' can't be satisfied");
+            return any_value(MAX_ANY_VALUE_DEPTH);
+        }
+        OPENVINO_ASSERT(schema.is_object(), "JSON schema must be an object or a boolean, but got: ", schema.dump());
+
+        if (schema.contains("$ref")) {
+            return convert_reference(schema["$ref"].get<std::string>());
+        }
+        if (schema.contains("const")) {
+            return regex_escape(schema["const"].dump());
+        }
+        if (schema.contains("enum")) {
+            std::vector<std::string> values;
+            for (const auto& value : schema["enum"]) {
+                values.push_back(regex_escape(value.dump()));
+            }
+            return alternation(values);
+        }
+        for (const char* key : {"anyOf", "oneOf"}) {
+            if (schema.contains(key)) {
+                std::vector<std::string> alternatives;
+                for (const auto& subschema : schema[key]) {
+                    alternatives.push_back(convert(subschema));
+                }
+                return alternation(alternatives);
+            }
+        }
+        if (schema.contains("allOf")) {
+            OPENVINO_ASSERT(schema["allOf"].size() == 1, "'allOf' with more than one schema is not supported");
+            return convert(schema["allOf"][0]);
+        }
+
+        if (!schema.contains("type")) {
+            if (schema.contains("properties")) {
+                return convert_object(schema);
+            }
+            if (schema.contains("items")) {
+                return convert_array(schema);
+            }
+            return any_value(MAX_ANY_VALUE_DEPTH);
+        }
+        if (schema["type"].is_array()) {
+            std::vector<std::string> alternatives;
+            for (const auto& type : schema["type"]) {
+                nlohmann::ordered_json typed_schema = schema;
+                typed_schema["type"] = type;
+                alternatives.push_back(convert(typed_schema));
+            }
+            return alternation(alternatives);
+        }
+
+        const std::string type = schema["type"].get<std::string>();
+        if (type == "object") {
+            return convert_object(schema);
+        } else if (type == "array") {
+            return convert_array(schema);
+        } else if (type == "string") {
+            return convert_string(schema);
+        } else if (type == "integer") {
+            return INTEGER;
+        } else if (type == "number") {
+            return NUMBER;
+        } else if (type == "boolean") {
+            return BOOLEAN;
+        } else if (type == "null") {
+            return NULL_VALUE;
+        }
+        OPENVINO_THROW("Unsupported type '", type, "' in JSON schema");
+    }
+
+private:
+    // depth of nested arrays and objects in values which are not constrained by a schema
+    static constexpr size_t MAX_ANY_VALUE_DEPTH = 2;
+
+    inline static const std::string WHITESPACE = "[ ]?";
+    inline static const std::string STRING_CHAR = R"(([^"\\\x00-\x1f]|\\["\\/bfnrt]|\\u[0-9a-fA-F]{4}))";
+    inline static const std::string STRING = "\"" + STRING_CHAR + "*\"";
+    inline static const std::string INTEGER = "(-?(0|[1-9][0-9]*))";
+    inline static const std::string NUMBER = "(-?(0|[1-9][0-9]*)(\\.[0-9]+)?([eE][+-]?[0-9]+)?)";
+    inline static const std::string BOOLEAN = "(true|false)";
+    inline static const std::string NULL_VALUE = "null";
+
+    std::string convert_reference(const std::string& reference) {
+        OPENVINO_ASSERT(!reference.empty() && reference[0] == '#', "Only local '$ref' are supported in JSON schema, but got: ", reference);
+        OPENVINO_ASSERT(std::find(m_references.begin(), m_references.end(), reference) == m_references.end(),
+                        "Recursive JSON schemas are not supported, '$ref' ", reference, " refers to itself");
+        m_references.push_back(reference);
+        const std::string regex = convert(m_root.at(nlohmann::ordered_json::json_pointer(reference.substr(1))));
+        m_references.pop_back();
+        return regex;
+    }
+
+    std::string member(const std::string& key_regex, const std::string& value_regex) const {
+        return key_regex + WHITESPACE + ":" + WHITESPACE + value_regex;
+    }
+
+    std::string convert_object(const nlohmann::ordered_json& schema) {
+        const std::string separator = WHITESPACE + "," + WHITESPACE;
+        if (!schema.contains("properties") || schema["properties"].empty()) {
+            if (schema.contains("additionalProperties") && schema["additionalProperties"] == false) {
+                return "\\{" + WHITESPACE + "\\}";
+            }
+            const std::string value = schema.contains("additionalProperties") && schema["additionalProperties"].is_object()
+                ? convert(schema["additionalProperties"]) : any_value(MAX_ANY_VALUE_DEPTH - 1);
+            const std::string item = member(STRING, value);
+            return "\\{" + WHITESPACE + "(" + item + "(" + separator + item + ")*)?" + WHITESPACE + "\\}";
+        }
+
+        std::vector<std::string> items;
+        std::vector<bool> is_required;
+        const auto required = schema.value("required", nlohmann::ordered_json::array());
+        for (const auto& [name, property_schema] : schema["properties"].items()) {
+            items.push_back(member(regex_escape(nlohmann::ordered_json(name).dump()), convert(property_schema)));
+            is_required.push_back(std::find(required.begin(), required.end(), name) != required.end());
+        }
+
+        // properties are generated in the declared order, optional ones can be skipped:
+        // with_separator[i] matches properties [i, n) each preceded by a separator,
+        // without_separator[i] matches the same properties, but the first of them has no separator
+        std::vector<std::string> with_separator(items.size() + 1), without_separator(items.size() + 1);
+        for (size_t i = items.size(); i-- > 0;) {
+            if (is_required[i]) {
+                with_separator[i] = separator + items[i] + with_separator[i + 1];
+                without_separator[i] = items[i] + with_separator[i + 1];
+            } else {
+                with_separator[i] = "(" + separator + items[i] + ")?" + with_separator[i + 1];
+                without_separator[i] = "(" + items[i] + with_separator[i + 1] + "|" + without_separator[i + 1] + ")";
+            }
+        }
+        return "\\{" + WHITESPACE + without_separator[0] + WHITESPACE + "\\}";
+    }
+
+    std::string convert_array(const nlohmann::ordered_json& schema) {
+        const std::string item = schema.contains("items") ? convert(schema["items"]) : any_value(MAX_ANY_VALUE_DEPTH - 1);
+        const size_t min_items = schema.value("minItems", size_t(0));
+        const size_t max_items = schema.value("maxItems", UNBOUNDED);
+        OPENVINO_ASSERT(min_items <= max_items, "'minItems' must not be greater than 'maxItems' in JSON schema");
+        if (max_items == 0) {
+            return "\\[" + WHITESPACE + "\\]";
+        }
+
+        const std::string separator = WHITESPACE + "," + WHITESPACE;
+        const size_t max_tail = max_items == UNBOUNDED ? UNBOUNDED : max_items - 1;
+        std::string items = item + "(" + separator + item + ")" + quantifier(min_items == 0 ? 0 : min_items - 1, max_tail);
+        if (min_items == 0) {
+            items = "(" + items + ")?";
+        }
+        return "\\[" + WHITESPACE + items + WHITESPACE + "\\]";
+    }
+
+    std::string convert_string(const nlohmann::ordered_json& schema) {
+        if (schema.contains("pattern")) {
+            return "\"(" + schema["pattern"].get<std::string>() + ")\"";
+        }
+        if (schema.contains("format")) {
+            const std::string format = schema["format"].get<std::string>();
+            const std::string date = "[0-9]{4}-[0-9]{2}-[0-9]{2}";
+            const std::string time = "[0-9]{2}:[0-9]{2}:[0-9]{2}(\\.[0-9]+)?(Z|[+-][0-9]{2}:[0-9]{2})?";
+            if (format == "date") {
+                return "\"" + date + "\"";
+            } else if (format == "time") {
+                return "\"" + time + "\"";
+            } else if (format == "date-time") {
+                return "\"" + date + "T" + time + "\"";
+            } else if (format == "uuid") {
+                return "\"[0-9a-fA-F]{8}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{4}-[0-9a-fA-F]{12}\"";
+            }
+        }
+        const size_t min_length = schema.value("minLength", size_t(0));
+        const size_t max_length = schema.value("maxLength", UNBOUNDED);
+        OPENVINO_ASSERT(min_length <= max_length, "'minLength' must not be greater than 'maxLength' in JSON schema");
+        return "\"" + STRING_CHAR + quantifier(min_length, max_length) + "\"";
+    }
+
+    std::string any_value(size_t depth) const {
+        std::vector<std::string> alternatives = {STRING, NUMBER, BOOLEAN, NULL_VALUE};
+        if (depth > 0) {
+            const std::string nested = any_value(depth - 1);
+            const std::string separator = WHITESPACE + "," + WHITESPACE;
+            const std::string item = member(STRING, nested);
+            alternatives.push_back("\\[" + WHITESPACE + "(" + nested + "(" + separator + nested + ")*)?" + WHITESPACE + "\\]");
+            alternatives.push_back("\\{" + WHITESPACE + "(" + item + "(" + separator + item + ")*)?" + WHITESPACE + "\\}");
+        }
+        return alternation(alternatives);
+    }
+
+    const nlohmann::ordered_json& m_root;
+    std::vector<std::string> m_references;
+};
+
+// Converts rules of GBNF grammar to regex by inlining referenced rules
+class EbnfConverter {
+public:
+    explicit EbnfConverter(const std::string& grammar) {
+        tokenize(grammar);
+    }
+
+    std::string convert() {
+        return expand("root");
+    }
+
+private:
+    enum class TokenType { IDENTIFIER, DEFINITION, LITERAL, REGEX };
+
+    struct Token {
+        TokenType type;
+        std::string text;
+    };
+
+    void tokenize(const std::string& grammar) {
+        std::vector<Token> tokens;
+        for (size_t pos = 0; pos < grammar.size();) {
+            const char c = grammar[pos];
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                ++pos;
+            } else if (c == '#') {
+                pos = grammar.find('\n', pos);
+                pos = pos == std::string::npos ? grammar.size() : pos;
+            } else if (grammar.compare(pos, 3, "::=") == 0) {
+                tokens.push_back({TokenType::DEFINITION, "::="});
+                pos += 3;
+            } else if (std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-') {
+                const size_t begin = pos;
+                while (pos < grammar.size() && (std::isalnum(static_cast<unsigned char>(grammar[pos])) || grammar[pos] == '_' || grammar[pos] == '-')) {
+                    ++pos;
+                }
+                tokens.push_back({TokenType::IDENTIFIER, grammar.substr(begin, pos - begin)});
+            } else if (c == '"') {
+                tokens.push_back({TokenType::LITERAL, parse_literal(grammar, ++pos)});
+            } else if (c == '[') {
+                // character classes of GBNF have regex syntax
+                const size_t begin = pos++;
+                for (bool first = true; pos < grammar.size() && (grammar[pos] != ']' || first); first = false) {
+                    pos += grammar[pos] == '\\' ? 2 : 1;
+                }
+                OPENVINO_ASSERT(pos < grammar.size(), "Unterminated character class in grammar");
+                tokens.push_back({TokenType::REGEX, grammar.substr(begin, ++pos - begin)});
+            } else if (c == '{') {
+                const size_t end = grammar.find('}', pos);
+                OPENVINO_ASSERT(end != std::string::npos, "Unterminated repetition bounds in grammar");
+                tokens.push_back({TokenType::REGEX, grammar.substr(pos, end + 1 - pos)});
+                pos = end + 1;
+            } else {
+                OPENVINO_ASSERT(std::string_view("()|*+?.").find(c) != std::string_view::npos, "Unexpected '", c, "' in grammar");
+                tokens.push_back({TokenType::REGEX, std::string(1, c)});
+                ++pos;
+            }
+        }
+
+        // a rule starts with `name ::=` and lasts until the next rule
+        std::string name;
+        for (size_t i = 0; i < tokens.size(); ++i) {
+            if (tokens[i].type == TokenType::IDENTIFIER && i + 1 < tokens.size() && tokens[i + 1].type == TokenType::DEFINITION) {
+                name = tokens[i].text;
+                OPENVINO_ASSERT(!m_rules.count(name), "Rule '", name, "' is defined more than once in grammar");
+                m_rules[name];
+                ++i;
+            } else {
+                OPENVINO_ASSERT(!name.empty() && tokens[i].type != TokenType::DEFINITION, "Grammar must consist of rules `name ::= expression`");
+                m_rules[name].push_back(tokens[i]);
+            }
+        }
+    }
+
+    static std::string parse_literal(const std::string& grammar, size_t& pos) {
+        std::string literal;
+        while (true) {
+            OPENVINO_ASSERT(pos < grammar.size(), "Unterminated literal in grammar");
+            const char c = grammar[pos++];
+            if (c == '"') {
+                return literal;
+            }
+            if (c != '\\') {
+                literal += c;
+                continue;
+            }
+            OPENVINO_ASSERT(pos < grammar.size(), "Unterminated literal in grammar");
+            const char escaped = grammar[pos++];
+            switch (escaped) {
+            case 'n': literal += '\n'; break;
+            case 't': literal += '\t'; break;
+            case 'r': literal += '\r'; break;
+            case 'x': literal += encode_utf8(parse_hex(grammar, pos, 2)); break;
+            case 'u': literal += encode_utf8(parse_hex(grammar, pos, 4)); break;
+            case 'U': literal += encode_utf8(parse_hex(grammar, pos, 8)); break;
+            default: literal += escaped;
+            }
+        }
+    }
+
+    std::string expand(const std::string& name) {
+        if (auto it = m_expanded_rules.find(name); it != m_expanded_rules.end()) {
+            return it->second;
+        }
+        OPENVINO_ASSERT(m_rules.count(name), "Rule '", name, "' is not defined in grammar");
+        OPENVINO_ASSERT(std::find(m_expansion_stack.begin(), m_expansion_stack.end(), name) == m_expansion_stack.end(),
+                        "Recursive rules are not supported in grammar, rule '", name, "' refers to itself");
+        m_expansion_stack.push_back(name);
+        std::string regex;
+        for (const Token& token : m_rules.at(name)) {
+            switch (token.type) {
+            case TokenType::IDENTIFIER: regex += "(" + expand(token.text) + ")"; break;
+            case TokenType::LITERAL: regex += "(" + regex_escape(token.text) + ")"; break;
+            default: regex += token.text;
+            }
+        }
+        m_expansion_stack.pop_back();
+        return m_expanded_rules[name] = regex;
+    }
+
+    std::map<std::string, std::vector<Token>> m_rules;
+    std::map<std::string, std::string> m_expanded_rules;
+    std::vector<std::string> m_expansion_stack;
+};
+
+}  // namespace
+
+std::string json_schema_to_regex(const std::string& json_schema) {
+    const nlohmann::ordered_json schema = nlohmann::ordered_json::parse(json_schema);
+    return JsonSchemaConverter(schema).convert(schema);
+}
+
+std::string ebnf_grammar_to_regex(const std::string& grammar) {
+    return EbnfConverter(grammar).convert();
+}
+
+std::string structured_output_to_regex(const StructuredOutputConfig& config) {
+    config.validate();
+    if (config.json_schema.has_value()) {
+        return json_schema_to_regex(*config.json_schema);
+    } else if (config.regex.has_value()) {
+        return *config.regex;
+    }
+    return ebnf_grammar_to_regex(*config.grammar);
+}
+
+RegexAutomaton::RegexAutomaton(const std::string& regex) {
+    const NFA nfa(RegexParser(regex).parse());
+
+    // subset construction, where each DFA state is a sorted set of NFA states closed by epsilon transitions
+    std::vector<uint32_t> visited(nfa.size(), 0);
+    uint32_t visit_id = 0;
+    auto epsilon_closure = [&](std::vector<int32_t> states) {
+        ++visit_id;
+        for (int32_t state : states)
+            visited[state] = visit_id;
+        for (size_t i = 0; i < states.size(); ++i) {
+            for (int32_t next : nfa.get_state(states[i]).epsilon_transitions) {
+                if (visited[next] != visit_id) {
+                    visited[next] = visit_id;
+                    states.push_back(next);
+                }
+            }
+        }
+        std::sort(states.begin(), states.end());
+        return states;
+    };
+
+    std::map<std::vector<int32_t>, int32_t> dfa_states;
+    std::vector<std::vector<int32_t>> nfa_states;
+    auto add_state = [&](std::vector<int32_t> states) {
+        auto it = dfa_states.find(states);
+        if (it != dfa_states.end()) {
+            return it->second;
+        }
+        OPENVINO_ASSERT(nfa_states.size() < MAX_DFA_STATES, "Structured output constraint is too complex");
+        const int32_t state = static_cast<int32_t>(nfa_states.size());
+        m_accepting.push_back(std::binary_search(states.begin(), states.end(), nfa.get_final()));
+        m_transitions.emplace_back();
+        dfa_states.emplace(states, state);
+        nfa_states.push_back(std::move(states));
+        return state;
+    };
+    add_state(epsilon_closure(nfa.get_initial_states()));
+
+    for (size_t state = 0; state < nfa_states.size(); ++state) {
+        std::array<std::vector<int32_t>, 256> moves;
+        for (int32_t nfa_state : nfa_states[state]) {
+            const NFA::State& transition = nfa.get_state(nfa_state);
+            if (transition.next < 0)
+                continue;
+            for (size_t byte = 0; byte < 256; ++byte) {
+                if (transition.bytes[byte])
+                    moves[byte].push_back(transition.next);
+            }
+        }
+        // many bytes usually lead to the same set of states
+        std::map<std::vector<int32_t>, int32_t> next_states;
+        for (size_t byte = 0; byte < 256; ++byte) {
+            int32_t next_state = DEAD_STATE;
+            if (!moves[byte].empty()) {
+                auto it = next_states.find(moves[byte]);
+                if (it == next_states.end()) {
+                    it = next_states.emplace(moves[byte], add_state(epsilon_closure(moves[byte]))).first;
+                }
+                next_state = it->second;
+            }
+            m_transitions[state][byte] = next_state;
+        }
+    }
+}
+
+SortedVocabulary::SortedVocabulary(std::shared_ptr<const TokenBytesTable> token_bytes_table) : token_bytes(std::move(token_bytes_table)) {
+    for (size_t token_id = 0; token_id < token_bytes->size(); ++token_id) {
+        if (token_bytes->is_partial(token_id)) {
+            partial_token_ids.push_back(static_cast<int64_t>(token_id));
+        } else if (!token_bytes->get(token_id).empty()) {
+            token_ids.push_back(static_cast<int64_t>(token_id));
+        }
+    }
+    std::sort(token_ids.begin(), token_ids.end(), [this](int64_t lhs, int64_t rhs) {
+        return token_bytes->get(lhs) < token_bytes->get(rhs);
+    });
+
+    common_prefix_lengths.resize(token_ids.size(), 0);
+    for (size_t i = 0; i < token_ids.size(); ++i) {
+        const std::string_view bytes = token_bytes->get(token_ids[i]);
+        max_token_length = std::max(max_token_length, bytes.size());
+        if (i > 0) {
+            const std::string_view previous = token_bytes->get(token_ids[i - 1]);
+            const size_t max_length = std::min(bytes.size(), previous.size());
+            common_prefix_lengths[i] = std::mismatch(bytes.begin(), bytes.begin() + max_length, previous.begin()).first - bytes.begin();
+        }
+    }
+}
+
+StructuredOutputGrammar::StructuredOutputGrammar(const StructuredOutputConfig& config, std::shared_ptr<const SortedVocabulary> vocabulary)
+    : StructuredOutputGrammar(std::make_shared<const RegexAutomaton>(structured_output_to_regex(config)), std::move(vocabulary)) {}
+
+StructuredOutputGrammar::StructuredOutputGrammar(std::shared_ptr<const RegexAutomaton> automaton, std::shared_ptr<const SortedVocabulary> vocabulary)
+    : m_automaton(std::move(automaton)),
+      m_vocabulary(std::move(vocabulary)) {}
+
+std::shared_ptr<const TokenBitmask> StructuredOutputGrammar::get_mask(int32_t state) {
+    std::shared_ptr<MaskEntry> entry = get_mask_entry(state).first;
+    // waits for a prefetch task which is computing the mask, but doesn't wait for a queued one
+    std::call_once(entry->is_computed, [&] {
+        entry->mask = compute_mask(state);
+    });
+    return entry->mask;
+}
+
+void StructuredOutputGrammar::prefetch_mask(int32_t state, ThreadPool& thread_pool) {
+    auto [entry, is_created] = get_mask_entry(state);
+    if (!is_created) {
+        return;
+    }
+    thread_pool.submit([grammar = shared_from_this(), entry = std::move(entry), state] {
+        std::call_once(entry->is_computed, [&] {
+            entry->mask = grammar->compute_mask(state);
+        });
+    });
+}
+
+std::pair<std::shared_ptr<StructuredOutputGrammar::MaskEntry>, bool> StructuredOutputGrammar::get_mask_entry(int32_t state) {
+    std::lock_guard<std::mutex> lock(m_masks_mutex);
+    auto [it, is_created] = m_masks.try_emplace(state);
+    if (is_created) {
+        it->second = std::make_shared<MaskEntry>();
+    }
+    return {it->second, is_created};
+}
+
+std::shared_ptr<const TokenBitmask> StructuredOutputGrammar::compute_mask(int32_t state) const {
+    const TokenBytesTable& token_bytes = *m_vocabulary->token_bytes;
+    const std::vector<int64_t>& token_ids = m_vocabulary->token_ids;
+    const std::vector<size_t>& common_prefix_lengths = m_vocabulary->common_prefix_lengths;
+
+    auto mask = std::make_shared<TokenBitmask>();
+    mask->words.assign((token_bytes.size() + 31) / 32, 0);
+
+    // states after each prefix of bytes of the current token, shared with the next tokens by a common prefix
+    std::vector<int32_t> prefix_states(m_vocabulary->max_token_length + 1);
+    prefix_states[0] = state;
+    size_t num_valid_prefix_states = 0;
+    for (size_t i = 0; i < token_ids.size();) {
+        const std::string_view bytes = token_bytes.get(token_ids[i]);
+        size_t length = std::min(common_prefix_lengths[i], num_valid_prefix_states);
+        for (int32_t current = prefix_states[length]; length < bytes.size(); ++length) {
+            current = m_automaton->next(current, static_cast<unsigned char>(bytes[length]));
+            if (current == RegexAutomaton::DEAD_STATE)
+                break;
+            prefix_states[length + 1] = current;
+        }
+        num_valid_prefix_states = length;
+
+        if (length == bytes.size()) {
+            mask->words[token_ids[i] / 32] |= 1u << (token_ids[i] % 32);
+            ++mask->num_allowed_tokens;
+            ++i;
+        } else {
+            // tokens sharing the first length + 1 bytes lead to the dead state as well
+            for (++i; i < token_ids.size() && common_prefix_lengths[i] > length; ++i) {}
+        }
+    }
+
+    bool is_non_ascii_allowed = false;
+    for (size_t byte = 0x80; byte < 256 && !is_non_ascii_allowed; ++byte) {
+        is_non_ascii_allowed = m_automaton->next(state, static_cast<unsigned char>(byte)) != RegexAutomaton::DEAD_STATE;
+    }
+    if (is_non_ascii_allowed) {
+        for (int64_t token_id : m_vocabulary->partial_token_ids) {
+            mask->words[token_id / 32] |= 1u << (token_id % 32);
+            ++mask->num_allowed_tokens;
+        }
+    }
+    return mask;
+}
+
+}  // namespace ov::genai
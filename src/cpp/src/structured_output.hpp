@@ -0,0 +1,133 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "openvino/genai/generation_config.hpp"
+#include "stop_string_matcher.hpp"
+#include "threadpool.hpp"
+
+namespace ov::genai {
+
+// Converts a JSON schema to a regex which matches JSON documents valid against the schema.
+// Supported subset: types, properties, required, items, min/maxItems, min/maxLength, pattern, enum, const,
+// anyOf / oneOf, non-recursive $ref. Numeric ranges and additionalProperties are not constrained.
+std::string json_schema_to_regex(const std::string& json_schema);
+
+// Converts a non-recursive EBNF grammar in GBNF notation with `root` rule to an equivalent regex
+std::string ebnf_grammar_to_regex(const std::string& grammar);
+
+// Converts a JSON schema, regex or EBNF grammar set in a config to a regex
+std::string structured_output_to_regex(const StructuredOutputConfig& config);
+
+// Deterministic finite automaton over bytes compiled from a regex. The whole output must match the regex.
+// Character classes and '.' match bytes, so non-ASCII characters are matched as separate bytes.
+class RegexAutomaton {
+public:
+    static constexpr int32_t DEAD_STATE = -1;
+    static constexpr int32_t INITIAL_STATE = 0;
+
+    explicit RegexAutomaton(const std::string& regex);
+
+    int32_t next(int32_t state, unsigned char byte) const {
+        return state == DEAD_STATE ? DEAD_STATE : m_transitions[state][byte];
+    }
+
+    int32_t next(int32_t state, std::string_view bytes) const {
+        for (size_t i = 0; i < bytes.size() && state != DEAD_STATE; ++i) {
+            state = m_transitions[state][static_cast<unsigned char>(bytes[i])];
+        }
+        return state;
+    }
+
+    bool is_accepting(int32_t state) const {
+        return state != DEAD_STATE && m_accepting[state];
+    }
+
+    size_t num_states() const {
+        return m_transitions.size();
+    }
+
+private:
+    std::vector<std::array<int32_t, 256>> m_transitions;
+    std::vector<bool> m_accepting;
+};
+
+// Tokens of a vocabulary sorted by their bytes, so tokens sharing a prefix are walked through an automaton once
+struct SortedVocabulary {
+    explicit SortedVocabulary(std::shared_ptr<const TokenBytesTable> token_bytes);
+
+    std::shared_ptr<const TokenBytesTable> token_bytes;
+    // IDs of tokens with non empty bytes, except partial ones
+    std::vector<int64_t> token_ids;
+    // IDs of tokens holding parts of multi-byte characters, their bytes depend on preceding tokens
+    std::vector<int64_t> partial_token_ids;
+    // length of common prefix of bytes of token_ids[i] and token_ids[i - 1]
+    std::vector<size_t> common_prefix_lengths;
+    size_t max_token_length = 0;
+};
+
+struct TokenBitmask {
+    // bit i is set if token i is allowed
+    std::vector<uint32_t> words;
+    size_t num_allowed_tokens = 0;
+
+    bool is_allowed(int64_t token_id) const {
+        const size_t word_idx = static_cast<size_t>(token_id) / 32;
+        return word_idx < words.size() && (words[word_idx] >> (token_id % 32) & 1u);
+    }
+};
+
+// Structured output constraint compiled to a token level automaton: automaton states are advanced
+// by token bytes and each state has a cached bitmask of tokens which keep output valid.
+// Masks are computed lazily and can be prefetched by a thread pool, while a model infers next logits.
+// Bytes of partial tokens are known only within a sequence, so they are allowed wherever a non-ASCII byte is.
+class StructuredOutputGrammar : public std::enable_shared_from_this<StructuredOutputGrammar> {
+public:
+    StructuredOutputGrammar(const StructuredOutputConfig& config, std::shared_ptr<const SortedVocabulary> vocabulary);
+    // Shares an automaton compiled already, e.g. when a request is added
+    StructuredOutputGrammar(std::shared_ptr<const RegexAutomaton> automaton, std::shared_ptr<const SortedVocabulary> vocabulary);
+
+    // Advances a state by bytes of a generated token at a position, see TokenBytesTable::get()
+    int32_t next_state(int32_t state, const TokenStore& generated_ids, size_t token_idx) const {
+        std::string buffer;
+        return m_automaton->next(state, m_vocabulary->token_bytes->get(generated_ids, token_idx, buffer));
+    }
+
+    bool is_accepting(int32_t state) const {
+        return m_automaton->is_accepting(state);
+    }
+
+    // Returns a mask of a state. If the mask is not computed yet, it's computed by the calling thread,
+    // unless a prefetch task is already computing it.
+    std::shared_ptr<const TokenBitmask> get_mask(int32_t state);
+
+    // Submits computation of a mask of a state to a thread pool, if it's not requested yet.
+    // The grammar must be owned by a shared pointer, which is kept by the task.
+    void prefetch_mask(int32_t state, ThreadPool& thread_pool);
+
+private:
+    struct MaskEntry {
+        std::once_flag is_computed;
+        std::shared_ptr<const TokenBitmask> mask;
+    };
+
+    // Returns an entry of a state and whether it has just been created
+    std::pair<std::shared_ptr<MaskEntry>, bool> get_mask_entry(int32_t state);
+    std::shared_ptr<const TokenBitmask> compute_mask(int32_t state) const;
+
+    std::shared_ptr<const RegexAutomaton> m_automaton;
+    std::shared_ptr<const SortedVocabulary> m_vocabulary;
+
+    std::mutex m_masks_mutex;
+    std::unordered_map<int32_t, std::shared_ptr<MaskEntry>> m_masks;
+};
+
+}  // namespace ov::genai
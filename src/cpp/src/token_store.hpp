@@ -0,0 +1,152 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace ov::genai {
+
+// Persistent storage of token IDs: full chunks of tokens are immutable and shared between copies,
+// while the last incomplete chunk (tail) is owned by each copy. Copying the store, e.g. when a sequence is forked
+// in beam search or parallel sampling, costs O(size / CHUNK_SIZE + CHUNK_SIZE) instead of O(size),
+// and appending tokens to one copy does not affect the others.
+class TokenStore {
+public:
+    static constexpr size_t CHUNK_SIZE = 128;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = int64_t;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int64_t*;
+        using reference = int64_t;
+
+        const_iterator() = default;
+        const_iterator(const TokenStore* store, size_t idx) : m_store(store), m_idx(idx) {}
+
+        int64_t operator*() const { return (*m_store)[m_idx]; }
+        int64_t operator[](difference_type n) const { return (*m_store)[m_idx + n]; }
+
+        const_iterator& operator++() { ++m_idx; return *this; }
+        const_iterator operator++(int) { const_iterator it = *this; ++m_idx; return it; }
+        const_iterator& operator--() { --m_idx; return *this; }
+        const_iterator operator--(int) { const_iterator it = *this; --m_idx; return it; }
+        const_iterator& operator+=(difference_type n) { m_idx += n; return *this; }
+        const_iterator& operator-=(difference_type n) { m_idx -= n; return *this; }
+        const_iterator operator+(difference_type n) const { return const_iterator(m_store, m_idx + n); }
+        const_iterator operator-(difference_type n) const { return const_iterator(m_store, m_idx - n); }
+        friend const_iterator operator+(difference_type n, const const_iterator& it) { return it + n; }
+        difference_type operator-(const const_iterator& other) const {
+            return static_cast<difference_type>(m_idx) - static_cast<difference_type>(other.m_idx);
+        }
+
+        bool operator==(const const_iterator& other) const { return m_idx == other.m_idx; }
+        bool operator!=(const const_iterator& other) const { return m_idx != other.m_idx; }
+        bool operator<(const const_iterator& other) const { return m_idx < other.m_idx; }
+        bool operator>(const const_iterator& other) const { return m_idx > other.m_idx; }
+        bool operator<=(const const_iterator& other) const { return m_idx <= other.m_idx; }
+        bool operator>=(const const_iterator& other) const { return m_idx >= other.m_idx; }
+
+    private:
+        const TokenStore* m_store = nullptr;
+        size_t m_idx = 0;
+    };
+
+    using value_type = int64_t;
+    using size_type = size_t;
+    using iterator = const_iterator;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    TokenStore() = default;
+
+    TokenStore(const std::vector<int64_t>& token_ids) : TokenStore(token_ids.begin(), token_ids.end()) {}
+
+    TokenStore(std::initializer_list<int64_t> token_ids) : TokenStore(token_ids.begin(), token_ids.end()) {}
+
+    template <typename InputIt>
+    TokenStore(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    size_t size() const {
+        return m_chunks.size() * CHUNK_SIZE + m_tail.size();
+    }
+
+    bool empty() const {
+        return m_chunks.empty() && m_tail.empty();
+    }
+
+    int64_t operator[](size_t idx) const {
+        const size_t chunk_idx = idx / CHUNK_SIZE;
+        return chunk_idx < m_chunks.size() ? (*m_chunks[chunk_idx])[idx % CHUNK_SIZE] : m_tail[idx - m_chunks.size() * CHUNK_SIZE];
+    }
+
+    int64_t back() const {
+        return m_tail.empty() ? m_chunks.back()->back() : m_tail.back();
+    }
+
+    void push_back(int64_t token_id) {
+        m_tail.push_back(token_id);
+        if (m_tail.size() == CHUNK_SIZE) {
+            auto chunk = std::make_shared<Chunk>();
+            std::copy(m_tail.begin(), m_tail.end(), chunk->begin());
+            m_chunks.push_back(std::move(chunk));
+            m_tail.clear();
+        }
+    }
+
+    void pop_back() {
+        if (m_tail.empty()) {
+            // the last chunk may be shared with other copies, so it's copied to the tail instead of modification
+            m_tail.assign(m_chunks.back()->begin(), m_chunks.back()->end());
+            m_chunks.pop_back();
+        }
+        m_tail.pop_back();
+    }
+
+    // Copies tokens to a contiguous vector
+    std::vector<int64_t> to_vector() const {
+        std::vector<int64_t> token_ids;
+        token_ids.reserve(size());
+        for (const auto& chunk : m_chunks) {
+            token_ids.insert(token_ids.end(), chunk->begin(), chunk->end());
+        }
+        token_ids.insert(token_ids.end(), m_tail.begin(), m_tail.end());
+        return token_ids;
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    friend bool operator==(const TokenStore& lhs, const TokenStore& rhs) {
+        return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool operator==(const TokenStore& lhs, const std::vector<int64_t>& rhs) {
+        return lhs.size() == rhs.size() && std::equal(rhs.begin(), rhs.end(), lhs.begin());
+    }
+
+    friend bool operator==(const std::vector<int64_t>& lhs, const TokenStore& rhs) {
+        return rhs == lhs;
+    }
+
+private:
+    using Chunk = std::array<int64_t, CHUNK_SIZE>;
+
+    std::vector<std::shared_ptr<const Chunk>> m_chunks;
+    std::vector<int64_t> m_tail;
+};
+
+}  // namespace ov::genai
@@ -0,0 +1,136 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tracing.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+std::vector<TraceEvent> TraceBuffer::get_events() const {
+    const size_t num_recorded = m_num_recorded.load(std::memory_order_acquire);
+    const size_t first_idx = num_recorded > CAPACITY ? num_recorded - CAPACITY : 0;
+
+    std::vector<TraceEvent> events;
+    events.reserve(num_recorded - first_idx);
+    for (size_t idx = first_idx; idx < num_recorded; ++idx) {
+        events.push_back(m_events[idx % m_events.size()]);
+    }
+
+    // the owning thread could overwrite the oldest events while they were copied
+    const size_t num_recorded_after = m_num_recorded.load(std::memory_order_acquire);
+    const size_t first_valid_idx = num_recorded_after > CAPACITY ? num_recorded_after - CAPACITY : 0;
+    if (first_valid_idx > first_idx) {
+        events.erase(events.begin(), events.begin() + std::min(first_valid_idx - first_idx, events.size()));
+    }
+    return events;
+}
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer() : m_start_time(std::chrono::steady_clock::now()) {
+    const char* trace_path = std::getenv("OV_GENAI_TRACE_FILE");
+    if (trace_path != nullptr && trace_path[0] != '\0') {
+        enable(trace_path);
+    }
+}
+
+Tracer::~Tracer() {
+    if (!m_trace_path.empty()) {
+        try {
+            dump(m_trace_path);
+        } catch (...) {
+            // exceptions must not escape the destructor of a static object
+        }
+    }
+}
+
+void Tracer::enable(const std::string& trace_path) {
+    if (!trace_path.empty()) {
+        std::lock_guard<std::mutex> lock(m_buffers_mutex);
+        m_trace_path = trace_path;
+    }
+    m_enabled.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::disable() {
+    m_enabled.store(false, std::memory_order_relaxed);
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(m_buffers_mutex);
+    m_buffers.clear();
+    m_generation.fetch_add(1, std::memory_order_release);
+}
+
+TraceBuffer& Tracer::_get_thread_buffer() {
+    static std::atomic<size_t> next_thread_idx{0};
+    thread_local const size_t thread_idx = next_thread_idx.fetch_add(1, std::memory_order_relaxed);
+    thread_local std::shared_ptr<TraceBuffer> buffer;
+    thread_local size_t buffer_generation = 0;
+
+    const size_t generation = m_generation.load(std::memory_order_acquire);
+    if (!buffer || buffer_generation != generation) {
+        buffer = std::make_shared<TraceBuffer>(thread_idx);
+        buffer_generation = generation;
+        std::lock_guard<std::mutex> lock(m_buffers_mutex);
+        m_buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void Tracer::record(const TraceEvent& event) {
+    _get_thread_buffer().push(event);
+}
+
+std::string Tracer::get_chrome_trace() const {
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(m_buffers_mutex);
+        buffers = m_buffers;
+    }
+
+    std::ostringstream trace;
+    trace << std::fixed << std::setprecision(3);
+    trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool is_first_event = true;
+    auto begin_event = [&]() -> std::ostringstream& {
+        trace << (is_first_event ? "\n" : ",\n");
+        is_first_event = false;
+        return trace;
+    };
+
+    for (const auto& buffer : buffers) {
+        const size_t tid = buffer->get_thread_idx();
+        begin_event() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                      << ",\"args\":{\"name\":\"thread " << tid << "\"}}";
+
+        for (const TraceEvent& event : buffer->get_events()) {
+            // timestamps and durations are in microseconds
+            begin_event() << "{\"name\":\"" << event.name << "\",\"cat\":\"genai\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                          << ",\"ts\":" << event.start_ns / 1000.0 << ",\"dur\":" << event.duration_ns / 1000.0 << ",\"args\":{";
+            for (size_t arg_idx = 0; arg_idx < event.num_args; ++arg_idx) {
+                trace << (arg_idx == 0 ? "" : ",") << "\"" << event.arg_names[arg_idx] << "\":" << event.arg_values[arg_idx];
+            }
+            trace << "}}";
+        }
+    }
+    trace << "\n]}\n";
+    return trace.str();
+}
+
+void Tracer::dump(const std::string& trace_path) const {
+    std::ofstream trace_file(trace_path);
+    OPENVINO_ASSERT(trace_file.is_open(), "Cannot open trace file ", trace_path);
+    trace_file << get_chrome_trace();
+}
+
+}  // namespace ov::genai
@@ -0,0 +1,167 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ov::genai {
+
+struct TraceEvent {
+    static constexpr size_t MAX_ARGS = 4;
+
+    // name and argument names must be string literals, since only pointers are stored
+    const char* name = nullptr;
+    int64_t start_ns = 0;
+    int64_t duration_ns = 0;
+    std::array<const char*, MAX_ARGS> arg_names{};
+    std::array<int64_t, MAX_ARGS> arg_values{};
+    size_t num_args = 0;
+};
+
+// Ring buffer of the latest CAPACITY events recorded by a single thread.
+// Recording is lock-free; reading from other threads skips events which could be overwritten during the read.
+class TraceBuffer {
+public:
+    static constexpr size_t CAPACITY = 1 << 14;
+
+    // an extra slot is written by the owning thread while the latest CAPACITY events are read
+    explicit TraceBuffer(size_t thread_idx) : m_events(CAPACITY + 1), m_thread_idx(thread_idx) {}
+
+    void push(const TraceEvent& event) {
+        const size_t num_recorded = m_num_recorded.load(std::memory_order_relaxed);
+        m_events[num_recorded % m_events.size()] = event;
+        m_num_recorded.store(num_recorded + 1, std::memory_order_release);
+    }
+
+    std::vector<TraceEvent> get_events() const;
+
+    size_t get_thread_idx() const {
+        return m_thread_idx;
+    }
+
+private:
+    std::vector<TraceEvent> m_events;
+    std::atomic<size_t> m_num_recorded{0};
+    size_t m_thread_idx;
+};
+
+/**
+ * Collects spans of pipeline stages (scheduling, inference, sampling, etc.) and exports them in Chrome trace
+ * event format, which can be opened in chrome://tracing or https://ui.perfetto.dev
+ * Tracing is enabled at runtime by OV_GENAI_TRACE_FILE environment variable, which specifies the file the trace
+ * is written to at exit. Building with OPENVINO_GENAI_DISABLE_TRACING defined compiles all spans out.
+ */
+class Tracer {
+public:
+    static Tracer& instance();
+
+    ~Tracer();
+
+    bool is_enabled() const {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    // Starts recording; if trace_path is not empty, the trace is written there at exit instead of the previous path
+    void enable(const std::string& trace_path = {});
+
+    void disable();
+
+    // Drops all recorded events
+    void clear();
+
+    void record(const TraceEvent& event);
+
+    // Returns recorded events in Chrome trace JSON format
+    std::string get_chrome_trace() const;
+
+    void dump(const std::string& trace_path) const;
+
+    // Nanoseconds since tracer creation
+    int64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start_time).count();
+    }
+
+private:
+    Tracer();
+
+    TraceBuffer& _get_thread_buffer();
+
+    std::atomic<bool> m_enabled{false};
+    std::string m_trace_path;
+    const std::chrono::steady_clock::time_point m_start_time;
+
+    // buffers are registered once per thread and outlive threads to be exported at exit
+    mutable std::mutex m_buffers_mutex;
+    std::vector<std::shared_ptr<TraceBuffer>> m_buffers;
+    // incremented by clear() to make threads register new buffers
+    std::atomic<size_t> m_generation{0};
+};
+
+#ifndef OPENVINO_GENAI_DISABLE_TRACING
+
+// Records a span from construction to destruction if tracing is enabled
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name) {
+        Tracer& tracer = Tracer::instance();
+        if (tracer.is_enabled()) {
+            m_event.name = name;
+            m_event.start_ns = tracer.now();
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    ~TraceSpan() {
+        if (is_recording()) {
+            Tracer& tracer = Tracer::instance();
+            m_event.duration_ns = tracer.now() - m_event.start_ns;
+            tracer.record(m_event);
+        }
+    }
+
+    // Allows to skip computation of arguments when tracing is disabled
+    bool is_recording() const {
+        return m_event.name != nullptr;
+    }
+
+    TraceSpan& arg(const char* name, int64_t value) {
+        if (is_recording() && m_event.num_args < TraceEvent::MAX_ARGS) {
+            m_event.arg_names[m_event.num_args] = name;
+            m_event.arg_values[m_event.num_args] = value;
+            ++m_event.num_args;
+        }
+        return *this;
+    }
+
+private:
+    TraceEvent m_event;
+};
+
+#else
+
+class TraceSpan {
+public:
+    explicit TraceSpan(const char*) {}
+
+    bool is_recording() const {
+        return false;
+    }
+
+    TraceSpan& arg(const char*, int64_t) {
+        return *this;
+    }
+};
+
+#endif
+
+}  // namespace ov::genai
@@ -3,6 +3,7 @@
 
 #include "utils.hpp"
 
+#include <algorithm>
 #include <variant>
 #include <fstream>
 #include <memory>
@@ -367,6 +368,45 @@ ov::Tensor push_front_inputs(const ov::Tensor& base_tensor, int64_t add_to_front
     return new_tensor;
 }
 
+size_t get_vocab_size(const ov::CompiledModel& compiled_model) {
+    for (const auto& output : compiled_model.outputs()) {
+        if (!output.get_names().count("logits"))
+            continue;
+        const ov::PartialShape& shape = output.get_partial_shape();
+        if (shape.rank().is_dynamic() || shape.rank().get_length() == 0)
+            return 0;
+        const ov::Dimension& vocab_size = shape[shape.rank().get_length() - 1];
+        return vocab_size.is_static() ? vocab_size.get_length() : 0;
+    }
+    return 0;
+}
+
+void encode_appended_text(const std::function<std::vector<int64_t>(const std::string&)>& encode,
+                          const std::string& previous_text,
+                          const std::string& text,
+                          std::vector<int64_t>& tokens) {
+    // number of bytes before the end of previous text, which are encoded along with the appended part
+    constexpr size_t PREVIOUS_TEXT_CONTEXT_SIZE = 64;
+
+    const size_t boundary = previous_text.size();
+    if (boundary > 0 && boundary < text.size() && text.compare(0, boundary, previous_text) == 0) {
+        // the context starts at the beginning of a UTF-8 character
+        size_t context_begin = boundary > PREVIOUS_TEXT_CONTEXT_SIZE ? boundary - PREVIOUS_TEXT_CONTEXT_SIZE : 0;
+        while (context_begin > 0 && (static_cast<unsigned char>(text[context_begin]) & 0xC0) == 0x80) {
+            --context_begin;
+        }
+        // if no token spans the boundary, encoding of the context alone is a prefix of encoding of the context with the appended part
+        const std::vector<int64_t> context_tokens = encode(text.substr(context_begin, boundary - context_begin));
+        const std::vector<int64_t> appended_tokens = encode(text.substr(context_begin));
+        if (!context_tokens.empty() && appended_tokens.size() >= context_tokens.size() &&
+            std::equal(context_tokens.begin(), context_tokens.end(), appended_tokens.begin())) {
+            tokens.insert(tokens.end(), appended_tokens.begin() + context_tokens.size(), appended_tokens.end());
+            return;
+        }
+    }
+    tokens = encode(text);
+}
+
 void print_compiled_model_properties(ov::CompiledModel& compiled_Model, const char* model_title) {
     // Specify the name of the environment variable
     const char* env_var_name = "OPENVINO_LOG_LEVEL";
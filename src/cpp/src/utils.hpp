@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #pragma once
+#include <functional>
 #include <type_traits>
 #include <optional>
 #include <stdexcept>
@@ -111,6 +112,20 @@ ov::Tensor push_front_inputs(const ov::Tensor& base_tensor, int64_t add_to_front
 
 void print_compiled_model_properties(ov::CompiledModel& compiled_Model, const char* model_title);
 
+// Returns size of the last dimension of 'logits' output, or 0 if the model has no such output or it's dynamic
+size_t get_vocab_size(const ov::CompiledModel& compiled_model);
+
+/**
+ * Updates tokens of previous_text to tokens of text, which usually extends it, e.g. a templated chat history with new
+ * messages. Only the appended part is encoded along with a few preceding bytes, so it's encoded as in the middle of a text
+ * (e.g. without a dummy prefix of SentencePiece tokenizers). If tokens merge across the end of previous_text or it's not
+ * a prefix of text, the whole text is encoded.
+ */
+void encode_appended_text(const std::function<std::vector<int64_t>(const std::string&)>& encode,
+                          const std::string& previous_text,
+                          const std::string& text,
+                          std::vector<int64_t>& tokens);
+
 
 /// @brief SharedOptional is a wrapper around a reference to an existing object and an optional shared alternative value.
 /// The difference from std::optional is that the default state is not empty and contains a reference to an existing object outside the class.
@@ -0,0 +1,144 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "virtual_memory.hpp"
+
+#ifdef _WIN32
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <sys/mman.h>
+#    include <unistd.h>
+#endif
+
+#ifdef __linux__
+#    include <linux/mempolicy.h>
+#    include <sys/syscall.h>
+#endif
+
+#include <bitset>
+#include <vector>
+
+#include "openvino/core/except.hpp"
+
+namespace ov::genai {
+
+VirtualMemoryRegion::VirtualMemoryRegion(size_t reserved_size) {
+    OPENVINO_ASSERT(reserved_size > 0, "Reserved size of virtual memory region must be non-zero");
+    m_reserved_size = round_up_to_pages(reserved_size);
+#ifdef _WIN32
+    m_data = static_cast<uint8_t*>(VirtualAlloc(nullptr, m_reserved_size, MEM_RESERVE, PAGE_NOACCESS));
+    OPENVINO_ASSERT(m_data != nullptr, "Cannot reserve ", m_reserved_size, " bytes of virtual memory");
+#else
+    void* data = mmap(nullptr, m_reserved_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    OPENVINO_ASSERT(data != MAP_FAILED, "Cannot reserve ", m_reserved_size, " bytes of virtual memory");
+    m_data = static_cast<uint8_t*>(data);
+#endif
+}
+
+VirtualMemoryRegion::~VirtualMemoryRegion() {
+#ifdef _WIN32
+    VirtualFree(m_data, 0, MEM_RELEASE);
+#else
+    munmap(m_data, m_reserved_size);
+#endif
+}
+
+void VirtualMemoryRegion::commit(size_t size) {
+    OPENVINO_ASSERT(size <= m_reserved_size, "Cannot commit ", size, " bytes of virtual memory region of ", m_reserved_size, " bytes");
+    size_t new_committed_size = round_up_to_pages(size);
+    if (new_committed_size <= m_committed_size) {
+        return;
+    }
+    uint8_t* begin = m_data + m_committed_size;
+    size_t num_bytes = new_committed_size - m_committed_size;
+#ifdef _WIN32
+    OPENVINO_ASSERT(VirtualAlloc(begin, num_bytes, MEM_COMMIT, PAGE_READWRITE) != nullptr, "Cannot commit ", num_bytes, " bytes of virtual memory");
+#else
+    OPENVINO_ASSERT(mprotect(begin, num_bytes, PROT_READ | PROT_WRITE) == 0, "Cannot commit ", num_bytes, " bytes of virtual memory");
+#endif
+    m_committed_size = new_committed_size;
+}
+
+void VirtualMemoryRegion::decommit(size_t size) {
+    size_t new_committed_size = round_up_to_pages(size);
+    if (new_committed_size >= m_committed_size) {
+        return;
+    }
+    uint8_t* begin = m_data + new_committed_size;
+    size_t num_bytes = m_committed_size - new_committed_size;
+#ifdef _WIN32
+    OPENVINO_ASSERT(VirtualFree(begin, num_bytes, MEM_DECOMMIT), "Cannot decommit ", num_bytes, " bytes of virtual memory");
+#else
+    // pages are returned to the OS and read as zeros if committed again
+    OPENVINO_ASSERT(madvise(begin, num_bytes, MADV_DONTNEED) == 0 && mprotect(begin, num_bytes, PROT_NONE) == 0,
+                    "Cannot decommit ", num_bytes, " bytes of virtual memory");
+#endif
+    m_committed_size = new_committed_size;
+}
+
+bool VirtualMemoryRegion::interleave_numa_nodes() {
+#ifdef __linux__
+    // the process policy is used as is if it's set explicitly
+    int mode = MPOL_DEFAULT;
+    if (syscall(SYS_get_mempolicy, &mode, nullptr, 0, nullptr, 0) != 0 || mode != MPOL_DEFAULT) {
+        return false;
+    }
+
+    constexpr size_t max_num_nodes = 1024;
+    constexpr size_t bits_per_word = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> allowed_nodes(max_num_nodes / bits_per_word, 0);
+    if (syscall(SYS_get_mempolicy, nullptr, allowed_nodes.data(), max_num_nodes, nullptr, MPOL_F_MEMS_ALLOWED) != 0) {
+        return false;
+    }
+
+    size_t num_allowed_nodes = 0;
+    for (unsigned long word : allowed_nodes) {
+        num_allowed_nodes += std::bitset<bits_per_word>(word).count();
+    }
+    if (num_allowed_nodes < 2) {
+        return false;
+    }
+
+    // the kernel expects the mask size to be larger by one
+    return syscall(SYS_mbind, m_data, m_reserved_size, MPOL_INTERLEAVE, allowed_nodes.data(), max_num_nodes + 1, 0) == 0;
+#else
+    return false;
+#endif
+}
+
+size_t VirtualMemoryRegion::get_page_size() {
+#ifdef _WIN32
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    return system_info.dwPageSize;
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+size_t VirtualMemoryRegion::round_up_to_pages(size_t size) const {
+    const size_t page_size = get_page_size();
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+size_t get_physical_memory_size() {
+#ifdef _WIN32
+    MEMORYSTATUSEX memory_status;
+    memory_status.dwLength = sizeof(memory_status);
+    OPENVINO_ASSERT(GlobalMemoryStatusEx(&memory_status), "Cannot get size of physical memory");
+    return static_cast<size_t>(memory_status.ullTotalPhys);
+#else
+    return static_cast<size_t>(sysconf(_SC_PHYS_PAGES)) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+void* VirtualMemoryAllocator::allocate(size_t bytes, size_t alignment) {
+    OPENVINO_ASSERT(alignment == 0 || VirtualMemoryRegion::get_page_size() % alignment == 0, "Unsupported alignment ", alignment, " of virtual memory allocation");
+    m_region->commit(bytes);
+    return m_region->data();
+}
+
+}  // namespace ov::genai
@@ -0,0 +1,97 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace ov::genai {
+
+/**
+ * Range of virtual address space which is reserved at once, while physical memory is committed on demand.
+ * Memory placed at the beginning of the region can grow and shrink in place, without copying of its contents.
+ */
+class VirtualMemoryRegion {
+public:
+    /**
+     * Reserves address space without committing physical memory.
+     * @param reserved_size Maximum size of the memory in bytes.
+     */
+    explicit VirtualMemoryRegion(size_t reserved_size);
+
+    ~VirtualMemoryRegion();
+
+    VirtualMemoryRegion(const VirtualMemoryRegion&) = delete;
+    VirtualMemoryRegion& operator=(const VirtualMemoryRegion&) = delete;
+
+    void* data() const {
+        return m_data;
+    }
+
+    size_t get_reserved_size() const {
+        return m_reserved_size;
+    }
+
+    size_t get_committed_size() const {
+        return m_committed_size;
+    }
+
+    /**
+     * Makes at least the first `size` bytes of the region accessible. Contents of the already committed part are kept.
+     */
+    void commit(size_t size);
+
+    /**
+     * Returns physical memory after the first `size` bytes of the region to the OS. Contents of the released part are lost.
+     */
+    void decommit(size_t size);
+
+    /**
+     * Spreads pages of the region across the NUMA nodes the process may use, so that memory bandwidth of all nodes
+     * is used by threads running on different sockets. Must be called before memory is committed to take effect.
+     * Memory policy set explicitly for the process (e.g. with numactl) is respected.
+     * @return Whether the interleaving is applied. It's not applied on single node machines and on non-Linux systems.
+     */
+    bool interleave_numa_nodes();
+
+    static size_t get_page_size();
+
+private:
+    size_t round_up_to_pages(size_t size) const;
+
+    uint8_t* m_data = nullptr;
+    size_t m_reserved_size = 0;
+    size_t m_committed_size = 0;
+};
+
+/**
+ * @return Size of physical memory of the machine in bytes.
+ */
+size_t get_physical_memory_size();
+
+/**
+ * ov::Allocator which places tensors at the beginning of a reserved region. Tensors of different sizes created
+ * with allocators of the same region share memory, so a tensor can be replaced by a larger one without copying.
+ * The region is released when all tensors using it are destroyed.
+ */
+class VirtualMemoryAllocator {
+public:
+    explicit VirtualMemoryAllocator(std::shared_ptr<VirtualMemoryRegion> region) : m_region(std::move(region)) {}
+
+    void* allocate(size_t bytes, size_t alignment);
+
+    void deallocate(void* /* handle */, size_t /* bytes */, size_t /* alignment */) {
+        // memory is owned by the region
+    }
+
+    bool is_equal(const VirtualMemoryAllocator& other) const {
+        return m_region == other.m_region;
+    }
+
+private:
+    std::shared_ptr<VirtualMemoryRegion> m_region;
+};
+
+}  // namespace ov::genai
@@ -4,13 +4,145 @@
 // Based on clip.cpp
 
 #include "clip.hpp"
+#include <algorithm>
 #include <cmath>
+#include <limits>
+
+#include "openvino/core/parallel.hpp"
+
+namespace {
+
+template<typename NUM>
+NUM clip(NUM x, NUM lower, NUM upper) {
+    return std::max(lower, std::min(x, upper));
+}
 
 // Linear interpolation between two points
-static float clip_lerp(float s, float e, float t) {
+float clip_lerp(float s, float e, float t) {
     return s + (e - s) * t;
 }
 
+// Splits [0, work_amount) between threads and calls func(begin, end) once per thread,
+// so per thread buffers are allocated once and not per row
+template <typename F>
+void parallel_rows(int work_amount, const F& func) {
+    ov::parallel_nt(0, [&](const int ithr, const int nthr) {
+        int begin = 0, end = 0;
+        ov::splitter(work_amount, nthr, ithr, begin, end);
+        if (begin < end) {
+            func(begin, end);
+        }
+    });
+}
+
+// Normalization of u8 values is a lookup in a per channel table,
+// values are bitwise identical to ((v / 255) - mean) / std computed in place
+struct NormalizationTable {
+    float values[3][256];
+
+    explicit NormalizationTable(const clip_ctx& ctx) {
+        for (size_t c = 0; c < 3; ++c) {
+            for (size_t v = 0; v < 256; ++v) {
+                values[c][v] = ((float(v) / 255.0f) - ctx.image_mean[c]) / ctx.image_std[c];
+            }
+        }
+    }
+
+    // Converts a row of interleaved RGB values to rows of planes
+    void normalize_row(const uint8_t* rgb, size_t width, float* r, float* g, float* b) const {
+        for (size_t x = 0; x < width; ++x) {
+            r[x] = values[0][rgb[3 * x]];
+            g[x] = values[1][rgb[3 * x + 1]];
+            b[x] = values[2][rgb[3 * x + 2]];
+        }
+    }
+};
+
+// Source pixels and an offset of a single output coordinate of bicubic interpolation
+struct CubicTap {
+    // offsets of 4 neighbouring pixels clipped to the image borders, in elements of a row or in rows
+    int idx[4];
+    float d;
+};
+
+std::vector<CubicTap> get_cubic_taps(int src_size, int dst_size, int begin, int size, int stride) {
+    const float ratio = (float)src_size / (float)dst_size;
+    std::vector<CubicTap> taps(size);
+    for (int i = 0; i < size; ++i) {
+        const int dst_idx = begin + i;
+        const int src_idx = (int)(ratio * dst_idx);
+        taps[i].d = ratio * dst_idx - src_idx;
+        for (int m = 0; m < 4; ++m) {
+            taps[i].idx[m] = clip(src_idx - 1 + m, 0, src_size - 1) * stride;
+        }
+    }
+    return taps;
+}
+
+float cubic(float p0, float p1, float p2, float p3, float d) {
+    const float d0 = p0 - p1;
+    const float d2 = p2 - p1;
+    const float d3 = p3 - p1;
+    const float a0 = p1;
+    const float a1 = -1.0 / 3 * d0 + d2 - 1.0 / 6 * d3;
+    const float a2 =  1.0 / 2 * d0 +      1.0 / 2 * d2;
+    const float a3 = -1.0 / 6 * d0 -      1.0 / 2 * d2 + 1.0 / 6 * d3;
+    return a0 + a1 * d + a2 * d * d + a3 * d * d * d;
+}
+
+// Bicubic interpolation; adapted from ViT.cpp, inspired from :
+//    -> https://github.com/yglukhov/bicubic-interpolation-image-processing/blob/master/libimage.c#L36
+//    -> https://en.wikipedia.org/wiki/Bicubic_interpolation
+// Computes width x height region starting at (x0, y0) of img resized to target_width x target_height
+// and passes each row of interleaved RGB values to store_row(row, rgb).
+// Interpolation is separable: 4 source rows are interpolated horizontally first,
+// then the results are combined vertically. Coefficients are shared by all rows and columns.
+template <typename StoreRow>
+void bicubic_resize_rows(const clip_image_u8& img, int target_width, int target_height,
+                         int x0, int y0, int width, int height, const StoreRow& store_row) {
+    const int nx = img.nx;
+    const int ny = img.ny;
+    const std::vector<CubicTap> col_taps = get_cubic_taps(nx, target_width, x0, width, 3);
+    const std::vector<CubicTap> row_taps = get_cubic_taps(ny, target_height, y0, height, 3 * nx);
+    const size_t row_size = 3 * size_t(width);
+
+    parallel_rows(height, [&](int begin, int end) {
+        std::vector<float> horizontal(4 * row_size);
+        std::vector<uint8_t> rgb(row_size);
+        for (int i = begin; i < end; ++i) {
+            const CubicTap& row_tap = row_taps[i];
+            for (int m = 0; m < 4; ++m) {
+                const uint8_t* src_row = img.buf.data() + row_tap.idx[m];
+                float* dst_row = horizontal.data() + m * row_size;
+                for (int j = 0; j < width; ++j) {
+                    const CubicTap& col_tap = col_taps[j];
+                    for (int k = 0; k < 3; ++k) {
+                        dst_row[3 * j + k] = cubic(src_row[col_tap.idx[0] + k], src_row[col_tap.idx[1] + k],
+                                                   src_row[col_tap.idx[2] + k], src_row[col_tap.idx[3] + k], col_tap.d);
+                    }
+                }
+            }
+            const float* h0 = horizontal.data();
+            const float* h1 = h0 + row_size;
+            const float* h2 = h1 + row_size;
+            const float* h3 = h2 + row_size;
+            for (size_t idx = 0; idx < row_size; ++idx) {
+                const float Cc = cubic(h0[idx], h1[idx], h2[idx], h3[idx], row_tap.d);
+                rgb[idx] = std::min(std::max(std::round(Cc), 0.0f), 255.0f);
+            }
+            store_row(i, rgb.data());
+        }
+    });
+}
+
+} // namespace
+
+clip_planar_dst clip_chw_dst(float* data, size_t width, size_t height) {
+    return [data, width, height](size_t channel, size_t row) {
+        return data + (channel * height + row) * width;
+    };
+}
+
 // Bilinear resize function
 void bilinear_resize(const clip_image_u8& src, clip_image_u8& dst, int target_width, int target_height) {
     dst.nx = target_width;
@@ -20,96 +152,80 @@ void bilinear_resize(const clip_image_u8& src, clip_image_u8& dst, int target_wi
     float x_ratio = static_cast<float>(src.nx - 1) / target_width;
     float y_ratio = static_cast<float>(src.ny - 1) / target_height;
 
-    for (int y = 0; y < target_height; y++) {
-        for (int x = 0; x < target_width; x++) {
-            float px = x_ratio * x;
+    // interpolation offsets are the same for all rows
+    std::vector<int> x_floors(target_width), x_ceils(target_width);
+    std::vector<float> x_lerps(target_width);
+    for (int x = 0; x < target_width; x++) {
+        float px = x_ratio * x;
+        x_floors[x] = 3 * static_cast<int>(px);
+        x_ceils[x] = 3 * std::min(static_cast<int>(px) + 1, src.nx - 1);
+        x_lerps[x] = px - static_cast<int>(px);
+    }
+
+    parallel_rows(target_height, [&](int begin, int end) {
+        for (int y = begin; y < end; y++) {
             float py = y_ratio * y;
-            int x_floor = static_cast<int>(px);
             int y_floor = static_cast<int>(py);
-            float x_lerp = px - x_floor;
             float y_lerp = py - y_floor;
-
-            for (int c = 0; c < 3; c++) {
-                float top = clip_lerp(
-                    static_cast<float>(src.buf[3 * (y_floor * src.nx + x_floor) + c]),
-                    static_cast<float>(src.buf[3 * (y_floor * src.nx + (x_floor + 1)) + c]),
-                    x_lerp
-                );
-                float bottom = clip_lerp(
-                    static_cast<float>(src.buf[3 * ((y_floor + 1) * src.nx + x_floor) + c]),
-                    static_cast<float>(src.buf[3 * ((y_floor + 1) * src.nx + (x_floor + 1)) + c]),
-                    x_lerp
-                );
-                dst.buf[3 * (y * target_width + x) + c] = static_cast<uint8_t>(clip_lerp(top, bottom, y_lerp));
+            const uint8_t* top_row = src.buf.data() + 3 * y_floor * src.nx;
+            const uint8_t* bottom_row = src.buf.data() + 3 * std::min(y_floor + 1, src.ny - 1) * src.nx;
+            uint8_t* dst_row = dst.buf.data() + 3 * y * target_width;
+
+            for (int x = 0; x < target_width; x++) {
+                for (int c = 0; c < 3; c++) {
+                    float top = clip_lerp(
+                        static_cast<float>(top_row[x_floors[x] + c]),
+                        static_cast<float>(top_row[x_ceils[x] + c]),
+                        x_lerps[x]
+                    );
+                    float bottom = clip_lerp(
+                        static_cast<float>(bottom_row[x_floors[x] + c]),
+                        static_cast<float>(bottom_row[x_ceils[x] + c]),
+                        x_lerps[x]
+                    );
+                    dst_row[3 * x + c] = static_cast<uint8_t>(clip_lerp(top, bottom, y_lerp));
+                }
             }
         }
-    }
-}
-
-template<typename NUM>
-NUM clip(NUM x, NUM lower, NUM upper) {
-    return std::max(lower, std::min(x, upper));
+    });
 }
 
 void bicubic_resize(const clip_image_u8 &img, clip_image_u8 &dst, int target_width, int target_height) {
-    const int nx = img.nx;
-    const int ny = img.ny;
-
     dst.nx = target_width;
     dst.ny = target_height;
     dst.buf.resize(3 * target_width * target_height);
 
-    float Cc;
-    float C[5];
-    float d0, d2, d3, a0, a1, a2, a3;
-    int i, j, k, jj;
-    int x, y;
-    float dx, dy;
-    float tx, ty;
-
-    tx = (float)nx / (float)target_width;
-    ty = (float)ny / (float)target_height;
-
-    // Bicubic interpolation; adapted from ViT.cpp, inspired from :
-    //    -> https://github.com/yglukhov/bicubic-interpolation-image-processing/blob/master/libimage.c#L36
-    //    -> https://en.wikipedia.org/wiki/Bicubic_interpolation
-
-    for (i = 0; i < target_height; i++) {
-        for (j = 0; j < target_width; j++) {
-            x = (int)(tx * j);
-            y = (int)(ty * i);
-
-            dx = tx * j - x;
-            dy = ty * i - y;
-
-            for (k = 0; k < 3; k++) {
-                for (jj = 0; jj <= 3; jj++) {
-                    d0 = img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x - 1, 0, nx - 1)) * 3 + k] - img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x, 0, nx - 1)) * 3 + k];
-                    d2 = img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x + 1, 0, nx - 1)) * 3 + k] - img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x, 0, nx - 1)) * 3 + k];
-                    d3 = img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x + 2, 0, nx - 1)) * 3 + k] - img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x, 0, nx - 1)) * 3 + k];
-                    a0 = img.buf[(clip(y - 1 + jj, 0, ny - 1) * nx + clip(x, 0, nx - 1)) * 3 + k];
-
-                    a1 = -1.0 / 3 * d0 + d2 - 1.0 / 6 * d3;
-                    a2 =  1.0 / 2 * d0 +      1.0 / 2 * d2;
-                    a3 = -1.0 / 6 * d0 -      1.0 / 2 * d2 + 1.0 / 6 * d3;
-
-                    C[jj] = a0 + a1 * dx + a2 * dx * dx + a3 * dx * dx * dx;
-
-                    d0 = C[0] - C[1];
-                    d2 = C[2] - C[1];
-                    d3 = C[3] - C[1];
-                    a0 = C[1];
-                    a1 = -1.0 / 3 * d0 + d2 - 1.0 / 6 * d3;
-                    a2 =  1.0 / 2 * d0 +      1.0 / 2 * d2;
-                    a3 = -1.0 / 6 * d0 -      1.0 / 2 * d2 + 1.0 / 6 * d3;
-                    Cc = a0 + a1 * dy + a2 * dy * dy + a3 * dy * dy * dy;
-
-                    const uint8_t Cc2 = std::min(std::max(std::round(Cc), 0.0f), 255.0f);
-                    dst.buf[(i * target_width + j) * 3 + k] = float(Cc2);
-                }
-            }
+    const size_t row_size = 3 * size_t(target_width);
+    bicubic_resize_rows(img, target_width, target_height, 0, 0, target_width, target_height, [&](int row, const uint8_t* rgb) {
+        std::copy_n(rgb, row_size, dst.buf.data() + row * row_size);
+    });
+}
+
+void clip_image_normalize(const clip_ctx& ctx, const clip_image_u8& img, int x0, int y0, int width, int height, const clip_planar_dst& dst) {
+    const NormalizationTable table{ctx};
+    parallel_rows(height, [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            const uint8_t* rgb = img.buf.data() + 3 * (size_t(y0 + y) * img.nx + x0);
+            table.normalize_row(rgb, width, dst(0, y), dst(1, y), dst(2, y));
         }
+    });
+}
+
+void bicubic_resize_normalize(const clip_ctx& ctx, const clip_image_u8& img, int target_width, int target_height,
+                              int x0, int y0, int width, int height, const clip_planar_dst& dst) {
+    if (img.nx == target_width && img.ny == target_height) {
+        // bicubic resize to the same size is identity
+        clip_image_normalize(ctx, img, x0, y0, width, height, dst);
+        return;
     }
+    const NormalizationTable table{ctx};
+    bicubic_resize_rows(img, target_width, target_height, x0, y0, width, height, [&](int row, const uint8_t* rgb) {
+        table.normalize_row(rgb, width, dst(0, row), dst(1, row), dst(2, row));
+    });
+}
+
+void bicubic_resize_normalize(const clip_ctx& ctx, const clip_image_u8& img, int target_width, int target_height, const clip_planar_dst& dst) {
+    bicubic_resize_normalize(ctx, img, target_width, target_height, 0, 0, target_width, target_height, dst);
 }
 
 // llava-1.6 type of resize_and_pad (black)
@@ -144,11 +260,8 @@ static clip_image_u8 resize_and_pad_image(const clip_image_u8& image, const std:
 
     // Copy the resized image into the center of the padded buffer
     for (int y = 0; y < new_height; ++y) {
-        for (int x = 0; x < new_width; ++x) {
-            for (int c = 0; c < 3; ++c) {
-                padded_image.buf[3 * ((y + pad_y) * target_width + (x + pad_x)) + c] = resized_image.buf[3 * (y * new_width + x) + c];
-            }
-        }
+        std::copy_n(resized_image.buf.data() + 3 * y * new_width, 3 * new_width,
+                    padded_image.buf.data() + 3 * ((y + pad_y) * target_width + pad_x));
     }
     return padded_image;
 }
@@ -188,72 +301,13 @@ std::pair<int, int> select_best_resolution(const std::pair<int, int> & original_
 
 // returns the normalized float tensor for llava-1.5, for spatial_unpad with anyres processing for llava-1.6 it returns the normalized image patch tensors as a vector
 clip_image_f32 clip_image_preprocess(clip_ctx& ctx, const clip_image_u8& img) {
-    bool pad_to_square = true;
-
-    clip_image_u8 temp;  // we will keep the input image data here temporarily
-    temp.nx = img.nx;
-    temp.ny = img.ny;
-    temp.buf.resize(img.buf.size());
-    memcpy(temp.buf.data(), img.buf.data(), temp.buf.size());
-
-
-    const int nx = temp.nx;
-    const int ny = temp.ny;
-
-    const int nx2 = temp.nx;
-    const int ny2 = temp.ny;
-
     clip_image_f32 res;
-    res.nx = nx2;
-    res.ny = ny2;
-    res.buf.resize(3 * nx2 * ny2);
-
-    const int nx3 = nx;
-    const int ny3 = ny;
-
-    const auto& m3 = ctx.image_mean; // {0.48145466f, 0.4578275f, 0.40821073f};
-    const auto& s3 = ctx.image_std;  // {0.26862954f, 0.26130258f, 0.27577711f};
-
-    for (int y = 0; y < ny3; y++) {
-        for (int x = 0; x < nx3; x++) {
-            for (int c = 0; c < 3; c++) {
-                // linear interpolation
-                const float sx = x;
-                const float sy = y;
-
-                const int x0 = std::max(0, (int)std::floor(sx));
-                const int y0 = std::max(0, (int)std::floor(sy));
-
-                const int x1 = std::min(x0 + 1, nx - 1);
-                const int y1 = std::min(y0 + 1, ny - 1);
-
-                const float dx = sx - x0;
-                const float dy = sy - y0;
-
-                const int j00 = 3 * (y0 * nx + x0) + c;
-                const int j01 = 3 * (y0 * nx + x1) + c;
-                const int j10 = 3 * (y1 * nx + x0) + c;
-                const int j11 = 3 * (y1 * nx + x1) + c;
+    res.nx = img.nx;
+    res.ny = img.ny;
+    res.buf.resize(3 * size_t(img.nx) * img.ny);
 
-                const float v00 = temp.buf[j00];
-                const float v01 = temp.buf[j01];
-                const float v10 = temp.buf[j10];
-                const float v11 = temp.buf[j11];
-
-                const float v0 = v00 * (1.0f - dx) + v01 * dx;
-                const float v1 = v10 * (1.0f - dx) + v11 * dx;
-
-                const float v = v0 * (1.0f - dy) + v1 * dy;
-
-                const uint8_t v2 = std::min(std::max(std::round(v), 0.0f), 255.0f);
-
-                //rgb hwc ->chw
-                const int i = (y * nx3 + x) + c * nx3 * ny3;
-
-                res.buf[i] = ((float(v2) / 255.0f) - m3[c]) / s3[c];
-            }
-        }
-    }
+    //rgb hwc ->chw
+    clip_image_normalize(ctx, img, 0, 0, img.nx, img.ny, clip_chw_dst(res.buf.data(), img.nx, img.ny));
     return res;
 }
 
@@ -298,15 +352,10 @@ std::vector<clip_image_u8> get_image_patches(
             patch.buf.resize(3 * patch_size * patch_size);
 
             for (int y = 0; y < patch_size; ++y) {
-                for (int x = 0; x < patch_size; ++x) {
-                    for (int c = 0; c < 3; ++c) {
-                        int src_y = h * patch_size + y;
-                        int src_x = w * patch_size + x;
-                        int src_idx = (src_y * width + src_x) * 3 + c;
-                        int dst_idx = (y * patch_size + x) * 3 + c;
-                        patch.buf[dst_idx] = resized_image.buf[src_idx];
-                    }
-                }
+                int src_y = h * patch_size + y;
+                int src_x = w * patch_size;
+                std::copy_n(resized_image.buf.data() + (src_y * width + src_x) * 3, 3 * patch_size,
+                            patch.buf.data() + y * patch_size * 3);
             }
             patches.push_back(patch);
         }
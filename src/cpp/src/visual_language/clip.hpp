@@ -5,6 +5,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <vector>
 
 struct clip_ctx {
@@ -30,9 +31,27 @@ struct clip_image_f32 {
     std::vector<float> buf;
 };
 
+// Destination of planar float32 images produced by fused kernels below:
+// returns a pointer to the beginning of a given row of a given channel.
+// Allows to write rows directly to encoder inputs with model specific layouts.
+using clip_planar_dst = std::function<float*(size_t channel, size_t row)>;
+
+// Destination writing an image of a given size to data in CHW layout
+clip_planar_dst clip_chw_dst(float* data, size_t width, size_t height);
+
 void bicubic_resize(const clip_image_u8& img, clip_image_u8& dst, int target_width, int target_height);
 void bilinear_resize(const clip_image_u8& src, clip_image_u8& dst, int target_width, int target_height);
 
+// Fused bicubic_resize to target_width x target_height, crop of width x height region starting at (x0, y0)
+// of the resized image, normalization with ctx mean and std and HWC -> CHW conversion in a single pass.
+// Rows are processed in parallel, intermediate images are not materialized.
+void bicubic_resize_normalize(const clip_ctx& ctx, const clip_image_u8& img, int target_width, int target_height,
+                              int x0, int y0, int width, int height, const clip_planar_dst& dst);
+void bicubic_resize_normalize(const clip_ctx& ctx, const clip_image_u8& img, int target_width, int target_height, const clip_planar_dst& dst);
+
+// Fused normalization and HWC -> CHW conversion of width x height region of img starting at (x0, y0)
+void clip_image_normalize(const clip_ctx& ctx, const clip_image_u8& img, int x0, int y0, int width, int height, const clip_planar_dst& dst);
+
 /** preprocess img and store the result in res_imgs, pad_to_square may be overridden to false depending on model configuration */
 clip_image_f32 clip_image_preprocess(struct clip_ctx& ctx, const clip_image_u8& img);
 
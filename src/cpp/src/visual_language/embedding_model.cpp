@@ -74,6 +74,16 @@ ov::Tensor EmbeddingsModel::infer(const ov::Tensor& input_idx, bool return_remot
     return m_request.get_output_tensor();
 }
 
+EmbeddingsModel EmbeddingsModel::clone() const {
+    OPENVINO_ASSERT(m_request, "Text embeddings decoder model must be compiled first. Cannot clone non-compiled model");
+
+    ov::InferRequest request = m_request;
+    ov::CompiledModel compiled_model = request.get_compiled_model();
+    EmbeddingsModel cloned;
+    std::tie(cloned.m_request, cloned.m_cpu_tensor, cloned.m_remote_tensor) = init(compiled_model);
+    return cloned;
+}
+
 void EmbeddingsModel::merge_postprocess(std::shared_ptr<ov::Model> model, float scale_emb) const {
     ov::preprocess::PrePostProcessor ppp(model);
 
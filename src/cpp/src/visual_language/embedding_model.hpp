@@ -39,6 +39,10 @@ public:
 
     ov::Tensor infer(const ov::Tensor& input_idx, bool return_remote_tensor=false);
 
+    // creates a model with its own infer request sharing the same compiled model,
+    // so embeddings can be computed concurrently with this model
+    EmbeddingsModel clone() const;
+
 private:
     void merge_postprocess(std::shared_ptr<ov::Model> model, float scale_emb) const;
 
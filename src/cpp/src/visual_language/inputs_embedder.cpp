@@ -6,10 +6,12 @@
 
 #include "visual_language/clip.hpp"
 #include "visual_language/vision_encoder.hpp"
+#include "visual_language/vision_embeddings_cache.hpp"
 #include "visual_language/embedding_model.hpp"
 #include "openvino/opsets/opset13.hpp"
 
 #include "utils.hpp"
+#include <functional>
 #include <regex>
 
 namespace ov::genai {
@@ -43,6 +45,11 @@ protected:
     ov::genai::GenerationStatus m_chat_generation_finish_status = ov::genai::GenerationStatus::RUNNING;
     // reflection of tokens contained in the kv cache
     KVCacheState m_kv_cache_state;
+    // Embeddings of recently seen images to skip vision models inference for repeated images
+    VisionEmbeddingsCache m_embeddings_cache;
+    // Embeddings of images of future prompts encoded by prefetch_image_embeddings(), they are kept
+    // regardless of the cache capacity until release_prefetched_image_embeddings()
+    std::unordered_map<ImageKey, CachedImageEmbeddings, ImageKeyHash> m_prefetched_embeddings;
 
     std::set<int64_t> m_stop_token_ids;
 public:
@@ -78,6 +85,19 @@ public:
         m_apply_chat_template = apply_chat_template;
     }
 
+    void set_image_embeddings_cache_size(size_t cache_size_bytes) {
+        m_embeddings_cache.set_capacity(cache_size_bytes);
+    }
+
+    // Encodes images of one or several future prompts at once and keeps their embeddings,
+    // so following get_inputs_embeds() calls with these images skip vision encoding even if the cache can't hold them.
+    // Implemented by models which can batch images in a vision encoder inference.
+    virtual void prefetch_image_embeddings(const std::vector<ov::Tensor>& images) {}
+
+    void release_prefetched_image_embeddings() {
+        m_prefetched_embeddings.clear();
+    }
+
     virtual void start_chat(const std::string& system_message) {
         m_is_chat_conversation = true;
         m_kv_history_trim_manager.reset();
@@ -192,6 +212,106 @@ protected:
         return new_input_ids;
     }
 
+    /**
+    * @brief Encodes an image with vision encoder or takes its embeddings from the cache.
+    * Vision encoder config is constant for a given embedder, so image content is enough to identify embeddings.
+    *
+    * @param image An image tensor with a shape [1, H, W, C]
+    * @param config_map Vision encoder config overrides
+    * @param project Optional model specific postprocessing of encoded image, its results are cached as well.
+    * Returned tensors must not share memory with infer requests outputs.
+    * @return Encoded image and its projected embeddings
+    */
+    CachedImageEmbeddings encode_image(
+        const ov::Tensor& image,
+        const ov::AnyMap& config_map = {},
+        const std::function<std::vector<ov::Tensor>(const EncodedImage&)>& project = nullptr
+    ) {
+        const ImageKey key = VisionEmbeddingsCache::compute_key(image);
+        if (std::optional<CachedImageEmbeddings> cached = find_embeddings(key)) {
+            return *cached;
+        }
+
+        CachedImageEmbeddings embeddings;
+        embeddings.encoded_image = config_map.empty() ? m_vision_encoder.encode(image) : m_vision_encoder.encode(image, config_map);
+        if (project) {
+            embeddings.projected_embeds = project(embeddings.encoded_image);
+        }
+        return m_embeddings_cache.put(key, embeddings);
+    }
+
+    /**
+    * @brief Encodes images with a single batched vision encoder inference or takes their embeddings from the cache.
+    * Images missing in the cache are deduplicated by content and passed to VisionEncoder together,
+    * so models supporting batched encoding run one inference for all slices of all images.
+    *
+    * @param images Image tensors with a shape [1, H, W, C]
+    * @param config_map Vision encoder config overrides
+    * @param project Optional model specific postprocessing of an encoded image, its results are cached as well.
+    * Returned tensors must not share memory with infer requests outputs.
+    * @return Encoded images and their projected embeddings in the order of images
+    */
+    std::vector<CachedImageEmbeddings> encode_images(
+        const std::vector<ov::Tensor>& images,
+        const ov::AnyMap& config_map = {},
+        const std::function<std::vector<ov::Tensor>(const ov::Tensor&, const EncodedImage&)>& project = nullptr
+    ) {
+        std::vector<std::optional<CachedImageEmbeddings>> embeddings(images.size());
+        // images missing in the cache, their keys and positions of their copies in images
+        std::vector<ov::Tensor> images_to_encode;
+        std::vector<ImageKey> keys_to_encode;
+        std::unordered_map<ImageKey, std::vector<size_t>, ImageKeyHash> key_to_indices;
+        for (size_t image_idx = 0; image_idx < images.size(); ++image_idx) {
+            const ImageKey key = VisionEmbeddingsCache::compute_key(images[image_idx]);
+            auto it = key_to_indices.find(key);
+            if (it != key_to_indices.end()) {
+                it->second.push_back(image_idx);
+            } else if (!(embeddings[image_idx] = find_embeddings(key))) {
+                key_to_indices[key].push_back(image_idx);
+                images_to_encode.push_back(images[image_idx]);
+                keys_to_encode.push_back(key);
+            }
+        }
+
+        if (!images_to_encode.empty()) {
+            std::vector<EncodedImage> encoded_images = m_vision_encoder.encode(images_to_encode, config_map);
+            for (size_t encoded_idx = 0; encoded_idx < encoded_images.size(); ++encoded_idx) {
+                CachedImageEmbeddings image_embeddings;
+                image_embeddings.encoded_image = std::move(encoded_images[encoded_idx]);
+                if (project) {
+                    image_embeddings.projected_embeds = project(images_to_encode[encoded_idx], image_embeddings.encoded_image);
+                }
+                image_embeddings = m_embeddings_cache.put(keys_to_encode[encoded_idx], image_embeddings);
+                for (size_t image_idx : key_to_indices.at(keys_to_encode[encoded_idx])) {
+                    embeddings[image_idx] = image_embeddings;
+                }
+            }
+        }
+
+        std::vector<CachedImageEmbeddings> result;
+        result.reserve(images.size());
+        for (std::optional<CachedImageEmbeddings>& image_embeddings : embeddings) {
+            result.push_back(std::move(*image_embeddings));
+        }
+        return result;
+    }
+
+    // Keeps embeddings of images encoded by prefetch_image_embeddings() until release_prefetched_image_embeddings().
+    // Unlike the cache, they are never evicted, so each image is encoded once for a batch of prompts.
+    void keep_prefetched_embeddings(const std::vector<ov::Tensor>& images, std::vector<CachedImageEmbeddings>&& embeddings) {
+        for (size_t image_idx = 0; image_idx < images.size(); ++image_idx) {
+            m_prefetched_embeddings.emplace(VisionEmbeddingsCache::compute_key(images[image_idx]), std::move(embeddings[image_idx]));
+        }
+    }
+
+    std::optional<CachedImageEmbeddings> find_embeddings(const ImageKey& key) {
+        auto it = m_prefetched_embeddings.find(key);
+        if (it != m_prefetched_embeddings.end()) {
+            return it->second;
+        }
+        return m_embeddings_cache.get(key);
+    }
+
     /**
     * @brief Unpads an image tensor of a padded and resized image.
     * Used for packing image features of llava_next models.
@@ -280,12 +400,15 @@ public:
 
     virtual ov::Tensor get_inputs_embeds(const std::string& prompt, const std::vector<ov::Tensor>& images, ov::genai::VLMPerfMetrics& metrics) override {
         std::string images_prompt;
-        std::vector<EncodedImage> embeds;
+        std::vector<CachedImageEmbeddings> embeds;
 
         std::vector<ov::Tensor> single_images = to_single_image_tensors(images);
 
         for (const ov::Tensor& image : single_images) {
-            EncodedImage encoded_image = m_vision_encoder.encode(image);
+            CachedImageEmbeddings image_embeddings = encode_image(image, {}, [this](const EncodedImage& encoded_image) {
+                return resample_image(encoded_image);
+            });
+            const EncodedImage& encoded_image = image_embeddings.encoded_image;
             if (m_vlm_config.use_image_id) {
                 images_prompt += m_vlm_config.im_id_start + std::to_string(m_image_id) + m_vlm_config.im_id_end;
                 ++m_image_id;
@@ -309,7 +432,7 @@ public:
                 // Strangely, \n isn't placed between </image><slice>.
                 images_prompt += '\n';
             }
-            embeds.push_back(std::move(encoded_image));
+            embeds.push_back(std::move(image_embeddings));
         }
         images_prompt += prompt;
 
@@ -344,30 +467,22 @@ public:
         size_t encoded_input_size = encoded_input.get_size();
         int64_t* end = ids + encoded_input_size;
         float* inputs_embeds_data = inputs_embeds.data<float>();
-        for (const EncodedImage& encoded_image : embeds) {
-            const ov::Tensor& resampled_source = resample(encoded_image.resized_source, {encoded_image.resized_source_size});
+        for (const CachedImageEmbeddings& image_embeddings : embeds) {
+            // the first tensor is a resampled source image followed by resampled slices in row-major order
+            const ov::Tensor& resampled_source = image_embeddings.projected_embeds.at(0);
             float* emb = resampled_source.data<float>();
             ids = std::find(ids, end, im_start_id);
             OPENVINO_ASSERT(end != ids);
             ++ids;
             std::copy_n(emb, resampled_source.get_size(), inputs_embeds_data + std::distance(begin, ids) * m_vlm_config.hidden_size);
             ids += m_vlm_config.query_num;
-            if (encoded_image.slices) {
-                size_t token_idx = 0;
-                const ov::Shape& slices_shape = encoded_image.slices.get_shape();
-                for (size_t i = 0; i < slices_shape.at(0); ++i) {
-                    for (size_t ja = 0; ja < slices_shape.at(1); ++ja) {
-                        size_t d2 = slices_shape.at(2);
-                        size_t d3 = slices_shape.at(3);
-                        ov::Tensor encoded_view{ov::element::f32, {1, d2, d3}, encoded_image.slices.data<float>() + (i * slices_shape.at(1) + ja) * d2 * d3};
-                        const ov::Tensor& vision_embed_tensor_i_j = resample(encoded_view, {encoded_image.slices_size});
-                        ids = std::find(ids, end, slice_start_id);
-                        OPENVINO_ASSERT(end != ids);
-                        ++ids;
-                        std::copy_n(vision_embed_tensor_i_j.data<float>(), vision_embed_tensor_i_j.get_size(), inputs_embeds_data + std::distance(begin, ids) * m_vlm_config.hidden_size);
-                        ids += m_vlm_config.query_num;
-                    }
-                }
+            for (size_t slice_idx = 1; slice_idx < image_embeddings.projected_embeds.size(); ++slice_idx) {
+                const ov::Tensor& vision_embed_tensor_i_j = image_embeddings.projected_embeds.at(slice_idx);
+                ids = std::find(ids, end, slice_start_id);
+                OPENVINO_ASSERT(end != ids);
+                ++ids;
+                std::copy_n(vision_embed_tensor_i_j.data<float>(), vision_embed_tensor_i_j.get_size(), inputs_embeds_data + std::distance(begin, ids) * m_vlm_config.hidden_size);
+                ids += m_vlm_config.query_num;
             }
         }
 
@@ -388,6 +503,29 @@ public:
     }
 
 private:
+    // Resamples a source image and its slices. Results are copied since resample() returns resampler output tensor.
+    std::vector<ov::Tensor> resample_image(const EncodedImage& encoded_image) {
+        std::vector<ov::Tensor> resampled;
+        auto copy_tensor = [](const ov::Tensor& tensor) {
+            ov::Tensor copy{tensor.get_element_type(), tensor.get_shape()};
+            tensor.copy_to(copy);
+            return copy;
+        };
+        resampled.push_back(copy_tensor(resample(encoded_image.resized_source, {encoded_image.resized_source_size})));
+        if (encoded_image.slices) {
+            const ov::Shape& slices_shape = encoded_image.slices.get_shape();
+            for (size_t i = 0; i < slices_shape.at(0); ++i) {
+                for (size_t ja = 0; ja < slices_shape.at(1); ++ja) {
+                    size_t d2 = slices_shape.at(2);
+                    size_t d3 = slices_shape.at(3);
+                    ov::Tensor encoded_view{ov::element::f32, {1, d2, d3}, encoded_image.slices.data<float>() + (i * slices_shape.at(1) + ja) * d2 * d3};
+                    resampled.push_back(copy_tensor(resample(encoded_view, {encoded_image.slices_size})));
+                }
+            }
+        }
+        return resampled;
+    }
+
     ov::Tensor resample(const ov::Tensor& encoded_image, const std::vector<ImageSize>& target_sizes) {
         size_t bs = encoded_image.get_shape().at(0);
         std::vector<size_t> patch_len{target_sizes.size()};
@@ -585,10 +723,8 @@ public:
         std::vector<ov::Tensor> image_embeds;
         image_embeds.reserve(single_images.size());
 
-        for (const auto& image : single_images) {
-            ov::AnyMap vision_config = {{"patch_size", m_vlm_config.vision_config_patch_size}};
-            EncodedImage encoded_image = m_vision_encoder.encode(image, vision_config);
-            image_embeds.push_back(std::move(encoded_image.resized_source));
+        for (CachedImageEmbeddings& image_embeddings : encode_prompt_images(single_images)) {
+            image_embeds.push_back(get_image_features(image_embeddings));
             formatted_prompt += image_token + "\n";
         }
         formatted_prompt += prompt;
@@ -608,6 +744,23 @@ public:
         return merge_text_and_image_embeddings_llava(input_ids, text_embeds, image_embeds, image_token_id);
     }
 
+    void prefetch_image_embeddings(const std::vector<ov::Tensor>& images) override {
+        const std::vector<ov::Tensor> single_images = to_single_image_tensors(images);
+        keep_prefetched_embeddings(single_images, encode_prompt_images(single_images));
+    }
+
+protected:
+    // Encodes all images of a prompt with a single vision encoder inference
+    virtual std::vector<CachedImageEmbeddings> encode_prompt_images(const std::vector<ov::Tensor>& single_images) {
+        ov::AnyMap vision_config = {{"patch_size", m_vlm_config.vision_config_patch_size}};
+        return encode_images(single_images, vision_config);
+    }
+
+    // Image features which replace an image token in a prompt
+    virtual ov::Tensor get_image_features(const CachedImageEmbeddings& image_embeddings) const {
+        return image_embeddings.encoded_image.resized_source;
+    }
+
 protected:
     ov::Tensor merge_text_and_image_embeddings_llava(
         const ov::Tensor& input_ids,
@@ -689,50 +842,24 @@ public:
         const ov::AnyMap device_config) :
         InputsEmbedderLLaVA(vlm_config, models_map, tokenizer, config_dir_path, device, device_config) { }
 
-    virtual ov::Tensor get_inputs_embeds(const std::string& prompt, const std::vector<ov::Tensor>& images, ov::genai::VLMPerfMetrics& metrics) override {
-        std::string image_token = m_vlm_config.im_start;
-
-        std::vector<ov::Tensor> single_images = to_single_image_tensors(images);
-
-        std::string formatted_prompt;
-        std::vector<ov::Tensor> image_embeds;
-        image_embeds.reserve(single_images.size());
-        
+protected:
+    std::vector<CachedImageEmbeddings> encode_prompt_images(const std::vector<ov::Tensor>& single_images) override {
+        ov::AnyMap vision_config = {{"patch_size", m_vlm_config.vision_config_patch_size}};
         ov::Tensor image_newline;
-
-        for (const auto& image : single_images) {
-            ov::AnyMap vision_config = {{"patch_size", m_vlm_config.vision_config_patch_size}};
-            EncodedImage encoded_image = m_vision_encoder.encode(image, vision_config);
-
+        return encode_images(single_images, vision_config, [&](const ov::Tensor& image, const EncodedImage& encoded_image) {
+            ImageSize original_image_size{image.get_shape().at(1), image.get_shape().at(2)}; // [height, width]
             if (!image_newline) {
                 size_t embed_dim = encoded_image.resized_source.get_shape().at(2);
                 image_newline = ov::Tensor(encoded_image.resized_source.get_element_type(), {embed_dim});
                 float* image_newline_data = image_newline.data<float>();
                 std::copy(m_vlm_config.image_newline.begin(), m_vlm_config.image_newline.end(), image_newline_data);
             }
+            return std::vector<ov::Tensor>{pack_image_features_llava_next(encoded_image, original_image_size, image_newline)};
+        });
+    }
 
-            ImageSize original_image_size{image.get_shape().at(1), image.get_shape().at(2)}; // [height, width]
-
-            ov::Tensor packed_features = pack_image_features_llava_next(encoded_image, original_image_size, image_newline);
-
-            image_embeds.push_back(std::move(packed_features));
-            formatted_prompt += image_token + "\n";
-        }
-        formatted_prompt += prompt;
-
-        ov::Tensor input_ids = get_encoded_input_ids(formatted_prompt, metrics);
-        ov::Tensor text_embeds = m_embedding.infer(input_ids);
-
-        if (images.empty()) {
-            return text_embeds;
-        }
-        auto start_tokenizer_time = std::chrono::steady_clock::now();
-        ov::Tensor encoded_image_token = m_tokenizer.encode(m_vlm_config.im_start, ov::genai::add_special_tokens(false)).input_ids;
-        auto end_tokenizer_time = std::chrono::steady_clock::now();
-        OPENVINO_ASSERT(metrics.raw_metrics.tokenization_durations.size() > 0);
-        metrics.raw_metrics.tokenization_durations[metrics.raw_metrics.tokenization_durations.size() - 1] += ov::genai::MicroSeconds(PerfMetrics::get_microsec(end_tokenizer_time - start_tokenizer_time));
-        int64_t image_token_id = encoded_image_token.data<int64_t>()[encoded_image_token.get_size() - 1];
-        return merge_text_and_image_embeddings_llava(input_ids, text_embeds, image_embeds, image_token_id);
+    ov::Tensor get_image_features(const CachedImageEmbeddings& image_embeddings) const override {
+        return image_embeddings.projected_embeds.at(0);
     }
 
 private:
@@ -1026,9 +1153,8 @@ public:
         std::vector<ov::Tensor> image_embeds;
         image_embeds.reserve(single_images.size());
         
-        for (const auto& image : single_images) {
-            EncodedImage encoded_image = m_vision_encoder.encode(image);
-            ov::Tensor single_image_embeds = encoded_image.resized_source;
+        for (const CachedImageEmbeddings& image_embeddings : encode_images(single_images)) {
+            ov::Tensor single_image_embeds = image_embeddings.encoded_image.resized_source;
 
             const size_t num_patches = single_image_embeds.get_shape().at(0);
             const size_t num_image_tokens = single_image_embeds.get_shape().at(1);
@@ -1058,6 +1184,11 @@ public:
         return merge_text_and_image_embeddings_internvl(input_ids, text_embeds, image_embeds, image_context_token_id);
     }
 
+    void prefetch_image_embeddings(const std::vector<ov::Tensor>& images) override {
+        const std::vector<ov::Tensor> single_images = to_single_image_tensors(images);
+        keep_prefetched_embeddings(single_images, encode_images(single_images));
+    }
+
 protected:
     ov::Tensor merge_text_and_image_embeddings_internvl(
         const ov::Tensor& input_ids,
@@ -1424,8 +1555,10 @@ public:
         std::vector<ov::Tensor> images_features_proj;
         std::stringstream images_prompt;
         for (const ov::Tensor& image : to_single_image_tensors(images)) {
-            EncodedImage encoded_image = m_vision_encoder.encode(image);
-            images_features_proj.push_back(phi3_v::hd_feature_transform(encoded_image, m_hd_feature_transformer, m_vlm_config.sub_GN, m_vlm_config.glb_GN, m_vision_projection));
+            CachedImageEmbeddings image_embeddings = encode_image(image, {}, [this](const EncodedImage& encoded_image) {
+                return std::vector<ov::Tensor>{phi3_v::hd_feature_transform(encoded_image, m_hd_feature_transformer, m_vlm_config.sub_GN, m_vlm_config.glb_GN, m_vision_projection)};
+            });
+            images_features_proj.push_back(image_embeddings.projected_embeds.at(0));
             m_tokens_per_images.push_back(images_features_proj.back().get_shape().at(1));
             images_prompt << "<|image_" << m_tokens_per_images.size() << "|>\n";
         }
@@ -1568,9 +1701,8 @@ public:
         image_embeds.reserve(single_images.size());
         images_grid_thw.reserve(single_images.size());
         
-        for (const auto& image : single_images) {
-            EncodedImage encoded_image = m_vision_encoder.encode(image);
-            ov::Tensor single_image_embeds = encoded_image.resized_source;
+        for (const CachedImageEmbeddings& image_embeddings : encode_images(single_images)) {
+            ov::Tensor single_image_embeds = image_embeddings.encoded_image.resized_source;
             image_embeds.push_back(std::move(single_image_embeds));
 
             size_t grid_t = 1;
@@ -2001,6 +2133,18 @@ void InputsEmbedder::set_apply_chat_template_status(bool apply_chat_template) {
     return m_impl->set_apply_chat_template_status(apply_chat_template);
 }
 
+void InputsEmbedder::set_image_embeddings_cache_size(size_t cache_size_bytes) {
+    return m_impl->set_image_embeddings_cache_size(cache_size_bytes);
+}
+
+void InputsEmbedder::prefetch_image_embeddings(const std::vector<ov::Tensor>& images) {
+    return m_impl->prefetch_image_embeddings(images);
+}
+
+void InputsEmbedder::release_prefetched_image_embeddings() {
+    return m_impl->release_prefetched_image_embeddings();
+}
+
 void InputsEmbedder::finish_chat() {
     return m_impl->finish_chat();
 }
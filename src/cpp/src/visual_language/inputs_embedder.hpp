@@ -62,6 +62,16 @@ public:
     // set the apply_chat_template flag, which determines whether chat template should be applied for non-chat scenarios
     void set_apply_chat_template_status(bool apply_chat_template);
 
+    // sets a max total size in bytes of cached image embeddings, 0 disables the cache
+    void set_image_embeddings_cache_size(size_t cache_size_bytes);
+
+    // encodes images of future prompts in batched vision encoder inferences and keeps their embeddings
+    // for get_inputs_embeds() calls regardless of the image embeddings cache capacity
+    void prefetch_image_embeddings(const std::vector<ov::Tensor>& images);
+
+    // releases embeddings kept by prefetch_image_embeddings()
+    void release_prefetched_image_embeddings();
+
     // finishes chat and clears a chat history 
     void finish_chat();
 private:
@@ -80,14 +80,20 @@ public:
             )
         },
         m_is_chat_conversation{false} {
+        ov::AnyMap filtered_properties = properties;
+        std::optional<size_t> image_embeddings_cache_size = extract_image_embeddings_cache_size(filtered_properties);
+
         m_inputs_embedder = std::make_shared<InputsEmbedder>(
-            m_vlm_config, models_dir, device, properties);
+            m_vlm_config, models_dir, device, filtered_properties);
+        if (image_embeddings_cache_size.has_value()) {
+            m_inputs_embedder->set_image_embeddings_cache_size(*image_embeddings_cache_size);
+        }
 
         m_tokenizer = m_inputs_embedder->get_tokenizer();
         m_embedding = m_inputs_embedder->get_embedding_model();
 
         auto compiled_language_model = utils::singleton_core().compile_model(
-            models_dir / "openvino_language_model.xml", device, properties
+            models_dir / "openvino_language_model.xml", device, filtered_properties
         );
         ov::genai::utils::print_compiled_model_properties(compiled_language_model, "VLM language model");
         auto language_model = compiled_language_model.get_runtime_model();
@@ -121,16 +127,21 @@ public:
         },
         m_generation_config{generation_config},
         m_is_chat_conversation{false} {
-        
+        ov::AnyMap filtered_properties = properties;
+        std::optional<size_t> image_embeddings_cache_size = extract_image_embeddings_cache_size(filtered_properties);
+
         m_inputs_embedder = std::make_shared<InputsEmbedder>(
-            m_vlm_config, models_map, tokenizer, config_dir_path, device, properties);
+            m_vlm_config, models_map, tokenizer, config_dir_path, device, filtered_properties);
+        if (image_embeddings_cache_size.has_value()) {
+            m_inputs_embedder->set_image_embeddings_cache_size(*image_embeddings_cache_size);
+        }
 
         m_tokenizer = m_inputs_embedder->get_tokenizer();
         m_embedding = m_inputs_embedder->get_embedding_model();
 
         auto m_language_pair = get_model_weights_pair(models_map, "language");
         m_language = utils::singleton_core().compile_model(
-            m_language_pair.first, m_language_pair.second, device, properties
+            m_language_pair.first, m_language_pair.second, device, filtered_properties
         ).create_infer_request();
 
         m_language.get_tensor("attention_mask").set_shape({1, 0});
@@ -144,6 +155,17 @@ public:
         m_sampler.set_seed(m_generation_config.rng_seed);
     }
 
+    // image_embeddings_cache_size is a pipeline property and must not be passed to compile_model()
+    static std::optional<size_t> extract_image_embeddings_cache_size(ov::AnyMap& properties) {
+        auto it = properties.find(ov::genai::image_embeddings_cache_size.name());
+        if (it == properties.end()) {
+            return std::nullopt;
+        }
+        size_t cache_size = it->second.as<size_t>();
+        properties.erase(it);
+        return cache_size;
+    }
+
     VLMDecodedResults generate(
         const std::string& prompt,
         const std::vector<ov::Tensor>& rgbs,
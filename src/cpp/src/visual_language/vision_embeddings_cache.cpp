@@ -0,0 +1,154 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include "visual_language/vision_embeddings_cache.hpp"
+
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace ov::genai {
+
+namespace {
+
+ov::Tensor deep_copy(const ov::Tensor& tensor) {
+    if (!tensor) {
+        return tensor;
+    }
+    ov::Tensor copy{tensor.get_element_type(), tensor.get_shape()};
+    tensor.copy_to(copy);
+    return copy;
+}
+
+size_t get_byte_size(const ov::Tensor& tensor) {
+    return tensor ? tensor.get_byte_size() : 0;
+}
+
+size_t get_byte_size(const CachedImageEmbeddings& embeddings) {
+    size_t byte_size = get_byte_size(embeddings.encoded_image.resized_source) + get_byte_size(embeddings.encoded_image.slices);
+    for (const ov::Tensor& projected : embeddings.projected_embeds) {
+        byte_size += get_byte_size(projected);
+    }
+    return byte_size;
+}
+
+CachedImageEmbeddings deep_copy(const CachedImageEmbeddings& embeddings) {
+    // tensors returned by vision models may share memory with infer requests outputs,
+    // so they must be copied to stay valid after subsequent inferences
+    CachedImageEmbeddings copy = embeddings;
+    copy.encoded_image.resized_source = deep_copy(embeddings.encoded_image.resized_source);
+    copy.encoded_image.slices = deep_copy(embeddings.encoded_image.slices);
+    for (ov::Tensor& projected : copy.projected_embeds) {
+        projected = deep_copy(projected);
+    }
+    return copy;
+}
+
+void hash_combine(uint64_t& seed, uint64_t value) {
+    seed ^= value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+}
+
+// xxHash64 rounds over 8-byte words of content, independent of std::hash used for the primary hash
+constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+uint64_t hash_round(uint64_t state, uint64_t word) {
+    state += word * PRIME64_2;
+    state = (state << 31) | (state >> 33);
+    return state * PRIME64_1;
+}
+
+uint64_t compute_check_hash(const char* data, size_t size) {
+    uint64_t state = PRIME64_5;
+    size_t offset = 0;
+    for (; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, data + offset, sizeof(word));
+        state = hash_round(state, word);
+    }
+    for (; offset < size; ++offset) {
+        state = hash_round(state, static_cast<uint8_t>(data[offset]));
+    }
+
+    state ^= static_cast<uint64_t>(size) * PRIME64_5;
+    state ^= state >> 33;
+    state *= PRIME64_2;
+    state ^= state >> 29;
+    state *= PRIME64_3;
+    state ^= state >> 32;
+    return state;
+}
+
+} // namespace
+
+VisionEmbeddingsCache::VisionEmbeddingsCache(size_t capacity_bytes) : m_capacity_bytes{capacity_bytes} {}
+
+ImageKey VisionEmbeddingsCache::compute_key(const ov::Tensor& image) {
+    const std::string_view content{static_cast<const char*>(image.data()), image.get_byte_size()};
+    ImageKey key;
+    key.hash = std::hash<std::string_view>{}(content);
+    hash_combine(key.hash, std::hash<std::string>{}(image.get_element_type().get_type_name()));
+    for (size_t dim : image.get_shape()) {
+        hash_combine(key.hash, dim);
+    }
+    key.check_hash = compute_check_hash(content.data(), content.size());
+    key.element_type = image.get_element_type();
+    key.shape = image.get_shape();
+    return key;
+}
+
+std::optional<CachedImageEmbeddings> VisionEmbeddingsCache::get(const ImageKey& key) {
+    auto it = m_key_to_entry.find(key);
+    if (it == m_key_to_entry.end()) {
+        return std::nullopt;
+    }
+    // move to the front as the most recently used
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return it->second->embeddings;
+}
+
+CachedImageEmbeddings VisionEmbeddingsCache::put(const ImageKey& key, const CachedImageEmbeddings& embeddings) {
+    const size_t byte_size = get_byte_size(embeddings);
+    if (byte_size > m_capacity_bytes) {
+        return embeddings;
+    }
+
+    auto it = m_key_to_entry.find(key);
+    if (it != m_key_to_entry.end()) {
+        m_size_bytes -= it->second->byte_size;
+        m_entries.erase(it->second);
+        m_key_to_entry.erase(it);
+    }
+
+    evict_to_fit(m_capacity_bytes - byte_size);
+
+    m_entries.push_front({key, deep_copy(embeddings), byte_size});
+    m_key_to_entry[key] = m_entries.begin();
+    m_size_bytes += byte_size;
+
+    return m_entries.front().embeddings;
+}
+
+void VisionEmbeddingsCache::set_capacity(size_t capacity_bytes) {
+    m_capacity_bytes = capacity_bytes;
+    evict_to_fit(m_capacity_bytes);
+}
+
+void VisionEmbeddingsCache::clear() {
+    m_entries.clear();
+    m_key_to_entry.clear();
+    m_size_bytes = 0;
+}
+
+void VisionEmbeddingsCache::evict_to_fit(size_t capacity_bytes) {
+    while (m_size_bytes > capacity_bytes) {
+        const Entry& lru_entry = m_entries.back();
+        m_size_bytes -= lru_entry.byte_size;
+        m_key_to_entry.erase(lru_entry.key);
+        m_entries.pop_back();
+    }
+}
+
+} // namespace ov::genai
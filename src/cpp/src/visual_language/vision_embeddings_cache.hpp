@@ -0,0 +1,115 @@
+// Copyright (C) 2023-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include <list>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "openvino/runtime/tensor.hpp"
+#include "visual_language/vision_encoder.hpp"
+
+namespace ov::genai {
+
+/// @brief Embeddings of a single image stored in VisionEmbeddingsCache.
+struct CachedImageEmbeddings {
+    /// @brief An output of VisionEncoder::encode().
+    EncodedImage encoded_image;
+    /// @brief Model specific embeddings computed from encoded_image
+    /// by additional models or postprocessing (e.g. resampled, projected
+    /// or packed image features). Can be empty.
+    std::vector<ov::Tensor> projected_embeds;
+};
+
+/// @brief Identity of an image in VisionEmbeddingsCache: two independent hashes
+/// of image content together with its element type and shape. Keys are compared
+/// entirely, so a collision of a single hash can't return embeddings of another image.
+struct ImageKey {
+    uint64_t hash = 0;
+    uint64_t check_hash = 0;
+    ov::element::Type element_type;
+    ov::Shape shape;
+
+    bool operator==(const ImageKey& other) const {
+        return hash == other.hash && check_hash == other.check_hash &&
+            element_type == other.element_type && shape == other.shape;
+    }
+
+    bool operator!=(const ImageKey& other) const {
+        return !(*this == other);
+    }
+};
+
+struct ImageKeyHash {
+    size_t operator()(const ImageKey& key) const {
+        return static_cast<size_t>(key.hash);
+    }
+};
+
+/// @brief LRU cache of image embeddings keyed by image content.
+/// Allows to skip vision encoder inference for images which have been
+/// already encoded, e.g. when the same image is sent on every chat turn.
+/// Each InputsEmbedder owns its cache, so cached embeddings are never
+/// shared between different VLMModelType-s.
+class VisionEmbeddingsCache {
+public:
+    /// @brief Default limit for a total size of cached tensors.
+    static constexpr size_t DEFAULT_CAPACITY_BYTES = 128 * 1024 * 1024;
+
+    /// @brief Construct the cache.
+    /// @param capacity_bytes Max total size of cached tensors in bytes.
+    /// 0 disables caching.
+    explicit VisionEmbeddingsCache(size_t capacity_bytes = DEFAULT_CAPACITY_BYTES);
+
+    /// @brief Compute a key of an image based on its element type, shape and content.
+    static ImageKey compute_key(const ov::Tensor& image);
+
+    /// @brief Find embeddings by a key and mark them as most recently used.
+    /// @return Cached embeddings or std::nullopt in case of cache miss.
+    std::optional<CachedImageEmbeddings> get(const ImageKey& key);
+
+    /// @brief Store deep copies of embeddings under a given key, evicting least
+    /// recently used entries to fit the capacity. Embeddings larger than the whole
+    /// capacity are not stored.
+    /// @return Embeddings which can be safely kept by a caller: stored copies
+    /// or original embeddings if they were not cached.
+    CachedImageEmbeddings put(const ImageKey& key, const CachedImageEmbeddings& embeddings);
+
+    /// @brief Change a limit for a total size of cached tensors.
+    /// Evicts least recently used entries if needed.
+    void set_capacity(size_t capacity_bytes);
+
+    size_t get_capacity() const {
+        return m_capacity_bytes;
+    }
+
+    /// @brief Total size of cached tensors in bytes.
+    size_t get_size_bytes() const {
+        return m_size_bytes;
+    }
+
+    size_t get_num_entries() const {
+        return m_entries.size();
+    }
+
+    void clear();
+
+private:
+    struct Entry {
+        ImageKey key;
+        CachedImageEmbeddings embeddings;
+        size_t byte_size;
+    };
+
+    void evict_to_fit(size_t capacity_bytes);
+
+    size_t m_capacity_bytes;
+    size_t m_size_bytes = 0;
+    // most recently used entries are at the front
+    std::list<Entry> m_entries;
+    std::unordered_map<ImageKey, std::list<Entry>::iterator, ImageKeyHash> m_key_to_entry;
+};
+
+} // namespace ov::genai
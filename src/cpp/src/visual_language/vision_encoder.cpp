@@ -5,6 +5,8 @@
 #include "visual_language/clip.hpp"
 #include "utils.hpp"
 
+#include "openvino/core/parallel.hpp"
+
 using namespace ov::genai;
 
 namespace {
@@ -23,21 +25,6 @@ clip_image_u8 tensor_to_clip_image_u8(const ov::Tensor& image_tensor) {
     return image;
 }
 
-/**
- * @brief Converts a clip_image_f32 structure to an OpenVINO image tensor (1CHW).
- *
- * @param image A clip_image_f32 structure containing the image data.
- * @return An OpenVINO tensor containing the image data (1CHW).
- */
-ov::Tensor clip_image_f32_to_tensor(const clip_image_f32& image) {
-    ov::Tensor image_tensor{
-        ov::element::f32,
-        {1, 3, static_cast<size_t>(image.ny), static_cast<size_t>(image.nx)}
-    };
-    std::memcpy(image_tensor.data<float>(), image.buf.data(), image.buf.size() * sizeof(float));
-    return image_tensor;
-}
-
 int ensure_divide(int length, int patch_size) {
     return std::max(static_cast<int>(std::round(static_cast<float>(length) / patch_size) * patch_size), patch_size);
 }
@@ -160,92 +147,6 @@ std::vector<std::vector<clip_image_u8>> slice_image(const clip_image_u8& img, co
     return images;
 }
 
-// Reimplemented https://pytorch.org/docs/stable/generated/torch.nn.Unfold.html#torch.nn.Unfold
-// in shape [NCHW], out shape: [N, C*kernel*kernel, H*W/kernel/kernel]
-ov::Tensor unfold(const ov::Tensor& images_tensor, size_t kernel) {
-    ov::Shape images_shape = images_tensor.get_shape();
-
-    OPENVINO_ASSERT(4 == images_shape.size(), "Input tensor must be 4D (NCHW).");
-
-    const size_t bs = images_shape.at(0);
-    const size_t images_c = images_shape.at(1);
-    const size_t images_h = images_shape.at(2);
-    const size_t images_w = images_shape.at(3);
-
-    OPENVINO_ASSERT(images_h >= kernel && images_w >= kernel, "Input height and width must be greater than or equal to kernel size.");
-
-    const size_t new_c = images_c * kernel * kernel;
-    const size_t output_h = (images_h - kernel) / kernel + 1;
-    const size_t output_w = (images_w - kernel) / kernel + 1;
-    const size_t kernels_per_plane = output_h * output_w;
-
-    ov::Tensor unfolded_tensor(ov::element::f32, {bs, new_c, kernels_per_plane});
-    const float* images = images_tensor.data<float>();
-    float* unfolded = unfolded_tensor.data<float>();
-    for (size_t batch_idx = 0; batch_idx < bs; ++batch_idx) {
-        for (size_t c_idx = 0; c_idx < images_c; ++c_idx) {
-            for (size_t h_out = 0; h_out < output_h; ++h_out) {
-                for (size_t w_out = 0; w_out < output_w; ++w_out) {
-                    size_t h_idx = h_out * kernel;  // Calculate input height index
-                    size_t w_idx = w_out * kernel;  // Calculate input width index
-
-                    for (size_t kh = 0; kh < kernel; ++kh) {
-                        for (size_t kw = 0; kw < kernel; ++kw) {
-                            size_t input_idx = (batch_idx * images_c * images_h * images_w) +
-                                               (c_idx * images_h * images_w) +
-                                               ((h_idx + kh) * images_w) +
-                                               (w_idx + kw);
-
-                            size_t unfolded_c_idx = (c_idx * kernel * kernel) + (kh * kernel) + kw;
-                            size_t unfolded_idx = (batch_idx * new_c * kernels_per_plane) +
-                                                  unfolded_c_idx * kernels_per_plane +
-                                                  (h_out * output_w + w_out);
-
-                            unfolded[unfolded_idx] = images[input_idx];
-                        }
-                    }
-                }
-            }
-        }
-    }
-    return unfolded_tensor;
-}
-
-ov::Tensor preprocess_for_encoder(const ov::Tensor& images, size_t kernel) {
-    ov::Shape images_shape = images.get_shape();
-    OPENVINO_ASSERT(4 == images_shape.size());
-    ov::Tensor unfolded_tensor = unfold(images, kernel);
-    const ov::Shape& unfolded_shape = unfolded_tensor.get_shape();  // [N, C*kernel*kernel, H*W/kernel/kernel]
-    const size_t bs = unfolded_shape[0];
-    const size_t d1 = unfolded_shape[1];
-    const size_t d2 = unfolded_shape[2];
-    const size_t channels = 3;
-    const size_t new_len = d2 * kernel;
-
-    ov::Tensor permuted_tensor{ov::element::f32, {bs, channels, kernel, new_len}};
-    const float* unfolded = unfolded_tensor.data<float>();
-    float* permuted = permuted_tensor.data<float>();
-    for (size_t b_idx = 0; b_idx < bs; ++b_idx) {
-        for (size_t c_idx = 0; c_idx < channels; ++c_idx) {
-            for (size_t k1_idx = 0; k1_idx < kernel; ++k1_idx) {
-                for (size_t d2_idx = 0; d2_idx < d2; ++d2_idx) {
-                    for (size_t k2_idx = 0; k2_idx < kernel; ++k2_idx) {
-                        size_t unfolded_idx = b_idx * d1 * d2 +
-                                            (c_idx * kernel * kernel + k1_idx * kernel + k2_idx) * d2 +
-                                            d2_idx;
-                        size_t permuted_idx = b_idx * channels * kernel * new_len +
-                                            c_idx * kernel * new_len +
-                                            k1_idx * new_len +
-                                            d2_idx * kernel + k2_idx;
-                        permuted[permuted_idx] = unfolded[unfolded_idx];
-                    }
-                }
-            }
-        }
-    }
-    return permuted_tensor;
-}
-
 // torch.bucketize(fractional_coords, boundaries, right=True)
 std::vector<int64_t> bucket_size_right(const std::vector<float>& fractional_coords, const std::vector<float>& boundaries) {
     std::vector<int64_t> bucket_coords(fractional_coords.size());
@@ -304,76 +205,60 @@ ov::Tensor prepare_vis_position_ids(
     return position_ids;
 }
 
-EncodedImage llava_image_embed_make_with_bytes_slice(clip_ctx& ctx_clip, const ov::Tensor& img, ov::InferRequest& encoder, int max_slice_nums, int scale_resolution, size_t patch_size, bool never_split) {
-    clip_image_u8 source = tensor_to_clip_image_u8(img);
-    std::vector<std::vector<clip_image_u8>> imgs = ::slice_image(source, max_slice_nums, scale_resolution, patch_size, never_split);
-    std::vector<std::vector<ov::Tensor>> results;
-    std::vector<std::vector<ImageSize>> sizes;
+// Normalizes the source image and its slices and writes them to pixel values batch directly
+// in the layout of torch.nn.Unfold with kernel = stride = patch_size followed by a permutation
+// to [N, C, patch_size, H*W/patch_size], padded with zeros to the largest image.
+// The first row of imgs must contain only the resized source image.
+ov::Tensor get_pixel_values_minicpm(const clip_ctx& ctx_clip, const std::vector<std::vector<clip_image_u8>>& imgs, size_t patch_size) {
     const size_t channels = 3;
-
-    std::vector<std::vector<clip_image_f32>> preprocessed{imgs.size()};
-    size_t max_h = 0, max_w = 0, n_images = 0, max_size = 0;
-    std::transform(imgs.begin(), imgs.end(), preprocessed.begin(), [&ctx_clip, &max_h, &max_w, &max_size, &n_images](const std::vector<clip_image_u8>& row) {
-        std::vector<clip_image_f32> processed_row{row.size()};
-        std::transform(row.begin(), row.end(), processed_row.begin(), [&ctx_clip, &max_h, &max_w, &max_size, &n_images](const clip_image_u8& raw) {
-            clip_image_f32 im = clip_image_preprocess(ctx_clip, raw);
-            if (size_t(im.ny) * size_t(im.nx) > max_size) {
-                max_size = size_t(im.ny) * size_t(im.nx);
-                max_h = size_t(im.ny);
-                max_w = size_t(im.nx);
-            }
+    size_t n_images = 0, max_size = 0;
+    for (const std::vector<clip_image_u8>& row : imgs) {
+        for (const clip_image_u8& raw : row) {
+            max_size = std::max(max_size, size_t(raw.ny) * size_t(raw.nx));
             ++n_images;
-            return im;
-        });
-        return processed_row;
-    });
+        }
+    }
 
     ov::Tensor pixel_values{ov::element::f32, {n_images, channels, patch_size, max_size / patch_size}};
-    size_t d3_all_pixel = pixel_values.get_shape().at(3);
+    const size_t d3_all_pixel = pixel_values.get_shape().at(3);
     float* pixel_value_data = pixel_values.data<float>();
-    
-    //image chw to 1*c*kernel*hw/kernel and padding zero
-    clip_image_f32& resized_preprocessed = preprocessed.at(0).at(0);
-    size_t img_h = resized_preprocessed.ny;
-    size_t img_w = resized_preprocessed.nx;
-    ov::Tensor clip_img{ov::element::f32, {1, channels, img_h, img_w}, resized_preprocessed.buf.data()};
-    ov::Tensor clip_pixel_values = preprocess_for_encoder(clip_img, patch_size);
-
-    float* clip_value_data = clip_pixel_values.data<float>();
-    size_t batch_pixel = 1;
-    size_t d3_clip_pixel = clip_pixel_values.get_shape().at(3);
-    for (size_t c_idx = 0; c_idx < channels; ++c_idx) {
-        for (size_t k_idx = 0; k_idx < patch_size; k_idx++) {
-            std::copy(clip_value_data, clip_value_data + d3_clip_pixel, pixel_value_data);
-            clip_value_data += d3_clip_pixel;
-            pixel_value_data += d3_all_pixel; 
+    std::fill_n(pixel_value_data, pixel_values.get_size(), 0.0f);
+
+    size_t batch_pixel = 0;
+    for (const std::vector<clip_image_u8>& row : imgs) {
+        for (const clip_image_u8& raw : row) {
+            OPENVINO_ASSERT(size_t(raw.ny) >= patch_size && size_t(raw.nx) >= patch_size, "Input height and width must be greater than or equal to kernel size.");
+            // image chw to 1*c*kernel*hw/kernel: row y of a channel goes to y % kernel row of the plane
+            // at y / kernel kernel-high strip offset
+            const size_t strip_w = size_t(raw.nx) / patch_size * patch_size;
+            const size_t strip_h = size_t(raw.ny) / patch_size * patch_size;
+            float* batch_data = pixel_value_data + batch_pixel * channels * patch_size * d3_all_pixel;
+            clip_image_normalize(ctx_clip, raw, 0, 0, strip_w, strip_h, [=](size_t c_idx, size_t y) {
+                return batch_data + (c_idx * patch_size + y % patch_size) * d3_all_pixel + y / patch_size * strip_w;
+            });
+            ++batch_pixel;
         }
     }
+    return pixel_values;
+}
 
-    if (1 < preprocessed.size()) {
-        for (size_t row = 1; row < preprocessed.size(); ++row) {
-            size_t n_slices = preprocessed.at(row).size();
-            for (size_t col = 0; col < n_slices; ++col) {
-                clip_image_f32& elem = preprocessed.at(row).at(col);
-                img_h = elem.ny;
-                img_w = elem.nx;
-                ov::Tensor clip_img{ov::element::f32, {1, channels, img_h, img_w}, elem.buf.data()};
-                ov::Tensor clip_pixel_values = preprocess_for_encoder(clip_img, patch_size);
-                
-                d3_clip_pixel = clip_pixel_values.get_shape().at(3);
-                clip_value_data = clip_pixel_values.data<float>();
-                pixel_value_data = pixel_values.data<float>() + batch_pixel * channels * patch_size * d3_all_pixel;
-                for (size_t c_idx = 0; c_idx < channels; ++c_idx) {
-                    for (size_t k_idx = 0; k_idx < patch_size; k_idx++) {
-                        std::copy(clip_value_data, clip_value_data + d3_clip_pixel, pixel_value_data);
-                        clip_value_data += d3_clip_pixel;
-                        pixel_value_data += d3_all_pixel;
-                    }
-                }
-                batch_pixel++;
+EncodedImage llava_image_embed_make_with_bytes_slice(clip_ctx& ctx_clip, const ov::Tensor& img, ov::InferRequest& encoder, int max_slice_nums, int scale_resolution, size_t patch_size, bool never_split) {
+    clip_image_u8 source = tensor_to_clip_image_u8(img);
+    std::vector<std::vector<clip_image_u8>> preprocessed = ::slice_image(source, max_slice_nums, scale_resolution, patch_size, never_split);
+
+    size_t max_h = 0, max_w = 0, max_size = 0;
+    for (const std::vector<clip_image_u8>& row : preprocessed) {
+        for (const clip_image_u8& im : row) {
+            if (size_t(im.ny) * size_t(im.nx) > max_size) {
+                max_size = size_t(im.ny) * size_t(im.nx);
+                max_h = size_t(im.ny);
+                max_w = size_t(im.nx);
             }
         }
     }
+    const clip_image_u8& resized_preprocessed = preprocessed.at(0).at(0);
+
+    ov::Tensor pixel_values = get_pixel_values_minicpm(ctx_clip, preprocessed, patch_size);
     encoder.set_tensor("pixel_values", pixel_values);
 
     ov::Tensor patch_attention_mask{ov::element::f32, {pixel_values.get_shape().at(0), 1, max_h / patch_size * max_w / patch_size}};
@@ -384,7 +269,7 @@ EncodedImage llava_image_embed_make_with_bytes_slice(clip_ctx& ctx_clip, const o
         for (size_t row = 1; row < preprocessed.size(); ++row) {
             size_t n_slices = preprocessed.at(row).size();
             for (size_t col = 0; col < n_slices; ++col) {
-                const clip_image_f32& elem = preprocessed.at(row).at(col);
+                const clip_image_u8& elem = preprocessed.at(row).at(col);
                 std::fill_n(attention_data + ((row - 1) * n_slices + col + 1) * max_h / patch_size * max_w / patch_size, elem.ny / patch_size * elem.nx / patch_size, 1.0f);
             }
         }
@@ -394,8 +279,8 @@ EncodedImage llava_image_embed_make_with_bytes_slice(clip_ctx& ctx_clip, const o
     ImageSize resized_source_size{resized_preprocessed.ny / patch_size, resized_preprocessed.nx / patch_size};
     std::vector<ImageSize> tgt_sizes{resized_source_size};
     if (1 < preprocessed.size()) {
-        for (const std::vector<clip_image_f32>& row : preprocessed) {
-            for (const clip_image_f32& elem : row) {
+        for (const std::vector<clip_image_u8>& row : preprocessed) {
+            for (const clip_image_u8& elem : row) {
                 tgt_sizes.push_back({elem.ny / patch_size, elem.nx / patch_size});
             }
         }
@@ -442,59 +327,35 @@ ProcessorConfig from_any_map(
     return extracted_config;
 }
 
-clip_image_f32 preprocess_clip_image_llava(const clip_image_u8& image, const ProcessorConfig& config) {
-    bool do_resize = true;
-    bool do_center_crop = true;
-
+// Resizes the shortest edge to config.size_shortest_edge, center crops to config.crop_size and normalizes the image
+// in a single pass, the result is written to dst in CHW layout
+void preprocess_clip_image_llava(const clip_image_u8& image, const ProcessorConfig& config, float* dst) {
     // Resize
-    clip_image_u8 resized_image;
-    if (do_resize) {
-        int target_size = config.size_shortest_edge;
-        float scale = static_cast<float>(target_size) / std::min(image.nx, image.ny);
-        int new_width = static_cast<int>(image.nx * scale);
-        int new_height = static_cast<int>(image.ny * scale);
-        bicubic_resize(image, resized_image, new_width, new_height);
-    } else {
-        resized_image = image;
-    }
+    int target_size = config.size_shortest_edge;
+    float scale = static_cast<float>(target_size) / std::min(image.nx, image.ny);
+    int new_width = static_cast<int>(image.nx * scale);
+    int new_height = static_cast<int>(image.ny * scale);
 
     // Center crop
-    clip_image_u8 cropped_image;
-    if (do_center_crop) {
-        int crop_height = config.crop_size_height;
-        int crop_width = config.crop_size_width;
-        int start_x = (resized_image.nx - crop_width) / 2;
-        int start_y = (resized_image.ny - crop_height) / 2;
-
-        cropped_image.nx = crop_width;
-        cropped_image.ny = crop_height;
-        cropped_image.buf.resize(3 * crop_width * crop_height);
-
-        for (int y = 0; y < crop_height; ++y) {
-            for (int x = 0; x < crop_width; ++x) {
-                for (int c = 0; c < 3; ++c) {
-                    cropped_image.buf[(y * crop_width + x) * 3 + c] = 
-                        resized_image.buf[((start_y + y) * resized_image.nx + (start_x + x)) * 3 + c];
-                }
-            }
-        }
-    } else {
-        cropped_image = resized_image;
-    }
+    int crop_height = config.crop_size_height;
+    int crop_width = config.crop_size_width;
+    int start_x = (new_width - crop_width) / 2;
+    int start_y = (new_height - crop_height) / 2;
 
     // Normalize
     clip_ctx ctx;
     std::copy(config.image_mean.begin(), config.image_mean.end(), ctx.image_mean);
     std::copy(config.image_std.begin(), config.image_std.end(), ctx.image_std);
 
-    clip_image_f32 normalized_image = clip_image_preprocess(ctx, cropped_image);
-    return normalized_image;
+    bicubic_resize_normalize(ctx, image, new_width, new_height, start_x, start_y, crop_width, crop_height,
+                             clip_chw_dst(dst, crop_width, crop_height));
 }
 
 ov::Tensor get_pixel_values_llava(const ov::Tensor& image, const ProcessorConfig& config) {
     clip_image_u8 input_image = tensor_to_clip_image_u8(image);
-    clip_image_f32 preprocessed_image = preprocess_clip_image_llava(input_image, config);
-    return clip_image_f32_to_tensor(preprocessed_image);
+    ov::Tensor pixel_values{ov::element::f32, {1, 3, config.crop_size_height, config.crop_size_width}};
+    preprocess_clip_image_llava(input_image, config, pixel_values.data<float>());
+    return pixel_values;
 }
 
 ov::Tensor get_pixel_values_llava_next(const ov::Tensor& image, const ProcessorConfig& config) {
@@ -504,26 +365,17 @@ ov::Tensor get_pixel_values_llava_next(const ov::Tensor& image, const ProcessorC
     auto patch_size = config.crop_size_height;
     auto image_patches = get_image_patches(input_image, config.image_grid_pinpoints, size, patch_size);
 
-    // Preprocess image patches
-    std::vector<clip_image_f32> processed_patches;
-    processed_patches.reserve(image_patches.size());
-
-    for (const auto& patch : image_patches) {
-        processed_patches.push_back(preprocess_clip_image_llava(patch, config));
-    }
-
-    size_t num_patches = processed_patches.size();
+    size_t num_patches = image_patches.size();
     size_t channels = 3;
-    size_t height = processed_patches[0].ny;
-    size_t width = processed_patches[0].nx;
+    size_t height = config.crop_size_height;
+    size_t width = config.crop_size_width;
 
     ov::Tensor concatenated_tensor(ov::element::f32, {num_patches, channels, height, width});
     float* tensor_data = concatenated_tensor.data<float>();
 
-    // Fill the tensor with the preprocessed patches data (each patch layout is [C * H * W])
+    // Preprocess image patches directly into the tensor (each patch layout is [C * H * W])
     for (size_t i = 0; i < num_patches; ++i) {
-        const auto& img = processed_patches[i];
-        std::copy(img.buf.begin(), img.buf.end(), tensor_data + i * channels * height * width);
+        preprocess_clip_image_llava(image_patches[i], config, tensor_data + i * channels * height * width);
     }
 
     return concatenated_tensor;
@@ -624,23 +476,17 @@ ov::Tensor get_pixel_values_internvl(const ov::Tensor& image, const ProcessorCon
 
     std::vector<clip_image_u8> splitted_images = split_image_internvl(input_image, image_size);
 
-    std::vector<clip_image_f32> processed_images;
-    processed_images.reserve(splitted_images.size());
-    for (const auto& image : splitted_images) {
-        processed_images.push_back(clip_image_preprocess(ctx, image));
-    }
-
-    size_t batch_size = processed_images.size();
+    size_t batch_size = splitted_images.size();
     size_t channels = 3;
-    size_t height = processed_images[0].ny;
-    size_t width = processed_images[0].nx;
+    size_t height = splitted_images[0].ny;
+    size_t width = splitted_images[0].nx;
 
     ov::Tensor output_tensor(ov::element::f32, {batch_size, channels, height, width});
     float* output_data = output_tensor.data<float>();
 
     for (size_t i = 0; i < batch_size; ++i) {
-        const auto& img = processed_images[i];
-        std::copy(img.buf.begin(), img.buf.end(), output_data + i * channels * height * width);
+        clip_image_normalize(ctx, splitted_images[i], 0, 0, width, height,
+                             clip_chw_dst(output_data + i * channels * height * width, width, height));
     }
     return output_tensor;
 }
@@ -700,143 +546,38 @@ ov::Tensor HD_transform(const ov::Tensor& uint8, size_t num_crops) {
     return padding_336(ov::Tensor{ov::element::u8, {1, new_h, new_w, 3}, dst.buf.data()});
 }
 
-ov::Tensor mean_scale(const ov::Tensor& uint8, const ProcessorConfig& config) {
-    uint8_t* uint_8_data = uint8.data<uint8_t>();
-    ov::Tensor float_normalized{ov::element::f32, uint8.get_shape()};
-    float* float_data = float_normalized.data<float>();
-    OPENVINO_ASSERT(0 == uint8.get_size() % 3, "RGB");
-    for (size_t idx = 0; idx < uint8.get_size(); idx += 3) {
-        float_data[idx] = (float(uint_8_data[idx]) / 255.0f - config.image_mean[0]) / config.image_std[0];
-        float_data[idx + 1] = (float(uint_8_data[idx + 1]) / 255.0f - config.image_mean[1]) / config.image_std[1];
-        float_data[idx + 2] = (float(uint_8_data[idx + 2]) / 255.0f - config.image_mean[2]) / config.image_std[2];
-    }
-    return float_normalized;
-}
-
-ov::Tensor channels_first(const ov::Tensor& _1hw3) {
-    ov::Shape shape = _1hw3.get_shape();
-    ov::Tensor _13hw = ov::Tensor{ov::element::f32, {1, 3, shape.at(1), shape.at(2)}};
-    float* _1hw3_data = _1hw3.data<float>();
-    float* _13hw_data = _13hw.data<float>();
-    for (size_t plane = 0; plane < 3; ++plane) {
-        for (size_t row = 0; row < shape.at(1); ++row) {
-            for (size_t col = 0; col < shape.at(2); ++col) {
-                _13hw_data[plane * shape.at(1) * shape.at(2) + row * shape.at(2) + col] = _1hw3_data[row * shape.at(2) * 3 + col * 3 + plane];
-            }
-        }
-    }
-    return _13hw;
-}
-
-// Reimplementation of Python im.reshape(1, 3, h//336, 336, w//336, 336).permute(0,2,4,1,3,5).reshape(-1, 3, 336, 336)
-ov::Tensor slice_image(const ov::Tensor& image) {
-    ov::Shape shape = image.get_shape();
-    size_t N = shape[0];
-    size_t C = shape[1];
-    size_t H = shape[2];
-    size_t W = shape[3];
-
-    size_t num_h_slices = H / INPUT_IMAGE_SIZE;
-    size_t num_w_slices = W / INPUT_IMAGE_SIZE;
-
-    // Step 1: Define and populate the reshaped tensor in the correct shape order
-    ov::Tensor reshaped{ov::element::f32, {N, num_h_slices, num_w_slices, C, INPUT_IMAGE_SIZE, INPUT_IMAGE_SIZE}};
-    float* reshaped_data = reshaped.data<float>();
-    float* image_data = image.data<float>();
-
-    // Populate the reshaped tensor
-    for (size_t n = 0; n < N; ++n) {
-        for (size_t h = 0; h < num_h_slices; ++h) {
-            for (size_t w = 0; w < num_w_slices; ++w) {
-                for (size_t c = 0; c < C; ++c) {
-                    for (size_t i = 0; i < INPUT_IMAGE_SIZE; ++i) {
-                        for (size_t j = 0; j < INPUT_IMAGE_SIZE; ++j) {
-                            size_t src_idx = n * C * H * W + c * H * W + (h * INPUT_IMAGE_SIZE + i) * W + (w * INPUT_IMAGE_SIZE + j);
-                            size_t dst_idx = n * num_h_slices * num_w_slices * C * INPUT_IMAGE_SIZE * INPUT_IMAGE_SIZE +
-                                             h * num_w_slices * C * INPUT_IMAGE_SIZE * INPUT_IMAGE_SIZE +
-                                             w * C * INPUT_IMAGE_SIZE * INPUT_IMAGE_SIZE +
-                                             c * INPUT_IMAGE_SIZE * INPUT_IMAGE_SIZE +
-                                             i * INPUT_IMAGE_SIZE + j;
-                            reshaped_data[dst_idx] = image_data[src_idx];
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    // Step 2: Define the permuted tensor in the final shape
-    ov::Tensor permuted{ov::element::f32, {N * num_h_slices * num_w_slices, C, INPUT_IMAGE_SIZE, INPUT_IMAGE_SIZE}};
-    float* permuted_data = permuted.data<float>();
-
-    // Perform permutation by flattening N, num_h_slices, and num_w_slices
-    for (size_t n = 0; n < N; ++n) {
-        for (size_t h = 0; h < num_h_slices; ++h) {
-            for (size_t w = 0; w < num_w_slices; ++w) {
-                for (size_t c = 0; c < C; ++c) {
-                    for (size_t i = 0; i < INPUT_IMAGE_SIZE; ++i) {
-                        for (size_t j = 0; j < INPUT_IMAGE_SIZE; ++j) {
-                            size_t src_idx = n * num_h_slices * num_w_slices * C * INPUT_IMAGE_SIZE * INPUT_IMAGE_SIZE +
-                                             h * num_w_slices * C * INPUT_IMAGE_SIZE * INPUT_IMAGE_SIZE +
-                                             w * C * INPUT_IMAGE_SIZE * INPUT_IMAGE_SIZE +
-                                             c * INPUT_IMAGE_SIZE * INPUT_IMAGE_SIZE +
-                                             i * INPUT_IMAGE_SIZE + j;
-                            size_t dst_idx = (n * num_h_slices * num_w_slices + h * num_w_slices + w) * C * INPUT_IMAGE_SIZE * INPUT_IMAGE_SIZE +
-                                             c * INPUT_IMAGE_SIZE * INPUT_IMAGE_SIZE +
-                                             i * INPUT_IMAGE_SIZE + j;
-                            permuted_data[dst_idx] = reshaped_data[src_idx];
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    return permuted;
-}
-
-ov::Tensor concatenate_batch(const ov::Tensor& float_first, const ov::Tensor& float_second) {
-    ov::Shape shape_first = float_first.get_shape();
-    ov::Shape shape_second = float_second.get_shape();
-    OPENVINO_ASSERT(shape_first.at(1) == shape_second.at(1), "Channels must be the same");
-    OPENVINO_ASSERT(shape_first.at(2) == shape_second.at(2), "Height must be the same");
-    OPENVINO_ASSERT(shape_first.at(3) == shape_second.at(3), "Width must be the same");
-    ov::Tensor concatenated{ov::element::f32, {shape_first.at(0) + shape_second.at(0), shape_first.at(1), shape_first.at(2), shape_first.at(3)}};
-    float* concatenated_data = concatenated.data<float>();
-    float* first_data = float_first.data<float>();
-    float* second_data = float_second.data<float>();
-    std::copy(first_data, first_data + float_first.get_size(), concatenated_data);
-    std::copy(second_data, second_data + float_second.get_size(), concatenated_data + float_first.get_size());
-    return concatenated;
-}
-
-ov::Tensor pad_to_max_num_crops_tensor(const ov::Tensor& nchw, size_t max_crops) {
-    ov::Shape shape = nchw.get_shape();
-    size_t num_crops = shape[0];
-    if (num_crops >= max_crops) {
-        return nchw;
-    }
-    ov::Tensor padded{ov::element::f32, {max_crops, shape[1], shape[2], shape[3]}};
-    float* padded_data = padded.data<float>();
-    float* nchw_data = nchw.data<float>();
-    std::copy_n(nchw_data, nchw.get_size(), padded_data);
-    return padded;
-}
-
+// Global image resized to INPUT_IMAGE_SIZE followed by INPUT_IMAGE_SIZE x INPUT_IMAGE_SIZE slices of hd_image
+// in row-major order, padded with zeros to num_crops images. Normalized NCHW images are written to pixel values
+// directly without intermediate float images, which is a reimplementation of Python
+// im.reshape(1, 3, h//336, 336, w//336, 336).permute(0,2,4,1,3,5).reshape(-1, 3, 336, 336)
+// for slices followed by the batch concatenation and padding.
 std::tuple<ov::Tensor, ImageSize> get_pixel_values_phi3_v(const ov::Tensor& image, const ProcessorConfig& config) {
     ov::Tensor hd_image = HD_transform(image, config.phi3_v.num_crops);
     ImageSize image_size{hd_image.get_shape().at(2), hd_image.get_shape().at(1)};
     clip_image_u8 img{int(hd_image.get_shape().at(2)), int(hd_image.get_shape().at(1)), {hd_image.data<uint8_t>(), hd_image.data<uint8_t>() + hd_image.get_size()}};
-    clip_image_u8 dst;
-    bicubic_resize(img, dst, INPUT_IMAGE_SIZE, INPUT_IMAGE_SIZE);
-    ov::Tensor global_image{ov::element::u8, {1, INPUT_IMAGE_SIZE, INPUT_IMAGE_SIZE, 3}, dst.buf.data()};
-    global_image = mean_scale(global_image, config);
-    hd_image = mean_scale(hd_image, config);
-    global_image = channels_first(global_image);
-    hd_image = channels_first(hd_image);
-    ov::Tensor slices = slice_image(hd_image);
-    ov::Tensor concatenated = concatenate_batch(global_image, slices);
-    ov::Tensor pixel_values = pad_to_max_num_crops_tensor(concatenated, config.phi3_v.num_crops);
+
+    clip_ctx ctx;
+    std::copy(config.image_mean.begin(), config.image_mean.end(), ctx.image_mean);
+    std::copy(config.image_std.begin(), config.image_std.end(), ctx.image_std);
+
+    const size_t num_h_slices = img.ny / INPUT_IMAGE_SIZE;
+    const size_t num_w_slices = img.nx / INPUT_IMAGE_SIZE;
+    const size_t num_images = 1 + num_h_slices * num_w_slices;
+    const size_t image_elements = 3 * INPUT_IMAGE_SIZE * INPUT_IMAGE_SIZE;
+
+    ov::Tensor pixel_values{ov::element::f32, {std::max(num_images, config.phi3_v.num_crops), 3, INPUT_IMAGE_SIZE, INPUT_IMAGE_SIZE}};
+    float* pixel_values_data = pixel_values.data<float>();
+    std::fill(pixel_values_data + num_images * image_elements, pixel_values_data + pixel_values.get_size(), 0.0f);
+
+    bicubic_resize_normalize(ctx, img, INPUT_IMAGE_SIZE, INPUT_IMAGE_SIZE,
+                             clip_chw_dst(pixel_values_data, INPUT_IMAGE_SIZE, INPUT_IMAGE_SIZE));
+    for (size_t h = 0; h < num_h_slices; ++h) {
+        for (size_t w = 0; w < num_w_slices; ++w) {
+            float* slice_data = pixel_values_data + (1 + h * num_w_slices + w) * image_elements;
+            clip_image_normalize(ctx, img, w * INPUT_IMAGE_SIZE, h * INPUT_IMAGE_SIZE, INPUT_IMAGE_SIZE, INPUT_IMAGE_SIZE,
+                                 clip_chw_dst(slice_data, INPUT_IMAGE_SIZE, INPUT_IMAGE_SIZE));
+        }
+    }
     return {std::move(pixel_values), image_size};
 }
 }  // namespace phi3_v
@@ -865,9 +606,13 @@ ImageSize smart_resize_qwen2vl(size_t height, size_t width, size_t factor, size_
     return ImageSize{h_bar, w_bar};
 }
 
-ov::Tensor reshape_image_patches_qwen2vl(
-    const ov::Tensor& patches,
-    const size_t grid_t,
+// Converts a normalized CHW image of [channel, grid_h * patch_size, grid_w * patch_size] shape to flattened patches
+// of [grid_h * grid_w, channel * temporal_patch_size * patch_size * patch_size] shape with a single gather.
+// It's a reimplementation of tiling the image temporal_patch_size times, reshaping to
+// [grid_t, temporal_patch_size, channel, grid_h / merge_size, merge_size, patch_size, grid_w / merge_size, merge_size, patch_size],
+// transposing to [0, 3, 6, 4, 7, 2, 1, 5, 8] and flattening. Rows of patch_size elements stay contiguous in both layouts.
+ov::Tensor flatten_image_patches_qwen2vl(
+    const float* image,
     const size_t grid_h,
     const size_t grid_w,
     const size_t channel,
@@ -875,122 +620,69 @@ ov::Tensor reshape_image_patches_qwen2vl(
     const size_t patch_size,
     const size_t spatial_merge_size
 ) {
-    ov::Shape output_shape{
-        grid_t,                      
-        temporal_patch_size,         
-        channel,                     
-        grid_h / spatial_merge_size, 
-        spatial_merge_size,          
-        patch_size,                  
-        grid_w / spatial_merge_size, 
-        spatial_merge_size,          
-        patch_size                   
-    };
-    
-    ov::Tensor reshaped_patches(patches.get_element_type(), output_shape);
-
-    const float* input_data = patches.data<float>();
-    float* output_data = reshaped_patches.data<float>();
-
-    size_t input_idx = 0;
-    
-    for (size_t gt = 0; gt < output_shape.at(0); ++gt) {
-        for (size_t tp = 0; tp < output_shape.at(1); ++tp) {
-            for (size_t c = 0; c < output_shape.at(2); ++c) {
-                for (size_t gh = 0; gh < output_shape.at(3); ++gh) {
-                    for (size_t ms1 = 0; ms1 < output_shape.at(4); ++ms1) {
-                        for (size_t p1 = 0; p1 < output_shape.at(5); ++p1) {
-                            for (size_t gw = 0; gw < output_shape.at(6); ++gw) {
-                                for (size_t ms2 = 0; ms2 < output_shape.at(7); ++ms2) {
-                                    for (size_t p2 = 0; p2 < output_shape.at(8); ++p2) {
-                                        size_t output_idx = gt;
-                                        output_idx = output_idx * output_shape.at(1) + tp;
-                                        output_idx = output_idx * output_shape.at(2) + c;
-                                        output_idx = output_idx * output_shape.at(3) + gh;
-                                        output_idx = output_idx * output_shape.at(4) + ms1;
-                                        output_idx = output_idx * output_shape.at(5) + p1;
-                                        output_idx = output_idx * output_shape.at(6) + gw;
-                                        output_idx = output_idx * output_shape.at(7) + ms2;
-                                        output_idx = output_idx * output_shape.at(8) + p2;
-
-                                        output_data[output_idx] = input_data[input_idx];
-                                        input_idx++;
-                                    }
-                                }
-                            }
+    const size_t height = grid_h * patch_size;
+    const size_t width = grid_w * patch_size;
+    const size_t merged_grid_w = grid_w / spatial_merge_size;
+    const size_t patch_elements = channel * temporal_patch_size * patch_size * patch_size;
+
+    ov::Tensor flattened_patches(ov::element::f32, {grid_h * grid_w, patch_elements});
+    float* output_data = flattened_patches.data<float>();
+
+    ov::parallel_for(grid_h, [&](size_t patch_row) {
+        const size_t gh = patch_row / spatial_merge_size;
+        const size_t ms1 = patch_row % spatial_merge_size;
+        for (size_t gw = 0; gw < merged_grid_w; ++gw) {
+            for (size_t ms2 = 0; ms2 < spatial_merge_size; ++ms2) {
+                const size_t patch_idx = ((gh * merged_grid_w + gw) * spatial_merge_size + ms1) * spatial_merge_size + ms2;
+                float* patch = output_data + patch_idx * patch_elements;
+                const size_t x = (gw * spatial_merge_size + ms2) * patch_size;
+                for (size_t c = 0; c < channel; ++c) {
+                    for (size_t tp = 0; tp < temporal_patch_size; ++tp) {
+                        for (size_t p1 = 0; p1 < patch_size; ++p1) {
+                            const float* src = image + (c * height + patch_row * patch_size + p1) * width + x;
+                            std::copy_n(src, patch_size, patch + ((c * temporal_patch_size + tp) * patch_size + p1) * patch_size);
                         }
                     }
                 }
             }
         }
-    }
+    });
 
-    return reshaped_patches;
+    return flattened_patches;
 }
 
-ov::Tensor transpose_image_patches_qwen2vl(const ov::Tensor& reshaped_patches) {
-    // Input dimensions order:  [0,1,2,3,4,5,6,7,8]
-    // Output dimensions order: [0,3,6,4,7,2,1,5,8]
-    auto input_shape = reshaped_patches.get_shape();
-    
-    ov::Shape output_shape = {
-        input_shape.at(0), // grid_t
-        input_shape.at(3), // grid_h / spatial_merge_size
-        input_shape.at(6), // grid_w / spatial_merge_size
-        input_shape.at(4), // spatial_merge_size
-        input_shape.at(7), // spatial_merge_size
-        input_shape.at(2), // channel
-        input_shape.at(1), // temporal_patch_size
-        input_shape.at(5), // patch_size
-        input_shape.at(8)  // patch_size
-    };
+std::tuple<ov::Tensor, ImageSize> get_pixel_values_qwen2vl(const ov::Tensor& image, const ProcessorConfig& config) {
+    ov::Shape image_shape = image.get_shape();
+    auto original_height = image_shape.at(1);
+    auto original_width = image_shape.at(2);
 
-    ov::Tensor transposed_patches(reshaped_patches.get_element_type(), output_shape);
-    
-    const float* src = reshaped_patches.data<float>();
-    float* dst = transposed_patches.data<float>();
-    
-    size_t shape_size = input_shape.size();
-    std::vector<size_t> input_strides(shape_size);
-    std::vector<size_t> output_strides(shape_size);
-    
-    input_strides[shape_size - 1] = 1;
-    output_strides[shape_size - 1] = 1;
-    for(int i = 7; i >= 0; i--) {
-        input_strides[i] = input_strides[i+1] * input_shape[i+1];
-        output_strides[i] = output_strides[i+1] * output_shape[i+1];
-    }
+    ImageSize target_image_size = smart_resize_qwen2vl(
+        original_height, 
+        original_width, 
+        config.patch_size * config.merge_size,
+        config.min_pixels,
+        config.max_pixels
+    );
 
-    size_t total_elements = reshaped_patches.get_size();
-    for(size_t idx = 0; idx < total_elements; idx++) {
-        size_t remaining = idx;
-        std::vector<size_t> input_indices(shape_size);
-        for(int i = 0; i < shape_size; i++) {
-            input_indices[i] = remaining / input_strides[i];
-            remaining %= input_strides[i];
-        }
-        
-        std::vector<size_t> output_indices = {
-            input_indices.at(0),
-            input_indices.at(3),
-            input_indices.at(6),
-            input_indices.at(4),
-            input_indices.at(7),
-            input_indices.at(2),
-            input_indices.at(1),
-            input_indices.at(5),
-            input_indices.at(8)
-        };
-        
-        size_t dst_idx = 0;
-        for(int i = 0; i < shape_size; i++) {
-            dst_idx += output_indices[i] * output_strides[i];
-        }
-        
-        dst[dst_idx] = src[idx];
-    }
-    
-    return transposed_patches;
+    clip_image_u8 input_image = tensor_to_clip_image_u8(image);
+
+    clip_ctx ctx;
+    std::copy(config.image_mean.begin(), config.image_mean.end(), ctx.image_mean);
+    std::copy(config.image_std.begin(), config.image_std.end(), ctx.image_std);
+
+    const size_t channel = 3;
+    std::vector<float> normalized_image(channel * target_image_size.height * target_image_size.width);
+    bicubic_resize_normalize(ctx, input_image, target_image_size.width, target_image_size.height,
+                             clip_chw_dst(normalized_image.data(), target_image_size.width, target_image_size.height));
+
+    // A single image is tiled to match temporal_patch_size, so grid_t is 1
+    size_t grid_h = target_image_size.height / config.patch_size;
+    size_t grid_w = target_image_size.width / config.patch_size;
+
+    ov::Tensor flattened_patches = flatten_image_patches_qwen2vl(
+        normalized_image.data(), grid_h, grid_w, channel, config.temporal_patch_size, config.patch_size, config.merge_size
+    );
+    return {std::move(flattened_patches), ImageSize{grid_h, grid_w}};
 }
 }
 
@@ -1022,12 +714,8 @@ VisionEncoder::VisionEncoder(
 EncodedImage VisionEncoder::encode(const ov::Tensor& image, const ProcessorConfig& config) {
     if (model_type == VLMModelType::MINICPM) {
         return encode_minicpm(image, config);
-    } else if (model_type == VLMModelType::LLAVA) {
-        return encode_llava(image, config);
-    } else if (model_type == VLMModelType::LLAVA_NEXT) {
-        return encode_llava_next(image, config);
-    } else if (model_type == VLMModelType::INTERNVL_CHAT) {
-        return encode_internvl(image, config);
+    } else if (model_type == VLMModelType::LLAVA || model_type == VLMModelType::LLAVA_NEXT || model_type == VLMModelType::INTERNVL_CHAT) {
+        return encode_batched({image}, config).at(0);
     }  else if (model_type == VLMModelType::PHI3_V) {
         return encode_phi3_v(image, config);
     } else if (model_type == VLMModelType::QWEN2_VL) {
@@ -1043,6 +731,26 @@ EncodedImage VisionEncoder::encode(const ov::Tensor& image, const ov::AnyMap& co
     ));
 }
 
+std::vector<EncodedImage> VisionEncoder::encode(const std::vector<ov::Tensor>& images, const ProcessorConfig& config) {
+    if (model_type == VLMModelType::LLAVA || model_type == VLMModelType::LLAVA_NEXT || model_type == VLMModelType::INTERNVL_CHAT) {
+        return encode_batched(images, config);
+    }
+    // MiniCPM encodes all slices of an image in a single inference already, pixel values of other models
+    // are processed as a whole (Phi-3-V crops, Qwen2-VL patches), so they can't be concatenated
+    std::vector<EncodedImage> encoded_images;
+    encoded_images.reserve(images.size());
+    for (const ov::Tensor& image : images) {
+        encoded_images.push_back(encode(image, config));
+    }
+    return encoded_images;
+}
+
+std::vector<EncodedImage> VisionEncoder::encode(const std::vector<ov::Tensor>& images, const ov::AnyMap& config_map) {
+    return encode(images, from_any_map(
+        config_map, m_processor_config
+    ));
+}
+
 EncodedImage VisionEncoder::encode_minicpm(const ov::Tensor& image, const ProcessorConfig& config) {
     clip_ctx ctx_clip;
     ctx_clip.image_size = m_processor_config.image_size;
@@ -1051,59 +759,70 @@ EncodedImage VisionEncoder::encode_minicpm(const ov::Tensor& image, const Proces
     return llava_image_embed_make_with_bytes_slice(ctx_clip, image, m_vision_encoder, config.max_slice_nums, config.scale_resolution, config.patch_size, 0 == config.max_slice_nums);
 }
 
-EncodedImage VisionEncoder::encode_llava(const ov::Tensor& image, const ProcessorConfig& config) {
-    ov::Tensor pixel_values = get_pixel_values_llava(image, config);
-
-    m_vision_encoder.set_tensor("pixel_values", pixel_values);
-    m_vision_encoder.infer();
-
-    const ov::Tensor& infer_output = m_vision_encoder.get_output_tensor();
-    ov::Tensor image_features(infer_output.get_element_type(), infer_output.get_shape());
-    std::memcpy(image_features.data(), infer_output.data(), infer_output.get_byte_size());
-
-    ImageSize resized_source_size{config.crop_size_height / config.patch_size, config.crop_size_width / config.patch_size};
-
-    return {std::move(image_features), resized_source_size};
-}
-
-EncodedImage VisionEncoder::encode_llava_next(const ov::Tensor& image, const ProcessorConfig& config) {
-    ov::Tensor pixel_values = get_pixel_values_llava_next(image, config);
-
-    m_vision_encoder.set_tensor("pixel_values", pixel_values);
-    m_vision_encoder.infer();
-
-    const ov::Tensor& infer_output = m_vision_encoder.get_output_tensor();
-    ov::Tensor image_features(infer_output.get_element_type(), infer_output.get_shape());
-    std::memcpy(image_features.data(), infer_output.data(), infer_output.get_byte_size());
-
-    ImageSize resized_source_size{config.crop_size_height / config.patch_size, config.crop_size_width / config.patch_size};
-
-    // Gen number of patches
-    ImageSize original_image_size{image.get_shape().at(1), image.get_shape().at(2)};
-    auto best_resolution = select_best_resolution({original_image_size.width, original_image_size.height}, config.image_grid_pinpoints);
-    int num_patches_w = best_resolution.first / config.size_shortest_edge;
-    int num_patches_h = best_resolution.second / config.size_shortest_edge;
-
-    EncodedImage encoded_image;
-    encoded_image.resized_source = std::move(image_features);
-    encoded_image.resized_source_size = resized_source_size;
-    encoded_image.patches_grid = {num_patches_h, num_patches_w};
-    return encoded_image;
-}
+std::vector<EncodedImage> VisionEncoder::encode_batched(const std::vector<ov::Tensor>& images, const ProcessorConfig& config) {
+    if (images.empty()) {
+        return {};
+    }
 
-EncodedImage VisionEncoder::encode_internvl(const ov::Tensor& image, const ProcessorConfig& config) {
-    ov::Tensor pixel_values = get_pixel_values_internvl(image, config);
+    // pixel values of each image are [num_patches, C, H, W] with the same C, H, W for a given config
+    std::vector<ov::Tensor> pixel_values;
+    pixel_values.reserve(images.size());
+    size_t total_num_patches = 0;
+    for (const ov::Tensor& image : images) {
+        pixel_values.push_back(preprocess_image(image, model_type, config));
+        total_num_patches += pixel_values.back().get_shape().at(0);
+    }
 
-    m_vision_encoder.set_tensor("pixel_values", pixel_values);
+    if (pixel_values.size() == 1) {
+        m_vision_encoder.set_tensor("pixel_values", pixel_values.at(0));
+    } else {
+        ov::Shape batched_shape = pixel_values.at(0).get_shape();
+        batched_shape.at(0) = total_num_patches;
+        ov::Tensor batched_pixel_values{ov::element::f32, batched_shape};
+        uint8_t* batched_data = static_cast<uint8_t*>(batched_pixel_values.data());
+        for (const ov::Tensor& image_pixel_values : pixel_values) {
+            OPENVINO_ASSERT(image_pixel_values.get_byte_size() / image_pixel_values.get_shape().at(0) == batched_pixel_values.get_byte_size() / total_num_patches,
+                "Pixel values of images encoded in a batch must have the same shape except for the batch dimension");
+            std::memcpy(batched_data, image_pixel_values.data(), image_pixel_values.get_byte_size());
+            batched_data += image_pixel_values.get_byte_size();
+        }
+        m_vision_encoder.set_tensor("pixel_values", batched_pixel_values);
+    }
     m_vision_encoder.infer();
 
+    // scatter encoder output [total_num_patches, num_tokens, hidden_size] back to images
     const ov::Tensor& infer_output = m_vision_encoder.get_output_tensor();
-    ov::Tensor image_features(infer_output.get_element_type(), infer_output.get_shape());
-    std::memcpy(image_features.data(), infer_output.data(), infer_output.get_byte_size());
+    OPENVINO_ASSERT(infer_output.get_shape().at(0) == total_num_patches, "Vision encoder output batch must match the number of encoded patches");
+    const size_t patch_byte_size = infer_output.get_byte_size() / total_num_patches;
+    const uint8_t* output_data = static_cast<const uint8_t*>(infer_output.data());
 
     ImageSize resized_source_size{config.crop_size_height / config.patch_size, config.crop_size_width / config.patch_size};
 
-    return {std::move(image_features), resized_source_size};
+    std::vector<EncodedImage> encoded_images;
+    encoded_images.reserve(images.size());
+    for (size_t image_idx = 0; image_idx < images.size(); ++image_idx) {
+        ov::Shape features_shape = infer_output.get_shape();
+        features_shape.at(0) = pixel_values.at(image_idx).get_shape().at(0);
+        ov::Tensor image_features(infer_output.get_element_type(), features_shape);
+        std::memcpy(image_features.data(), output_data, image_features.get_byte_size());
+        output_data += features_shape.at(0) * patch_byte_size;
+
+        EncodedImage encoded_image;
+        encoded_image.resized_source = std::move(image_features);
+        encoded_image.resized_source_size = resized_source_size;
+
+        if (model_type == VLMModelType::LLAVA_NEXT) {
+            // Gen number of patches
+            const ov::Shape& image_shape = images.at(image_idx).get_shape();
+            ImageSize original_image_size{image_shape.at(1), image_shape.at(2)};
+            auto best_resolution = select_best_resolution({original_image_size.width, original_image_size.height}, config.image_grid_pinpoints);
+            int num_patches_w = best_resolution.first / config.size_shortest_edge;
+            int num_patches_h = best_resolution.second / config.size_shortest_edge;
+            encoded_image.patches_grid = {num_patches_h, num_patches_w};
+        }
+        encoded_images.push_back(std::move(encoded_image));
+    }
+    return encoded_images;
 }
 
 EncodedImage VisionEncoder::encode_phi3_v(const ov::Tensor& image, const ProcessorConfig& config) {
@@ -1114,63 +833,7 @@ EncodedImage VisionEncoder::encode_phi3_v(const ov::Tensor& image, const Process
 }
 
 EncodedImage VisionEncoder::encode_qwen2vl(const ov::Tensor& image, const ProcessorConfig& config) {
-    ov::Shape image_shape = image.get_shape();
-    auto original_height = image_shape.at(1);
-    auto original_width = image_shape.at(2);
-
-    ImageSize target_image_size = smart_resize_qwen2vl(
-        original_height, 
-        original_width, 
-        config.patch_size * config.merge_size,
-        config.min_pixels,
-        config.max_pixels
-    );
-
-    clip_image_u8 input_image = tensor_to_clip_image_u8(image);
-    clip_image_u8 resized_image;
-    bicubic_resize(input_image, resized_image, target_image_size.width, target_image_size.height);
-
-    clip_ctx ctx;
-    std::copy(config.image_mean.begin(), config.image_mean.end(), ctx.image_mean);
-    std::copy(config.image_std.begin(), config.image_std.end(), ctx.image_std);
-    clip_image_f32 normalized_image = clip_image_preprocess(ctx, resized_image);
-
-    ov::Tensor patches = clip_image_f32_to_tensor(normalized_image);
-
-    // For single patch tile it to match temporal_patch_size
-    if (patches.get_shape().at(0) == 1) {
-        auto orig_shape = patches.get_shape();
-        ov::Tensor tiled_patches(patches.get_element_type(),
-                                 {config.temporal_patch_size, orig_shape.at(1), orig_shape.at(2), orig_shape.at(3)});
-        
-        for (size_t i = 0; i < config.temporal_patch_size; i++) {
-            std::memcpy(
-                tiled_patches.data<float>() + i * patches.get_byte_size() / sizeof(float),
-                patches.data<float>(),
-                patches.get_byte_size()
-            );
-        }
-        patches = std::move(tiled_patches);
-    }
-
-    auto patches_shape = patches.get_shape();
-    size_t channel = patches_shape.at(1);
-    
-    size_t grid_t = patches_shape.at(0) / config.temporal_patch_size;
-    size_t grid_h = target_image_size.height / config.patch_size;
-    size_t grid_w = target_image_size.width / config.patch_size;
-
-    ov::Tensor reshaped_patches = reshape_image_patches_qwen2vl(
-        patches, grid_t, grid_h, grid_w, channel, config.temporal_patch_size, config.patch_size, config.merge_size
-    );
-    ov::Tensor transposed_patches = transpose_image_patches_qwen2vl(reshaped_patches);
-
-    ov::Shape flattened_patches_shape{
-        grid_t * grid_h * grid_w,
-        channel * config.temporal_patch_size * config.patch_size * config.patch_size
-    };
-    ov::Tensor flattened_patches(transposed_patches.get_element_type(), flattened_patches_shape);
-    std::memcpy(flattened_patches.data(), transposed_patches.data(), transposed_patches.get_byte_size());
+    const auto& [flattened_patches, resized_source_size] = get_pixel_values_qwen2vl(image, config);
 
     m_vision_encoder.set_tensor("hidden_states", flattened_patches);
     m_vision_encoder.infer();
@@ -1179,7 +842,28 @@ EncodedImage VisionEncoder::encode_qwen2vl(const ov::Tensor& image, const Proces
     ov::Tensor image_features(infer_output.get_element_type(), infer_output.get_shape());
     std::memcpy(image_features.data(), infer_output.data(), infer_output.get_byte_size());
 
-    ImageSize resized_source_size{grid_h, grid_w};
-
     return {std::move(image_features), resized_source_size};
 }
+
+ov::Tensor ov::genai::preprocess_image(const ov::Tensor& image, const VLMModelType model_type, const ProcessorConfig& config) {
+    if (model_type == VLMModelType::MINICPM) {
+        clip_ctx ctx_clip;
+        std::copy(config.norm_mean.begin(), config.norm_mean.end(), ctx_clip.image_mean);
+        std::copy(config.norm_std.begin(), config.norm_std.end(), ctx_clip.image_std);
+        clip_image_u8 source = tensor_to_clip_image_u8(image);
+        std::vector<std::vector<clip_image_u8>> imgs = ::slice_image(source, config.max_slice_nums, config.scale_resolution, config.patch_size, 0 == config.max_slice_nums);
+        return get_pixel_values_minicpm(ctx_clip, imgs, config.patch_size);
+    } else if (model_type == VLMModelType::LLAVA) {
+        return get_pixel_values_llava(image, config);
+    } else if (model_type == VLMModelType::LLAVA_NEXT) {
+        return get_pixel_values_llava_next(image, config);
+    } else if (model_type == VLMModelType::INTERNVL_CHAT) {
+        return get_pixel_values_internvl(image, config);
+    } else if (model_type == VLMModelType::PHI3_V) {
+        return std::get<0>(phi3_v::get_pixel_values_phi3_v(image, config));
+    } else if (model_type == VLMModelType::QWEN2_VL) {
+        return std::get<0>(get_pixel_values_qwen2vl(image, config));
+    } else {
+        OPENVINO_THROW("Unsupported type of VisionEncoder");
+    }
+}
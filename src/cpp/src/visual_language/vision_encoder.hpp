@@ -142,21 +142,38 @@ public:
         );
     }
 
-private:
-    EncodedImage encode_minicpm(
-        const ov::Tensor& image, const ProcessorConfig& config
+    /// @brief Compute embeddings of several images given ProcessorConfig.
+    /// Preprocessed images are concatenated along the batch dimension
+    /// and encoded by a single inference for model types supporting it
+    /// (LLaVA, LLaVA-NeXT, InternVL), otherwise images are encoded one
+    /// by one.
+    /// @param images Images to infer embeddings for. Each image shape must
+    /// be [1HWC].
+    /// @param config A config to follow instead of the config obtained
+    /// in constructors.
+    /// @return Embeddings of each image in the order of images.
+    std::vector<EncodedImage> encode(
+        const std::vector<ov::Tensor>& images, const ProcessorConfig& config
     );
 
-    EncodedImage encode_llava(
-        const ov::Tensor& image, const ProcessorConfig& config
+    /// @brief Compute embeddings of several images given
+    /// ProcessorConfig members.
+    /// @param images Images to infer embeddings for. Each image shape must
+    /// be [1HWC].
+    /// @param config_map A config or its members values to follow
+    /// instead of the config obtained in constructors.
+    /// @return Embeddings of each image in the order of images.
+    std::vector<EncodedImage> encode(
+        const std::vector<ov::Tensor>& images, const ov::AnyMap& config_map = {}
     );
 
-    EncodedImage encode_llava_next(
+private:
+    EncodedImage encode_minicpm(
         const ov::Tensor& image, const ProcessorConfig& config
     );
 
-    EncodedImage encode_internvl(
-        const ov::Tensor& image, const ProcessorConfig& config
+    std::vector<EncodedImage> encode_batched(
+        const std::vector<ov::Tensor>& images, const ProcessorConfig& config
     );
 
     EncodedImage encode_phi3_v(
@@ -167,4 +184,14 @@ private:
         const ov::Tensor& image, const ProcessorConfig& config
     );
 };
+
+/// @brief Compute vision encoder input of an image the same way
+/// VisionEncoder::encode() does, but without inferring the encoder.
+/// Allows to measure image preprocessing separately from the model.
+/// @param image An image to preprocess. Image shape must be [1HWC] of u8.
+/// @param model_type A type of VLM model to preprocess the image for.
+/// @param config A config to follow.
+/// @return pixel_values input of the encoder, hidden_states for Qwen2-VL.
+/// MiniCPM's resized source and slices are packed into a single batch.
+ov::Tensor preprocess_image(const ov::Tensor& image, const VLMModelType model_type, const ProcessorConfig& config);
 }
@@ -140,7 +140,7 @@ std::pair<ov::genai::EncodedResults, bool> decode(std::shared_ptr<ov::genai::Whi
 
             auto beam_idx = beam_idxs[sequence->get_id()];
             next_beams.push_back(beam_idx);
-            batch_to_generated_ids[next_beams.size() - 1] = sequence->get_generated_ids();
+            batch_to_generated_ids[next_beams.size() - 1] = sequence->get_generated_ids().to_vector();
         }
 
         const auto infer_start = std::chrono::steady_clock::now();
@@ -179,7 +179,7 @@ std::pair<ov::genai::EncodedResults, bool> decode(std::shared_ptr<ov::genai::Whi
     const float score = sampling_params.is_beam_search() ? sequence->get_beam_search_score(sampling_params)
                                                          : sequence->get_cumulative_log_prob();
 
-    results.tokens.push_back(sequence->get_generated_ids());
+    results.tokens.push_back(sequence->get_generated_ids().to_vector());
     results.scores.push_back(score);
 
     sampler.clear_request_info(sequence_group->get_request_id());
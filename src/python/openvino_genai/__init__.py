@@ -31,6 +31,8 @@ from .py_openvino_genai import (
 # LLM pipeline
 from .py_openvino_genai import (
     LLMPipeline, 
+    ChatSession,
+    ChatSessionCache,
     draft_model,
 )
 
@@ -43,7 +45,9 @@ from .py_openvino_genai import (
 # Generation config
 from .py_openvino_genai import (
     GenerationConfig,
-    StopCriteria
+    StopCriteria,
+    RequestPriority,
+    StructuredOutputConfig
 )
 
 # Tokenizers
@@ -88,5 +92,6 @@ from .py_openvino_genai import (
     GenerationResult,
     SchedulerConfig,
     CacheEvictionConfig,
+    CacheEvictionPolicy,
     AggregationMode
 )
@@ -5,7 +5,7 @@ from __future__ import annotations
 import openvino._pyopenvino
 import os
 import typing
-__all__ = ['Adapter', 'AdapterConfig', 'AggregationMode', 'AutoencoderKL', 'CLIPTextModel', 'CLIPTextModelWithProjection', 'CacheEvictionConfig', 'ChunkStreamerBase', 'ContinuousBatchingPipeline', 'CppStdGenerator', 'DecodedResults', 'EncodedGenerationResult', 'EncodedResults', 'FluxTransformer2DModel', 'GenerationConfig', 'GenerationFinishReason', 'GenerationHandle', 'GenerationOutput', 'GenerationResult', 'GenerationStatus', 'Generator', 'Image2ImagePipeline', 'ImageGenerationConfig', 'ImageGenerationPerfMetrics', 'InpaintingPipeline', 'LLMPipeline', 'MeanStdPair', 'PerfMetrics', 'PipelineMetrics', 'RawImageGenerationPerfMetrics', 'RawPerfMetrics', 'SD3Transformer2DModel', 'Scheduler', 'SchedulerConfig', 'StopCriteria', 'StreamerBase', 'StreamingStatus', 'T5EncoderModel', 'Text2ImagePipeline', 'TextStreamer', 'TokenizedInputs', 'Tokenizer', 'TorchGenerator', 'UNet2DConditionModel', 'VLMDecodedResults', 'VLMPerfMetrics', 'VLMPipeline', 'VLMRawPerfMetrics', 'WhisperDecodedResultChunk', 'WhisperDecodedResults', 'WhisperGenerationConfig', 'WhisperPerfMetrics', 'WhisperPipeline', 'WhisperRawPerfMetrics', 'draft_model', 'get_version']
+__all__ = ['Adapter', 'AdapterConfig', 'AggregationMode', 'AutoencoderKL', 'CLIPTextModel', 'CLIPTextModelWithProjection', 'CacheEvictionConfig', 'CacheEvictionPolicy', 'ChatSession', 'ChatSessionCache', 'ChunkStreamerBase', 'ContinuousBatchingPipeline', 'CppStdGenerator', 'DecodedResults', 'EncodedGenerationResult', 'EncodedResults', 'FluxTransformer2DModel', 'GenerationConfig', 'GenerationFinishReason', 'GenerationHandle', 'GenerationOutput', 'GenerationResult', 'GenerationStatus', 'Generator', 'Image2ImagePipeline', 'ImageGenerationConfig', 'ImageGenerationPerfMetrics', 'InpaintingPipeline', 'LLMPipeline', 'MeanStdPair', 'MetricsHistogram', 'PerfMetrics', 'PipelineMetrics', 'RawImageGenerationPerfMetrics', 'RawPerfMetrics', 'RequestPriority', 'SD3Transformer2DModel', 'Scheduler', 'SchedulerConfig', 'StopCriteria', 'StreamerBase', 'StreamingStatus', 'StructuredOutputConfig', 'T5EncoderModel', 'Text2ImagePipeline', 'TextStreamer', 'TokenizedInputs', 'Tokenizer', 'TorchGenerator', 'UNet2DConditionModel', 'VLMDecodedResults', 'VLMPerfMetrics', 'VLMPipeline', 'VLMRawPerfMetrics', 'WhisperDecodedResultChunk', 'WhisperDecodedResults', 'WhisperGenerationConfig', 'WhisperPerfMetrics', 'WhisperPipeline', 'WhisperRawPerfMetrics', 'draft_model', 'get_version']
 class Adapter:
     """
     Immutable LoRA Adapter that carries the adaptation matrices and serves as unique adapter identifier.
@@ -334,9 +334,25 @@ class CacheEvictionConfig:
           Set this to false if your model has different RoPE scheme from the one used in the
           original llama model and you experience accuracy issues with cache eviction enabled.
         :type apply_rotation: bool
+    
+        :param score_aggregation_interval: Attention scores are aggregated and blocks are evicted once per this number of generation steps.
+          Values larger than 1 reduce the cost of score aggregation at large batch sizes, but the KV cache of a sequence
+          may exceed `max_cache_size` by the tokens generated between evictions. Must be non-zero.
+        :type score_aggregation_interval: int
+    
+        :param score_layers: Indices of decoder layers whose attention scores are aggregated. If empty, each layer is
+          evicted independently based on its own scores. Otherwise, scores of the listed layers are summed and the same
+          blocks are evicted from all layers.
+        :type score_layers: list[int]
+    
+        :param policy: The policy which determines the tokens that may be evicted from cache and the moment of eviction.
+        :type policy: openvino_genai.CacheEvictionPolicy
     """
     aggregation_mode: AggregationMode
     apply_rotation: bool
+    policy: CacheEvictionPolicy
+    score_aggregation_interval: int
+    score_layers: list[int]
     def __init__(self, start_size: int, recent_size: int, max_cache_size: int, aggregation_mode: AggregationMode, apply_rotation: bool = False) -> None:
         ...
     def get_evictable_size(self) -> int:
@@ -347,6 +363,88 @@ class CacheEvictionConfig:
         ...
     def get_start_size(self) -> int:
         ...
+class CacheEvictionPolicy:
+    """
+    Represents the policy which determines the tokens that may be evicted from cache and the moment of eviction
+                                   :param CacheEvictionPolicy.DEFAULT: The "start" and "recent" areas of KV cache are retained and the blocks with the lowest aggregated importance scores are evicted from the area between them during generation
+                                   :param CacheEvictionPolicy.H2O: Heavy-hitter oracle: same as DEFAULT, but the "start" area is not retained, so the blocks in the beginning of KV cache are kept only if their scores are high enough
+                                   :param CacheEvictionPolicy.SNAPKV: The prompt is compressed to max_cache_size once after it is processed, based on attention scores of the last recent_size prompt tokens, and no tokens are evicted during generation
+    
+    Members:
+    
+      DEFAULT
+    
+      H2O
+    
+      SNAPKV
+    """
+    DEFAULT: typing.ClassVar[CacheEvictionPolicy]  # value = <CacheEvictionPolicy.DEFAULT: 0>
+    H2O: typing.ClassVar[CacheEvictionPolicy]  # value = <CacheEvictionPolicy.H2O: 1>
+    SNAPKV: typing.ClassVar[CacheEvictionPolicy]  # value = <CacheEvictionPolicy.SNAPKV: 2>
+    __members__: typing.ClassVar[dict[str, CacheEvictionPolicy]]  # value = {'DEFAULT': <CacheEvictionPolicy.DEFAULT: 0>, 'H2O': <CacheEvictionPolicy.H2O: 1>, 'SNAPKV': <CacheEvictionPolicy.SNAPKV: 2>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
+class ChatSession:
+    """
+    
+        Snapshot of a chat conversation of LLMPipeline: the chat history and the KV cache computed for it.
+        A session exported by LLMPipeline.export_chat_session() can be imported later with LLMPipeline.import_chat_session()
+        to continue the conversation without recomputing its history. The KV cache is valid only for the model and the device
+        the session was exported from.
+    """
+    history: list[dict[str, str]]
+    @staticmethod
+    def load(path: os.PathLike) -> ChatSession:
+        ...
+    def __init__(self) -> None:
+        ...
+    def get_byte_size(self) -> int:
+        ...
+    def save(self, path: os.PathLike) -> None:
+        ...
+class ChatSessionCache:
+    """
+    
+        Keeps chat sessions of many conversations within a memory budget.
+        When the total size of sessions exceeds max_memory_size bytes, the least recently used ones are saved to spill_dir
+        and loaded back on access, or dropped if spill_dir is not set.
+    """
+    def __init__(self, max_memory_size: int, spill_dir: os.PathLike = ...) -> None:
+        ...
+    def contains(self, session_id: str) -> bool:
+        ...
+    def get_memory_size(self) -> int:
+        ...
+    def put(self, session_id: str, session: ChatSession) -> None:
+        ...
+    def remove(self, session_id: str) -> None:
+        ...
+    def take(self, session_id: str) -> ChatSession | None:
+        ...
 class ChunkStreamerBase:
     """
     
@@ -391,12 +489,18 @@ class ContinuousBatchingPipeline:
     def add_request(self, request_id: int, prompt: str, generation_config: GenerationConfig) -> GenerationHandle:
         ...
     @typing.overload
+    def add_request(self, request_id: int, prompt: str, images: list[openvino._pyopenvino.Tensor], generation_config: GenerationConfig) -> GenerationHandle:
+        ...
+    @typing.overload
     def generate(self, input_ids: list[openvino._pyopenvino.Tensor], generation_config: list[GenerationConfig], streamer: typing.Callable[[str], int | None] | StreamerBase | None = None) -> list[EncodedGenerationResult]:
         ...
     @typing.overload
     def generate(self, prompts: list[str], generation_config: list[GenerationConfig], streamer: typing.Callable[[str], int | None] | StreamerBase | None = None) -> list[GenerationResult]:
         ...
     @typing.overload
+    def generate(self, prompts: list[str], images: list[list[openvino._pyopenvino.Tensor]], generation_config: list[GenerationConfig], streamer: typing.Callable[[str], int | None] | StreamerBase | None = None) -> list[VLMDecodedResults]:
+        ...
+    @typing.overload
     def generate(self, prompt: str, generation_config: GenerationConfig, streamer: typing.Callable[[str], int | None] | StreamerBase | None = None) -> list[GenerationResult]:
         ...
     def get_config(self) -> GenerationConfig:
@@ -407,8 +511,14 @@ class ContinuousBatchingPipeline:
         ...
     def has_non_finished_requests(self) -> bool:
         ...
+    def is_engine_running(self) -> bool:
+        ...
+    def start_engine(self, max_waiting_requests: int = 0) -> None:
+        ...
     def step(self) -> None:
         ...
+    def stop_engine(self) -> None:
+        ...
 class CppStdGenerator(Generator):
     """
     This class wraps std::mt19937 pseudo-random generator.
@@ -567,6 +677,13 @@ class GenerationConfig:
         logprobs:       number of top logprobs computed for each position, if set to 0, logprobs are not computed and value 0.0 is returned.
                         Currently only single top logprob can be returned, so any logprobs > 1 is treated as logprobs == 1. (default: 0).
         apply_chat_template: whether to apply chat_template for non-chat scenarios
+        structured_output_config: if set, the output is constrained by a JSON schema, regex or grammar. Not supported by beam search.
+        cache_eviction_config: if set, overrides the cache eviction config of the pipeline for this request, e.g. to select another
+                       eviction policy or cache budget. Requires SchedulerConfig.use_cache_eviction. apply_rotation and
+                       score_aggregation_interval are taken from the pipeline config.
+        priority: scheduling priority of the request in continuous batching pipelines, see RequestPriority.
+        deadline_ms: time in milliseconds since the request is added by which its first token is expected. Among requests of the same
+                     priority, the ones with earlier deadlines are scheduled first. 0 means no deadline.
     
         repetition_penalty: the parameter for repetition penalty. 1.0 means no penalty.
         presence_penalty: reduces absolute log prob if the token was generated at least once.
@@ -597,6 +714,8 @@ class GenerationConfig:
     adapters: AdapterConfig | None
     apply_chat_template: bool
     assistant_confidence_threshold: float
+    cache_eviction_config: CacheEvictionConfig | None
+    deadline_ms: int
     diversity_penalty: float
     do_sample: bool
     echo: bool
@@ -611,16 +730,19 @@ class GenerationConfig:
     max_ngram_size: int
     min_new_tokens: int
     no_repeat_ngram_size: int
+    num_assistant_branches: int
     num_assistant_tokens: int
     num_beam_groups: int
     num_beams: int
     num_return_sequences: int
     presence_penalty: float
+    priority: RequestPriority
     repetition_penalty: float
     rng_seed: int
     stop_criteria: StopCriteria
     stop_strings: set[str]
     stop_token_ids: set[int]
+    structured_output_config: StructuredOutputConfig | None
     temperature: float
     top_k: int
     top_p: float
@@ -701,6 +823,8 @@ class GenerationHandle:
         ...
     def read_all(self) -> list[GenerationOutput]:
         ...
+    def set_output_callback(self, callback: typing.Callable[[dict[int, GenerationOutput], GenerationStatus], None]) -> None:
+        ...
     def stop(self) -> None:
         ...
 class GenerationOutput:
@@ -870,7 +994,8 @@ class Image2ImagePipeline:
             generator: openvino_genai.TorchGenerator, openvino_genai.CppStdGenerator or class inherited from openvino_genai.Generator - random generator,
             adapters: LoRA adapters,
             strength: strength for image to image generation. 1.0f means initial image is fully noised,
-            max_sequence_length: int - length of t5_encoder_model input
+            max_sequence_length: int - length of t5_encoder_model input,
+            cfg_truncation_step: int - inference step starting from which classifier-free guidance is not computed
         
             :return: ov.Tensor with resulting images
             :rtype: ov.Tensor
@@ -890,6 +1015,7 @@ class ImageGenerationConfig:
     This class is used for storing generation config for image generation pipeline.
     """
     adapters: AdapterConfig | None
+    cfg_truncation_step: int
     generator: Generator
     guidance_scale: float
     height: int
@@ -1072,7 +1198,8 @@ class InpaintingPipeline:
             generator: openvino_genai.TorchGenerator, openvino_genai.CppStdGenerator or class inherited from openvino_genai.Generator - random generator,
             adapters: LoRA adapters,
             strength: strength for image to image generation. 1.0f means initial image is fully noised,
-            max_sequence_length: int - length of t5_encoder_model input
+            max_sequence_length: int - length of t5_encoder_model input,
+            cfg_truncation_step: int - inference step starting from which classifier-free guidance is not computed
         
             :return: ov.Tensor with resulting images
             :rtype: ov.Tensor
@@ -1129,6 +1256,13 @@ class LLMPipeline:
             logprobs:       number of top logprobs computed for each position, if set to 0, logprobs are not computed and value 0.0 is returned.
                             Currently only single top logprob can be returned, so any logprobs > 1 is treated as logprobs == 1. (default: 0).
             apply_chat_template: whether to apply chat_template for non-chat scenarios
+            structured_output_config: if set, the output is constrained by a JSON schema, regex or grammar. Not supported by beam search.
+            cache_eviction_config: if set, overrides the cache eviction config of the pipeline for this request, e.g. to select another
+                           eviction policy or cache budget. Requires SchedulerConfig.use_cache_eviction. apply_rotation and
+                           score_aggregation_interval are taken from the pipeline config.
+            priority: scheduling priority of the request in continuous batching pipelines, see RequestPriority.
+            deadline_ms: time in milliseconds since the request is added by which its first token is expected. Among requests of the same
+                         priority, the ones with earlier deadlines are scheduled first. 0 means no deadline.
         
             repetition_penalty: the parameter for repetition penalty. 1.0 means no penalty.
             presence_penalty: reduces absolute log prob if the token was generated at least once.
@@ -1175,6 +1309,8 @@ class LLMPipeline:
                     Add {"scheduler_config": ov_genai.SchedulerConfig} to config properties to create continuous batching pipeline.
                     kwargs: Device properties.
         """
+    def export_chat_session(self) -> ChatSession:
+        ...
     def finish_chat(self) -> None:
         ...
     def generate(self, inputs: openvino._pyopenvino.Tensor | TokenizedInputs | str | list[str], generation_config: GenerationConfig | None = None, streamer: typing.Callable[[str], int | None] | StreamerBase | None = None, **kwargs) -> EncodedResults | DecodedResults:
@@ -1215,6 +1351,13 @@ class LLMPipeline:
             logprobs:       number of top logprobs computed for each position, if set to 0, logprobs are not computed and value 0.0 is returned.
                             Currently only single top logprob can be returned, so any logprobs > 1 is treated as logprobs == 1. (default: 0).
             apply_chat_template: whether to apply chat_template for non-chat scenarios
+            structured_output_config: if set, the output is constrained by a JSON schema, regex or grammar. Not supported by beam search.
+            cache_eviction_config: if set, overrides the cache eviction config of the pipeline for this request, e.g. to select another
+                           eviction policy or cache budget. Requires SchedulerConfig.use_cache_eviction. apply_rotation and
+                           score_aggregation_interval are taken from the pipeline config.
+            priority: scheduling priority of the request in continuous batching pipelines, see RequestPriority.
+            deadline_ms: time in milliseconds since the request is added by which its first token is expected. Among requests of the same
+                         priority, the ones with earlier deadlines are scheduled first. 0 means no deadline.
         
             repetition_penalty: the parameter for repetition penalty. 1.0 means no penalty.
             presence_penalty: reduces absolute log prob if the token was generated at least once.
@@ -1246,6 +1389,8 @@ class LLMPipeline:
         ...
     def get_tokenizer(self) -> Tokenizer:
         ...
+    def import_chat_session(self, session: ChatSession) -> None:
+        ...
     def set_generation_config(self, config: GenerationConfig) -> None:
         ...
     def start_chat(self, system_message: str = '') -> None:
@@ -1261,6 +1406,37 @@ class MeanStdPair:
     @property
     def std(self) -> float:
         ...
+class MetricsHistogram:
+    """
+    
+        Distribution of values observed during the lifetime of the pipeline.
+    
+        :param bounds: Upper bounds (inclusive) of buckets in ascending order, the last bucket has no upper bound
+        :type bounds: List[float]
+    
+        :param counts: Number of observed values in each bucket, len(counts) == len(bounds) + 1
+        :type counts: List[int]
+    
+        :param sum: Sum of all observed values
+        :type sum: float
+    
+        :param count: Number of observed values
+        :type count: int
+    """
+    def __init__(self) -> None:
+        ...
+    @property
+    def bounds(self) -> list[float]:
+        ...
+    @property
+    def count(self) -> int:
+        ...
+    @property
+    def counts(self) -> list[int]:
+        ...
+    @property
+    def sum(self) -> float:
+        ...
 class PerfMetrics:
     """
     
@@ -1352,6 +1528,15 @@ class PipelineMetrics:
         :param requests: Number of requests to be processed by the pipeline.
         :type requests: int
     
+        :param waiting_requests: Number of requests which wait for their prompts to be processed at the previous step of the pipeline.
+        :type waiting_requests: int
+    
+        :param running_requests: Number of requests which are being processed at the previous step of the pipeline.
+        :type running_requests: int
+    
+        :param preempted_requests: Number of requests which were preempted and wait to be scheduled again at the previous step of the pipeline.
+        :type preempted_requests: int
+    
         :param scheduled_requests:  Number of requests that were scheduled for processing at the previous step of the pipeline.
         :type scheduled_requests: int
     
@@ -1364,9 +1549,56 @@ class PipelineMetrics:
     
         :param avg_cache_usage: Running average of the KV cache usage (in %) during the lifetime of the pipeline, with max window size of 1000 steps
         :type avg_cache_usage: float
+    
+        :param used_kv_blocks: Number of KV cache blocks occupied by sequences in the last generation step.
+        :type used_kv_blocks: int
+    
+        :param free_kv_blocks: Number of KV cache blocks available for allocation in the last generation step, including cached ones.
+        :type free_kv_blocks: int
+    
+        :param cached_kv_blocks: Number of free KV cache blocks which keep prefixes of finished sequences for prefix caching.
+        :type cached_kv_blocks: int
+    
+        :param num_preemptions: Number of preemptions of sequence groups by recompute during the lifetime of the pipeline
+        :type num_preemptions: int
+    
+        :param num_partial_preemptions: Number of preemptions which released only a part of sequence group blocks, other preemptions release all blocks
+        :type num_partial_preemptions: int
+    
+        :param prompt_tokens: Total number of prompt tokens of requests added to the pipeline
+        :type prompt_tokens: int
+    
+        :param cached_prompt_tokens: Number of prompt tokens whose KV cache was restored from the prefix cache instead of being computed
+        :type cached_prompt_tokens: int
+    
+        :param generated_tokens: Total number of tokens generated by the pipeline
+        :type generated_tokens: int
+    
+        :param draft_tokens: Number of draft tokens proposed by speculative decoding or prompt lookup
+        :type draft_tokens: int
+    
+        :param accepted_draft_tokens: Number of draft tokens accepted by the main model
+        :type accepted_draft_tokens: int
+    
+        :param step_duration: Histogram of durations of generation steps in milliseconds
+        :type step_duration: MetricsHistogram
+    
+        :param tokens_per_step: Histogram of numbers of tokens scheduled for processing in a generation step
+        :type tokens_per_step: MetricsHistogram
     """
     def __init__(self) -> None:
         ...
+    def to_prometheus(self, prefix: str = 'ov_genai') -> str:
+        """
+        Returns metrics in Prometheus text exposition format.
+        """
+    def write_prometheus(self, path: os.PathLike, prefix: str = 'ov_genai') -> None:
+        """
+        Atomically replaces the file with metrics in Prometheus text exposition format.
+        """
+    @property
+    def accepted_draft_tokens(self) -> int:
+        ...
     @property
     def avg_cache_usage(self) -> float:
         ...
@@ -1374,14 +1606,56 @@ class PipelineMetrics:
     def cache_usage(self) -> float:
         ...
     @property
+    def cached_kv_blocks(self) -> int:
+        ...
+    @property
+    def cached_prompt_tokens(self) -> int:
+        ...
+    @property
+    def draft_tokens(self) -> int:
+        ...
+    @property
+    def free_kv_blocks(self) -> int:
+        ...
+    @property
+    def generated_tokens(self) -> int:
+        ...
+    @property
     def max_cache_usage(self) -> float:
         ...
     @property
+    def num_partial_preemptions(self) -> int:
+        ...
+    @property
+    def num_preemptions(self) -> int:
+        ...
+    @property
+    def preempted_requests(self) -> int:
+        ...
+    @property
+    def prompt_tokens(self) -> int:
+        ...
+    @property
     def requests(self) -> int:
         ...
     @property
+    def running_requests(self) -> int:
+        ...
+    @property
     def scheduled_requests(self) -> int:
         ...
+    @property
+    def step_duration(self) -> MetricsHistogram:
+        ...
+    @property
+    def tokens_per_step(self) -> MetricsHistogram:
+        ...
+    @property
+    def used_kv_blocks(self) -> int:
+        ...
+    @property
+    def waiting_requests(self) -> int:
+        ...
 class RawImageGenerationPerfMetrics:
     """
     
@@ -1468,6 +1742,57 @@ class RawPerfMetrics:
     @property
     def tokenization_durations(self) -> list[float]:
         ...
+class RequestPriority:
+    """
+    
+        RequestPriority is a scheduling priority of a request in continuous batching pipelines.
+    
+        The following values are possible:
+            "openvino_genai.RequestPriority.HIGH" is meant for latency sensitive requests, e.g. interactive chat. These requests are scheduled first,
+                preempted last and may use the part of the token budget reserved by SchedulerConfig.high_priority_tokens_share.
+            "openvino_genai.RequestPriority.NORMAL" requests are scheduled after HIGH priority ones.
+            "openvino_genai.RequestPriority.LOW" is meant for offline batch jobs, which only fill the capacity left by requests of higher priorities
+                and are preempted first.
+    
+    
+    Members:
+    
+      HIGH
+    
+      NORMAL
+    
+      LOW
+    """
+    HIGH: typing.ClassVar[RequestPriority]  # value = <RequestPriority.HIGH: 0>
+    LOW: typing.ClassVar[RequestPriority]  # value = <RequestPriority.LOW: 2>
+    NORMAL: typing.ClassVar[RequestPriority]  # value = <RequestPriority.NORMAL: 1>
+    __members__: typing.ClassVar[dict[str, RequestPriority]]  # value = {'HIGH': <RequestPriority.HIGH: 0>, 'NORMAL': <RequestPriority.NORMAL: 1>, 'LOW': <RequestPriority.LOW: 2>}
+    def __eq__(self, other: typing.Any) -> bool:
+        ...
+    def __getstate__(self) -> int:
+        ...
+    def __hash__(self) -> int:
+        ...
+    def __index__(self) -> int:
+        ...
+    def __init__(self, value: int) -> None:
+        ...
+    def __int__(self) -> int:
+        ...
+    def __ne__(self, other: typing.Any) -> bool:
+        ...
+    def __repr__(self) -> str:
+        ...
+    def __setstate__(self, state: int) -> None:
+        ...
+    def __str__(self) -> str:
+        ...
+    @property
+    def name(self) -> str:
+        ...
+    @property
+    def value(self) -> int:
+        ...
 class SD3Transformer2DModel:
     """
     SD3Transformer2DModel class.
@@ -1589,8 +1914,12 @@ class SchedulerConfig:
             independent sequences, we consider total amount of tokens in a batch).
         num_kv_blocks:              total number of KV blocks available to scheduler logic.
         cache_size:                 total size of KV cache in GB.
+        cache_size_limit:           upper bound of KV cache size in GB when the cache is allocated dynamically,
+            i.e. both num_kv_blocks and cache_size are 0. If 0, the size of physical memory is used for CPU.
         block_size:                 block size for KV cache.
         dynamic_split_fuse:         whether to split prompt / generate to different scheduling phases.
+        high_priority_tokens_share: share of max_num_batched_tokens reserved for requests of RequestPriority.HIGH, in range [0, 1).
+            Requests of lower priorities are scheduled within the rest of the budget.
     
         vLLM-like settings:
         max_num_seqs:               max number of scheduled sequences (you can think of it as "max batch size").
@@ -1603,8 +1932,10 @@ class SchedulerConfig:
     """
     cache_eviction_config: CacheEvictionConfig
     cache_size: int
+    cache_size_limit: int
     dynamic_split_fuse: bool
     enable_prefix_caching: bool
+    high_priority_tokens_share: float
     max_num_batched_tokens: int
     max_num_seqs: int
     num_kv_blocks: int
@@ -1671,6 +2002,10 @@ class StreamerBase:
         """
         End is called at the end of generation. It can be used to flush cache if your own streamer has one
         """
+    def get_status(self) -> StreamingStatus:
+        """
+        Get_status is called while a long prompt is processed in chunks, before the first token is generated. Returns a StreamingStatus flag to indicate whether generation should be stopped or cancelled
+        """
     def put(self, token: int) -> bool:
         """
         Put is called every time new token is decoded. Returns a bool flag to indicate whether generation should be stopped, if return true generation stops
@@ -1719,6 +2054,24 @@ class StreamingStatus:
     @property
     def value(self) -> int:
         ...
+class StructuredOutputConfig:
+    """
+    
+        Structure to keep parameters of structured output generation. Generated tokens are constrained,
+        so the whole output matches one of the following descriptions. Exactly one of them should be set.
+    
+        Parameters:
+        json_schema: if set, the output is a JSON document valid against the JSON schema.
+        regex:       if set, the output matches the regex.
+        grammar:     if set, the output matches EBNF grammar in GBNF notation with `root` rule. Recursive rules are not supported.
+    """
+    grammar: str | None
+    json_schema: str | None
+    regex: str | None
+    def __init__(self, *, json_schema: str | None = None, regex: str | None = None, grammar: str | None = None) -> None:
+        ...
+    def validate(self) -> None:
+        ...
 class T5EncoderModel:
     """
     T5EncoderModel class.
@@ -1833,7 +2186,8 @@ class Text2ImagePipeline:
             generator: openvino_genai.TorchGenerator, openvino_genai.CppStdGenerator or class inherited from openvino_genai.Generator - random generator,
             adapters: LoRA adapters,
             strength: strength for image to image generation. 1.0f means initial image is fully noised,
-            max_sequence_length: int - length of t5_encoder_model input
+            max_sequence_length: int - length of t5_encoder_model input,
+            cfg_truncation_step: int - inference step starting from which classifier-free guidance is not computed
         
             :return: ov.Tensor with resulting images
             :rtype: ov.Tensor
@@ -17,6 +17,7 @@ namespace py = pybind11;
 namespace pyutils = ov::genai::pybind::utils;
 
 using ov::genai::AggregationMode;
+using ov::genai::CacheEvictionPolicy;
 using ov::genai::CacheEvictionConfig;
 using ov::genai::ContinuousBatchingPipeline;
 using ov::genai::GenerationResult;
@@ -27,6 +28,7 @@ using ov::genai::GenerationFinishReason;
 using ov::genai::GenerationStatus;
 using ov::genai::SchedulerConfig;
 using ov::genai::PipelineMetrics;
+using ov::genai::MetricsHistogram;
 
 namespace {
 
@@ -48,6 +50,19 @@ auto cache_eviction_config_docstring = R"(
       Set this to false if your model has different RoPE scheme from the one used in the
       original llama model and you experience accuracy issues with cache eviction enabled.
     :type apply_rotation: bool
+
+    :param score_aggregation_interval: Attention scores are aggregated and blocks are evicted once per this number of generation steps.
+      Values larger than 1 reduce the cost of score aggregation at large batch sizes, but the KV cache of a sequence
+      may exceed `max_cache_size` by the tokens generated between evictions. Must be non-zero.
+    :type score_aggregation_interval: int
+
+    :param score_layers: Indices of decoder layers whose attention scores are aggregated. If empty, each layer is
+      evicted independently based on its own scores. Otherwise, scores of the listed layers are summed and the same
+      blocks are evicted from all layers.
+    :type score_layers: list[int]
+
+    :param policy: The policy which determines the tokens that may be evicted from cache and the moment of eviction.
+    :type policy: openvino_genai.CacheEvictionPolicy
 )";
 
 auto scheduler_config_docstring = R"(
@@ -58,8 +73,12 @@ auto scheduler_config_docstring = R"(
         independent sequences, we consider total amount of tokens in a batch).
     num_kv_blocks:              total number of KV blocks available to scheduler logic.
     cache_size:                 total size of KV cache in GB.
+    cache_size_limit:           upper bound of KV cache size in GB when the cache is allocated dynamically,
+        i.e. both num_kv_blocks and cache_size are 0. If 0, the size of physical memory is used for CPU.
     block_size:                 block size for KV cache.
     dynamic_split_fuse:         whether to split prompt / generate to different scheduling phases.
+    high_priority_tokens_share: share of max_num_batched_tokens reserved for requests of RequestPriority.HIGH, in range [0, 1).
+        Requests of lower priorities are scheduled within the rest of the budget.
 
     vLLM-like settings:
     max_num_seqs:               max number of scheduled sequences (you can think of it as "max batch size").
@@ -91,6 +110,22 @@ auto generation_result_docstring = R"(
 
 )";
 
+auto metrics_histogram_docstring = R"(
+    Distribution of values observed during the lifetime of the pipeline.
+
+    :param bounds: Upper bounds (inclusive) of buckets in ascending order, the last bucket has no upper bound
+    :type bounds: List[float]
+
+    :param counts: Number of observed values in each bucket, len(counts) == len(bounds) + 1
+    :type counts: List[int]
+
+    :param sum: Sum of all observed values
+    :type sum: float
+
+    :param count: Number of observed values
+    :type count: int
+)";
+
 auto pipeline_metrics_docstring = R"(
     Contains general pipeline metrics, either aggregated throughout the lifetime of the generation pipeline
     or measured at the previous generation step.
@@ -98,6 +133,15 @@ auto pipeline_metrics_docstring = R"(
     :param requests: Number of requests to be processed by the pipeline.
     :type requests: int
 
+    :param waiting_requests: Number of requests which wait for their prompts to be processed at the previous step of the pipeline.
+    :type waiting_requests: int
+
+    :param running_requests: Number of requests which are being processed at the previous step of the pipeline.
+    :type running_requests: int
+
+    :param preempted_requests: Number of requests which were preempted and wait to be scheduled again at the previous step of the pipeline.
+    :type preempted_requests: int
+
     :param scheduled_requests:  Number of requests that were scheduled for processing at the previous step of the pipeline.
     :type scheduled_requests: int
 
@@ -110,6 +154,42 @@ auto pipeline_metrics_docstring = R"(
 
     :param avg_cache_usage: Running average of the KV cache usage (in %) during the lifetime of the pipeline, with max window size of 1000 steps
     :type avg_cache_usage: float
+
+    :param used_kv_blocks: Number of KV cache blocks occupied by sequences in the last generation step.
+    :type used_kv_blocks: int
+
+    :param free_kv_blocks: Number of KV cache blocks available for allocation in the last generation step, including cached ones.
+    :type free_kv_blocks: int
+
+    :param cached_kv_blocks: Number of free KV cache blocks which keep prefixes of finished sequences for prefix caching.
+    :type cached_kv_blocks: int
+
+    :param num_preemptions: Number of preemptions of sequence groups by recompute during the lifetime of the pipeline
+    :type num_preemptions: int
+
+    :param num_partial_preemptions: Number of preemptions which released only a part of sequence group blocks, other preemptions release all blocks
+    :type num_partial_preemptions: int
+
+    :param prompt_tokens: Total number of prompt tokens of requests added to the pipeline
+    :type prompt_tokens: int
+
+    :param cached_prompt_tokens: Number of prompt tokens whose KV cache was restored from the prefix cache instead of being computed
+    :type cached_prompt_tokens: int
+
+    :param generated_tokens: Total number of tokens generated by the pipeline
+    :type generated_tokens: int
+
+    :param draft_tokens: Number of draft tokens proposed by speculative decoding or prompt lookup
+    :type draft_tokens: int
+
+    :param accepted_draft_tokens: Number of draft tokens accepted by the main model
+    :type accepted_draft_tokens: int
+
+    :param step_duration: Histogram of durations of generation steps in milliseconds
+    :type step_duration: MetricsHistogram
+
+    :param tokens_per_step: Histogram of numbers of tokens scheduled for processing in a generation step
+    :type tokens_per_step: MetricsHistogram
 )";
 
 std::ostream& operator << (std::ostream& stream, const GenerationResult& generation_result) {
@@ -211,8 +291,10 @@ void init_continuous_batching_pipeline(py::module_& m) {
         .def("can_read", &GenerationHandleImpl::can_read)
         .def("stop", &GenerationHandleImpl::stop)
         .def("cancel", &GenerationHandleImpl::cancel)
-        .def("read", &GenerationHandleImpl::read)
-        .def("read_all", &GenerationHandleImpl::read_all);
+        .def("read", &GenerationHandleImpl::read, py::call_guard<py::gil_scoped_release>())
+        .def("read_all", &GenerationHandleImpl::read_all, py::call_guard<py::gil_scoped_release>())
+        // the callback is called from the thread performing generation steps and acquires GIL itself
+        .def("set_output_callback", &GenerationHandleImpl::set_output_callback, py::arg("callback"), py::call_guard<py::gil_scoped_release>());
     OPENVINO_SUPPRESS_DEPRECATED_START
     generation_handle.def("drop", &GenerationHandleImpl::drop);
     OPENVINO_SUPPRESS_DEPRECATED_END
@@ -225,12 +307,24 @@ void init_continuous_batching_pipeline(py::module_& m) {
             .value("SUM", AggregationMode::SUM)
             .value("NORM_SUM", AggregationMode::NORM_SUM);
 
+    py::enum_<CacheEvictionPolicy>(m, "CacheEvictionPolicy",
+                                   R"(Represents the policy which determines the tokens that may be evicted from cache and the moment of eviction
+                               :param CacheEvictionPolicy.DEFAULT: The "start" and "recent" areas of KV cache are retained and the blocks with the lowest aggregated importance scores are evicted from the area between them during generation
+                               :param CacheEvictionPolicy.H2O: Heavy-hitter oracle: same as DEFAULT, but the "start" area is not retained, so the blocks in the beginning of KV cache are kept only if their scores are high enough
+                               :param CacheEvictionPolicy.SNAPKV: The prompt is compressed to max_cache_size once after it is processed, based on attention scores of the last recent_size prompt tokens, and no tokens are evicted during generation)")
+            .value("DEFAULT", CacheEvictionPolicy::DEFAULT)
+            .value("H2O", CacheEvictionPolicy::H2O)
+            .value("SNAPKV", CacheEvictionPolicy::SNAPKV);
+
     py::class_<CacheEvictionConfig>(m, "CacheEvictionConfig", cache_eviction_config_docstring)
             .def(py::init<>([](const size_t start_size, size_t recent_size, size_t max_cache_size, AggregationMode aggregation_mode, bool apply_rotation) {
                 return CacheEvictionConfig{start_size, recent_size, max_cache_size, aggregation_mode, apply_rotation}; }),
                  py::arg("start_size"), py::arg("recent_size"), py::arg("max_cache_size"), py::arg("aggregation_mode"), py::arg("apply_rotation") = false)
             .def_readwrite("aggregation_mode", &CacheEvictionConfig::aggregation_mode)
             .def_readwrite("apply_rotation", &CacheEvictionConfig::apply_rotation)
+            .def_readwrite("score_aggregation_interval", &CacheEvictionConfig::score_aggregation_interval)
+            .def_readwrite("score_layers", &CacheEvictionConfig::score_layers)
+            .def_readwrite("policy", &CacheEvictionConfig::policy)
             .def("get_start_size", &CacheEvictionConfig::get_start_size)
             .def("get_recent_size", &CacheEvictionConfig::get_recent_size)
             .def("get_max_cache_size", &CacheEvictionConfig::get_max_cache_size)
@@ -241,19 +335,47 @@ void init_continuous_batching_pipeline(py::module_& m) {
         .def_readwrite("max_num_batched_tokens", &SchedulerConfig::max_num_batched_tokens)
         .def_readwrite("num_kv_blocks", &SchedulerConfig::num_kv_blocks)
         .def_readwrite("cache_size", &SchedulerConfig::cache_size)
+        .def_readwrite("cache_size_limit", &SchedulerConfig::cache_size_limit)
         .def_readwrite("dynamic_split_fuse", &SchedulerConfig::dynamic_split_fuse)
+        .def_readwrite("high_priority_tokens_share", &SchedulerConfig::high_priority_tokens_share)
         .def_readwrite("max_num_seqs", &SchedulerConfig::max_num_seqs)
         .def_readwrite("enable_prefix_caching", &SchedulerConfig::enable_prefix_caching)
         .def_readwrite("use_cache_eviction", &SchedulerConfig::use_cache_eviction)
         .def_readwrite("cache_eviction_config", &SchedulerConfig::cache_eviction_config);
 
+    py::class_<MetricsHistogram>(m, "MetricsHistogram", metrics_histogram_docstring)
+            .def(py::init<>())
+            .def_readonly("bounds", &MetricsHistogram::bounds)
+            .def_readonly("counts", &MetricsHistogram::counts)
+            .def_readonly("sum", &MetricsHistogram::sum)
+            .def_readonly("count", &MetricsHistogram::count);
+
     py::class_<PipelineMetrics>(m, "PipelineMetrics", pipeline_metrics_docstring)
             .def(py::init<>())
             .def_readonly("requests", &PipelineMetrics::requests)
+            .def_readonly("waiting_requests", &PipelineMetrics::waiting_requests)
+            .def_readonly("running_requests", &PipelineMetrics::running_requests)
+            .def_readonly("preempted_requests", &PipelineMetrics::preempted_requests)
             .def_readonly("scheduled_requests", &PipelineMetrics::scheduled_requests)
             .def_readonly("cache_usage", &PipelineMetrics::cache_usage)
             .def_readonly("avg_cache_usage", &PipelineMetrics::avg_cache_usage)
-            .def_readonly("max_cache_usage", &PipelineMetrics::max_cache_usage);
+            .def_readonly("max_cache_usage", &PipelineMetrics::max_cache_usage)
+            .def_readonly("used_kv_blocks", &PipelineMetrics::used_kv_blocks)
+            .def_readonly("free_kv_blocks", &PipelineMetrics::free_kv_blocks)
+            .def_readonly("cached_kv_blocks", &PipelineMetrics::cached_kv_blocks)
+            .def_readonly("num_preemptions", &PipelineMetrics::num_preemptions)
+            .def_readonly("num_partial_preemptions", &PipelineMetrics::num_partial_preemptions)
+            .def_readonly("prompt_tokens", &PipelineMetrics::prompt_tokens)
+            .def_readonly("cached_prompt_tokens", &PipelineMetrics::cached_prompt_tokens)
+            .def_readonly("generated_tokens", &PipelineMetrics::generated_tokens)
+            .def_readonly("draft_tokens", &PipelineMetrics::draft_tokens)
+            .def_readonly("accepted_draft_tokens", &PipelineMetrics::accepted_draft_tokens)
+            .def_readonly("step_duration", &PipelineMetrics::step_duration)
+            .def_readonly("tokens_per_step", &PipelineMetrics::tokens_per_step)
+            .def("to_prometheus", &PipelineMetrics::to_prometheus, py::arg("prefix") = "ov_genai",
+                "Returns metrics in Prometheus text exposition format.")
+            .def("write_prometheus", &PipelineMetrics::write_prometheus, py::arg("path"), py::arg("prefix") = "ov_genai",
+                "Atomically replaces the file with metrics in Prometheus text exposition format.");
 
     py::class_<ContinuousBatchingPipeline>(m, "ContinuousBatchingPipeline", "This class is used for generation with LLMs with continuous batchig")
         .def(py::init([](const std::filesystem::path& models_path, const SchedulerConfig& scheduler_config, const std::string& device, const std::map<std::string, py::object>& llm_plugin_config, const std::map<std::string, py::object>& tokenizer_plugin_config) {
@@ -280,8 +402,12 @@ void init_continuous_batching_pipeline(py::module_& m) {
         .def("get_metrics", &ContinuousBatchingPipeline::get_metrics)
         .def("add_request", py::overload_cast<uint64_t, const ov::Tensor&, const ov::genai::GenerationConfig&>(&ContinuousBatchingPipeline::add_request), py::arg("request_id"), py::arg("input_ids"), py::arg("generation_config"))
         .def("add_request", py::overload_cast<uint64_t, const std::string&, const ov::genai::GenerationConfig&>(&ContinuousBatchingPipeline::add_request), py::arg("request_id"), py::arg("prompt"), py::arg("generation_config"))
+        .def("add_request", py::overload_cast<uint64_t, const std::string&, const std::vector<ov::Tensor>&, const ov::genai::GenerationConfig&>(&ContinuousBatchingPipeline::add_request), py::arg("request_id"), py::arg("prompt"), py::arg("images"), py::arg("generation_config"))
         .def("step", &ContinuousBatchingPipeline::step)
         .def("has_non_finished_requests", &ContinuousBatchingPipeline::has_non_finished_requests)
+        .def("start_engine", &ContinuousBatchingPipeline::start_engine, py::arg("max_waiting_requests") = 0)
+        .def("stop_engine", &ContinuousBatchingPipeline::stop_engine, py::call_guard<py::gil_scoped_release>())
+        .def("is_engine_running", &ContinuousBatchingPipeline::is_engine_running)
 
 
         .def(
@@ -311,6 +437,28 @@ void init_continuous_batching_pipeline(py::module_& m) {
             py::arg("generation_config"),
             py::arg("streamer") = std::monostate{}
         )
+
+        .def(
+            "generate",
+            [](ContinuousBatchingPipeline& pipe,
+               const std::vector<std::string>& prompts,
+               const std::vector<std::vector<ov::Tensor>>& images,
+               const std::vector<ov::genai::GenerationConfig>& generation_config,
+               const pyutils::PyBindStreamerVariant& py_streamer
+            ) -> py::typing::Union<std::vector<ov::genai::VLMDecodedResults>> {
+                ov::genai::StreamerVariant streamer = pyutils::pystreamer_to_streamer(py_streamer);
+                std::vector<ov::genai::VLMDecodedResults> generated_results;
+                {
+                    py::gil_scoped_release rel;
+                    generated_results = pipe.generate(prompts, images, generation_config, streamer);
+                }
+                return py::cast(generated_results);
+            },
+            py::arg("prompts"),
+            py::arg("images"),
+            py::arg("generation_config"),
+            py::arg("streamer") = std::monostate{}
+        )
         
         .def(
             "generate",
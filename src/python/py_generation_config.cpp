@@ -14,6 +14,8 @@ namespace py = pybind11;
 namespace pyutils = ov::genai::pybind::utils;
 
 using ov::genai::StopCriteria;
+using ov::genai::RequestPriority;
+using ov::genai::StructuredOutputConfig;
 using ov::genai::GenerationConfig;
 
 namespace {
@@ -27,6 +29,27 @@ auto stop_criteria_docstring =  R"(
         "openvino_genai.StopCriteria.NEVER" stops when there cannot be better candidates.
 )";
 
+auto request_priority_docstring = R"(
+    RequestPriority is a scheduling priority of a request in continuous batching pipelines.
+
+    The following values are possible:
+        "openvino_genai.RequestPriority.HIGH" is meant for latency sensitive requests, e.g. interactive chat. These requests are scheduled first,
+            preempted last and may use the part of the token budget reserved by SchedulerConfig.high_priority_tokens_share.
+        "openvino_genai.RequestPriority.NORMAL" requests are scheduled after HIGH priority ones.
+        "openvino_genai.RequestPriority.LOW" is meant for offline batch jobs, which only fill the capacity left by requests of higher priorities
+            and are preempted first.
+)";
+
+auto structured_output_config_docstring = R"(
+    Structure to keep parameters of structured output generation. Generated tokens are constrained,
+    so the whole output matches one of the following descriptions. Exactly one of them should be set.
+
+    Parameters:
+    json_schema: if set, the output is a JSON document valid against the JSON schema.
+    regex:       if set, the output matches the regex.
+    grammar:     if set, the output matches EBNF grammar in GBNF notation with `root` rule. Recursive rules are not supported.
+)";
+
 } // namespace
 
 char generation_config_docstring[] = R"(
@@ -48,6 +71,13 @@ char generation_config_docstring[] = R"(
     logprobs:       number of top logprobs computed for each position, if set to 0, logprobs are not computed and value 0.0 is returned.
                     Currently only single top logprob can be returned, so any logprobs > 1 is treated as logprobs == 1. (default: 0).
     apply_chat_template: whether to apply chat_template for non-chat scenarios
+    structured_output_config: if set, the output is constrained by a JSON schema, regex or grammar. Not supported by beam search.
+    cache_eviction_config: if set, overrides the cache eviction config of the pipeline for this request, e.g. to select another
+                   eviction policy or cache budget. Requires SchedulerConfig.use_cache_eviction. apply_rotation and
+                   score_aggregation_interval are taken from the pipeline config.
+    priority: scheduling priority of the request in continuous batching pipelines, see RequestPriority.
+    deadline_ms: time in milliseconds since the request is added by which its first token is expected. Among requests of the same
+                 priority, the ones with earlier deadlines are scheduled first. 0 means no deadline.
 
     repetition_penalty: the parameter for repetition penalty. 1.0 means no penalty.
     presence_penalty: reduces absolute log prob if the token was generated at least once.
@@ -83,6 +113,28 @@ void init_generation_config(py::module_& m) {
         .value("HEURISTIC", StopCriteria::HEURISTIC)
         .value("NEVER", StopCriteria::NEVER);
 
+    py::enum_<RequestPriority>(m, "RequestPriority", request_priority_docstring)
+        .value("HIGH", RequestPriority::HIGH)
+        .value("NORMAL", RequestPriority::NORMAL)
+        .value("LOW", RequestPriority::LOW);
+
+    py::class_<StructuredOutputConfig>(m, "StructuredOutputConfig", structured_output_config_docstring)
+        .def(py::init([](std::optional<std::string> json_schema, std::optional<std::string> regex, std::optional<std::string> grammar) {
+                StructuredOutputConfig config;
+                config.json_schema = json_schema;
+                config.regex = regex;
+                config.grammar = grammar;
+                return config;
+            }),
+            py::kw_only(),
+            py::arg("json_schema") = std::nullopt,
+            py::arg("regex") = std::nullopt,
+            py::arg("grammar") = std::nullopt)
+        .def_readwrite("json_schema", &StructuredOutputConfig::json_schema)
+        .def_readwrite("regex", &StructuredOutputConfig::regex)
+        .def_readwrite("grammar", &StructuredOutputConfig::grammar)
+        .def("validate", &StructuredOutputConfig::validate);
+
      // Binding for GenerationConfig
     py::class_<GenerationConfig>(m, "GenerationConfig", generation_config_docstring)
         .def(py::init<std::filesystem::path>(), py::arg("json_path"), "path where generation_config.json is stored")
@@ -113,10 +165,15 @@ void init_generation_config(py::module_& m) {
         .def_readwrite("assistant_confidence_threshold", &GenerationConfig::assistant_confidence_threshold)
         .def_readwrite("num_assistant_tokens", &GenerationConfig::num_assistant_tokens)
         .def_readwrite("max_ngram_size", &GenerationConfig::max_ngram_size)
+        .def_readwrite("num_assistant_branches", &GenerationConfig::num_assistant_branches)
         .def_readwrite("include_stop_str_in_output", &GenerationConfig::include_stop_str_in_output)
         .def_readwrite("stop_token_ids", &GenerationConfig::stop_token_ids)
         .def_readwrite("adapters", &GenerationConfig::adapters)
         .def_readwrite("apply_chat_template", &GenerationConfig::apply_chat_template)
+        .def_readwrite("structured_output_config", &GenerationConfig::structured_output_config)
+        .def_readwrite("cache_eviction_config", &GenerationConfig::cache_eviction_config)
+        .def_readwrite("priority", &GenerationConfig::priority)
+        .def_readwrite("deadline_ms", &GenerationConfig::deadline_ms)
         .def("set_eos_token_id", &GenerationConfig::set_eos_token_id, py::arg("tokenizer_eos_token_id"))
         .def("is_beam_search", &GenerationConfig::is_beam_search)
         .def("is_greedy_decoding", &GenerationConfig::is_greedy_decoding)
@@ -52,7 +52,8 @@ auto text2image_generate_docstring = R"(
     generator: openvino_genai.TorchGenerator, openvino_genai.CppStdGenerator or class inherited from openvino_genai.Generator - random generator,
     adapters: LoRA adapters,
     strength: strength for image to image generation. 1.0f means initial image is fully noised,
-    max_sequence_length: int - length of t5_encoder_model input
+    max_sequence_length: int - length of t5_encoder_model input,
+    cfg_truncation_step: int - inference step starting from which classifier-free guidance is not computed
 
     :return: ov.Tensor with resulting images
     :rtype: ov.Tensor
@@ -307,6 +308,7 @@ void init_image_generation_pipelines(py::module_& m) {
         .def_readwrite("adapters", &ov::genai::ImageGenerationConfig::adapters)
         .def_readwrite("strength", &ov::genai::ImageGenerationConfig::strength)
         .def_readwrite("max_sequence_length", &ov::genai::ImageGenerationConfig::max_sequence_length)
+        .def_readwrite("cfg_truncation_step", &ov::genai::ImageGenerationConfig::cfg_truncation_step)
         .def("validate", &ov::genai::ImageGenerationConfig::validate)
         .def("update_generation_config", [](
             ov::genai::ImageGenerationConfig& config,
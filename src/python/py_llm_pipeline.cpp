@@ -17,6 +17,8 @@ namespace py = pybind11;
 namespace pyutils = ov::genai::pybind::utils;
 
 using ov::genai::OptionalGenerationConfig;
+using ov::genai::ChatSession;
+using ov::genai::ChatSessionCache;
 using ov::genai::LLMPipeline;
 using ov::genai::TokenizedInputs;
 using ov::genai::EncodedInputs;
@@ -27,6 +29,19 @@ using ov::genai::draft_model;
 
 namespace {
 
+auto chat_session_docstring = R"(
+    Snapshot of a chat conversation of LLMPipeline: the chat history and the KV cache computed for it.
+    A session exported by LLMPipeline.export_chat_session() can be imported later with LLMPipeline.import_chat_session()
+    to continue the conversation without recomputing its history. The KV cache is valid only for the model and the device
+    the session was exported from.
+)";
+
+auto chat_session_cache_docstring = R"(
+    Keeps chat sessions of many conversations within a memory budget.
+    When the total size of sessions exceeds max_memory_size bytes, the least recently used ones are saved to spill_dir
+    and loaded back on access, or dropped if spill_dir is not set.
+)";
+
 auto generate_docstring = R"(
     Generates sequences or tokens for LLMs. If input is a string or list of strings then resulting sequences will be already detokenized.
 
@@ -108,6 +123,21 @@ py::object call_common_generate(
 extern char generation_config_docstring[];
 
 void init_llm_pipeline(py::module_& m) {
+    py::class_<ChatSession>(m, "ChatSession", chat_session_docstring)
+        .def(py::init<>())
+        .def_readwrite("history", &ChatSession::history)
+        .def("get_byte_size", &ChatSession::get_byte_size)
+        .def("save", &ChatSession::save, py::arg("path"), py::call_guard<py::gil_scoped_release>())
+        .def_static("load", &ChatSession::load, py::arg("path"), py::call_guard<py::gil_scoped_release>());
+
+    py::class_<ChatSessionCache>(m, "ChatSessionCache", chat_session_cache_docstring)
+        .def(py::init<size_t, const std::filesystem::path&>(), py::arg("max_memory_size"), py::arg("spill_dir") = std::filesystem::path{})
+        .def("put", &ChatSessionCache::put, py::arg("session_id"), py::arg("session"), py::call_guard<py::gil_scoped_release>())
+        .def("take", &ChatSessionCache::take, py::arg("session_id"), py::call_guard<py::gil_scoped_release>())
+        .def("contains", &ChatSessionCache::contains, py::arg("session_id"))
+        .def("remove", &ChatSessionCache::remove, py::arg("session_id"))
+        .def("get_memory_size", &ChatSessionCache::get_memory_size);
+
     py::class_<LLMPipeline>(m, "LLMPipeline", "This class is used for generation with LLMs")
         // init(model_path, tokenizer, device, config, kwargs) should be defined before init(model_path, device, config, kwargs) 
         // to prevent tokenizer treated as kwargs argument
@@ -205,6 +235,8 @@ void init_llm_pipeline(py::module_& m) {
         .def("get_tokenizer", &LLMPipeline::get_tokenizer)
         .def("start_chat", &LLMPipeline::start_chat, py::arg("system_message") = "")
         .def("finish_chat", &LLMPipeline::finish_chat)
+        .def("export_chat_session", &LLMPipeline::export_chat_session)
+        .def("import_chat_session", &LLMPipeline::import_chat_session, py::arg("session"))
         .def("get_generation_config", &LLMPipeline::get_generation_config, py::return_value_policy::copy)
         .def("set_generation_config", &LLMPipeline::set_generation_config, py::arg("config"));
 
@@ -51,6 +51,13 @@ class ConstructableStreamer: public StreamerBase {
             token  // Argument(s)
         );
     }
+    StreamingStatus get_status() override {
+        PYBIND11_OVERRIDE(
+            StreamingStatus,  // Return type
+            StreamerBase,  // Parent class
+            get_status  // Name of function in C++ (must match Python name)
+        );
+    }
     void end() override {
         PYBIND11_OVERRIDE_PURE(void, StreamerBase, end);
     }
@@ -67,6 +74,7 @@ void init_streamers(py::module_& m) {
     auto streamer = py::class_<StreamerBase, ConstructableStreamer, std::shared_ptr<StreamerBase>>(m, "StreamerBase", streamer_base_docstring)  // Change the holder form unique_ptr to shared_ptr
         .def(py::init<>())
         .def("write", &StreamerBase::write, "Write is called every time new token is decoded. Returns a StreamingStatus flag to indicate whether generation should be stopped or cancelled", py::arg("token"))
+        .def("get_status", &StreamerBase::get_status, "Get_status is called while a long prompt is processed in chunks, before the first token is generated. Returns a StreamingStatus flag to indicate whether generation should be stopped or cancelled")
         .def("end", &StreamerBase::end, "End is called at the end of generation. It can be used to flush cache if your own streamer has one");
     OPENVINO_SUPPRESS_DEPRECATED_START
     streamer.def("put", &StreamerBase::put, "Put is called every time new token is decoded. Returns a bool flag to indicate whether generation should be stopped, if return true generation stops", py::arg("token"));
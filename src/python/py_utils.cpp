@@ -256,8 +256,14 @@ ov::Any py_object_to_any(const py::object& py_obj, std::string property_name) {
         return py::cast<ov::genai::ImageGenerationConfig>(py_obj);
     } else if (py::isinstance<ov::genai::WhisperGenerationConfig>(py_obj)) {
         return py::cast<ov::genai::WhisperGenerationConfig>(py_obj);
+    } else if (py::isinstance<ov::genai::StructuredOutputConfig>(py_obj)) {
+        return py::cast<ov::genai::StructuredOutputConfig>(py_obj);
+    } else if (py::isinstance<ov::genai::CacheEvictionConfig>(py_obj)) {
+        return py::cast<ov::genai::CacheEvictionConfig>(py_obj);
     } else if (py::isinstance<ov::genai::StopCriteria>(py_obj)) {
         return py::cast<ov::genai::StopCriteria>(py_obj);
+    } else if (py::isinstance<ov::genai::RequestPriority>(py_obj)) {
+        return py::cast<ov::genai::RequestPriority>(py_obj);
     } else if (py::isinstance<ov::genai::Generator>(py_obj)) {
         return py::cast<std::shared_ptr<ov::genai::Generator>>(py_obj);
     } else if (py::isinstance<py::function>(py_obj) && property_name == "callback") {
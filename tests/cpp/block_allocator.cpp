@@ -227,6 +227,28 @@ TEST_F(PrefixCachingBlockAllocatorTest, HandlesHashCollisionsAtFreeCorrectly) {
     allocator.free(blocks_to_release);
 }
 
+TEST_F(PrefixCachingBlockAllocatorTest, DoesNotRestoreBlocksOfAnotherPromptContent) {
+    const uint64_t prefix_check = 42;
+    auto blocks = allocator.allocate_block(7, cached_blocks_map, prefix_check);
+
+    // occupied block with the same hash, but computed for another prompt content
+    EXPECT_TRUE(allocator.get_cached_block(7, cached_blocks_map, prefix_check + 1).empty());
+    auto restored_occupied_blocks = allocator.get_cached_block(7, cached_blocks_map, prefix_check);
+    EXPECT_EQ(restored_occupied_blocks, blocks);
+    allocator.free(restored_occupied_blocks);
+
+    allocator.free(blocks);
+    ASSERT_EQ(allocator.num_overwriteable_blocks(), 1);
+
+    // overwritable block is kept in the store if prompt content doesn't match
+    std::map<uint64_t, ov::genai::BlocksPerLayer> empty_map{};
+    EXPECT_TRUE(allocator.get_cached_block(7, empty_map, prefix_check + 1).empty());
+    EXPECT_EQ(allocator.num_overwriteable_blocks(), 1);
+    auto restored_blocks = allocator.get_cached_block(7, empty_map, prefix_check);
+    EXPECT_EQ(restored_blocks, blocks);
+    allocator.free(restored_blocks);
+}
+
 TEST(TestBlockAllocator, CalculatesUsagePercentageCorrectly) {
     size_t num_layers = 10;
     size_t initial_num_free_blocks = 10;
@@ -268,3 +290,36 @@ TEST(TestBlockAllocator, CalculatesUsagePercentageCorrectlyWithPrefixCaching) {
         allocator.free(prefix_hash_map[allocated_block.first]);
     }
 }
+
+TEST(TestBlockAllocator, ShrinksOnlyFreeBlocksAtTheEnd) {
+    size_t num_layers = 3;
+    auto allocator = ov::genai::BlockAllocator(4, false, num_layers);
+
+    // blocks 0 and 1 are used in all layers, block 2 only in the last one
+    auto first_blocks = allocator.allocate_block();
+    auto second_blocks = allocator.allocate_block();
+    auto third_block = allocator.allocate_block(2);
+    allocator.free(first_blocks);
+
+    allocator.increase_kv_blocks_number(10);
+    EXPECT_EQ(allocator.shrink_kv_blocks_number(10), 10);
+
+    // shrinking stops at block 2, which is used in the last layer
+    EXPECT_EQ(allocator.shrink_kv_blocks_number(1), 3);
+    EXPECT_EQ(allocator.get_total_number_of_kv_blocks(), 3);
+    EXPECT_EQ(allocator.num_free_blocks(0), 2);
+    EXPECT_EQ(allocator.num_free_blocks(2), 1);
+
+    allocator.free(third_block, 2);
+    allocator.free(second_blocks);
+    EXPECT_EQ(allocator.shrink_kv_blocks_number(1), 1);
+    for (size_t i = 0; i < num_layers; i++) {
+        EXPECT_EQ(allocator.num_free_blocks(i), 1);
+    }
+
+    // the released indices are reused when the cache grows again
+    allocator.increase_kv_blocks_number(4);
+    auto blocks = allocator.allocate_block();
+    EXPECT_EQ(blocks[0]->get_index(), 0);
+    allocator.free(blocks);
+}
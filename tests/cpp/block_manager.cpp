@@ -112,4 +112,65 @@ TEST(TestBlockManager, CanFreeBlocksFromSequence) {
     for (auto& sequence : sequence_group->get_sequences()) {
         bm.free_sequence(sequence->get_id());
     }
-}
\ No newline at end of file
+}
+
+TEST(TestBlockManager, embeddings_prompt_hashes) {
+    const size_t prompt_len = 8, hidden_size = 4, block_size = 4;
+    auto create_sequence_group = [&](float value) {
+        ov::Tensor inputs_embeds(ov::element::f32, {1, prompt_len, hidden_size});
+        std::fill_n(inputs_embeds.data<float>(), inputs_embeds.get_size(), value);
+        return std::make_shared<ov::genai::SequenceGroup>(0, inputs_embeds, ov::genai::greedy(), block_size);
+    };
+
+    auto sequence_group = create_sequence_group(1.0f);
+    EXPECT_EQ(sequence_group->get_sequence_group_type(), ov::genai::SequenceGroupType::EMBEDDINGS);
+    EXPECT_EQ(sequence_group->get_prompt_len(), prompt_len);
+    EXPECT_EQ(sequence_group->get_prompt_embeds().get_shape(), ov::Shape({prompt_len, hidden_size}));
+
+    // KV blocks of prompts with the same embeddings can be shared, while different embeddings lead to different hashes
+    auto same_sequence_group = create_sequence_group(1.0f);
+    auto other_sequence_group = create_sequence_group(2.0f);
+    auto hash = (*sequence_group)[0]->get_hash(block_size);
+    EXPECT_EQ(hash, (*same_sequence_group)[0]->get_hash(block_size));
+    EXPECT_NE(hash, (*other_sequence_group)[0]->get_hash(block_size));
+    EXPECT_EQ((*sequence_group)[0]->get_prefix_check(block_size), (*same_sequence_group)[0]->get_prefix_check(block_size));
+    EXPECT_NE((*sequence_group)[0]->get_prefix_check(block_size), (*other_sequence_group)[0]->get_prefix_check(block_size));
+
+    // prompt ids are chained, so a row id depends on all previous rows
+    ov::Tensor inputs_embeds(ov::element::f32, {1, prompt_len, hidden_size});
+    std::fill_n(inputs_embeds.data<float>(), inputs_embeds.get_size(), 1.0f);
+    inputs_embeds.data<float>()[0] = 2.0f;
+    auto changed_first_row_group = std::make_shared<ov::genai::SequenceGroup>(0, inputs_embeds, ov::genai::greedy(), block_size);
+    for (size_t token_idx = 0; token_idx < prompt_len; ++token_idx) {
+        EXPECT_NE(sequence_group->get_prompt_ids()[token_idx], changed_first_row_group->get_prompt_ids()[token_idx]);
+    }
+}
+
+TEST(TestBlockManager, incremental_hashes) {
+    const size_t block_size = 4;
+    ov::genai::TokenIds prompt_ids = {1, 2, 3, 4, 5, 6};
+    auto create_sequence = [&]() {
+        auto sequence_group = std::make_shared<ov::genai::SequenceGroup>(0, prompt_ids, ov::genai::greedy(), block_size);
+        return std::make_pair(sequence_group, (*sequence_group)[0]);
+    };
+
+    // hashes of a partially filled block are updated token by token
+    auto [sequence_group, sequence] = create_sequence();
+    size_t partial_hash = sequence->get_hash(5);
+    EXPECT_NE(partial_hash, sequence->get_hash(6));
+    sequence->append_token(7, 0.0f);
+    sequence->append_token(8, 0.0f);
+    const size_t full_hash = sequence->get_hash(8);
+
+    auto [same_sequence_group, same_sequence] = create_sequence();
+    same_sequence->append_token(7, 0.0f);
+    same_sequence->append_token(8, 0.0f);
+    EXPECT_EQ(same_sequence->get_hash(5), partial_hash);
+    EXPECT_EQ(same_sequence->get_hash(8), full_hash);
+
+    // removed tokens are not taken into account
+    sequence->remove_last_tokens(1);
+    sequence->append_token(9, 0.0f);
+    EXPECT_NE(sequence->get_hash(8), full_hash);
+    EXPECT_EQ(sequence->get_hash(4), same_sequence->get_hash(4));
+}
@@ -238,8 +238,89 @@ INSTANTIATE_TEST_SUITE_P(VariousSetsOfLowScoreBlocks, CacheEvictionLowScoreBlock
                              return info.param.test_id;
                          });
 
+TEST(CacheEvictionSharedScoresTest, EvictsSameBlocksFromAllLayers) {
+    auto eviction_config = DEFAULT_CACHE_EVICTION_CONFIG;
+    eviction_config.score_layers = {0, 2};
+    const size_t num_decoder_layers = 3;
+    auto algo = ov::genai::CacheEvictionAlgorithm(eviction_config, DEFAULT_BLOCK_SIZE, num_decoder_layers);
+
+    auto scores = get_mock_scores(num_decoder_layers, algo.get_max_cache_size_after_eviction() + 1);
+    for (auto& scores_per_layer : scores) {
+        fill_scores(scores_per_layer, 0, scores_per_layer.get_size(), 1.0);
+    }
+    // block 9 has the lowest score summed over the score layers, the scores of layer 1 are ignored
+    fill_scores(scores[0], DEFAULT_BLOCK_SIZE * 9, DEFAULT_BLOCK_SIZE * 10, 0.0);
+    fill_scores(scores[2], DEFAULT_BLOCK_SIZE * 9, DEFAULT_BLOCK_SIZE * 10, 0.5);
+    fill_scores(scores[0], DEFAULT_BLOCK_SIZE * 12, DEFAULT_BLOCK_SIZE * 13, 0.5);
+    fill_scores(scores[1], DEFAULT_BLOCK_SIZE * 15, DEFAULT_BLOCK_SIZE * 16, 0.0);
+    algo.register_new_token_scores(scores);
+
+    auto evicted_blocks = algo.evict_logical_blocks();
+    ASSERT_EQ(evicted_blocks.size(), num_decoder_layers);
+    for (const auto& evicted_blocks_for_this_layer : evicted_blocks) {
+        EXPECT_EQ(evicted_blocks_for_this_layer, std::set<size_t>({9}));
+    }
+}
+
 
 static constexpr size_t BLOCKS_TO_EVICT = 3;  // 3 blocks to evict
+TEST(CacheEvictionPolicyTest, H2ODoesNotKeepStartArea) {
+    auto eviction_config = DEFAULT_CACHE_EVICTION_CONFIG;
+    eviction_config.policy = ov::genai::CacheEvictionPolicy::H2O;
+    auto algo = ov::genai::CacheEvictionAlgorithm(eviction_config, DEFAULT_BLOCK_SIZE, DEFAULT_NUM_DECODER_LAYERS);
+
+    auto scores = get_mock_scores(DEFAULT_NUM_DECODER_LAYERS, algo.get_max_cache_size_after_eviction() + 1);
+    for (auto& scores_per_layer : scores) {
+        fill_scores(scores_per_layer, 0, scores_per_layer.get_size(), 1.0);
+        // block 2 is in the start area of the config
+        fill_scores(scores_per_layer, DEFAULT_BLOCK_SIZE * 2, DEFAULT_BLOCK_SIZE * 3, 0.0);
+    }
+    algo.register_new_token_scores(scores);
+
+    auto evicted_blocks = algo.evict_logical_blocks();
+    for (const auto& evicted_blocks_for_this_layer : evicted_blocks) {
+        EXPECT_EQ(evicted_blocks_for_this_layer, std::set<size_t>({2}));
+    }
+}
+
+TEST(CacheEvictionPolicyTest, SnapKVCompressesOnceByLatestScores) {
+    auto eviction_config = DEFAULT_CACHE_EVICTION_CONFIG;
+    eviction_config.policy = ov::genai::CacheEvictionPolicy::SNAPKV;
+    auto algo = ov::genai::CacheEvictionAlgorithm(eviction_config, DEFAULT_BLOCK_SIZE, DEFAULT_NUM_DECODER_LAYERS);
+
+    // the prompt is 3 blocks larger than the cache budget
+    const size_t prompt_len = eviction_config.get_max_cache_size() + 3 * DEFAULT_BLOCK_SIZE;
+    auto prefill_scores = get_mock_scores(DEFAULT_NUM_DECODER_LAYERS, prompt_len - 8 * DEFAULT_BLOCK_SIZE);
+    for (auto& scores_per_layer : prefill_scores) {
+        // scores of the prefix chunk are not used
+        fill_scores(scores_per_layer, 0, scores_per_layer.get_size(), 0.0);
+    }
+    algo.register_new_token_scores(prefill_scores);
+
+    auto window_scores = get_mock_scores(DEFAULT_NUM_DECODER_LAYERS, prompt_len);
+    for (auto& scores_per_layer : window_scores) {
+        fill_scores(scores_per_layer, 0, scores_per_layer.get_size(), 1.0);
+        for (size_t block_idx : {9, 20, 30}) {
+            fill_scores(scores_per_layer, DEFAULT_BLOCK_SIZE * block_idx, DEFAULT_BLOCK_SIZE * (block_idx + 1), 0.0);
+        }
+    }
+    algo.register_new_token_scores(window_scores);
+    auto evicted_blocks = algo.evict_logical_blocks();
+    for (const auto& evicted_blocks_for_this_layer : evicted_blocks) {
+        EXPECT_EQ(evicted_blocks_for_this_layer, std::set<size_t>({9, 20, 30}));
+    }
+
+    // no eviction during generation
+    auto generation_scores = get_mock_scores(DEFAULT_NUM_DECODER_LAYERS, eviction_config.get_max_cache_size() + 2 * DEFAULT_BLOCK_SIZE);
+    for (auto& scores_per_layer : generation_scores) {
+        fill_scores(scores_per_layer, 0, scores_per_layer.get_size(), 0.0);
+    }
+    algo.register_new_token_scores(generation_scores);
+    for (const auto& evicted_blocks_for_this_layer : algo.evict_logical_blocks()) {
+        EXPECT_TRUE(evicted_blocks_for_this_layer.empty());
+    }
+}
+
 struct NormalizationSettingTestStruct {
     ov::genai::AggregationMode normalization_mode;
     double token_score_power;
@@ -414,6 +495,13 @@ struct CacheEvictionAlgoInitParamsForTest {
 
 using CacheEvictionAlgoInitializationTest = ::testing::TestWithParam<CacheEvictionAlgoInitParamsForTest>;
 
+ov::genai::CacheEvictionConfig with_score_params(ov::genai::CacheEvictionConfig config, size_t score_aggregation_interval,
+                                                 std::vector<size_t> score_layers) {
+    config.score_aggregation_interval = score_aggregation_interval;
+    config.score_layers = std::move(score_layers);
+    return config;
+}
+
 const std::vector<CacheEvictionAlgoInitParamsForTest> INVALID_ALGO_INIT_PARAMS_CASES = {
         // area sizes not multiple of block size
         { {32, 32, 97, ov::genai::AggregationMode::SUM}, 16, 8},
@@ -422,6 +510,12 @@ const std::vector<CacheEvictionAlgoInitParamsForTest> INVALID_ALGO_INIT_PARAMS_C
 
         // zero decoder layers
         { {32, 64, 192, ov::genai::AggregationMode::SUM}, 32, 0},
+
+        // zero score aggregation interval
+        { with_score_params({32, 64, 192, ov::genai::AggregationMode::SUM}, 0, {}), 32, 4},
+
+        // score layer index out of range
+        { with_score_params({32, 64, 192, ov::genai::AggregationMode::SUM}, 1, {0, 4}), 32, 4},
 };
 TEST_P(CacheEvictionAlgoInitializationTest, ThrowsForInvalidConfigs) {
     auto params = GetParam();
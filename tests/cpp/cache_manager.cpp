@@ -3,6 +3,9 @@
 //
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <functional>
 #include "openvino/runtime/core.hpp"
 #include "scheduler.hpp"
 #include "cache_manager.hpp"
@@ -108,3 +111,78 @@ TEST(TestCacheManager, test_dynamic_cache_increase) {
     cache_manager->allocate_cache_if_needed(block_manager.get_total_number_of_kv_blocks());
     ASSERT_EQ(get_total_allocated_bytes(cache_manager), 200 * block_size_in_bytes);
 }
+
+
+TEST(TestCacheManager, test_dynamic_cache_increase_in_place) {
+    ov::Core core;
+    const size_t num_decoder_layers = 2;
+    const std::vector<KVHeadConfig> kv_cache_config(num_decoder_layers, KVHeadConfig { 12, 12, 64, 64 });
+
+    ov::InferRequest request = core.compile_model(get_dummy_model(core, num_decoder_layers)).create_infer_request();
+    auto cache_manager = std::make_shared<CacheManager>(request, kv_cache_config);
+    cache_manager->set_max_num_kv_blocks(300);
+    ASSERT_EQ(cache_manager->get_max_num_kv_blocks(), 300);
+
+    cache_manager->allocate_cache_if_needed(100);
+    ov::Tensor key_cache = cache_manager->get_key_cache(0);
+    const size_t key_cache_byte_size = key_cache.get_byte_size();
+    std::memset(key_cache.data(), 42, key_cache_byte_size);
+
+    // the cache grows without moving, so the contents are kept without copying
+    cache_manager->allocate_cache_if_needed(200);
+    ov::Tensor increased_key_cache = cache_manager->get_key_cache(0);
+    ASSERT_EQ(increased_key_cache.get_shape()[0], 200);
+    ASSERT_EQ(increased_key_cache.data(), key_cache.data());
+    const auto* data = static_cast<const uint8_t*>(increased_key_cache.data());
+    ASSERT_TRUE(std::all_of(data, data + key_cache_byte_size, [](uint8_t value) { return value == 42; }));
+
+    // the cache can't grow above the upper bound
+    EXPECT_THROW(cache_manager->allocate_cache_if_needed(301), ov::Exception);
+
+    ASSERT_TRUE(cache_manager->shrink_cache(50));
+    ov::Tensor decreased_key_cache = cache_manager->get_key_cache(0);
+    ASSERT_EQ(decreased_key_cache.get_shape()[0], 50);
+    ASSERT_EQ(decreased_key_cache.data(), key_cache.data());
+    ASSERT_EQ(get_total_allocated_bytes(cache_manager), 50 * cache_manager->get_block_size_in_bytes());
+    ASSERT_EQ(data[decreased_key_cache.get_byte_size() - 1], 42);
+}
+
+
+TEST(TestCacheManager, test_copy_blocks) {
+    ov::Core core;
+    const size_t num_decoder_layers = 3;
+    const std::vector<KVHeadConfig> kv_cache_config(num_decoder_layers, KVHeadConfig { 2, 2, 8, 8 });
+
+    ov::InferRequest request = core.compile_model(get_dummy_model(core, num_decoder_layers)).create_infer_request();
+    auto cache_manager = std::make_shared<CacheManager>(request, kv_cache_config);
+    const size_t num_kv_blocks = 6;
+    cache_manager->allocate_cache_if_needed(num_kv_blocks);
+
+    // each byte of a block keeps the block index, the layer index and whether the block is a key one
+    auto block_value = [](size_t block_id, size_t layer_id, bool is_key) {
+        return static_cast<uint8_t>(block_id * 16 + layer_id * 2 + is_key);
+    };
+    auto for_each_block = [&](const std::function<void(uint8_t*, size_t, size_t, size_t, bool)>& func) {
+        for (size_t layer_id = 0; layer_id < num_decoder_layers; ++layer_id) {
+            for (bool is_key : {true, false}) {
+                ov::Tensor cache = is_key ? cache_manager->get_key_cache(layer_id) : cache_manager->get_value_cache(layer_id);
+                const size_t block_byte_size = cache.get_byte_size() / num_kv_blocks;
+                for (size_t block_id = 0; block_id < num_kv_blocks; ++block_id) {
+                    func(static_cast<uint8_t*>(cache.data()) + block_id * block_byte_size, block_byte_size, block_id, layer_id, is_key);
+                }
+            }
+        }
+    };
+    for_each_block([&](uint8_t* block, size_t block_byte_size, size_t block_id, size_t layer_id, bool is_key) {
+        std::memset(block, block_value(block_id, layer_id, is_key), block_byte_size);
+    });
+
+    const std::map<size_t, size_t> dst_to_src_block_ids = {{2, 0}, {3, 0}, {5, 1}};
+    cache_manager->copy_blocks({{0, {2, 3}}, {1, {5}}});
+
+    for_each_block([&](uint8_t* block, size_t block_byte_size, size_t block_id, size_t layer_id, bool is_key) {
+        auto it = dst_to_src_block_ids.find(block_id);
+        const uint8_t expected = block_value(it == dst_to_src_block_ids.end() ? block_id : it->second, layer_id, is_key);
+        EXPECT_TRUE(std::all_of(block, block + block_byte_size, [&](uint8_t value) { return value == expected; }));
+    });
+}
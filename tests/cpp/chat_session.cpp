@@ -0,0 +1,176 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+#include "openvino/genai/chat_session.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+ChatSession create_session(const std::string& content, size_t kv_cache_len) {
+    ChatSession session;
+    session.history = {{{"role", "user"}, {"content", content}}, {{"role", "assistant"}, {"content", "Hi"}}};
+    session.templated_history = "<user>" + content + "<assistant>";
+    session.history_tokens = {1, 2, 3};
+    session.kv_cache_tokens = std::vector<int64_t>(kv_cache_len, 7);
+    session.num_kv_cache_tokens_to_trim = 1;
+    session.attention_mask = ov::Tensor(ov::element::i64, {1, kv_cache_len});
+    std::fill_n(session.attention_mask.data<int64_t>(), kv_cache_len, 1);
+    for (const std::string name : {"past_key_values.0.key", "past_key_values.0.value"}) {
+        ov::Tensor state(ov::element::f16, {1, 2, kv_cache_len, 4});
+        std::memset(state.data(), name.size(), state.get_byte_size());
+        session.states[name] = state;
+    }
+    return session;
+}
+
+std::filesystem::path get_test_dir(const std::string& name) {
+    std::filesystem::path dir = std::filesystem::temp_directory_path() / ("ov_genai_" + name);
+    std::filesystem::remove_all(dir);
+    return dir;
+}
+
+}  // namespace
+
+TEST(TestChatSession, save_and_load) {
+    std::filesystem::path dir = get_test_dir("chat_session");
+    std::filesystem::create_directories(dir);
+    ChatSession session = create_session("Hello", 5);
+    session.save(dir / "session.ovchat");
+
+    ChatSession loaded = ChatSession::load(dir / "session.ovchat");
+    EXPECT_EQ(loaded.history, session.history);
+    EXPECT_EQ(loaded.templated_history, session.templated_history);
+    EXPECT_EQ(loaded.history_tokens, session.history_tokens);
+    EXPECT_EQ(loaded.encoded_inputs, session.encoded_inputs);
+    EXPECT_EQ(loaded.kv_cache_tokens, session.kv_cache_tokens);
+    EXPECT_EQ(loaded.num_kv_cache_tokens_to_trim, session.num_kv_cache_tokens_to_trim);
+    EXPECT_EQ(loaded.get_byte_size(), session.get_byte_size());
+    ASSERT_EQ(loaded.states.size(), session.states.size());
+    for (const auto& [name, state] : session.states) {
+        const ov::Tensor& loaded_state = loaded.states.at(name);
+        EXPECT_EQ(loaded_state.get_element_type(), state.get_element_type());
+        EXPECT_EQ(loaded_state.get_shape(), state.get_shape());
+        EXPECT_EQ(std::memcmp(loaded_state.data(), state.data(), state.get_byte_size()), 0);
+    }
+    std::filesystem::remove_all(dir);
+}
+
+TEST(TestChatSession, load_rejects_corrupted_sizes) {
+    std::filesystem::path dir = get_test_dir("chat_session_corrupted");
+    std::filesystem::create_directories(dir);
+    const std::filesystem::path path = dir / "session.ovchat";
+    create_session("Hello", 5).save(path);
+
+    // truncated file
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+    EXPECT_THROW(ChatSession::load(path), ov::Exception);
+
+    // the number of messages is too large for the file, it's read after the magic string and the version
+    {
+        std::ofstream file(path, std::ios::binary);
+        const std::string magic = "OVGENAI_CHAT_SESSION";
+        const uint64_t magic_size = magic.size(), num_messages = uint64_t(1) << 60;
+        const uint32_t version = 1;
+        file.write(reinterpret_cast<const char*>(&magic_size), sizeof(magic_size));
+        file.write(magic.data(), magic.size());
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        file.write(reinterpret_cast<const char*>(&num_messages), sizeof(num_messages));
+    }
+    EXPECT_THROW(ChatSession::load(path), ov::Exception);
+    std::filesystem::remove_all(dir);
+}
+
+TEST(TestChatSessionCache, spills_least_recently_used_sessions) {
+    std::filesystem::path dir = get_test_dir("chat_session_cache");
+    const size_t session_size = create_session("", 8).get_byte_size();
+    {
+        ChatSessionCache cache(2 * session_size, dir);
+        cache.put("a", create_session("a", 8));
+        cache.put("b", create_session("b", 8));
+        cache.put("c", create_session("c", 8));
+        // "a" doesn't fit into the memory budget anymore
+        EXPECT_EQ(cache.get_memory_size(), 2 * session_size);
+        EXPECT_TRUE(cache.contains("a"));
+
+        auto session = cache.take("a");
+        ASSERT_TRUE(session.has_value());
+        EXPECT_EQ(session->history[0].at("content"), "a");
+        EXPECT_FALSE(cache.contains("a"));
+
+        cache.put("a", std::move(*session));
+        // "b" is the least recently used session now
+        EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator{}), 1);
+        cache.remove("b");
+        EXPECT_FALSE(cache.contains("b"));
+        EXPECT_TRUE(std::filesystem::is_empty(dir));
+    }
+    std::filesystem::remove_all(dir);
+}
+
+TEST(TestChatSessionCache, drops_sessions_without_spill_dir) {
+    const size_t session_size = create_session("", 8).get_byte_size();
+    ChatSessionCache cache(session_size);
+    cache.put("a", create_session("a", 8));
+    cache.put("b", create_session("b", 8));
+    EXPECT_FALSE(cache.contains("a"));
+    EXPECT_FALSE(cache.take("a").has_value());
+    EXPECT_TRUE(cache.contains("b"));
+    EXPECT_EQ(cache.get_memory_size(), session_size);
+}
+
+TEST(TestChatSessionCache, rejects_session_larger_than_budget_without_spill_dir) {
+    const size_t session_size = create_session("", 8).get_byte_size();
+    ChatSessionCache cache(2 * session_size);
+    cache.put("a", create_session("a", 8));
+    EXPECT_THROW(cache.put("a", create_session("a", 32)), ov::Exception);
+    // the previous session is kept
+    EXPECT_TRUE(cache.contains("a"));
+    EXPECT_EQ(cache.get_memory_size(), session_size);
+}
+
+TEST(TestChatSessionCache, spills_session_larger_than_budget) {
+    std::filesystem::path dir = get_test_dir("chat_session_cache_large");
+    const size_t session_size = create_session("", 8).get_byte_size();
+    {
+        ChatSessionCache cache(2 * session_size, dir);
+        cache.put("a", create_session("a", 8));
+        cache.put("b", create_session("b", 32));
+        // the small session stays in memory
+        EXPECT_EQ(cache.get_memory_size(), session_size);
+        EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator{}), 1);
+
+        auto session = cache.take("b");
+        ASSERT_TRUE(session.has_value());
+        EXPECT_EQ(session->kv_cache_tokens.size(), 32u);
+        EXPECT_TRUE(cache.contains("a"));
+    }
+    std::filesystem::remove_all(dir);
+}
+
+TEST(TestChatSessionCache, spills_sessions_with_long_ids) {
+    std::filesystem::path dir = get_test_dir("chat_session_cache_long_ids");
+    const size_t session_size = create_session("", 8).get_byte_size();
+    // hex encoded ids would exceed the file name limit of 255 bytes
+    const std::string long_id(300, 'a'), other_long_id = long_id + "b";
+    {
+        ChatSessionCache cache(session_size, dir);
+        cache.put(long_id, create_session("a", 8));
+        cache.put(other_long_id, create_session("b", 8));
+        cache.put("c", create_session("c", 8));
+        EXPECT_EQ(std::distance(std::filesystem::directory_iterator(dir), std::filesystem::directory_iterator{}), 2);
+
+        auto session = cache.take(long_id);
+        ASSERT_TRUE(session.has_value());
+        EXPECT_EQ(session->history[0].at("content"), "a");
+        session = cache.take(other_long_id);
+        ASSERT_TRUE(session.has_value());
+        EXPECT_EQ(session->history[0].at("content"), "b");
+        EXPECT_TRUE(std::filesystem::is_empty(dir));
+    }
+    std::filesystem::remove_all(dir);
+}
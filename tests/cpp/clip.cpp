@@ -0,0 +1,66 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include "visual_language/clip.hpp"
+
+namespace {
+
+clip_image_u8 create_image(int width, int height) {
+    clip_image_u8 image{width, height, std::vector<uint8_t>(3 * width * height)};
+    for (size_t i = 0; i < image.buf.size(); ++i) {
+        image.buf[i] = static_cast<uint8_t>((i * 37 + i / 7) % 256);
+    }
+    return image;
+}
+
+clip_ctx create_ctx() {
+    clip_ctx ctx;
+    const float mean[3] = {0.48145466f, 0.4578275f, 0.40821073f};
+    const float std[3] = {0.26862954f, 0.26130258f, 0.27577711f};
+    std::copy_n(mean, 3, ctx.image_mean);
+    std::copy_n(std, 3, ctx.image_std);
+    return ctx;
+}
+
+} // namespace
+
+TEST(TestClip, fused_resize_normalize_matches_separate_steps) {
+    clip_ctx ctx = create_ctx();
+    const clip_image_u8 image = create_image(57, 33);
+
+    // downscale, upscale and identity
+    for (auto [width, height] : std::vector<std::pair<int, int>>{{20, 14}, {100, 61}, {57, 33}}) {
+        clip_image_u8 resized;
+        bicubic_resize(image, resized, width, height);
+        const clip_image_f32 expected = clip_image_preprocess(ctx, resized);
+
+        std::vector<float> fused(3 * width * height);
+        bicubic_resize_normalize(ctx, image, width, height, clip_chw_dst(fused.data(), width, height));
+        EXPECT_EQ(fused, expected.buf);
+    }
+}
+
+TEST(TestClip, fused_resize_normalize_crops_region) {
+    clip_ctx ctx = create_ctx();
+    const clip_image_u8 image = create_image(40, 30);
+    const int width = 64, height = 48, x0 = 5, y0 = 7, crop_width = 32, crop_height = 24;
+
+    clip_image_u8 resized;
+    bicubic_resize(image, resized, width, height);
+    const clip_image_f32 expected = clip_image_preprocess(ctx, resized);
+
+    std::vector<float> cropped(3 * crop_width * crop_height);
+    bicubic_resize_normalize(ctx, image, width, height, x0, y0, crop_width, crop_height,
+                             clip_chw_dst(cropped.data(), crop_width, crop_height));
+
+    for (int c = 0; c < 3; ++c) {
+        for (int y = 0; y < crop_height; ++y) {
+            for (int x = 0; x < crop_width; ++x) {
+                EXPECT_EQ(cropped[(c * crop_height + y) * crop_width + x],
+                          expected.buf[(c * height + y0 + y) * width + x0 + x]);
+            }
+        }
+    }
+}
@@ -0,0 +1,320 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <thread>
+
+#include "continuous_batching_engine.hpp"
+#include "generation_stream.hpp"
+#include "speculative_decoding/continuous_batching_for_speculative_decoding_impl.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+// blocks a generation step until the test lets it go on
+class StepGate {
+public:
+    void wait() {
+        m_entered.set_value();
+        m_opened.get_future().wait();
+    }
+
+    void wait_entered() {
+        m_entered.get_future().wait();
+    }
+
+    void open() {
+        m_opened.set_value();
+    }
+
+private:
+    std::promise<void> m_entered, m_opened;
+};
+
+GenerationOutputs make_outputs(int64_t token_id) {
+    GenerationOutput output;
+    output.generated_ids = {token_id};
+    return {{0, output}};
+}
+
+} // namespace
+
+class ContinuousBatchingEngineTest : public testing::Test, public ContinuousBatchingPipeline {
+protected:
+    using Engine = ContinuousBatchingPipeline::ContinuousBatchingEngine;
+
+    class PipelineTestInstance : public ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl {
+    public:
+        GenerationHandle add_request(uint64_t request_id, const GenerationConfig& sampling_params) {
+            std::vector<int64_t> prompt{0, 1, 2, 3};
+            auto sequence_group = std::make_shared<SequenceGroup>(request_id, ov::Tensor(ov::element::i64, {prompt.size()}, prompt.data()),
+                                                                  sampling_params, 4);
+            std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+            m_awaiting_requests.push_back(sequence_group);
+            return std::make_shared<GenerationHandleImpl>(sequence_group->get_generation_stream(), sampling_params);
+        }
+
+        std::vector<uint64_t> pull_request_ids() {
+            {
+                std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+                _insert_awaiting_requests();
+            }
+            std::vector<uint64_t> request_ids;
+            for (const auto& request : m_requests) {
+                request_ids.push_back(request->get_request_id());
+            }
+            return request_ids;
+        }
+    };
+
+    static GenerationHandle add_nothing() {
+        return nullptr;
+    }
+};
+
+TEST_F(ContinuousBatchingEngineTest, rejects_requests_over_waiting_limit) {
+    size_t num_waiting_requests = 1;
+    // steps are not performed, so admitted requests keep waiting
+    Engine engine([] {}, [] { return false; }, [&] { return num_waiting_requests; }, [] {}, 3);
+
+    engine.add_request(add_nothing);
+    engine.add_request(add_nothing);
+    EXPECT_THROW(engine.add_request(add_nothing), ov::Exception);
+
+    engine.stop();
+    EXPECT_THROW(engine.add_request(add_nothing), ov::Exception);
+}
+
+TEST_F(ContinuousBatchingEngineTest, failed_request_is_not_counted_as_waiting) {
+    Engine engine([] {}, [] { return false; }, [] { return size_t(0); }, [] {}, 1);
+
+    EXPECT_THROW(engine.add_request([]() -> GenerationHandle { throw std::runtime_error("invalid request"); }), std::runtime_error);
+    engine.add_request(add_nothing);
+    EXPECT_THROW(engine.add_request(add_nothing), ov::Exception);
+}
+
+TEST_F(ContinuousBatchingEngineTest, concurrent_requests_are_admitted_up_to_limit) {
+    const size_t max_waiting_requests = 8;
+    Engine engine([] {}, [] { return false; }, [] { return size_t(0); }, [] {}, max_waiting_requests);
+
+    std::atomic<size_t> num_admitted_requests = 0;
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4 * max_waiting_requests; ++i) {
+        threads.emplace_back([&] {
+            try {
+                engine.add_request(add_nothing);
+                ++num_admitted_requests;
+            } catch (const ov::Exception&) {
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(num_admitted_requests, max_waiting_requests);
+}
+
+TEST_F(ContinuousBatchingEngineTest, requests_are_counted_as_waiting_until_step_is_done) {
+    StepGate gate;
+    std::atomic<bool> has_requests = false;
+    // the step pulls requests, but the pipeline doesn't count them as waiting until the step is done
+    Engine engine([&] { gate.wait(); has_requests = false; }, [&] { return has_requests.load(); }, [] { return size_t(0); }, [] {}, 2);
+
+    engine.add_request([&] { has_requests = true; return add_nothing(); });
+    gate.wait_entered();
+    engine.add_request(add_nothing);
+    EXPECT_THROW(engine.add_request(add_nothing), ov::Exception);
+
+    gate.open();
+    engine.stop();
+}
+
+TEST_F(ContinuousBatchingEngineTest, requests_added_during_step_are_pulled_by_priority) {
+    PipelineTestInstance pipeline;
+    StepGate gate;
+    std::vector<uint64_t> request_ids;
+    std::atomic<bool> has_requests = false;
+    Engine engine([&] { gate.wait(); request_ids = pipeline.pull_request_ids(); has_requests = false; },
+                  [&] { return has_requests.load(); },
+                  [] { return size_t(0); },
+                  [] {});
+
+    GenerationConfig normal_config = greedy(), high_priority_config = greedy(), deadline_config = greedy();
+    high_priority_config.priority = RequestPriority::HIGH;
+    deadline_config.deadline_ms = 1000;
+
+    std::vector<GenerationHandle> handles;
+    handles.push_back(engine.add_request([&] { has_requests = true; return pipeline.add_request(0, normal_config); }));
+    gate.wait_entered();
+    handles.push_back(engine.add_request([&] { return pipeline.add_request(1, normal_config); }));
+    handles.push_back(engine.add_request([&] { return pipeline.add_request(2, deadline_config); }));
+    handles.push_back(engine.add_request([&] { return pipeline.add_request(3, high_priority_config); }));
+
+    gate.open();
+    engine.stop();
+    EXPECT_EQ(request_ids, std::vector<uint64_t>({3, 2, 0, 1}));
+}
+
+TEST_F(ContinuousBatchingEngineTest, step_exception_is_rethrown) {
+    std::promise<void> step_started;
+    std::atomic<bool> has_requests = false;
+    Engine engine([&] { step_started.set_value(); throw std::runtime_error("step failed"); },
+                  [&] { return has_requests.load(); },
+                  [] { return size_t(0); },
+                  [] {});
+
+    engine.add_request([&] { has_requests = true; return add_nothing(); });
+    step_started.get_future().wait();
+    EXPECT_THROW(engine.stop(), std::runtime_error);
+}
+
+TEST_F(ContinuousBatchingEngineTest, failed_step_drops_requests_and_wakes_readers_up) {
+    PipelineTestInstance pipeline;
+    StepGate gate;
+    std::atomic<bool> has_requests = false;
+    Engine engine([&] { gate.wait(); throw std::runtime_error("step failed"); },
+                  [&] { return has_requests.load(); },
+                  [] { return size_t(0); },
+                  [&] { pipeline.drop_requests(); });
+
+    GenerationHandle handle = engine.add_request([&] { has_requests = true; return pipeline.add_request(0, greedy()); });
+    auto outputs = std::async(std::launch::async, [&] { return handle->read(); });
+    gate.wait_entered();
+    gate.open();
+
+    ASSERT_EQ(outputs.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_TRUE(outputs.get().empty());
+    EXPECT_EQ(handle->get_status(), GenerationStatus::IGNORED);
+    EXPECT_TRUE(pipeline.pull_request_ids().empty());
+    EXPECT_THROW(engine.add_request([&] { return pipeline.add_request(1, greedy()); }), std::runtime_error);
+    EXPECT_THROW(engine.stop(), std::runtime_error);
+}
+
+TEST(TestGenerationStream, callback_gets_pushed_outputs_in_order) {
+    auto stream = GenerationStream::create();
+    stream->push(make_outputs(1));
+    stream->push(make_outputs(2));
+
+    std::vector<std::pair<int64_t, GenerationStatus>> outputs;
+    stream->set_output_callback([&](GenerationOutputs generation_outputs, GenerationStatus status) {
+        outputs.emplace_back(generation_outputs.at(0).generated_ids.at(0), status);
+    });
+    stream->push(make_outputs(3));
+    stream->set_generation_status(GenerationStatus::FINISHED);
+    stream->push(make_outputs(4));
+
+    using Outputs = std::vector<std::pair<int64_t, GenerationStatus>>;
+    EXPECT_EQ(outputs, Outputs({{1, GenerationStatus::RUNNING},
+                                {2, GenerationStatus::RUNNING},
+                                {3, GenerationStatus::RUNNING},
+                                {4, GenerationStatus::FINISHED}}));
+}
+
+TEST(TestGenerationStream, callback_set_after_generation_gets_final_status) {
+    // the last outputs are still in the queue
+    auto stream = GenerationStream::create();
+    stream->push(make_outputs(1));
+    stream->set_generation_status(GenerationStatus::FINISHED);
+    stream->push(make_outputs(2));
+
+    std::vector<GenerationStatus> statuses;
+    stream->set_output_callback([&](GenerationOutputs, GenerationStatus status) {
+        statuses.push_back(status);
+    });
+    EXPECT_EQ(statuses, std::vector<GenerationStatus>({GenerationStatus::RUNNING, GenerationStatus::FINISHED}));
+
+    // the outputs have been read already
+    stream = GenerationStream::create();
+    stream->set_generation_status(GenerationStatus::FINISHED);
+    stream->push(make_outputs(1));
+    stream->read();
+
+    std::vector<std::pair<GenerationOutputs, GenerationStatus>> outputs;
+    stream->set_output_callback([&](GenerationOutputs generation_outputs, GenerationStatus status) {
+        outputs.emplace_back(std::move(generation_outputs), status);
+    });
+    ASSERT_EQ(outputs.size(), 1u);
+    EXPECT_TRUE(outputs[0].first.empty());
+    EXPECT_EQ(outputs[0].second, GenerationStatus::FINISHED);
+
+    // the generation is not finished yet, so the final status comes with the last outputs
+    stream = GenerationStream::create();
+    stream->push(make_outputs(1));
+    stream->read();
+    outputs.clear();
+    stream->set_output_callback([&](GenerationOutputs generation_outputs, GenerationStatus status) {
+        outputs.emplace_back(std::move(generation_outputs), status);
+    });
+    EXPECT_TRUE(outputs.empty());
+}
+
+TEST(TestGenerationStream, callback_may_use_stream) {
+    auto stream = GenerationStream::create();
+    std::vector<int64_t> token_ids;
+    stream->set_output_callback([&](GenerationOutputs generation_outputs, GenerationStatus) {
+        token_ids.push_back(generation_outputs.at(0).generated_ids.at(0));
+        EXPECT_TRUE(stream->has_output_callback());
+        // outputs pushed by the callback are passed after the current ones
+        if (token_ids.size() == 1) {
+            stream->push(make_outputs(2));
+            EXPECT_EQ(token_ids.size(), 1u);
+        }
+    });
+    stream->push(make_outputs(1));
+    EXPECT_EQ(token_ids, std::vector<int64_t>({1, 2}));
+}
+
+TEST(TestGenerationStream, callback_is_not_called_concurrently) {
+    auto stream = GenerationStream::create();
+    std::atomic<size_t> num_active_calls = 0, num_calls = 0;
+    bool is_called_concurrently = false;
+    stream->set_output_callback([&](GenerationOutputs, GenerationStatus) {
+        if (++num_active_calls > 1) {
+            is_called_concurrently = true;
+        }
+        std::this_thread::yield();
+        ++num_calls;
+        --num_active_calls;
+    });
+
+    std::vector<std::thread> threads;
+    for (int64_t i = 0; i < 4; ++i) {
+        threads.emplace_back([&stream, i] {
+            for (int64_t token_id = 0; token_id < 100; ++token_id) {
+                stream->push(make_outputs(i * 100 + token_id));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(is_called_concurrently);
+    EXPECT_EQ(num_calls, 400u);
+}
+
+TEST(TestGenerationStream, abort_passes_final_status_once) {
+    auto stream = GenerationStream::create();
+    std::vector<std::pair<size_t, GenerationStatus>> outputs;
+    stream->set_output_callback([&](GenerationOutputs generation_outputs, GenerationStatus status) {
+        outputs.emplace_back(generation_outputs.size(), status);
+    });
+    stream->push(make_outputs(1));
+    stream->abort();
+    stream->abort();
+
+    using Outputs = std::vector<std::pair<size_t, GenerationStatus>>;
+    EXPECT_EQ(outputs, Outputs({{1, GenerationStatus::RUNNING}, {0, GenerationStatus::IGNORED}}));
+
+    // the last outputs have been pushed already
+    stream = GenerationStream::create();
+    stream->set_generation_status(GenerationStatus::FINISHED);
+    stream->push(make_outputs(1));
+    stream->abort();
+    EXPECT_EQ(stream->get_status(), GenerationStatus::FINISHED);
+    stream->read();
+    EXPECT_FALSE(stream->can_read());
+}
@@ -0,0 +1,166 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include "lm_encoding.hpp"
+#include "openvino/op/assign.hpp"
+#include "openvino/op/broadcast.hpp"
+#include "openvino/op/concat.hpp"
+#include "openvino/op/constant.hpp"
+#include "openvino/op/convert.hpp"
+#include "openvino/op/floor_mod.hpp"
+#include "openvino/op/gather.hpp"
+#include "openvino/op/one_hot.hpp"
+#include "openvino/op/parameter.hpp"
+#include "openvino/op/read_value.hpp"
+#include "openvino/op/reduce_sum.hpp"
+#include "openvino/op/result.hpp"
+#include "openvino/op/shape_of.hpp"
+#include "openvino/op/unsqueeze.hpp"
+#include "openvino/op/util/variable.hpp"
+#include "utils.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+constexpr int64_t VOCAB_SIZE = 97;
+
+// Stateful model whose state keeps all processed tokens and which predicts a sum of them modulo vocabulary size,
+// so each generated token depends on the whole prompt
+ov::InferRequest create_dummy_stateful_model() {
+    auto input_ids = std::make_shared<ov::op::v0::Parameter>(ov::element::i64, ov::PartialShape{-1, -1});
+    auto attention_mask = std::make_shared<ov::op::v0::Parameter>(ov::element::i64, ov::PartialShape{-1, -1});
+    auto position_ids = std::make_shared<ov::op::v0::Parameter>(ov::element::i64, ov::PartialShape{-1, -1});
+    auto beam_idx = std::make_shared<ov::op::v0::Parameter>(ov::element::i32, ov::PartialShape{-1});
+    input_ids->get_output_tensor(0).set_names({"input_ids"});
+    attention_mask->get_output_tensor(0).set_names({"attention_mask"});
+    position_ids->get_output_tensor(0).set_names({"position_ids"});
+    beam_idx->get_output_tensor(0).set_names({"beam_idx"});
+
+    auto tokens = std::make_shared<ov::op::v0::Convert>(input_ids, ov::element::f32);
+    // the state is empty initially: [batch_size, 0]
+    auto batch_size = std::make_shared<ov::op::v8::Gather>(std::make_shared<ov::op::v3::ShapeOf>(input_ids),
+                                                           ov::op::v0::Constant::create(ov::element::i64, {1}, {0}),
+                                                           ov::op::v0::Constant::create(ov::element::i64, {}, {0}));
+    auto init_shape = std::make_shared<ov::op::v0::Concat>(
+        ov::OutputVector{batch_size, ov::op::v0::Constant::create(ov::element::i64, {1}, {0})}, 0);
+    auto init_value = std::make_shared<ov::op::v3::Broadcast>(ov::op::v0::Constant::create(ov::element::f32, {}, {0.0f}), init_shape);
+
+    auto variable = std::make_shared<ov::op::util::Variable>(
+        ov::op::util::VariableInfo{ov::PartialShape{-1, -1}, ov::element::f32, "past_tokens"});
+    auto past_tokens = std::make_shared<ov::op::v6::ReadValue>(init_value, variable);
+    auto reordered_past_tokens = std::make_shared<ov::op::v8::Gather>(past_tokens, beam_idx,
+                                                                      ov::op::v0::Constant::create(ov::element::i64, {}, {0}));
+    auto all_tokens = std::make_shared<ov::op::v0::Concat>(ov::OutputVector{reordered_past_tokens, tokens}, 1);
+    auto assign = std::make_shared<ov::op::v6::Assign>(all_tokens, variable);
+
+    auto sum = std::make_shared<ov::op::v1::ReduceSum>(all_tokens, ov::op::v0::Constant::create(ov::element::i64, {1}, {1}));
+    auto next_token = std::make_shared<ov::op::v1::FloorMod>(std::make_shared<ov::op::v0::Convert>(sum, ov::element::i64),
+                                                             ov::op::v0::Constant::create(ov::element::i64, {}, {VOCAB_SIZE}));
+    auto one_hot = std::make_shared<ov::op::v1::OneHot>(next_token,
+                                                        ov::op::v0::Constant::create(ov::element::i64, {}, {VOCAB_SIZE}),
+                                                        ov::op::v0::Constant::create(ov::element::f32, {}, {1.0f}),
+                                                        ov::op::v0::Constant::create(ov::element::f32, {}, {0.0f}),
+                                                        -1);
+    auto logits = std::make_shared<ov::op::v0::Unsqueeze>(one_hot, ov::op::v0::Constant::create(ov::element::i64, {1}, {1}));
+    auto result = std::make_shared<ov::op::v0::Result>(logits);
+    result->get_output_tensor(0).set_names({"logits"});
+
+    auto model = std::make_shared<ov::Model>(ov::ResultVector{result}, ov::SinkVector{assign},
+                                             ov::ParameterVector{input_ids, attention_mask, position_ids, beam_idx});
+    return utils::singleton_core().compile_model(model, "CPU").create_infer_request();
+}
+
+size_t get_kv_cache_length(ov::InferRequest& request) {
+    return request.query_state().at(0).get_state().get_shape().at(1);
+}
+
+class PrefillStatusStreamer : public StreamerBase {
+public:
+    PrefillStatusStreamer(size_t num_running_chunks, StreamingStatus status) :
+        m_num_running_chunks(num_running_chunks), m_status(status) {}
+
+    StreamingStatus get_status() override {
+        return m_num_calls++ < m_num_running_chunks ? StreamingStatus::RUNNING : m_status;
+    }
+
+    StreamingStatus write(int64_t token) override {
+        m_tokens.push_back(token);
+        return StreamingStatus::RUNNING;
+    }
+
+    void end() override {}
+
+    const std::vector<int64_t>& get_tokens() const {
+        return m_tokens;
+    }
+
+private:
+    size_t m_num_running_chunks;
+    StreamingStatus m_status;
+    size_t m_num_calls = 0;
+    std::vector<int64_t> m_tokens;
+};
+
+utils::GenerationFinishInfo generate(ov::InferRequest& request, const std::vector<int64_t>& prompt, size_t prefill_chunk_size,
+                                     KVCacheState& kv_cache_state, const std::shared_ptr<StreamerBase>& streamer = nullptr) {
+    GenerationConfig config = greedy();
+    config.max_new_tokens = 5;
+    config.set_eos_token_id(VOCAB_SIZE + 1);
+
+    ov::Tensor input_ids(ov::element::i64, {1, prompt.size()});
+    std::copy(prompt.begin(), prompt.end(), input_ids.data<int64_t>());
+    ov::Tensor attention_mask(ov::element::i64, {1, prompt.size()});
+    std::fill_n(attention_mask.data<int64_t>(), prompt.size(), 1);
+    ov::Tensor position_ids(ov::element::i64, {1, prompt.size()});
+    utils::initialize_position_ids(position_ids, attention_mask);
+
+    Sampler sampler;
+    std::vector<SequenceGroup::Ptr> requests{std::make_shared<SequenceGroup>(0, prompt, config, 1)};
+    request.reset_state();
+    kv_cache_state.reset_state();
+    return get_lm_encoded_results(request, input_ids, attention_mask, streamer, sampler, requests, position_ids,
+                                  kv_cache_state, std::nullopt, std::nullopt, prefill_chunk_size);
+}
+
+}  // namespace
+
+TEST(TestPrefillChunking, chunked_prompt_gives_same_tokens) {
+    ov::InferRequest request = create_dummy_stateful_model();
+    const std::vector<int64_t> prompt{5, 17, 3, 42, 8, 11, 90, 23, 1, 64, 7};
+
+    KVCacheState kv_cache_state;
+    const auto expected = generate(request, prompt, 0, kv_cache_state);
+    ASSERT_EQ(expected.results.tokens.size(), 1u);
+    ASSERT_EQ(expected.results.tokens[0].size(), 5u);
+
+    // chunks of the same size, a shorter last chunk and a chunk larger than the prompt
+    for (size_t prefill_chunk_size : {1, 4, 11, 32}) {
+        const auto actual = generate(request, prompt, prefill_chunk_size, kv_cache_state);
+        EXPECT_EQ(actual.results.tokens, expected.results.tokens) << "prefill_chunk_size: " << prefill_chunk_size;
+    }
+}
+
+TEST(TestPrefillChunking, interrupted_prefill_keeps_kv_cache_state_consistent) {
+    ov::InferRequest request = create_dummy_stateful_model();
+    const std::vector<int64_t> prompt{5, 17, 3, 42, 8, 11, 90, 23, 1, 64, 7};
+
+    for (StreamingStatus status : {StreamingStatus::STOP, StreamingStatus::CANCEL}) {
+        // two chunks are processed, the status is checked before the second and the third ones
+        auto streamer = std::make_shared<PrefillStatusStreamer>(1, status);
+        KVCacheState kv_cache_state;
+        const auto finish_info = generate(request, prompt, 4, kv_cache_state, streamer);
+
+        ASSERT_EQ(finish_info.results.tokens.size(), 1u);
+        EXPECT_TRUE(finish_info.results.tokens[0].empty());
+        EXPECT_TRUE(streamer->get_tokens().empty());
+        EXPECT_EQ(finish_info.streaming_finish_status,
+                  status == StreamingStatus::STOP ? GenerationStatus::STOP : GenerationStatus::CANCEL);
+
+        EXPECT_EQ(kv_cache_state.get_state(), std::vector<int64_t>(prompt.begin(), prompt.begin() + 8));
+        EXPECT_EQ(get_kv_cache_length(request), kv_cache_state.get_state().size());
+    }
+}
@@ -303,6 +303,36 @@ TEST(PresencePenaltyTransformInitializationTest, ThrowsForInvalidInputIds) {
     EXPECT_THROW(transform.apply(logits, {0, -1}), ov::Exception);
 }
 
+TEST(PenaltyTransformTest, CombinedPenaltiesEqualToSequentialOnes) {
+    float input[]{ 1.0f, -2.0f, 0.3f, 4.0f };
+    float expected[]{ 1.0f, -2.0f, 0.3f, 4.0f };
+    const TokenIds prompt_ids{ 0, 3 };
+    const TokenIds generated_ids{ 3, 2, 2, 1 };
+
+    Logits expected_logits(expected, 4);
+    auto repetition = RepetitionPenaltyTransform(1.5);
+    repetition.set_prompt_token_ids(std::make_shared<const TokenIds>(prompt_ids));
+    repetition.apply(expected_logits, generated_ids);
+    // presence penalty changes sign of logit of token 2, so frequency penalty increases it
+    PresencePenaltyTransform(0.5).apply(expected_logits, generated_ids);
+    FrequencyPenaltyTransform(0.1).apply(expected_logits, generated_ids);
+
+    Logits logits(input, 4);
+    auto counts = std::make_shared<TokenCounts>();
+    auto transform = PenaltyTransform(1.5f, 0.5f, 0.1f);
+    transform.set_prompt_token_ids(std::make_shared<const TokenIds>(prompt_ids));
+    transform.set_generated_token_counts(counts);
+    // token which was generated and removed afterwards is not penalized
+    counts->add(0);
+    counts->remove(0);
+    transform.apply(logits, generated_ids);
+    for (size_t i = 0; i < logits.m_size; i++) {
+        EXPECT_NEAR(logits.m_data[i], expected_logits.m_data[i], 1e-6);
+    }
+    EXPECT_EQ(counts->count(2), 2);
+    EXPECT_EQ(counts->get_token_ids().size(), 3);
+}
+
 struct EOSPenaltyTransformTestStruct {
     static inline const size_t size = 3;
 
@@ -0,0 +1,73 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include "prompt_lookup/ngram_index.hpp"
+
+using namespace ov::genai;
+
+using Continuations = std::vector<std::vector<int64_t>>;
+
+TEST(TestNgramIndex, finds_continuations_of_longest_ngram_first) {
+    NgramIndex index(3);
+    const std::vector<int64_t> tokens{1, 2, 3, 4, 1, 2, 5, 1, 2, 5, 1, 2};
+    index.add_tokens(tokens.begin(), tokens.end());
+
+    Continuations continuations;
+    index.find_continuations(index.get_tokens(), 3, 3, 1, continuations);
+    EXPECT_EQ(continuations, Continuations({{5, 1, 2}}));
+
+    // [1, 2] is followed by 5 twice and by 3 once
+    continuations.clear();
+    index.find_continuations(index.get_tokens(), 2, 3, 3, continuations);
+    EXPECT_EQ(continuations, Continuations({{5, 1, 2}, {3, 4, 1}}));
+}
+
+TEST(TestNgramIndex, is_updated_incrementally) {
+    NgramIndex index(2);
+    const std::vector<int64_t> tokens{7, 8, 9, 7, 8};
+    index.add_tokens(tokens.begin(), tokens.end());
+
+    Continuations continuations;
+    index.find_continuations(index.get_tokens(), 2, 4, 1, continuations);
+    EXPECT_EQ(continuations, Continuations({{9, 7, 8}}));
+
+    index.add_token(6);
+    continuations.clear();
+    index.find_continuations(index.get_tokens(), 2, 4, 1, continuations);
+    EXPECT_TRUE(continuations.empty());
+}
+
+TEST(TestRecentOutputsIndex, drops_oldest_outputs) {
+    // each output is a separate document, so continuations don't run into the next output
+    RecentOutputsIndex index(2, 8);
+    index.add_output({7, 8, 9});
+    index.add_output({7, 8, 6});
+    index.add_output({1, 7, 8, 9, 9});
+
+    Continuations continuations;
+    index.find_continuations({0, 7, 8}, 3, 4, 3, continuations);
+    EXPECT_EQ(continuations, Continuations({{9, 9}, {6}}));
+}
+
+TEST(TestNgramIndex, ranks_continuations_on_update) {
+    NgramIndex index(1);
+    // [1] is followed by more distinct tokens than are ranked, later 20 and 30 overtake the earlier ones
+    std::vector<int64_t> tokens;
+    for (int64_t token_id = 10; token_id < 10 + 2 * static_cast<int64_t>(NgramIndex::MAX_RANKED_CONTINUATIONS); ++token_id) {
+        tokens.insert(tokens.end(), {1, token_id});
+    }
+    tokens.insert(tokens.end(), {1, 30, 1, 20, 1, 30, 1, 20, 1, 11});
+    index.add_tokens(tokens.begin(), tokens.end());
+
+    Continuations continuations;
+    index.find_continuations({1}, 1, 1, 4, continuations);
+    // 20 occurs 3 times, 11 and 30 occur twice, but 11 occurs first
+    EXPECT_EQ(continuations, Continuations({{20}, {11}, {30}, {10}}));
+
+    // all ranked continuations are found
+    continuations.clear();
+    index.find_continuations({1}, 1, 1, 2 * NgramIndex::MAX_RANKED_CONTINUATIONS, continuations);
+    EXPECT_EQ(continuations.size(), NgramIndex::MAX_RANKED_CONTINUATIONS);
+}
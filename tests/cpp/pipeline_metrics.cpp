@@ -0,0 +1,68 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "pipeline_metrics_collector.hpp"
+
+using namespace ov::genai;
+
+TEST(TestPipelineMetrics, histogram_buckets) {
+    AtomicHistogram histogram({1, 10, 100});
+    for (double value : {0.5, 1.0, 5.0, 50.0, 500.0, 1000.0})
+        histogram.observe(value);
+
+    MetricsHistogram snapshot = histogram.get();
+    EXPECT_EQ(snapshot.bounds, std::vector<double>({1, 10, 100}));
+    // upper bounds are inclusive, values greater than the last bound go to the extra bucket
+    EXPECT_EQ(snapshot.counts, std::vector<size_t>({2, 1, 1, 2}));
+    EXPECT_EQ(snapshot.count, 6);
+    EXPECT_DOUBLE_EQ(snapshot.sum, 1556.5);
+}
+
+TEST(TestPipelineMetrics, metrics_can_be_read_during_updates) {
+    PipelineMetricsCollector collector;
+    const size_t num_steps = 10000;
+
+    std::thread step_thread([&] {
+        for (size_t step = 1; step <= num_steps; ++step) {
+            PipelineMetricsCollector::add(collector.generated_tokens, 2);
+            collector.tokens_per_step.observe(step % 16);
+        }
+    });
+    size_t prev_generated_tokens = 0;
+    for (size_t poll = 0; poll < 100; ++poll) {
+        PipelineMetrics metrics = collector.get();
+        EXPECT_GE(metrics.generated_tokens, prev_generated_tokens);
+        EXPECT_EQ(metrics.tokens_per_step.counts.size(), metrics.tokens_per_step.bounds.size() + 1);
+        prev_generated_tokens = metrics.generated_tokens;
+    }
+    step_thread.join();
+
+    PipelineMetrics metrics = collector.get();
+    EXPECT_EQ(metrics.generated_tokens, 2 * num_steps);
+    EXPECT_EQ(metrics.tokens_per_step.count, num_steps);
+}
+
+TEST(TestPipelineMetrics, prometheus_format) {
+    PipelineMetrics metrics;
+    metrics.running_requests = 3;
+    metrics.num_preemptions = 5;
+    metrics.num_partial_preemptions = 2;
+    metrics.step_duration.bounds = {10, 100};
+    metrics.step_duration.counts = {1, 2, 1};
+    metrics.step_duration.sum = 500;
+    metrics.step_duration.count = 4;
+
+    const std::string text = metrics.to_prometheus("test");
+    EXPECT_NE(text.find("# TYPE test_running_requests gauge\ntest_running_requests 3\n"), std::string::npos);
+    EXPECT_NE(text.find("test_preemptions_total{kind=\"full\"} 3\n"), std::string::npos);
+    EXPECT_NE(text.find("test_preemptions_total{kind=\"partial\"} 2\n"), std::string::npos);
+    // milliseconds are converted to seconds and buckets are cumulative
+    EXPECT_NE(text.find("test_step_duration_seconds_bucket{le=\"0.01\"} 1\n"
+                        "test_step_duration_seconds_bucket{le=\"0.1\"} 3\n"
+                        "test_step_duration_seconds_bucket{le=\"+Inf\"} 4\n"
+                        "test_step_duration_seconds_sum 0.5\n"
+                        "test_step_duration_seconds_count 4\n"), std::string::npos);
+}
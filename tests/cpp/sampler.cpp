@@ -71,7 +71,7 @@ TEST(SamplerValidationMode, gen_phase_to_cut_whole_seq) {
     Sampler sampler;
     sampler.sample(sequence_groups, gen_input_ids, true);
 
-    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids(),
+    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids().to_vector(),
              expected{0, 1};
     ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
 }
@@ -116,7 +116,7 @@ TEST(SamplerValidationMode, gen_phase_to_cut_part_seq) {
     Sampler sampler;
     sampler.sample(sequence_groups, gen_input_ids, true);
 
-    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids(),
+    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids().to_vector(),
              expected{0, 1, 2, 3};
     ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
 }
@@ -160,11 +160,64 @@ TEST(SamplerValidationMode, gen_phase) {
     Sampler sampler;
     sampler.sample(sequence_groups, gen_input_ids, true);
 
-    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids(),
+    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids().to_vector(),
              expected{0, 1, 2, 3, 4};
     ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
 }
 
+TEST(SamplerValidationMode, gen_phase_keeps_longest_branch) {
+    auto sampling_config = ov::genai::greedy();
+    // create sequence group with prompt [0, 1, 2, 3, 4]
+    std::vector<int64_t> input_vector{0, 1, 2, 3, 4};
+    ov::Tensor input_tensor(ov::element::i64, ov::Shape{1, 5}, input_vector.data());
+    std::vector<SequenceGroup::Ptr> sequence_groups{
+        SequenceGroup::Ptr(new SequenceGroup(0, input_tensor, sampling_config, 32)),
+    };
+
+    // to emulate processed prompt and add next token [ 0 ]
+    auto sequence = sequence_groups.front()->get_sequences().front();
+    sequence->append_token(0, 1.f);
+    sequence_groups.front()->update_processed_tokens_num(5);
+
+    // append candidates [ 2, 3, 4 ] to the first branch and [ 1, 2, 2 ] to the second one
+    auto branch = sequence_groups.front()->fork_branch(sequence);
+    size_t num_validated_tokens = 3;
+    for (size_t i = 1; i <= num_validated_tokens; ++i) {
+        sequence->append_token(i + 1, 1.f);
+        branch->append_token(i == num_validated_tokens ? i - 1 : i, 1.f);
+    }
+
+    sequence_groups.front()->set_num_validated_tokens(num_validated_tokens);
+    const auto num_scheduled_tokens = sequence_groups.front()->get_num_available_tokens_for_batching();
+    ASSERT_EQ(num_scheduled_tokens, num_validated_tokens + 1);
+    sequence_groups.front()->schedule_tokens(num_scheduled_tokens);
+
+    // create ref tensor : to generate candidates + next token for both branches
+    std::vector<float> logits = {
+        0, 1.f, 0, 0, 0,
+        0, 0, 1.f, 0, 0,
+        0, 0, 0, 1.f, 0,
+        0, 0, 0, 0, 1.f,
+        0, 1.f, 0, 0, 0,
+        0, 0, 1.f, 0, 0,
+        0, 0, 0, 1.f, 0,
+        0, 0, 0, 0, 1.f,
+    };
+
+    // shape 2 branches * 4 tokens + 1 batch + 5 vocab
+    ov::Tensor gen_input_ids(ov::element::f32, ov::Shape{8, 1, 5}, logits.data());
+
+    Sampler sampler;
+    auto sampler_output = sampler.sample(sequence_groups, gen_input_ids, true);
+
+    // generated sequences [0, 1] and [0, 1, 2, 3], the second one is kept
+    std::vector<uint64_t> expected_dropped{sequence->get_id()};
+    ASSERT_EQ(sampler_output.m_dropped_sequences, expected_dropped);
+    ASSERT_EQ(sequence_groups.front()->get_sequences().size(), 1);
+    TokenIds expected{0, 1, 2, 3};
+    ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
+}
+
 TEST(SamplerValidationMode, prompt_phase_to_cut_part_seq) {
     auto sampling_config = ov::genai::greedy();
     // create sequence group with prompt [0, 1, 2, 3, 4]
@@ -206,7 +259,7 @@ TEST(SamplerValidationMode, prompt_phase_to_cut_part_seq) {
     Sampler sampler;
     sampler.sample(sequence_groups, gen_input_ids, true);
 
-    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids(),
+    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids().to_vector(),
              expected{0, 1, 2};
     ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
 }
@@ -251,7 +304,7 @@ TEST(SamplerValidationMode, prompt_phase_to_cut_whole_seq) {
     Sampler sampler;
     sampler.sample(sequence_groups, gen_input_ids, true);
 
-    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids(),
+    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids().to_vector(),
              expected{0};
     ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
 }
@@ -296,7 +349,7 @@ TEST(SamplerValidationMode, prompt_phase) {
     Sampler sampler;
     sampler.sample(sequence_groups, gen_input_ids, true);
 
-    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids(),
+    TokenIds actual = sequence_groups.front()->get_sequences().front()->get_generated_ids().to_vector(),
              expected{0, 1, 2, 3};
     ASSERT_EQ(sequence_groups.front()->get_sequences().front()->get_generated_ids(), expected);
 }
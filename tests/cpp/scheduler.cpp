@@ -1011,3 +1011,103 @@ TEST(TestScheduler, FullyPreemptsCacheEvictedSequences) {
         }
     }
 }
+
+TEST(TestScheduler, ReservesTokensForHighPriorityRequests) {
+    SchedulerConfig scheduler_config;
+    scheduler_config.max_num_batched_tokens = 32;
+    scheduler_config.num_kv_blocks = 20;
+    scheduler_config.dynamic_split_fuse = true;
+    scheduler_config.max_num_seqs = 5;
+    scheduler_config.high_priority_tokens_share = 0.5;
+
+    std::vector<uint64_t> long_prompt(32, 0), short_prompt(8, 0);
+    ov::genai::GenerationConfig high_priority_config = ov::genai::greedy();
+    high_priority_config.priority = RequestPriority::HIGH;
+    // the high priority request arrives while the normal one could occupy the whole batch
+    SequenceGroup::Ptr normal_priority_group = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {long_prompt.size()}, long_prompt.data()),
+                                                                               ov::genai::greedy(), 4);
+    SequenceGroup::Ptr high_priority_group = std::make_shared<SequenceGroup>(1, ov::Tensor(ov::element::i64, {short_prompt.size()}, short_prompt.data()),
+                                                                             high_priority_config, 4);
+    std::vector<SequenceGroup::Ptr> requests = {normal_priority_group, high_priority_group};
+
+    Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+    auto out = scheduler.schedule(requests);
+
+    const std::vector<uint64_t> ref_ids = {0, 1};
+    EXPECT_EQ(out.m_scheduled_sequence_groups_ids, ref_ids);
+    EXPECT_EQ(normal_priority_group->get_num_scheduled_tokens(), 16);
+    EXPECT_EQ(high_priority_group->get_num_scheduled_tokens(), 8);
+    EXPECT_EQ(out.m_total_num_scheduled_tokens, 24);
+
+    for (auto& req : requests) {
+        for (auto& seq : req->get_sequences()) {
+            scheduler.free_sequence(seq->get_id());
+        }
+    }
+}
+
+TEST(TestScheduler, ReservesTokensForHighPriorityPromptsInVllmMode) {
+    SchedulerConfig scheduler_config;
+    scheduler_config.max_num_batched_tokens = 32;
+    scheduler_config.num_kv_blocks = 20;
+    scheduler_config.dynamic_split_fuse = false;
+    scheduler_config.max_num_seqs = 5;
+    scheduler_config.high_priority_tokens_share = 0.5;
+
+    // the normal priority prompt is longer than the budget left for it by the reserved tokens
+    std::vector<uint64_t> long_prompt(32, 0), short_prompt(8, 0);
+    ov::genai::GenerationConfig high_priority_config = ov::genai::greedy();
+    high_priority_config.priority = RequestPriority::HIGH;
+    SequenceGroup::Ptr high_priority_group = std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {short_prompt.size()}, short_prompt.data()),
+                                                                             high_priority_config, 4);
+    SequenceGroup::Ptr normal_priority_group = std::make_shared<SequenceGroup>(1, ov::Tensor(ov::element::i64, {long_prompt.size()}, long_prompt.data()),
+                                                                               ov::genai::greedy(), 4);
+    std::vector<SequenceGroup::Ptr> requests = {high_priority_group, normal_priority_group};
+
+    Scheduler scheduler = Scheduler(4, init_cache_manager(scheduler_config), scheduler_config);
+    auto out1 = scheduler.schedule(requests);
+
+    // tokens are reserved while the high priority prompt waits
+    EXPECT_EQ(out1.m_scheduled_sequence_groups_ids, std::vector<uint64_t>({0}));
+    EXPECT_EQ(high_priority_group->get_num_scheduled_tokens(), 8);
+    EXPECT_EQ(normal_priority_group->get_num_scheduled_tokens(), 0);
+    EXPECT_TRUE(out1.is_prompt);
+    high_priority_group->finish_iteration();
+
+    // then the normal priority prompt uses the whole batch instead of waiting forever
+    auto out2 = scheduler.schedule(requests);
+
+    EXPECT_EQ(out2.m_scheduled_sequence_groups_ids, std::vector<uint64_t>({1}));
+    EXPECT_EQ(normal_priority_group->get_num_scheduled_tokens(), 32);
+    EXPECT_EQ(out2.m_total_num_scheduled_tokens, 32);
+    EXPECT_TRUE(out2.is_prompt);
+
+    for (auto& req : requests) {
+        for (auto& seq : req->get_sequences()) {
+            scheduler.free_sequence(seq->get_id());
+        }
+    }
+}
+
+TEST(TestScheduler, OrdersSequenceGroupsByPriorityAndDeadline) {
+    std::vector<uint64_t> tokens = {0, 1, 2, 3};
+    auto make_group = [&](RequestPriority priority, size_t deadline_ms) {
+        ov::genai::GenerationConfig config = ov::genai::greedy();
+        config.priority = priority;
+        config.deadline_ms = deadline_ms;
+        return std::make_shared<SequenceGroup>(0, ov::Tensor(ov::element::i64, {tokens.size()}, tokens.data()), config, 4);
+    };
+    SequenceGroup::Ptr low = make_group(RequestPriority::LOW, 10);
+    SequenceGroup::Ptr normal = make_group(RequestPriority::NORMAL, 0);
+    SequenceGroup::Ptr normal_late_deadline = make_group(RequestPriority::NORMAL, 10000);
+    SequenceGroup::Ptr normal_early_deadline = make_group(RequestPriority::NORMAL, 100);
+    SequenceGroup::Ptr high = make_group(RequestPriority::HIGH, 0);
+
+    EXPECT_TRUE(high->is_scheduled_before(*normal_early_deadline));
+    EXPECT_TRUE(normal->is_scheduled_before(*low));
+    EXPECT_TRUE(normal_early_deadline->is_scheduled_before(*normal_late_deadline));
+    EXPECT_TRUE(normal_late_deadline->is_scheduled_before(*normal));
+    // groups without deadline keep the order of arrival
+    EXPECT_FALSE(normal->is_scheduled_before(*make_group(RequestPriority::NORMAL, 0)));
+    EXPECT_FALSE(make_group(RequestPriority::NORMAL, 0)->is_scheduled_before(*normal));
+}
@@ -0,0 +1,174 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include "stop_string_matcher.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+enum Tokens : int64_t { HELLO, WORLD, EXCLAMATION, NEW_LINE, QUES, TION, COLON, A, B, C, SPECIAL };
+
+std::shared_ptr<const TokenBytesTable> create_token_bytes() {
+    return std::make_shared<const TokenBytesTable>(std::vector<std::string>{
+        "Hello", " world", "!", "\n", "Ques", "tion", ":", "a", "b", "c", ""});
+}
+
+// "中" and "文" are split into byte tokens, like byte fallback tokens of SentencePiece
+enum ByteTokens : int64_t { BYTE_HELLO, BYTE_SPACE, E4, B8, AD, E6, B96, B87, ZHONG_LEAD };
+
+const std::vector<std::string> raw_token_bytes = {"Hello", " ", "\xE4", "\xB8", "\xAD", "\xE6", "\x96", "\x87", "\xE4\xB8"};
+
+// concatenates bytes of tokens and replaces bytes of invalid or incomplete characters by U+FFFD, like detokenizers do
+std::string decode_bytes(const std::vector<int64_t>& tokens) {
+    std::string bytes;
+    for (int64_t token : tokens) {
+        bytes += raw_token_bytes[token];
+    }
+    std::string text;
+    for (size_t i = 0; i < bytes.size();) {
+        const unsigned char lead = bytes[i];
+        const size_t length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+        bool is_valid = length > 0 && i + length <= bytes.size();
+        for (size_t j = 1; is_valid && j < length; ++j) {
+            is_valid = (static_cast<unsigned char>(bytes[i + j]) & 0xC0) == 0x80;
+        }
+        if (is_valid) {
+            text.append(bytes, i, length);
+            i += length;
+        } else {
+            text += "\xEF\xBF\xBD";
+            ++i;
+        }
+    }
+    return text;
+}
+
+std::shared_ptr<const TokenBytesTable> create_byte_token_bytes() {
+    std::vector<std::string> token_bytes;
+    for (int64_t token = 0; token < static_cast<int64_t>(raw_token_bytes.size()); ++token) {
+        token_bytes.push_back(decode_bytes({token}));
+    }
+    return std::make_shared<const TokenBytesTable>(token_bytes, decode_bytes);
+}
+
+} // namespace
+
+TEST(TestStopStringMatcher, stop_string_split_between_tokens) {
+    StopStringMatcher matcher({"Question:"}, create_token_bytes(), false);
+    TokenIds generated_ids = {HELLO, NEW_LINE, QUES};
+    EXPECT_FALSE(matcher.match(0, generated_ids).is_matched);
+    generated_ids.push_back(TION);
+    EXPECT_FALSE(matcher.match(0, generated_ids).is_matched);
+    generated_ids.push_back(COLON);
+
+    auto result = matcher.match(0, generated_ids);
+    EXPECT_TRUE(result.is_matched);
+    // stop string and a new line before it are removed
+    EXPECT_EQ(result.to_remove, 4);
+}
+
+TEST(TestStopStringMatcher, include_stop_string_removes_following_tokens) {
+    StopStringMatcher matcher({"on:"}, create_token_bytes(), true);
+    // several tokens are added at once, like in speculative decoding
+    auto result = matcher.match(0, {HELLO, QUES, TION, COLON, EXCLAMATION, SPECIAL});
+    EXPECT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 2);
+}
+
+TEST(TestStopStringMatcher, token_partially_matching_stop_string_is_kept) {
+    StopStringMatcher matcher({"llo"}, create_token_bytes(), false);
+    auto result = matcher.match(0, {HELLO, WORLD});
+    EXPECT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 1);
+}
+
+TEST(TestStopStringMatcher, overlapping_stop_strings) {
+    StopStringMatcher matcher({"abac", "bab"}, create_token_bytes(), false);
+    TokenIds generated_ids;
+    for (int64_t token : {A, B, A}) {
+        generated_ids.push_back(token);
+        EXPECT_FALSE(matcher.match(0, generated_ids).is_matched);
+    }
+    generated_ids.push_back(B);
+    auto result = matcher.match(0, generated_ids);
+    EXPECT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 3);
+}
+
+TEST(TestStopStringMatcher, match_candidate_does_not_change_state) {
+    StopStringMatcher matcher({"o w"}, create_token_bytes(), false);
+    const TokenIds generated_ids = {HELLO};
+    auto result = matcher.match_candidate(generated_ids, WORLD);
+    EXPECT_TRUE(result.is_matched);
+    // only candidate token is removed, as it's the first token to contain stop string
+    EXPECT_EQ(result.to_remove, 1);
+
+    EXPECT_FALSE(matcher.match_candidate(generated_ids, EXCLAMATION).is_matched);
+    EXPECT_FALSE(matcher.match(0, generated_ids).is_matched);
+}
+
+TEST(TestStopStringMatcher, replaced_tokens_are_rechecked) {
+    StopStringMatcher matcher({"Question:"}, create_token_bytes(), true);
+    EXPECT_FALSE(matcher.match(0, {HELLO, WORLD}).is_matched);
+
+    // last token is replaced and new ones are appended
+    auto result = matcher.match(0, {HELLO, QUES, TION, COLON}, 3);
+    EXPECT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 0);
+}
+
+TEST(TestStopStringMatcher, sequences_are_matched_independently) {
+    StopStringMatcher matcher({"ab"}, create_token_bytes(), false);
+    EXPECT_FALSE(matcher.match(0, {A}).is_matched);
+    EXPECT_FALSE(matcher.match(1, {C}).is_matched);
+    EXPECT_FALSE(matcher.match(1, {C, B}).is_matched);
+    EXPECT_TRUE(matcher.match(0, {A, B}).is_matched);
+    // forked sequence is matched from the beginning
+    EXPECT_TRUE(matcher.match(2, {A, B}).is_matched);
+}
+
+TEST(TestStopStringMatcher, dropped_sequence_is_matched_from_the_beginning) {
+    StopStringMatcher matcher({"bab"}, create_token_bytes(), false);
+    EXPECT_FALSE(matcher.match(0, {A, B}).is_matched);
+    matcher.drop_sequence(0);
+    // sequence ID is reused, its tokens are not a continuation of the dropped sequence
+    EXPECT_TRUE(matcher.match(0, {B, A, B}).is_matched);
+}
+
+TEST(TestStopStringMatcher, non_ascii_stop_string_split_between_byte_tokens) {
+    StopStringMatcher matcher({"中文"}, create_byte_token_bytes(), false);
+    TokenIds generated_ids = {BYTE_HELLO, BYTE_SPACE};
+    for (int64_t token : {E4, B8, AD, E6, B96}) {
+        generated_ids.push_back(token);
+        EXPECT_FALSE(matcher.match(0, generated_ids).is_matched);
+    }
+    generated_ids.push_back(B87);
+
+    auto result = matcher.match(0, generated_ids);
+    EXPECT_TRUE(result.is_matched);
+    // bytes of the stop string and a space before it are removed
+    EXPECT_EQ(result.to_remove, 7);
+}
+
+TEST(TestStopStringMatcher, non_ascii_stop_string_after_non_ascii_text) {
+    StopStringMatcher matcher({"文"}, create_byte_token_bytes(), false);
+    // the first character is split as a token of two bytes and a byte token
+    auto result = matcher.match(0, {ZHONG_LEAD, AD, E6, B96, B87});
+    EXPECT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 3);
+
+    EXPECT_FALSE(matcher.match(1, {E6, B96, E4, B8, AD}).is_matched);
+}
+
+TEST(TestStopStringMatcher, non_ascii_candidate_completes_stop_string) {
+    StopStringMatcher matcher({"中"}, create_byte_token_bytes(), true);
+    const TokenIds generated_ids = {BYTE_HELLO, E4, B8};
+    auto result = matcher.match_candidate(generated_ids, AD);
+    EXPECT_TRUE(result.is_matched);
+    EXPECT_EQ(result.to_remove, 0);
+
+    EXPECT_FALSE(matcher.match_candidate(generated_ids, B87).is_matched);
+}
@@ -0,0 +1,236 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include "logit_processor.hpp"
+#include "speculative_decoding/continuous_batching_for_speculative_decoding_impl.hpp"
+#include "structured_output.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+bool matches(const RegexAutomaton& automaton, const std::string& text) {
+    return automaton.is_accepting(automaton.next(RegexAutomaton::INITIAL_STATE, text));
+}
+
+enum Tokens : int64_t { OPEN_BRACE, CLOSE_BRACE, KEY, COLON, ONE, TWO, QUOTE, SPACE, WORD, EOS };
+
+std::shared_ptr<const SortedVocabulary> create_vocabulary() {
+    auto token_bytes = std::make_shared<const TokenBytesTable>(std::vector<std::string>{
+        "{", "}", "\"a\"", ":", "1", "2", "\"", " ", "abc", ""});
+    return std::make_shared<const SortedVocabulary>(token_bytes);
+}
+
+StructuredOutputConfig json_schema_config(const std::string& json_schema) {
+    StructuredOutputConfig config;
+    config.json_schema = json_schema;
+    return config;
+}
+
+} // namespace
+
+TEST(TestStructuredOutput, regex_automaton) {
+    RegexAutomaton automaton("(ab|c)+[0-9]{2,3}\\.?x?");
+    EXPECT_TRUE(matches(automaton, "ab12"));
+    EXPECT_TRUE(matches(automaton, "cabc123.x"));
+    EXPECT_FALSE(matches(automaton, "ab1"));
+    EXPECT_FALSE(matches(automaton, "ab1234"));
+    EXPECT_FALSE(matches(automaton, "12"));
+    // prefix of a valid output is not accepted, but it's not a dead end either
+    EXPECT_NE(automaton.next(RegexAutomaton::INITIAL_STATE, "cab"), RegexAutomaton::DEAD_STATE);
+    EXPECT_EQ(automaton.next(RegexAutomaton::INITIAL_STATE, "abd"), RegexAutomaton::DEAD_STATE);
+
+    EXPECT_ANY_THROW(RegexAutomaton("(ab"));
+}
+
+TEST(TestStructuredOutput, json_schema) {
+    RegexAutomaton automaton(json_schema_to_regex(R"({
+        "type": "object",
+        "properties": {
+            "name": {"type": "string", "maxLength": 5},
+            "age": {"type": "integer"},
+            "tags": {"type": "array", "items": {"enum": ["x", "y"]}, "minItems": 1}
+        },
+        "required": ["name", "tags"]
+    })"));
+    EXPECT_TRUE(matches(automaton, R"({"name": "Bob", "age": 42, "tags": ["x"]})"));
+    EXPECT_TRUE(matches(automaton, R"({"name":"Bob","tags":["x","y"]})"));
+    // too long name
+    EXPECT_FALSE(matches(automaton, R"({"name": "Alexander", "tags": ["x"]})"));
+    // not an integer
+    EXPECT_FALSE(matches(automaton, R"({"name": "Bob", "age": 4.2, "tags": ["x"]})"));
+    // missing required property
+    EXPECT_FALSE(matches(automaton, R"({"name": "Bob", "age": 42})"));
+    // empty array
+    EXPECT_FALSE(matches(automaton, R"({"name": "Bob", "tags": []})"));
+
+    EXPECT_ANY_THROW(json_schema_to_regex(R"({"$defs": {"node": {"type": "array", "items": {"$ref": "#/$defs/node"}}}, "$ref": "#/$defs/node"})"));
+}
+
+TEST(TestStructuredOutput, ebnf_grammar) {
+    RegexAutomaton automaton(ebnf_grammar_to_regex(R"(
+        # list of answers
+        root ::= answer ("," " "? answer)*
+        answer ::= "yes" | "no" | number
+        number ::= [0-9]+
+    )"));
+    EXPECT_TRUE(matches(automaton, "yes"));
+    EXPECT_TRUE(matches(automaton, "no, 42,yes"));
+    EXPECT_FALSE(matches(automaton, "maybe"));
+    EXPECT_FALSE(matches(automaton, "yes,"));
+
+    EXPECT_ANY_THROW(ebnf_grammar_to_regex("root ::= \"(\" root \")\" | \"\""));
+    EXPECT_ANY_THROW(ebnf_grammar_to_regex("root ::= undefined"));
+}
+
+TEST(TestStructuredOutput, token_masks) {
+    auto grammar = std::make_shared<StructuredOutputGrammar>(
+        json_schema_config(R"({"type": "object", "properties": {"a": {"type": "integer"}}, "required": ["a"]})"), create_vocabulary());
+    int32_t state = RegexAutomaton::INITIAL_STATE;
+    auto mask = grammar->get_mask(state);
+    EXPECT_TRUE(mask->is_allowed(OPEN_BRACE));
+    EXPECT_FALSE(mask->is_allowed(KEY));
+    EXPECT_FALSE(mask->is_allowed(EOS));
+    EXPECT_EQ(mask->num_allowed_tokens, 1);
+
+    const TokenIds generated_ids = {OPEN_BRACE, KEY, COLON, SPACE, ONE, CLOSE_BRACE};
+    for (size_t i = 0; i < 4; ++i) {
+        state = grammar->next_state(state, generated_ids, i);
+    }
+    {
+        ThreadPool thread_pool(1);
+        grammar->prefetch_mask(state, thread_pool);
+        mask = grammar->get_mask(state);
+    }
+    EXPECT_TRUE(mask->is_allowed(ONE));
+    EXPECT_TRUE(mask->is_allowed(TWO));
+    EXPECT_FALSE(mask->is_allowed(SPACE));
+    EXPECT_FALSE(mask->is_allowed(WORD));
+    // masks of states are cached
+    EXPECT_EQ(mask, grammar->get_mask(state));
+
+    state = grammar->next_state(grammar->next_state(state, generated_ids, 4), generated_ids, 5);
+    EXPECT_TRUE(grammar->is_accepting(state));
+    EXPECT_EQ(grammar->get_mask(state)->num_allowed_tokens, 0);
+}
+
+TEST(TestStructuredOutput, partial_tokens_of_non_ascii_characters) {
+    // "中" is split into byte tokens, which are decoded to U+FFFD on their own
+    enum ByteTokens : int64_t { BYTE_QUOTE, BYTE_A, E4, B8, AD };
+    const std::vector<std::string> raw_token_bytes = {"\"", "a", "\xE4", "\xB8", "\xAD"};
+    // decodes complete characters only, like a detokenizer replacing incomplete characters with U+FFFD
+    auto decode = [raw_token_bytes](const std::vector<int64_t>& tokens) {
+        std::string bytes;
+        for (int64_t token : tokens) {
+            bytes += raw_token_bytes[token];
+        }
+        const size_t pos = bytes.find("\xE4\xB8\xAD");
+        std::string text;
+        for (size_t i = 0; i < bytes.size(); ++i) {
+            if (i == pos) {
+                text += "\xE4\xB8\xAD";
+                i += 2;
+            } else {
+                text += static_cast<unsigned char>(bytes[i]) < 0x80 ? bytes.substr(i, 1) : std::string("\xEF\xBF\xBD");
+            }
+        }
+        return text;
+    };
+    auto token_bytes = std::make_shared<const TokenBytesTable>(
+        std::vector<std::string>{"\"", "a", "\xEF\xBF\xBD", "\xEF\xBF\xBD", "\xEF\xBF\xBD"}, decode);
+    StructuredOutputConfig config;
+    config.regex = "\"(a|中)+\"";
+    auto grammar = std::make_shared<StructuredOutputGrammar>(config, std::make_shared<const SortedVocabulary>(token_bytes));
+
+    // partial tokens are allowed where non-ASCII bytes are
+    auto mask = grammar->get_mask(RegexAutomaton::INITIAL_STATE);
+    EXPECT_EQ(mask->num_allowed_tokens, 1);
+    EXPECT_TRUE(mask->is_allowed(BYTE_QUOTE));
+
+    const TokenIds generated_ids = {BYTE_QUOTE, E4, B8, AD, BYTE_A, BYTE_QUOTE};
+    int32_t state = grammar->next_state(RegexAutomaton::INITIAL_STATE, generated_ids, 0);
+    mask = grammar->get_mask(state);
+    EXPECT_TRUE(mask->is_allowed(BYTE_A));
+    EXPECT_TRUE(mask->is_allowed(E4));
+    EXPECT_FALSE(mask->is_allowed(BYTE_QUOTE));
+
+    // partial tokens are advanced by bytes of characters they complete
+    for (size_t i = 1; i < generated_ids.size(); ++i) {
+        state = grammar->next_state(state, generated_ids, i);
+        EXPECT_NE(state, RegexAutomaton::DEAD_STATE);
+    }
+    EXPECT_TRUE(grammar->is_accepting(state));
+}
+
+TEST(TestStructuredOutput, transform_masks_logits) {
+    auto grammar = std::make_shared<StructuredOutputGrammar>(json_schema_config(R"({"enum": [1, 12]})"), create_vocabulary());
+    LogitTransformers::StructuredOutputTransform transform(grammar, {EOS});
+    const float minus_inf = -std::numeric_limits<float>::infinity();
+
+    std::vector<float> logits_data(EOS + 1, 1.0f);
+    Logits logits(logits_data.data(), logits_data.size());
+    transform.set_current_sequence(0, {}, 0);
+    transform.apply(logits);
+    for (int64_t token_id = 0; token_id <= EOS; ++token_id) {
+        EXPECT_EQ(logits_data[token_id], token_id == ONE ? 1.0f : minus_inf);
+    }
+
+    // "1" is a complete output, so both EOS and continuation are allowed
+    std::fill(logits_data.begin(), logits_data.end(), 1.0f);
+    transform.set_current_sequence(0, {ONE}, 1);
+    transform.apply(logits);
+    for (int64_t token_id = 0; token_id <= EOS; ++token_id) {
+        EXPECT_EQ(logits_data[token_id], token_id == TWO || token_id == EOS ? 1.0f : minus_inf);
+    }
+
+    // only EOS is allowed at the end of output
+    std::fill(logits_data.begin(), logits_data.end(), 1.0f);
+    transform.set_current_sequence(0, {ONE, TWO}, 2);
+    transform.apply(logits);
+    for (int64_t token_id = 0; token_id <= EOS; ++token_id) {
+        EXPECT_EQ(logits_data[token_id], token_id == EOS ? 1.0f : minus_inf);
+    }
+}
+
+class StructuredOutputRequestTest : public testing::Test, public ContinuousBatchingPipeline {
+protected:
+    class PipelineTestInstance : public ContinuousBatchingPipeline::ContinuousBatchingForSpeculativeDecodingImpl {
+    public:
+        PipelineTestInstance() {
+            m_scheduler = std::make_shared<Scheduler>(4, nullptr);
+            m_sampler = std::make_shared<Sampler>();
+            m_block_size = 4;
+        }
+
+        size_t get_num_awaiting_requests() {
+            std::lock_guard<std::mutex> lock{m_awaiting_requests_mutex};
+            return m_awaiting_requests.size();
+        }
+    };
+};
+
+TEST_F(StructuredOutputRequestTest, invalid_constraint_is_rejected_by_add_request) {
+    PipelineTestInstance pipeline;
+    std::vector<int64_t> prompt{0, 1, 2, 3};
+    ov::Tensor input_ids(ov::element::i64, {1, prompt.size()}, prompt.data());
+
+    GenerationConfig config = greedy();
+    config.set_eos_token_id(2);
+    config.structured_output_config = json_schema_config(R"({"type": "object", "properties": {"a": {"type": "integer"}}})");
+    GenerationHandle handle = pipeline.add_request(0, input_ids, config);
+
+    std::vector<StructuredOutputConfig> invalid_configs{
+        json_schema_config(R"({"type": "object", "properties": )"),
+        json_schema_config(R"({"$defs": {"node": {"type": "array", "items": {"$ref": "#/$defs/node"}}}, "$ref": "#/$defs/node"})"),
+        StructuredOutputConfig()};
+    invalid_configs.back().regex = "(ab";
+    for (size_t i = 0; i < invalid_configs.size(); ++i) {
+        config.structured_output_config = invalid_configs[i];
+        EXPECT_THROW(pipeline.add_request(i + 1, input_ids, config), ov::Exception);
+    }
+
+    EXPECT_EQ(pipeline.get_num_awaiting_requests(), 1u);
+    EXPECT_EQ(handle->get_status(), GenerationStatus::RUNNING);
+}
@@ -0,0 +1,43 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include "token_store.hpp"
+
+using namespace ov::genai;
+
+TEST(TestTokenStore, copies_are_independent) {
+    std::vector<int64_t> expected(TokenStore::CHUNK_SIZE * 2 + 3);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    TokenStore parent(expected);
+    TokenStore fork = parent;
+    fork.push_back(-1);
+    parent.pop_back();
+    parent.pop_back();
+
+    EXPECT_EQ(fork.size(), expected.size() + 1);
+    EXPECT_EQ(fork.back(), -1);
+    EXPECT_EQ(parent.size(), expected.size() - 2);
+    expected.push_back(-1);
+    EXPECT_EQ(fork, expected);
+}
+
+TEST(TestTokenStore, pop_back_does_not_change_shared_chunks) {
+    std::vector<int64_t> expected(TokenStore::CHUNK_SIZE);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    TokenStore parent(expected);
+    TokenStore fork = parent;
+    // the only chunk is full, so removal of its last token must not be visible to the parent
+    fork.pop_back();
+    fork.push_back(-1);
+
+    EXPECT_EQ(parent, expected);
+    EXPECT_EQ(parent.to_vector(), expected);
+    EXPECT_EQ(fork[TokenStore::CHUNK_SIZE - 1], -1);
+    EXPECT_EQ(*fork.rbegin(), -1);
+    EXPECT_EQ(std::vector<int64_t>(fork.begin(), fork.begin() + 3), (std::vector<int64_t>{0, 1, 2}));
+}
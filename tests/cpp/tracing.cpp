@@ -0,0 +1,80 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <nlohmann/json.hpp>
+#include "tracing.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+std::vector<nlohmann::json> get_spans(const std::string& chrome_trace) {
+    const nlohmann::json trace = nlohmann::json::parse(chrome_trace);
+    std::vector<nlohmann::json> spans;
+    for (const auto& event : trace["traceEvents"]) {
+        if (event["ph"] == "X")
+            spans.push_back(event);
+    }
+    return spans;
+}
+
+} // namespace
+
+TEST(TestTracing, spans_are_exported_to_chrome_trace) {
+    Tracer& tracer = Tracer::instance();
+    tracer.enable();
+    tracer.clear();
+
+    {
+        TraceSpan outer_span("step");
+        outer_span.arg("requests", 3);
+        std::thread([] {
+            TraceSpan inner_span("sample");
+            inner_span.arg("generated_tokens", 5).arg("forks", 1);
+        }).join();
+    }
+    tracer.disable();
+    {
+        TraceSpan ignored_span("ignored");
+        EXPECT_FALSE(ignored_span.is_recording());
+    }
+
+    auto spans = get_spans(tracer.get_chrome_trace());
+    ASSERT_EQ(spans.size(), 2);
+    std::sort(spans.begin(), spans.end(), [](const nlohmann::json& lhs, const nlohmann::json& rhs) {
+        return lhs["ts"].get<double>() < rhs["ts"].get<double>();
+    });
+
+    EXPECT_EQ(spans[0]["name"], "step");
+    EXPECT_EQ(spans[0]["args"]["requests"], 3);
+    EXPECT_EQ(spans[1]["name"], "sample");
+    EXPECT_EQ(spans[1]["args"]["generated_tokens"], 5);
+    EXPECT_EQ(spans[1]["args"]["forks"], 1);
+    // spans of different threads are exported as different tracks
+    EXPECT_NE(spans[0]["tid"], spans[1]["tid"]);
+    // the inner span is nested into the outer one
+    EXPECT_LE(spans[0]["ts"].get<double>(), spans[1]["ts"].get<double>());
+    EXPECT_GE(spans[0]["ts"].get<double>() + spans[0]["dur"].get<double>(),
+              spans[1]["ts"].get<double>() + spans[1]["dur"].get<double>());
+}
+
+TEST(TestTracing, ring_buffer_keeps_latest_spans) {
+    Tracer& tracer = Tracer::instance();
+    tracer.enable();
+    tracer.clear();
+
+    const size_t num_spans = TraceBuffer::CAPACITY + 10;
+    for (size_t span_idx = 0; span_idx < num_spans; ++span_idx) {
+        TraceSpan span("span");
+        span.arg("idx", span_idx);
+    }
+    tracer.disable();
+
+    auto spans = get_spans(tracer.get_chrome_trace());
+    ASSERT_EQ(spans.size(), TraceBuffer::CAPACITY);
+    EXPECT_EQ(spans.front()["args"]["idx"], num_spans - TraceBuffer::CAPACITY);
+    EXPECT_EQ(spans.back()["args"]["idx"], num_spans - 1);
+}
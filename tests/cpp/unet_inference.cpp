@@ -0,0 +1,127 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "openvino/genai/image_generation/unet2d_condition_model.hpp"
+#include "openvino/op/add.hpp"
+#include "openvino/op/constant.hpp"
+#include "openvino/op/multiply.hpp"
+#include "openvino/op/parameter.hpp"
+#include "openvino/op/reduce_mean.hpp"
+#include "openvino/op/reshape.hpp"
+#include "openvino/pass/manager.hpp"
+#include "openvino/pass/serialize.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+// sample * mean(encoder_hidden_states) + timestep, where the mean is computed for each batch element separately,
+// so each element of output depends on hidden states of the same batch element only
+std::shared_ptr<ov::Model> get_dummy_unet_model() {
+    auto sample = std::make_shared<ov::op::v0::Parameter>(ov::element::f32, ov::PartialShape{-1, 4, -1, -1});
+    auto timestep = std::make_shared<ov::op::v0::Parameter>(ov::element::f32, ov::PartialShape{-1});
+    auto encoder_hidden_states = std::make_shared<ov::op::v0::Parameter>(ov::element::f32, ov::PartialShape{-1, -1, -1});
+    sample->get_output_tensor(0).set_names({"sample"});
+    timestep->get_output_tensor(0).set_names({"timestep"});
+    encoder_hidden_states->get_output_tensor(0).set_names({"encoder_hidden_states"});
+
+    auto axes = ov::op::v0::Constant::create(ov::element::i64, ov::Shape{2}, {1, 2});
+    auto mean = std::make_shared<ov::op::v1::ReduceMean>(encoder_hidden_states, axes);
+    auto mean_shape = ov::op::v0::Constant::create(ov::element::i64, ov::Shape{4}, {-1, 1, 1, 1});
+    auto scale = std::make_shared<ov::op::v1::Reshape>(mean, mean_shape, false);
+    auto scaled_sample = std::make_shared<ov::op::v1::Multiply>(sample, scale);
+    auto out_sample = std::make_shared<ov::op::v1::Add>(scaled_sample, timestep);
+
+    return std::make_shared<ov::Model>(ov::OutputVector{out_sample},
+                                       ov::ParameterVector{sample, timestep, encoder_hidden_states});
+}
+
+UNet2DConditionModel create_unet() {
+    std::stringstream xml_stream, bin_stream;
+    ov::pass::Manager manager;
+    manager.register_pass<ov::pass::Serialize>(xml_stream, bin_stream);
+    manager.run_passes(get_dummy_unet_model());
+
+    const std::string bin = bin_stream.str();
+    ov::Tensor weights(ov::element::u8, ov::Shape{bin.size()});
+    std::copy(bin.begin(), bin.end(), weights.data<char>());
+
+    const auto config_path = std::filesystem::temp_directory_path() / "unet_inference_test_config.json";
+    std::ofstream(config_path) << R"({"in_channels": 4, "sample_size": 8})";
+    UNet2DConditionModel::Config config(config_path);
+    std::filesystem::remove(config_path);
+
+    return UNet2DConditionModel(xml_stream.str(), weights, config, 1);
+}
+
+ov::Tensor create_tensor(const ov::Shape& shape, const std::vector<float>& batch_values) {
+    ov::Tensor tensor(ov::element::f32, shape);
+    const size_t batch_stride = tensor.get_size() / shape[0];
+    for (size_t i = 0; i < tensor.get_size(); ++i) {
+        tensor.data<float>()[i] = batch_values[i / batch_stride] + 0.01f * (i % batch_stride);
+    }
+    return tensor;
+}
+
+} // namespace
+
+TEST(TestUNetInference, cfg_truncation_uses_conditional_batch) {
+    ov::Tensor timestep = create_tensor({1}, {0.5f});
+    // unconditional and conditional hidden states
+    ov::Tensor hidden_states(ov::element::f32, {2, 3, 2});
+    std::fill_n(hidden_states.data<float>(), 6, 1.0f);
+    std::fill_n(hidden_states.data<float>() + 6, 6, 3.0f);
+
+    for (bool is_static : {false, true}) {
+        UNet2DConditionModel unet = create_unet();
+        if (is_static) {
+            unet.reshape(2, 8, 8, 3);
+        }
+        unet.compile("CPU");
+        unet.set_hidden_states("encoder_hidden_states", hidden_states);
+
+        ov::Tensor sample = create_tensor({1, 4, 8, 8}, {1.0f});
+        ov::Tensor noise_pred = unet.infer(sample, timestep);
+
+        ASSERT_EQ(noise_pred.get_shape(), sample.get_shape()) << "static: " << is_static;
+        for (size_t i = 0; i < sample.get_size(); ++i) {
+            EXPECT_FLOAT_EQ(noise_pred.data<float>()[i], 3.0f * sample.data<float>()[i] + 0.5f) << "static: " << is_static;
+        }
+
+        // guidance is applied again with the same hidden states
+        ov::Tensor cfg_sample = create_tensor({2, 4, 8, 8}, {1.0f, 1.0f});
+        noise_pred = unet.infer(cfg_sample, timestep);
+        ASSERT_EQ(noise_pred.get_shape(), cfg_sample.get_shape());
+        EXPECT_FLOAT_EQ(noise_pred.data<float>()[0], cfg_sample.data<float>()[0] + 0.5f);
+    }
+}
+
+TEST(TestUNetInference, parallel_cfg_matches_sequential_cfg) {
+    ov::Tensor timestep = create_tensor({1}, {0.25f});
+    ov::Tensor hidden_states = create_tensor({4, 3, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+
+    UNet2DConditionModel sequential_unet = create_unet(), parallel_unet = create_unet();
+    sequential_unet.compile("CPU");
+    parallel_unet.compile("CPU", parallel_cfg(true));
+    sequential_unet.set_hidden_states("encoder_hidden_states", hidden_states);
+    parallel_unet.set_hidden_states("encoder_hidden_states", hidden_states);
+
+    // full guidance batch and truncated one
+    for (const std::vector<float>& batch_values : std::vector<std::vector<float>>{{1.0f, 2.0f, 3.0f, 4.0f}, {5.0f, 6.0f}}) {
+        ov::Tensor sample = create_tensor({batch_values.size(), 4, 8, 8}, batch_values);
+        ov::Tensor expected = sequential_unet.infer(sample, timestep);
+        ov::Tensor actual = parallel_unet.infer(sample, timestep);
+
+        ASSERT_EQ(actual.get_shape(), expected.get_shape());
+        for (size_t i = 0; i < expected.get_size(); ++i) {
+            EXPECT_FLOAT_EQ(actual.data<float>()[i], expected.data<float>()[i]);
+        }
+    }
+}
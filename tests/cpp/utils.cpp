@@ -18,4 +18,69 @@ TEST(TestIsContainer, test_is_container) {
     EXPECT_EQ(is_container<std::vector<float>>, true);
     EXPECT_EQ(is_container<map_type>, true);
     EXPECT_EQ(is_container<std::set<int64_t>>, true);
-}
\ No newline at end of file
+}
+namespace {
+
+// Splits text into words with preceding spaces and runs of new lines. The text gets a dummy prefix like
+// with SentencePiece tokenizers, so its first word is encoded with a space.
+std::vector<int64_t> encode_words(const std::string& text) {
+    static std::map<std::string, int64_t> vocab;
+    const std::string prefixed_text = " " + text;
+    std::vector<int64_t> tokens;
+    for (size_t begin = 0, end = 0; begin < prefixed_text.size(); begin = end) {
+        end = begin + 1;
+        if (prefixed_text[begin] == '\n') {
+            while (end < prefixed_text.size() && prefixed_text[end] == '\n')
+                ++end;
+        } else {
+            while (end < prefixed_text.size() && prefixed_text[end] != ' ' && prefixed_text[end] != '\n')
+                ++end;
+        }
+        tokens.push_back(vocab.emplace(prefixed_text.substr(begin, end - begin), vocab.size()).first->second);
+    }
+    return tokens;
+}
+
+}  // namespace
+
+TEST(TestEncodeAppendedText, encodes_appended_part_only) {
+    const std::string previous_text = "<|user|>\nWhat is the capital of France? Answer with a single word please.\n";
+    const std::string text = previous_text + "<|assistant|>\nParis\n";
+
+    std::vector<std::string> encoded_texts;
+    auto encode = [&encoded_texts](const std::string& text) {
+        encoded_texts.push_back(text);
+        return encode_words(text);
+    };
+
+    std::vector<int64_t> tokens = encode_words(previous_text);
+    encode_appended_text(encode, previous_text, text, tokens);
+    EXPECT_EQ(tokens, encode_words(text));
+    for (const std::string& encoded_text : encoded_texts) {
+        EXPECT_LT(encoded_text.size(), text.size());
+    }
+}
+
+TEST(TestEncodeAppendedText, encodes_whole_text_if_tokens_merge) {
+    const std::string previous_text = "<|user|>\nWhat is the capital of France? Answer with a single word please.\n";
+    std::vector<std::string> encoded_texts;
+    auto encode = [&encoded_texts](const std::string& text) {
+        encoded_texts.push_back(text);
+        return encode_words(text);
+    };
+
+    // new lines merge across the end of the previous text
+    std::string text = previous_text + "\n<|assistant|>\nParis\n";
+    std::vector<int64_t> tokens = encode_words(previous_text);
+    encode_appended_text(encode, previous_text, text, tokens);
+    EXPECT_EQ(tokens, encode_words(text));
+    EXPECT_EQ(encoded_texts.back(), text);
+
+    // the previous text is rendered differently
+    text = "<|user|>\nWhat is the capital of France?\n<|assistant|>\nParis\n";
+    tokens = encode_words(previous_text);
+    encoded_texts.clear();
+    encode_appended_text(encode, previous_text, text, tokens);
+    EXPECT_EQ(tokens, encode_words(text));
+    EXPECT_EQ(encoded_texts, std::vector<std::string>({text}));
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2018-2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+//
+
+#include <gtest/gtest.h>
+#include "visual_language/vision_embeddings_cache.hpp"
+
+using namespace ov::genai;
+
+namespace {
+
+ov::Tensor create_image(uint8_t value) {
+    ov::Tensor image(ov::element::u8, {1, 4, 4, 3});
+    std::fill_n(image.data<uint8_t>(), image.get_size(), value);
+    return image;
+}
+
+CachedImageEmbeddings create_embeddings(float value, size_t size) {
+    CachedImageEmbeddings embeddings;
+    embeddings.encoded_image.resized_source = ov::Tensor(ov::element::f32, {1, size});
+    std::fill_n(embeddings.encoded_image.resized_source.data<float>(), size, value);
+    embeddings.encoded_image.resized_source_size = {1, size};
+    return embeddings;
+}
+
+} // namespace
+
+TEST(TestVisionEmbeddingsCache, key_depends_on_content_and_shape) {
+    ov::Tensor image = create_image(1);
+    EXPECT_EQ(VisionEmbeddingsCache::compute_key(image), VisionEmbeddingsCache::compute_key(create_image(1)));
+    EXPECT_NE(VisionEmbeddingsCache::compute_key(image), VisionEmbeddingsCache::compute_key(create_image(2)));
+
+    ov::Tensor reshaped_image(ov::element::u8, {1, 2, 8, 3}, image.data());
+    EXPECT_NE(VisionEmbeddingsCache::compute_key(image), VisionEmbeddingsCache::compute_key(reshaped_image));
+}
+
+TEST(TestVisionEmbeddingsCache, hash_collision_is_cache_miss) {
+    VisionEmbeddingsCache cache;
+    const ImageKey key = VisionEmbeddingsCache::compute_key(create_image(1));
+    cache.put(key, create_embeddings(1.0f, 16));
+
+    // images with the same primary hash, but different content or shape
+    ImageKey other_content = VisionEmbeddingsCache::compute_key(create_image(2));
+    other_content.hash = key.hash;
+    ImageKey other_shape = key;
+    other_shape.shape = {1, 2, 8, 3};
+    EXPECT_FALSE(cache.get(other_content).has_value());
+    EXPECT_FALSE(cache.get(other_shape).has_value());
+
+    // both entries are kept
+    cache.put(other_content, create_embeddings(2.0f, 16));
+    EXPECT_EQ(cache.get_num_entries(), 2);
+    EXPECT_EQ(cache.get(key)->encoded_image.resized_source.data<float>()[0], 1.0f);
+    EXPECT_EQ(cache.get(other_content)->encoded_image.resized_source.data<float>()[0], 2.0f);
+}
+
+TEST(TestVisionEmbeddingsCache, get_returns_deep_copy) {
+    VisionEmbeddingsCache cache;
+    const ImageKey key = VisionEmbeddingsCache::compute_key(create_image(1));
+    EXPECT_FALSE(cache.get(key).has_value());
+
+    CachedImageEmbeddings embeddings = create_embeddings(1.0f, 16);
+    cache.put(key, embeddings);
+    // cached embeddings must not depend on the memory of the original tensors
+    std::fill_n(embeddings.encoded_image.resized_source.data<float>(), 16, 2.0f);
+
+    std::optional<CachedImageEmbeddings> cached = cache.get(key);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached->encoded_image.resized_source.get_shape(), ov::Shape({1, 16}));
+    EXPECT_EQ(cached->encoded_image.resized_source.data<float>()[0], 1.0f);
+    EXPECT_EQ(cached->encoded_image.resized_source_size.width, 16);
+    EXPECT_EQ(cache.get_num_entries(), 1);
+    EXPECT_EQ(cache.get_size_bytes(), 16 * sizeof(float));
+}
+
+TEST(TestVisionEmbeddingsCache, evicts_least_recently_used) {
+    // fits exactly two entries
+    VisionEmbeddingsCache cache(2 * 16 * sizeof(float));
+    const ImageKey key_1 = VisionEmbeddingsCache::compute_key(create_image(1));
+    const ImageKey key_2 = VisionEmbeddingsCache::compute_key(create_image(2));
+    const ImageKey key_3 = VisionEmbeddingsCache::compute_key(create_image(3));
+    cache.put(key_1, create_embeddings(1.0f, 16));
+    cache.put(key_2, create_embeddings(2.0f, 16));
+    // mark the first entry as recently used
+    EXPECT_TRUE(cache.get(key_1).has_value());
+
+    cache.put(key_3, create_embeddings(3.0f, 16));
+    EXPECT_EQ(cache.get_num_entries(), 2);
+    EXPECT_TRUE(cache.get(key_1).has_value());
+    EXPECT_FALSE(cache.get(key_2).has_value());
+    EXPECT_TRUE(cache.get(key_3).has_value());
+
+    cache.set_capacity(16 * sizeof(float));
+    EXPECT_EQ(cache.get_num_entries(), 1);
+    EXPECT_TRUE(cache.get(key_3).has_value());
+}
+
+TEST(TestVisionEmbeddingsCache, zero_capacity_disables_cache) {
+    VisionEmbeddingsCache cache(0);
+    const ImageKey key = VisionEmbeddingsCache::compute_key(create_image(1));
+    CachedImageEmbeddings embeddings = create_embeddings(1.0f, 16);
+    CachedImageEmbeddings returned = cache.put(key, embeddings);
+    EXPECT_EQ(returned.encoded_image.resized_source.data(), embeddings.encoded_image.resized_source.data());
+    EXPECT_FALSE(cache.get(key).has_value());
+    EXPECT_EQ(cache.get_num_entries(), 0);
+    EXPECT_EQ(cache.get_size_bytes(), 0);
+}
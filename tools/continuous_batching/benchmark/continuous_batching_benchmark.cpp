@@ -1,14 +1,17 @@
 // Copyright (C) 2023-2025 Intel Corporation
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
 #include <fstream>
 #include <cstdlib>
 #include <chrono>
+#include <limits>
 #include <ostream>
 #include <random>
 #include <stdexcept>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
 
 #include <nlohmann/json.hpp>
@@ -35,9 +38,16 @@ public:
 };
 
 struct Dataset {
+    // marks requests which can be sent without waiting for other requests
+    static constexpr size_t NO_DEPENDENCY = std::numeric_limits<size_t>::max();
+
     std::vector<std::string> m_prompts;
     std::vector<ov::genai::GenerationConfig> m_sampling_params;
     std::vector<size_t> m_input_lens, m_output_lens;
+    // index of a request which must be finished before the request is sent, e.g. the previous turn of a chat
+    std::vector<size_t> m_dependencies;
+    // arrival times in seconds relative to the beginning of the benchmark, filled only when a trace is replayed
+    std::vector<double> m_arrival_times;
 
     size_t m_total_input_len = 0;
     size_t m_total_output_len = 0;
@@ -47,11 +57,13 @@ struct Dataset {
         m_sampling_params.reserve(size);
         m_input_lens.reserve(size);
         m_output_lens.reserve(size);
+        m_dependencies.reserve(size);
     }
 
-    void push_data(std::string prompt, ov::genai::GenerationConfig sampling_params) {
+    void push_data(std::string prompt, ov::genai::GenerationConfig sampling_params, size_t dependency = NO_DEPENDENCY) {
         m_prompts.push_back(prompt);
         m_sampling_params.push_back(sampling_params);
+        m_dependencies.push_back(dependency);
     }
 
     void push_lens(size_t input_len, size_t output_len) {
@@ -72,6 +84,12 @@ struct Dataset {
         return static_cast<float>(m_total_output_len / size());
     }
 
+    bool has_dependencies() const {
+        return std::any_of(m_dependencies.begin(), m_dependencies.end(), [](size_t dependency) {
+            return dependency != NO_DEPENDENCY;
+        });
+    }
+
     bool empty() const {
         return size() == 0;
     }
@@ -139,68 +157,191 @@ Dataset filtered_dataset(const std::string& models_path, const std::string& data
     return sampled_dataset;
 }
 
-class GenerationInfo {
+// Reads a trace of requests to replay: a JSON array of objects with "prompt" and optional "max_new_tokens"
+// and "timestamp" (arrival time in seconds) fields, sorted by timestamp
+Dataset trace_dataset(const std::string& models_path, const std::string& trace_path, const size_t num_prompts, const size_t max_output_len) {
+    std::ifstream json_file(trace_path.c_str());
+    OPENVINO_ASSERT(json_file.is_open(), "Cannot open trace file");
 
-    struct SequenceInfo {
-        std::chrono::milliseconds ttft;
-        std::chrono::milliseconds cumulated_tpot;
-        std::chrono::milliseconds mean_tpot;
-        size_t num_output_tokens;
-    
-        std::chrono::steady_clock::time_point start_time;
-        std::chrono::steady_clock::time_point last_read_time;
-
-        SequenceInfo(std::chrono::steady_clock::time_point& start_time) {
-            num_output_tokens = 0;
-            ttft = std::chrono::milliseconds::zero();
-            cumulated_tpot = std::chrono::milliseconds::zero();
-            this->start_time = start_time;
-        }
+    nlohmann::json json_trace = nlohmann::json::parse(json_file);
+    OPENVINO_ASSERT(json_trace.is_array(), "Trace must be a JSON array of requests");
+
+    Dataset dataset;
+    dataset.reserve(std::min(num_prompts, json_trace.size()));
+
+    ov::genai::Tokenizer tokenizer(models_path);
+
+    double first_timestamp = 0.0;
+    for (const auto& json_request : json_trace) {
+        if (dataset.size() == num_prompts)
+            break;
+
+        std::string prompt = json_request.at("prompt");
+        size_t input_len = tokenizer.encode(prompt).input_ids.get_size();
+        size_t output_len = std::min(max_output_len, json_request.value("max_new_tokens", max_output_len));
+        double timestamp = json_request.value("timestamp", 0.0);
+        if (dataset.empty())
+            first_timestamp = timestamp;
+        OPENVINO_ASSERT(dataset.empty() || timestamp - first_timestamp >= dataset.m_arrival_times.back(), "Trace requests must be sorted by timestamp");
+
+        ov::genai::GenerationConfig greedy_search = ov::genai::greedy();
+        greedy_search.max_new_tokens = output_len;
+        greedy_search.ignore_eos = true;
+
+        dataset.push_data(prompt, greedy_search);
+        dataset.push_lens(input_len, output_len);
+        dataset.m_arrival_times.push_back(timestamp - first_timestamp);
+    }
+
+    OPENVINO_ASSERT(!dataset.empty(), "Trace does not contain requests");
+    return dataset;
+}
+
+struct SyntheticWorkloadConfig {
+    // number of words in a user message
+    size_t input_len = 64;
+    // number of tokens generated for each request
+    size_t output_len = 128;
+    // number of words in a shared system prompt or a document
+    size_t prefix_len = 512;
+    // number of distinct system prompts or documents
+    size_t num_prefixes = 4;
+    // number of turns in a chat
+    size_t num_turns = 4;
+};
+
+std::string random_text(std::mt19937& gen, size_t num_words) {
+    // short common words, so the number of tokens is close to the number of words for most tokenizers
+    static const std::vector<std::string> words = {
+        "the", "of", "and", "to", "in", "is", "it", "that", "was", "for", "on", "are", "with", "as", "be", "at",
+        "one", "have", "this", "from", "or", "had", "by", "word", "but", "what", "some", "we", "can", "out", "other", "were",
+        "all", "there", "when", "up", "use", "your", "how", "said", "an", "each", "she", "which", "do", "their", "time", "if",
+        "will", "way", "about", "many", "then", "them", "would", "write", "like", "so", "these", "her", "long", "make", "thing", "see"
+    };
+    std::uniform_int_distribution<size_t> distribution(0, words.size() - 1);
+
+    std::string text;
+    for (size_t i = 0; i < num_words; ++i) {
+        if (i > 0)
+            text += ' ';
+        text += words[distribution(gen)];
+    }
+    return text;
+}
 
-        void update() {
-            std::chrono::steady_clock::time_point new_read_time = std::chrono::steady_clock::now();
-            if (last_read_time.time_since_epoch() == std::chrono::milliseconds::zero()) {
-                ttft = std::chrono::duration_cast<std::chrono::milliseconds>(new_read_time - start_time);
-            } else {
-                cumulated_tpot += std::chrono::duration_cast<std::chrono::milliseconds>(new_read_time - last_read_time);
-                mean_tpot = cumulated_tpot / num_output_tokens;
+Dataset synthetic_dataset(const std::string& models_path, const std::string& workload, const SyntheticWorkloadConfig& config, const size_t num_prompts) {
+    OPENVINO_ASSERT(config.num_prefixes > 0 && config.num_turns > 0 && config.output_len > 0, "Invalid synthetic workload parameters");
 
+    std::mt19937 gen(42);
+    ov::genai::Tokenizer tokenizer(models_path);
+
+    ov::genai::GenerationConfig greedy_search = ov::genai::greedy();
+    greedy_search.max_new_tokens = config.output_len;
+    greedy_search.ignore_eos = true;
+
+    // system prompts or documents shared between requests
+    std::vector<std::string> prefixes(config.num_prefixes);
+    for (auto& prefix : prefixes)
+        prefix = random_text(gen, config.prefix_len);
+    std::uniform_int_distribution<size_t> prefix_distribution(0, config.num_prefixes - 1);
+
+    Dataset dataset;
+    dataset.reserve(num_prompts);
+    auto push_request = [&](const std::string& prompt, size_t dependency) {
+        size_t input_len = tokenizer.encode(prompt).input_ids.get_size();
+        dataset.push_data(prompt, greedy_search, dependency);
+        dataset.push_lens(input_len, config.output_len);
+    };
+
+    if (workload == "shared_prefix") {
+        // requests share one of a few system prompts and differ in user messages
+        while (dataset.size() < num_prompts) {
+            push_request(prefixes[prefix_distribution(gen)] + "\n\nUser: " + random_text(gen, config.input_len) + "\nAssistant:", Dataset::NO_DEPENDENCY);
+        }
+    } else if (workload == "rag") {
+        // long retrieved documents followed by short questions, each document is retrieved by multiple requests
+        while (dataset.size() < num_prompts) {
+            push_request("Context:\n" + prefixes[prefix_distribution(gen)] + "\n\nQuestion: " + random_text(gen, config.input_len) + "\nAnswer:", Dataset::NO_DEPENDENCY);
+        }
+    } else if (workload == "multi_turn") {
+        // each turn contains the whole chat history and is sent after the previous turn is finished;
+        // requests are ordered by turns, so waiting for the previous turn of one chat does not delay turns of other chats
+        const size_t num_chats = (num_prompts + config.num_turns - 1) / config.num_turns;
+        std::vector<std::string> histories(num_chats);
+        std::vector<size_t> previous_turns(num_chats, Dataset::NO_DEPENDENCY);
+        for (auto& history : histories)
+            history = prefixes[prefix_distribution(gen)] + "\n\n";
+
+        for (size_t turn = 0; turn < config.num_turns && dataset.size() < num_prompts; ++turn) {
+            for (size_t chat_id = 0; chat_id < num_chats && dataset.size() < num_prompts; ++chat_id) {
+                histories[chat_id] += "User: " + random_text(gen, config.input_len) + "\nAssistant:";
+                const size_t request_id = dataset.size();
+                push_request(histories[chat_id], previous_turns[chat_id]);
+                previous_turns[chat_id] = request_id;
+                // answers are not known in advance, so the history is continued with a synthetic one
+                histories[chat_id] += " " + random_text(gen, config.output_len) + "\n";
             }
-            num_output_tokens++;
-            last_read_time = new_read_time;
         }
-    };
+    } else {
+        OPENVINO_THROW("Unsupported synthetic workload: ", workload);
+    }
+
+    return dataset;
+}
+
+double to_milli(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
 
-    struct GenerationMetrics {
-        std::chrono::milliseconds mean_ttft = std::chrono::milliseconds::zero();
-        std::chrono::milliseconds mean_tpot = std::chrono::milliseconds::zero();
+class GenerationInfo {
+public:
+    struct RequestMetrics {
+        size_t request_id = 0;
+        size_t num_input_tokens = 0;
         size_t num_output_tokens = 0;
-        size_t num_input_tokens;
+        // all latencies are in milliseconds
+        double ttft = 0.0;
+        double mean_tpot = 0.0;
+        double e2e_latency = 0.0;
+        // whether generation was finished without being ignored or cancelled
+        bool completed = false;
     };
 
+private:
     ov::genai::GenerationHandle generation_handle;
     std::chrono::steady_clock::time_point start_time;
-    std::unordered_map<int64_t, SequenceInfo> sequences_info;
+    std::chrono::steady_clock::time_point last_read_time;
+    // latencies between consecutive portions of generated tokens
+    std::vector<double> inter_token_latencies;
+    RequestMetrics metrics;
     bool active = true;
-    size_t input_len;
 
 public:
-    GenerationInfo(ov::genai::GenerationHandle generation_handle, size_t input_len) : input_len(input_len)
+    GenerationInfo(ov::genai::GenerationHandle generation_handle, size_t request_id, size_t input_len)
     {
         this->generation_handle = std::move(generation_handle);
         start_time = std::chrono::steady_clock::now();
-    }
-
-    void update_sequence(int64_t sequence_id) {
-        if (sequences_info.find(sequence_id) == sequences_info.end())
-            sequences_info.emplace(sequence_id, SequenceInfo(start_time));
-        sequences_info.at(sequence_id).update();
+        metrics.request_id = request_id;
+        metrics.num_input_tokens = input_len;
     }
 
     void update(ov::genai::GenerationOutputs& outputs){
+        // tokens of all sequences are generated at the same steps
+        size_t num_new_tokens = 0;
         for (auto const& output: outputs) {
-            update_sequence(output.first);
+            num_new_tokens = std::max(num_new_tokens, output.second.generated_ids.size());
+        }
+        if (num_new_tokens == 0)
+            return;
+
+        std::chrono::steady_clock::time_point read_time = std::chrono::steady_clock::now();
+        if (metrics.num_output_tokens == 0) {
+            metrics.ttft = to_milli(read_time - start_time);
+        } else {
+            inter_token_latencies.push_back(to_milli(read_time - last_read_time));
         }
+        metrics.num_output_tokens += num_new_tokens;
+        last_read_time = read_time;
     }
 
     ov::genai::GenerationOutputs read() {
@@ -211,39 +352,77 @@ public:
         return generation_handle->can_read();
     }
 
-    bool is_finished() {
-        return generation_handle->get_status() == ov::genai::GenerationStatus::FINISHED;
+    ov::genai::GenerationStatus get_status() {
+        return generation_handle->get_status();
     }
 
-    void set_inactive() {
+    void finish(ov::genai::GenerationStatus status) {
         active = false;
+        metrics.completed = status == ov::genai::GenerationStatus::FINISHED;
+        metrics.e2e_latency = to_milli(std::chrono::steady_clock::now() - start_time);
+        if (metrics.num_output_tokens > 1) {
+            metrics.mean_tpot = (to_milli(last_read_time - start_time) - metrics.ttft) / (metrics.num_output_tokens - 1);
+        }
     }
 
-    bool is_active() {
+    bool is_active() const {
         return active;
     }
 
-    GenerationMetrics get_metrics() {
-        GenerationMetrics generation_metrics;
-        if (!sequences_info.empty()) {
-            for (auto& sequenceInfoPair : sequences_info) {
-                generation_metrics.mean_ttft += sequenceInfoPair.second.ttft;
-                generation_metrics.mean_tpot += sequenceInfoPair.second.mean_tpot;
-                generation_metrics.num_output_tokens += sequenceInfoPair.second.num_output_tokens;
-            }
-            generation_metrics.mean_ttft /= sequences_info.size();
-            generation_metrics.mean_tpot /= sequences_info.size();
-            generation_metrics.num_input_tokens = input_len;
-        }
-        return generation_metrics;
+    const RequestMetrics& get_metrics() const {
+        return metrics;
+    }
+
+    const std::vector<double>& get_inter_token_latencies() const {
+        return inter_token_latencies;
     }
 };
 
+struct SLOConfig {
+    // limits in milliseconds, 0 means that the latency is not constrained
+    double ttft = 0.0;
+    double tpot = 0.0;
+
+    bool is_met(const GenerationInfo::RequestMetrics& metrics) const {
+        return metrics.completed && (ttft <= 0.0 || metrics.ttft <= ttft) && (tpot <= 0.0 || metrics.mean_tpot <= tpot);
+    }
+};
+
+nlohmann::ordered_json get_distribution(std::vector<double> values) {
+    nlohmann::ordered_json distribution;
+    if (values.empty()) {
+        return distribution;
+    }
+
+    std::sort(values.begin(), values.end());
+    auto percentile = [&values](double p) {
+        // linear interpolation between closest ranks
+        double rank = p / 100.0 * (values.size() - 1);
+        size_t lower = static_cast<size_t>(rank);
+        size_t upper = std::min(lower + 1, values.size() - 1);
+        return values[lower] + (values[upper] - values[lower]) * (rank - lower);
+    };
+
+    double sum = 0.0;
+    for (double value : values)
+        sum += value;
+
+    distribution["mean"] = sum / values.size();
+    distribution["p50"] = percentile(50);
+    distribution["p90"] = percentile(90);
+    distribution["p95"] = percentile(95);
+    distribution["p99"] = percentile(99);
+    distribution["max"] = values.back();
+    return distribution;
+}
+
 class GenerationInfoCollector {
     std::mutex mutex;
+    std::condition_variable finished_cv;
     std::vector<GenerationInfo> generations_info;
     size_t num_finished = 0;
     std::chrono::steady_clock::time_point start_time;
+    std::chrono::steady_clock::time_point end_time;
 
 public:
 
@@ -261,58 +440,165 @@ public:
         }
         ov::genai::GenerationHandle generation_handle = pipe->add_request(request_id, dataset->m_prompts[request_id], sampling_params);
         std::lock_guard<std::mutex> lock(mutex);
-        generations_info.emplace_back(std::move(generation_handle), dataset->m_input_lens[request_id]);
+        generations_info.emplace_back(std::move(generation_handle), request_id, dataset->m_input_lens[request_id]);
+    }
+
+    // requests are added in the order of their IDs, so request ID is an index in generations_info
+    void wait_for_finish(size_t request_id) {
+        std::unique_lock<std::mutex> lock(mutex);
+        finished_cv.wait(lock, [this, request_id] {
+            return request_id < generations_info.size() && !generations_info[request_id].is_active();
+        });
     }
 
     size_t run() {
         std::lock_guard<std::mutex> lock(mutex);
+        size_t prev_num_finished = num_finished;
         for (GenerationInfo& generation_info : generations_info) {
             if (!generation_info.is_active())
                 continue;
-            
-            if (generation_info.is_finished()) {
-                num_finished++;
-                generation_info.set_inactive();
-            } else if (generation_info.can_read()) {
+
+            // status is checked before reading to not miss tokens generated right before the finish
+            ov::genai::GenerationStatus status = generation_info.get_status();
+            while (generation_info.can_read()) {
                 auto outputs = generation_info.read();
                 generation_info.update(outputs);
             }
+            if (status != ov::genai::GenerationStatus::RUNNING) {
+                num_finished++;
+                generation_info.finish(status);
+            }
+        }
+        if (num_finished != prev_num_finished) {
+            end_time = std::chrono::steady_clock::now();
+            finished_cv.notify_all();
         }
         return num_finished;
     }
 
-    void print_statistics() {
-        std::chrono::seconds total_duration = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now() - start_time);
-        std::chrono::milliseconds mean_ttft = std::chrono::milliseconds::zero();
-        std::chrono::milliseconds mean_tpot = std::chrono::milliseconds::zero();
+    nlohmann::ordered_json get_statistics(const ov::genai::PipelineMetrics& pipeline_metrics, const SLOConfig& slo_config) {
+        std::lock_guard<std::mutex> lock(mutex);
+        double total_duration = std::chrono::duration<double>(end_time - start_time).count();
         size_t total_input_len = 0;
         size_t total_output_len = 0;
-        
-    
-        for (GenerationInfo& generation_info : generations_info){
-            auto generation_metrics = generation_info.get_metrics();
-            mean_ttft += generation_metrics.mean_ttft;
-            mean_tpot += generation_metrics.mean_tpot;
-            total_input_len += generation_metrics.num_input_tokens;
-            total_output_len += generation_metrics.num_output_tokens;
+        size_t num_completed = 0;
+        size_t num_met_slo = 0;
+        std::vector<double> ttfts, tpots, itls, e2e_latencies;
+
+        for (const GenerationInfo& generation_info : generations_info) {
+            const auto& metrics = generation_info.get_metrics();
+            total_input_len += metrics.num_input_tokens;
+            total_output_len += metrics.num_output_tokens;
+            num_completed += metrics.completed;
+            num_met_slo += slo_config.is_met(metrics);
+            if (metrics.num_output_tokens > 0)
+                ttfts.push_back(metrics.ttft);
+            if (metrics.num_output_tokens > 1)
+                tpots.push_back(metrics.mean_tpot);
+            e2e_latencies.push_back(metrics.e2e_latency);
+            const auto& inter_token_latencies = generation_info.get_inter_token_latencies();
+            itls.insert(itls.end(), inter_token_latencies.begin(), inter_token_latencies.end());
+        }
+
+        nlohmann::ordered_json statistics;
+        statistics["duration_s"] = total_duration;
+        statistics["num_requests"] = generations_info.size();
+        statistics["num_completed_requests"] = num_completed;
+        statistics["total_input_tokens"] = total_input_len;
+        statistics["total_output_tokens"] = total_output_len;
+        statistics["request_throughput"] = num_completed / total_duration;
+        statistics["input_throughput"] = total_input_len / total_duration;
+        statistics["output_throughput"] = total_output_len / total_duration;
+        statistics["ttft_ms"] = get_distribution(ttfts);
+        statistics["tpot_ms"] = get_distribution(tpots);
+        statistics["itl_ms"] = get_distribution(itls);
+        statistics["e2e_latency_ms"] = get_distribution(e2e_latencies);
+        statistics["slo_ttft_ms"] = slo_config.ttft;
+        statistics["slo_tpot_ms"] = slo_config.tpot;
+        statistics["slo_attainment"] = generations_info.empty() ? 0.0 : static_cast<double>(num_met_slo) / generations_info.size();
+        statistics["goodput"] = num_met_slo / total_duration;
+        statistics["prefix_cache_hit_rate"] = pipeline_metrics.prompt_tokens == 0 ? 0.0 :
+            static_cast<double>(pipeline_metrics.cached_prompt_tokens) / pipeline_metrics.prompt_tokens;
+        statistics["num_preemptions"] = pipeline_metrics.num_preemptions;
+        statistics["max_cache_usage"] = pipeline_metrics.max_cache_usage;
+        statistics["avg_cache_usage"] = pipeline_metrics.avg_cache_usage;
+        return statistics;
+    }
+
+    nlohmann::ordered_json get_requests_metrics(const SLOConfig& slo_config) {
+        std::lock_guard<std::mutex> lock(mutex);
+        nlohmann::ordered_json requests_metrics = nlohmann::ordered_json::array();
+        for (const GenerationInfo& generation_info : generations_info) {
+            const auto& metrics = generation_info.get_metrics();
+            nlohmann::ordered_json request_metrics;
+            request_metrics["request_id"] = metrics.request_id;
+            request_metrics["input_tokens"] = metrics.num_input_tokens;
+            request_metrics["output_tokens"] = metrics.num_output_tokens;
+            request_metrics["ttft_ms"] = metrics.ttft;
+            request_metrics["tpot_ms"] = metrics.mean_tpot;
+            request_metrics["e2e_latency_ms"] = metrics.e2e_latency;
+            request_metrics["completed"] = metrics.completed;
+            request_metrics["met_slo"] = slo_config.is_met(metrics);
+            requests_metrics.push_back(std::move(request_metrics));
         }
-        mean_ttft /= generations_info.size();
-        mean_tpot /= generations_info.size();
-        std::cout << "Benchmark duration: " << total_duration.count() << " s" << std::endl;
-        std::cout << "Total number of input tokens: " << total_input_len << std::endl;
-        std::cout << "Total number of output tokens: " << total_output_len << std::endl;
-        std::cout << "Input throughput: " << total_input_len / total_duration.count() << " tokens / s" << std::endl;
-        std::cout << "Output throughput: " << total_output_len / total_duration.count() << " tokens / s" << std::endl;
-        std::cout << "Mean TTFT: " << mean_ttft.count() << " ms" << std::endl;
-        std::cout << "Mean TPOT: " << mean_tpot.count() << " ms" << std::endl; 
+        return requests_metrics;
     }
 };
 
-void trafficSimulator(ov::genai::ContinuousBatchingPipeline* pipe, Dataset* dataset, std::string request_rate, GenerationInfoCollector* generation_info_collector, bool is_speculative_decoding_enabled) {
+void print_statistics(const nlohmann::ordered_json& statistics) {
+    auto print_distribution = [&statistics](const std::string& name, const std::string& key) {
+        const auto& distribution = statistics[key];
+        if (distribution.is_null())
+            return;
+        std::cout << name << ": mean " << distribution["mean"].get<double>() << " ms, p50 " << distribution["p50"].get<double>()
+                  << " ms, p90 " << distribution["p90"].get<double>() << " ms, p99 " << distribution["p99"].get<double>() << " ms" << std::endl;
+    };
+
+    std::cout << "Benchmark duration: " << statistics["duration_s"].get<double>() << " s" << std::endl;
+    std::cout << "Completed requests: " << statistics["num_completed_requests"].get<size_t>() << " / " << statistics["num_requests"].get<size_t>() << std::endl;
+    std::cout << "Total number of input tokens: " << statistics["total_input_tokens"].get<size_t>() << std::endl;
+    std::cout << "Total number of output tokens: " << statistics["total_output_tokens"].get<size_t>() << std::endl;
+    std::cout << "Request throughput: " << statistics["request_throughput"].get<double>() << " requests / s" << std::endl;
+    std::cout << "Input throughput: " << statistics["input_throughput"].get<double>() << " tokens / s" << std::endl;
+    std::cout << "Output throughput: " << statistics["output_throughput"].get<double>() << " tokens / s" << std::endl;
+    print_distribution("TTFT", "ttft_ms");
+    print_distribution("TPOT", "tpot_ms");
+    print_distribution("ITL", "itl_ms");
+    print_distribution("E2E latency", "e2e_latency_ms");
+    std::cout << "SLO attainment (TTFT <= " << statistics["slo_ttft_ms"].get<double>() << " ms, TPOT <= " << statistics["slo_tpot_ms"].get<double>()
+              << " ms, 0 - not constrained): " << statistics["slo_attainment"].get<double>() * 100 << " %" << std::endl;
+    std::cout << "Goodput: " << statistics["goodput"].get<double>() << " requests / s" << std::endl;
+    std::cout << "Prefix cache hit rate: " << statistics["prefix_cache_hit_rate"].get<double>() * 100 << " %" << std::endl;
+    std::cout << "Number of preemptions: " << statistics["num_preemptions"].get<size_t>() << std::endl;
+    std::cout << "Max / average KV cache usage: " << statistics["max_cache_usage"].get<float>() << " / " << statistics["avg_cache_usage"].get<float>() << " %" << std::endl;
+}
+
+void write_csv(const std::string& csv_path, const nlohmann::ordered_json& requests_metrics) {
+    std::ofstream csv_file(csv_path);
+    OPENVINO_ASSERT(csv_file.is_open(), "Cannot open output CSV file ", csv_path);
+
+    csv_file << "request_id,input_tokens,output_tokens,ttft_ms,tpot_ms,e2e_latency_ms,completed,met_slo\n";
+    for (const auto& request_metrics : requests_metrics) {
+        csv_file << request_metrics["request_id"].get<size_t>() << ','
+                 << request_metrics["input_tokens"].get<size_t>() << ','
+                 << request_metrics["output_tokens"].get<size_t>() << ','
+                 << request_metrics["ttft_ms"].get<double>() << ','
+                 << request_metrics["tpot_ms"].get<double>() << ','
+                 << request_metrics["e2e_latency_ms"].get<double>() << ','
+                 << request_metrics["completed"].get<bool>() << ','
+                 << request_metrics["met_slo"].get<bool>() << '\n';
+    }
+}
+
+void trafficSimulator(ov::genai::ContinuousBatchingPipeline* pipe, Dataset* dataset, std::string request_rate, double burstiness, GenerationInfoCollector* generation_info_collector, bool is_speculative_decoding_enabled) {
     double numeric_request_rate;
     std::random_device rd;
     std::mt19937 gen(rd());
-    std::exponential_distribution<> distribution;
+    // burstiness 1 corresponds to Poisson process, lower values give more bursty arrivals and higher ones more uniform arrivals
+    std::gamma_distribution<> distribution;
+
+    if (burstiness <= 0)
+        throw std::invalid_argument("burstiness must be a positive number");
 
     if (request_rate == "inf") {
         numeric_request_rate = -1.0;
@@ -321,9 +607,12 @@ void trafficSimulator(ov::genai::ContinuousBatchingPipeline* pipe, Dataset* data
         if (numeric_request_rate < 0)
             throw std::invalid_argument("request_rate cannot be a negative number");
 
-        distribution = std::exponential_distribution<>(numeric_request_rate);
+        // mean inter-arrival time is 1 / request_rate regardless of burstiness
+        distribution = std::gamma_distribution<>(burstiness, 1.0 / (numeric_request_rate * burstiness));
     }
 
+    const bool replay_trace = !dataset->m_arrival_times.empty();
+
     /*
     std::cout << "Total input tokens: " << dataset->m_total_input_len << std::endl;
     std::cout << "Total output tokens: " << dataset->m_total_output_len << std::endl;
@@ -331,13 +620,25 @@ void trafficSimulator(ov::genai::ContinuousBatchingPipeline* pipe, Dataset* data
     std::cout << "Average output len: " << dataset->get_average_output_len() << " tokens" << std::endl;
     */
 
-    std::cout << "Launching traffic simulator thread with request_rate: " << request_rate << std::endl;
-    generation_info_collector->set_start_time(std::chrono::steady_clock::now());
+    if (replay_trace) {
+        std::cout << "Launching traffic simulator thread replaying trace timestamps" << std::endl;
+    } else {
+        std::cout << "Launching traffic simulator thread with request_rate: " << request_rate << ", burstiness: " << burstiness << std::endl;
+    }
+    const auto start_time = std::chrono::steady_clock::now();
+    generation_info_collector->set_start_time(start_time);
     for (size_t request_id = 0; request_id < dataset->size(); ++request_id) {
+        if (replay_trace) {
+            auto arrival_time = std::chrono::duration<double>(dataset->m_arrival_times[request_id]);
+            std::this_thread::sleep_until(start_time + std::chrono::duration_cast<std::chrono::steady_clock::duration>(arrival_time));
+        }
+        if (dataset->m_dependencies[request_id] != Dataset::NO_DEPENDENCY) {
+            generation_info_collector->wait_for_finish(dataset->m_dependencies[request_id]);
+        }
         std::cout << "Traffic thread adding request to the queue..." << std::endl;
         generation_info_collector->add_generation(pipe, dataset, request_id, is_speculative_decoding_enabled);
-        if (numeric_request_rate > 0)
-            std::this_thread::sleep_for(std::chrono::milliseconds(int(distribution(gen) * 1000)));
+        if (!replay_trace && numeric_request_rate > 0)
+            std::this_thread::sleep_for(std::chrono::duration<double>(distribution(gen)));
     }
     std::cout << "All requests sent, traffic simulation finished. Exiting thread." << std::endl;
 }
@@ -359,10 +660,7 @@ void statisticsReporter(GenerationInfoCollector* generations_info_collector, int
     while (num_finished < num_prompts) {
         num_finished = generations_info_collector->run();
     }
-    std::cout << "Benchmark finished, summarizing statistics..." << std::endl;
-    generations_info_collector->print_statistics();
-
-    std::cout << "Exiting statistics reporter thread." << std::endl;
+    std::cout << "All requests finished. Exiting statistics reporter thread." << std::endl;
 }
 
 bool parse_plugin_config_json(nlohmann::json& node, ov::AnyMap& device_config_map) {
@@ -437,14 +735,29 @@ int main(int argc, char* argv[]) try {
     ("dynamic_split_fuse", "Whether to use dynamic split-fuse or vLLM scheduling", cxxopts::value<bool>()->default_value("true"))
     ("m,model", "Path to model and tokenizers base directory", cxxopts::value<std::string>()->default_value("."))
     ("draft_model", "Path to assistant model directory", cxxopts::value<std::string>()->default_value(""))
-    ("dataset", "Path to dataset .json file", cxxopts::value<std::string>()->default_value("./ShareGPT_V3_unfiltered_cleaned_split.json"))
+    ("workload", "Workload type: 'sharegpt' samples conversations from the dataset, 'trace' replays requests from the dataset at their timestamps, "
+                 "'shared_prefix', 'multi_turn' and 'rag' are synthetic workloads with shared system prompts, multi-turn chats and long-context documents",
+                 cxxopts::value<std::string>()->default_value("sharegpt"))
+    ("dataset", "Path to dataset .json file. For 'trace' workload it's a JSON array of objects with 'prompt' and optional 'max_new_tokens' and 'timestamp' (in seconds) fields",
+                cxxopts::value<std::string>()->default_value("./ShareGPT_V3_unfiltered_cleaned_split.json"))
     ("max_input_len", "Max input length take from dataset", cxxopts::value<size_t>()->default_value("1024"))
     ("max_output_len", "Max output length", cxxopts::value<size_t>()->default_value("2048"))
+    ("input_len", "Number of words in a user message of synthetic workloads", cxxopts::value<size_t>()->default_value("64"))
+    ("output_len", "Number of generated tokens per request of synthetic workloads", cxxopts::value<size_t>()->default_value("128"))
+    ("prefix_len", "Number of words in a system prompt ('shared_prefix', 'multi_turn') or a document ('rag') of synthetic workloads", cxxopts::value<size_t>()->default_value("512"))
+    ("num_prefixes", "Number of distinct system prompts or documents of synthetic workloads", cxxopts::value<size_t>()->default_value("4"))
+    ("num_turns", "Number of turns in a chat of 'multi_turn' workload", cxxopts::value<size_t>()->default_value("4"))
     ("request_rate", "Number of requests per second. If this is inf, then all the requests are sent at time 0. Otherwise, we use Poisson process to synthesize the request arrival times.", cxxopts::value<std::string>()->default_value("inf"))
+    ("burstiness", "Shape of gamma distribution of request inter-arrival times. 1 corresponds to Poisson process, lower values give more bursty arrivals", cxxopts::value<double>()->default_value("1.0"))
     ("cache_size", "Size of memory used for KV cache in GB. Default: 16", cxxopts::value<size_t>()->default_value("16"))
+    ("enable_prefix_caching", "Whether to reuse KV cache of common prompt prefixes", cxxopts::value<bool>()->default_value("false"))
     ("device", "Target device to run the model. Default: CPU", cxxopts::value<std::string>()->default_value("CPU"))
     ("device_config", "Plugin configuration JSON. Example: '{\"MODEL_DISTRIBUTION_POLICY\":\"TENSOR_PARALLEL\",\"PERF_COUNT\":true}' Default: {\"PERF_COUNT\":true}", cxxopts::value<std::string>()->default_value("{\"PERF_COUNT\":true}"))
     ("use_cache_eviction", "Whether to use cache eviction", cxxopts::value<bool>()->default_value("false"))
+    ("slo_ttft", "TTFT service level objective in ms used to compute goodput. 0 means TTFT is not constrained", cxxopts::value<double>()->default_value("0"))
+    ("slo_tpot", "TPOT service level objective in ms used to compute goodput. 0 means TPOT is not constrained", cxxopts::value<double>()->default_value("0"))
+    ("output_json", "Path to .json file to save benchmark parameters, statistics and per-request metrics", cxxopts::value<std::string>()->default_value(""))
+    ("output_csv", "Path to .csv file to save per-request metrics", cxxopts::value<std::string>()->default_value(""))
     ("h,help", "Print usage");
 
     cxxopts::ParseResult result;
@@ -466,25 +779,49 @@ int main(int argc, char* argv[]) try {
     const bool dynamic_split_fuse = result["dynamic_split_fuse"].as<bool>();
     const std::string models_path = result["model"].as<std::string>();
     const std::string draft_model_path = result["draft_model"].as<std::string>();
+    const std::string workload = result["workload"].as<std::string>();
     const std::string dataset_path = result["dataset"].as<std::string>();
     const size_t max_input_len = result["max_input_len"].as<size_t>();
     const size_t max_output_len = result["max_output_len"].as<size_t>();
     const std::string request_rate = result["request_rate"].as<std::string>();
+    const double burstiness = result["burstiness"].as<double>();
     const std::string device = result["device"].as<std::string>();
     const std::string device_config = result["device_config"].as<std::string>();
     const size_t cache_size = result["cache_size"].as<size_t>();
+    const bool enable_prefix_caching = result["enable_prefix_caching"].as<bool>();
     const bool use_cache_eviction = result["use_cache_eviction"].as<bool>();
+    const std::string output_json = result["output_json"].as<std::string>();
+    const std::string output_csv = result["output_csv"].as<std::string>();
+
+    SyntheticWorkloadConfig synthetic_config;
+    synthetic_config.input_len = result["input_len"].as<size_t>();
+    synthetic_config.output_len = result["output_len"].as<size_t>();
+    synthetic_config.prefix_len = result["prefix_len"].as<size_t>();
+    synthetic_config.num_prefixes = result["num_prefixes"].as<size_t>();
+    synthetic_config.num_turns = result["num_turns"].as<size_t>();
+
+    SLOConfig slo_config;
+    slo_config.ttft = result["slo_ttft"].as<double>();
+    slo_config.tpot = result["slo_tpot"].as<double>();
 
     bool is_speculative_decoding_enabled = !draft_model_path.empty();
 
     // Create requests for generation
-    Dataset dataset = filtered_dataset(models_path, dataset_path, num_prompts, max_input_len, max_output_len);
+    Dataset dataset;
+    if (workload == "sharegpt") {
+        dataset = filtered_dataset(models_path, dataset_path, num_prompts, max_input_len, max_output_len);
+    } else if (workload == "trace") {
+        dataset = trace_dataset(models_path, dataset_path, num_prompts, max_output_len);
+    } else {
+        dataset = synthetic_dataset(models_path, workload, synthetic_config, num_prompts);
+    }
 
     // Perform the first inference
     ov::genai::SchedulerConfig scheduler_config;
     scheduler_config.max_num_batched_tokens = max_batch_size,
     scheduler_config.cache_size = cache_size,
     scheduler_config.dynamic_split_fuse = dynamic_split_fuse,
+    scheduler_config.enable_prefix_caching = enable_prefix_caching,
     scheduler_config.max_num_seqs = 256; // not used if dynamic_split_fuse=True
     if (use_cache_eviction) {
         scheduler_config.use_cache_eviction = true;
@@ -497,8 +834,10 @@ int main(int argc, char* argv[]) try {
     if (!scheduler_config.dynamic_split_fuse) {
         std::cout << "\tMax number of batched sequences: " << scheduler_config.max_num_seqs << std::endl;
     }
+    std::cout << "\tPrefix caching: " << (scheduler_config.enable_prefix_caching ? "enabled" : "disabled") << std::endl;
     std::cout << "Dataset parameters: " << std::endl;
-    std::cout << "\tNum prompts: " << num_prompts << std::endl;
+    std::cout << "\tWorkload: " << workload << std::endl;
+    std::cout << "\tNum prompts: " << dataset.size() << std::endl;
     std::cout << "\tMax input length: " << max_input_len << std::endl;
     std::cout << "\tMax output length: " << max_output_len << std::endl;
     std::cout << "\tTarget device: " << device << std::endl;
@@ -512,7 +851,7 @@ int main(int argc, char* argv[]) try {
         std::cout << "ERROR: Wrong json parameter in device_config." << std::endl;
         return EXIT_FAILURE;
     }
-    
+
     // Benchmarking
     std::cout << "Loading models, creating pipelines, preparing environment..." << std::endl;
     ov::genai::ContinuousBatchingPipeline pipe(models_path, scheduler_config, device, device_config_map);
@@ -521,23 +860,58 @@ int main(int argc, char* argv[]) try {
 
     GenerationInfoCollector generation_info_collector;
 
+    // all requests can be added before generation starts only if they don't wait for each other or for trace timestamps
+    const bool add_requests_in_advance = request_rate == "inf" && !dataset.has_dependencies() && dataset.m_arrival_times.empty();
+
     std::atomic<bool> finishGenerationThread{false};
-    if (request_rate == "inf") {
-        std::thread trafficSimulatorThread(trafficSimulator, &pipe, &dataset, request_rate, &generation_info_collector, is_speculative_decoding_enabled);
+    if (add_requests_in_advance) {
+        std::thread trafficSimulatorThread(trafficSimulator, &pipe, &dataset, request_rate, burstiness, &generation_info_collector, is_speculative_decoding_enabled);
         trafficSimulatorThread.join();
     }
-    
+
     std::thread lmmEngineThread(llmEngineLoop, &pipe, &dataset, &finishGenerationThread);
-    std::thread statisticsReporterThread(statisticsReporter, &generation_info_collector, num_prompts);
-    if (request_rate != "inf") {
-        std::thread trafficSimulatorThread(trafficSimulator, &pipe, &dataset, request_rate, &generation_info_collector, is_speculative_decoding_enabled);
+    std::thread statisticsReporterThread(statisticsReporter, &generation_info_collector, dataset.size());
+    if (!add_requests_in_advance) {
+        std::thread trafficSimulatorThread(trafficSimulator, &pipe, &dataset, request_rate, burstiness, &generation_info_collector, is_speculative_decoding_enabled);
         trafficSimulatorThread.join();
     }
     statisticsReporterThread.join();
     finishGenerationThread = true;
     lmmEngineThread.join();
 
-    std::cout << "Benchmark finished" << std::endl;
+    std::cout << "Benchmark finished, summarizing statistics..." << std::endl;
+    nlohmann::ordered_json statistics = generation_info_collector.get_statistics(pipe.get_metrics(), slo_config);
+    print_statistics(statistics);
+
+    if (!output_json.empty() || !output_csv.empty()) {
+        nlohmann::ordered_json requests_metrics = generation_info_collector.get_requests_metrics(slo_config);
+        if (!output_csv.empty()) {
+            write_csv(output_csv, requests_metrics);
+        }
+        if (!output_json.empty()) {
+            nlohmann::ordered_json report;
+            report["parameters"] = {
+                {"model", models_path},
+                {"draft_model", draft_model_path},
+                {"workload", workload},
+                {"num_prompts", dataset.size()},
+                {"request_rate", request_rate},
+                {"burstiness", burstiness},
+                {"max_batch_size", max_batch_size},
+                {"dynamic_split_fuse", dynamic_split_fuse},
+                {"enable_prefix_caching", enable_prefix_caching},
+                {"use_cache_eviction", use_cache_eviction},
+                {"cache_size", cache_size},
+                {"device", device}
+            };
+            report["statistics"] = statistics;
+            report["requests"] = requests_metrics;
+
+            std::ofstream json_file(output_json);
+            OPENVINO_ASSERT(json_file.is_open(), "Cannot open output JSON file ", output_json);
+            json_file << report.dump(4) << std::endl;
+        }
+    }
 } catch (const std::exception& error) {
     try {
         std::cerr << error.what() << '\n';
@@ -0,0 +1,146 @@
+// Copyright (C) 2025 Intel Corporation
+// SPDX-License-Identifier: Apache-2.0
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <cxxopts.hpp>
+
+#include "utils.hpp"
+#include "visual_language/vision_encoder.hpp"
+#include "visual_language/vlm_config.hpp"
+
+namespace {
+
+struct BenchmarkCase {
+    std::string name;
+    ov::genai::VLMModelType model_type;
+    ov::genai::ProcessorConfig config;
+};
+
+// Processor configs close to preprocessor_config.json of typical models of each type
+std::vector<BenchmarkCase> get_default_cases() {
+    using ov::genai::VLMModelType;
+    std::vector<BenchmarkCase> cases;
+
+    ov::genai::ProcessorConfig minicpm;
+    minicpm.max_slice_nums = 9;
+    minicpm.norm_mean = minicpm.norm_std = {0.5f, 0.5f, 0.5f};
+    cases.push_back({"minicpmv", VLMModelType::MINICPM, minicpm});
+
+    ov::genai::ProcessorConfig llava;
+    llava.image_mean = {0.48145466f, 0.4578275f, 0.40821073f};
+    llava.image_std = {0.26862954f, 0.26130258f, 0.27577711f};
+    cases.push_back({"llava", VLMModelType::LLAVA, llava});
+    cases.push_back({"llava_next", VLMModelType::LLAVA_NEXT, llava});
+
+    ov::genai::ProcessorConfig internvl;
+    internvl.size_shortest_edge = 448;
+    internvl.image_mean = {0.485f, 0.456f, 0.406f};
+    internvl.image_std = {0.229f, 0.224f, 0.225f};
+    cases.push_back({"internvl_chat", VLMModelType::INTERNVL_CHAT, internvl});
+
+    ov::genai::ProcessorConfig phi3_v = llava;
+    phi3_v.phi3_v.num_crops = 16;
+    cases.push_back({"phi3_v", VLMModelType::PHI3_V, phi3_v});
+
+    ov::genai::ProcessorConfig qwen2vl = llava;
+    qwen2vl.max_pixels = 1280 * 28 * 28;
+    cases.push_back({"qwen2_vl", VLMModelType::QWEN2_VL, qwen2vl});
+
+    return cases;
+}
+
+ov::Tensor create_random_image(size_t height, size_t width) {
+    ov::Tensor image{ov::element::u8, {1, height, width, 3}};
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> distribution{0, 255};
+    std::generate_n(image.data<uint8_t>(), image.get_size(), [&]() {
+        return static_cast<uint8_t>(distribution(generator));
+    });
+    return image;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) try {
+    cxxopts::Options options("vlm_preprocessing_benchmark", "Measures image preprocessing of VLM vision encoders");
+
+    options.add_options()
+    ("m,model", "Path to a VLM model directory. If set, only its model type and preprocessor_config.json are benchmarked", cxxopts::value<std::string>()->default_value(""))
+    ("image_height", "Height of a random input image", cxxopts::value<size_t>()->default_value("1080"))
+    ("image_width", "Width of a random input image", cxxopts::value<size_t>()->default_value("1920"))
+    ("n,num_iter", "Number of measured iterations per model type", cxxopts::value<size_t>()->default_value("20"))
+    ("num_warmup", "Number of warmup iterations per model type", cxxopts::value<size_t>()->default_value("2"))
+    ("h,help", "Print usage");
+
+    cxxopts::ParseResult result;
+    try {
+        result = options.parse(argc, argv);
+    } catch (const cxxopts::exceptions::exception& e) {
+        std::cout << e.what() << "\n\n";
+        std::cout << options.help() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (result.count("help")) {
+        std::cout << options.help() << std::endl;
+        return EXIT_SUCCESS;
+    }
+
+    const std::string models_path = result["model"].as<std::string>();
+    const size_t image_height = result["image_height"].as<size_t>();
+    const size_t image_width = result["image_width"].as<size_t>();
+    const size_t num_iter = result["num_iter"].as<size_t>();
+    const size_t num_warmup = result["num_warmup"].as<size_t>();
+
+    std::vector<BenchmarkCase> cases;
+    if (models_path.empty()) {
+        cases = get_default_cases();
+    } else {
+        auto vlm_config = ov::genai::utils::from_config_json_if_exists<ov::genai::VLMConfig>(models_path, "config.json");
+        auto processor_config = ov::genai::utils::from_config_json_if_exists<ov::genai::ProcessorConfig>(models_path, "preprocessor_config.json");
+        cases.push_back({models_path, vlm_config.model_type, processor_config});
+    }
+
+    const ov::Tensor image = create_random_image(image_height, image_width);
+    std::cout << "Input image: " << image_width << "x" << image_height << ", iterations: " << num_iter << std::endl;
+
+    for (const BenchmarkCase& benchmark_case : cases) {
+        ov::Tensor pixel_values;
+        for (size_t i = 0; i < num_warmup; ++i) {
+            pixel_values = ov::genai::preprocess_image(image, benchmark_case.model_type, benchmark_case.config);
+        }
+
+        std::vector<double> durations;
+        durations.reserve(num_iter);
+        for (size_t i = 0; i < num_iter; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            pixel_values = ov::genai::preprocess_image(image, benchmark_case.model_type, benchmark_case.config);
+            durations.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        if (durations.empty()) {
+            continue;
+        }
+        std::sort(durations.begin(), durations.end());
+        double mean = 0.0;
+        for (double duration : durations) {
+            mean += duration / durations.size();
+        }
+
+        std::cout << benchmark_case.name << ":" << std::endl;
+        std::cout << "\tOutput shape: " << pixel_values.get_shape() << std::endl;
+        std::cout << "\tMean: " << mean << " ms, median: " << durations[durations.size() / 2]
+                  << " ms, min: " << durations.front() << " ms, max: " << durations.back() << " ms" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+} catch (const std::exception& error) {
+    std::cerr << error.what() << '\n';
+    return EXIT_FAILURE;
+}